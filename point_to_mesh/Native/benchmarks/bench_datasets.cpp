@@ -0,0 +1,205 @@
+/**
+ * @file bench_datasets.cpp
+ * @brief Synthetic Scan Generation for smr_benchmarks
+ */
+
+#include "bench_datasets.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+static const float BENCH_PI = 3.14159265358979f;
+
+// =============================================================================
+// Random Numbers
+// =============================================================================
+
+// SplitMix64: tiny, and identical on every platform (unlike std distributions)
+class BenchRandom {
+public:
+    explicit BenchRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /// Uniform in [lo, hi)
+    float uniform(float lo, float hi) {
+        return lo + (hi - lo) * static_cast<float>((next() >> 40) * (1.0 / 16777216.0));
+    }
+
+    /// Normal with standard deviation sigma (Box-Muller)
+    float gaussian(float sigma) {
+        float u1 = uniform(1e-7f, 1.0f);
+        float u2 = uniform(0.0f, 1.0f);
+        return sigma * std::sqrt(-2.0f * std::log(u1)) * std::cos(2.0f * BENCH_PI * u2);
+    }
+
+private:
+    uint64_t state;
+};
+
+// =============================================================================
+// Shapes
+// =============================================================================
+
+static void add_point(BenchCloud& cloud, float x, float y, float z, float nx, float ny, float nz) {
+    cloud.points.push_back(x);
+    cloud.points.push_back(y);
+    cloud.points.push_back(z);
+    cloud.normals.push_back(nx);
+    cloud.normals.push_back(ny);
+    cloud.normals.push_back(nz);
+}
+
+static void make_plane(BenchCloud& cloud, size_t count, BenchRandom& rng) {
+    for (size_t i = 0; i < count; ++i) {
+        add_point(cloud, rng.uniform(-0.5f, 0.5f), rng.uniform(-0.5f, 0.5f), rng.gaussian(0.0005f),
+                  0, 0, 1);
+    }
+}
+
+static void make_cylinder(BenchCloud& cloud, size_t count, BenchRandom& rng) {
+    const float radius = 0.15f;
+    for (size_t i = 0; i < count; ++i) {
+        float a = rng.uniform(0.0f, 2.0f * BENCH_PI);
+        float r = radius + rng.gaussian(0.0005f);
+        float nx = std::cos(a), nz = std::sin(a);
+        add_point(cloud, r * nx, rng.uniform(-0.3f, 0.3f), r * nz, nx, 0, nz);
+    }
+}
+
+// Base plate z = 0 (x in [-0.2, 0.2]) and a 10 mm web at x = +-0.005 up to
+// z = 0.15, both 0.6 m long in y; the weld seams run along the web's foot
+static void make_tjoint(BenchCloud& cloud, size_t count, BenchRandom& rng) {
+    const float half_web = 0.005f;
+    const float noise = 0.0008f;
+    for (size_t i = 0; i < count; ++i) {
+        float y = rng.uniform(-0.3f, 0.3f);
+        float pick = rng.uniform(0.0f, 1.0f);
+        if (pick < 0.01f) {
+            // Stray returns (spatter, reflections)
+            add_point(cloud, rng.uniform(-0.2f, 0.2f), y, rng.uniform(0.0f, 0.15f), 0, 0, 1);
+        } else if (pick < 0.6f) {
+            float x;
+            do { x = rng.uniform(-0.2f, 0.2f); } while (std::fabs(x) < half_web);
+            add_point(cloud, x, y, rng.gaussian(noise), 0, 0, 1);
+        } else {
+            float side = pick < 0.8f ? -1.0f : 1.0f;
+            add_point(cloud, side * half_web + rng.gaussian(noise), y, rng.uniform(0.0f, 0.15f),
+                      side, 0, 0);
+        }
+    }
+}
+
+const char* bench_shape_name(int shape) {
+    switch (shape) {
+        case SHAPE_PLANE: return "plane";
+        case SHAPE_CYLINDER: return "cylinder";
+        case SHAPE_TJOINT: return "tjoint";
+        default: return "unknown";
+    }
+}
+
+const BenchCloud& bench_cloud(int shape, size_t count) {
+    static BenchCloud cached;
+    static int cached_shape = -1;
+    if (cached_shape == shape && cached.count() == count) return cached;
+
+    cached.points.clear();
+    cached.normals.clear();
+    cached.points.reserve(count * 3);
+    cached.normals.reserve(count * 3);
+
+    BenchRandom rng(0x5EED0000ull + static_cast<uint64_t>(shape) * 7919u + count);
+    switch (shape) {
+        case SHAPE_CYLINDER: make_cylinder(cached, count, rng); break;
+        case SHAPE_TJOINT: make_tjoint(cached, count, rng); break;
+        default: make_plane(cached, count, rng); break;
+    }
+    cached_shape = shape;
+    return cached;
+}
+
+std::string bench_write_ply(const BenchCloud& cloud, const char* name) {
+    const char* dir = std::getenv("TMPDIR");
+#if defined(_WIN32)
+    if (!dir) dir = std::getenv("TEMP");
+#endif
+    std::string path = std::string(dir ? dir : "/tmp") + "/" + name;
+
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return std::string();
+    size_t n = cloud.count();
+    std::fprintf(file, "ply\nformat ascii 1.0\nelement vertex %zu\n"
+                       "property float x\nproperty float y\nproperty float z\n"
+                       "property float nx\nproperty float ny\nproperty float nz\nend_header\n", n);
+    for (size_t i = 0; i < n; ++i) {
+        const float* p = &cloud.points[i * 3];
+        const float* q = &cloud.normals[i * 3];
+        std::fprintf(file, "%.6f %.6f %.6f %.4f %.4f %.4f\n", p[0], p[1], p[2], q[0], q[1], q[2]);
+    }
+    std::fclose(file);
+    return path;
+}
+
+void bench_seam(size_t count, std::vector<float>& points, std::vector<float>& normals) {
+    points.resize(count * 3);
+    normals.resize(count * 3);
+    for (size_t i = 0; i < count; ++i) {
+        float t = count > 1 ? static_cast<float>(i) / (count - 1) : 0.0f;
+        // 0.4 m fillet seam in front of the robot, with a slight S-bend
+        points[i * 3] = 0.45f + 0.02f * std::sin(2.0f * BENCH_PI * t);
+        points[i * 3 + 1] = -0.2f + 0.4f * t;
+        points[i * 3 + 2] = 0.05f;
+        normals[i * 3] = -0.7071f;
+        normals[i * 3 + 1] = 0.0f;
+        normals[i * 3 + 2] = 0.7071f;
+    }
+}
+
+void bench_joints(size_t count, std::vector<double>& joints) {
+    BenchRandom rng(0x10B07ull + count);
+    joints.resize(count * 6);
+    for (double& q : joints) q = rng.uniform(-2.0f, 2.0f);
+}
+
+// =============================================================================
+// Reporting
+// =============================================================================
+
+size_t bench_resident_bytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS info;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info))) return info.WorkingSetSize;
+    return 0;
+#elif defined(__linux__)
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+    unsigned long size = 0, resident = 0;
+    int read = std::fscanf(file, "%lu %lu", &size, &resident);
+    std::fclose(file);
+    return read == 2 ? resident * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+    return 0;
+#endif
+}
+
+void bench_report(benchmark::State& state, size_t items, size_t input_bytes) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(items));
+    state.counters["input_MB"] = input_bytes / (1024.0 * 1024.0);
+    state.counters["rss_MB"] = bench_resident_bytes() / (1024.0 * 1024.0);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file bench_datasets.h
+ * @brief Reproducible synthetic scans and reporting helpers for smr_benchmarks
+ */
+
+#ifndef SMR_BENCH_DATASETS_H
+#define SMR_BENCH_DATASETS_H
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// Scanned part shapes (benchmark argument)
+enum BenchShape {
+    SHAPE_PLANE,      // 1 x 1 m plate
+    SHAPE_CYLINDER,   // Pipe, r = 0.15 m, 0.6 m long
+    SHAPE_TJOINT,     // Base plate and web with 1% outliers and heavier noise
+    SHAPE_COUNT
+};
+
+/// Points and unit normals (XYZ each)
+struct BenchCloud {
+    std::vector<float> points;
+    std::vector<float> normals;
+
+    size_t count() const { return points.size() / 3; }
+    size_t bytes() const { return (points.size() + normals.size()) * sizeof(float); }
+};
+
+const char* bench_shape_name(int shape);
+
+/**
+ * Scan of `shape` with `count` points. The generator is self-contained (no
+ * std distributions), so every platform and compiler sees the same points.
+ * The most recent cloud is cached, since large clouds are costly to build.
+ */
+const BenchCloud& bench_cloud(int shape, size_t count);
+
+/// Write a cloud as ASCII PLY with normals to the temp directory; returns the path
+std::string bench_write_ply(const BenchCloud& cloud, const char* name);
+
+/**
+ * Weld seam of `count` points along the root of the T-joint, gently curved
+ * so that smoothing, resampling and IK do real work.
+ */
+void bench_seam(size_t count, std::vector<float>& points, std::vector<float>& normals);
+
+/// `count` joint configurations (6 each) inside +-2 rad, away from the limits
+void bench_joints(size_t count, std::vector<double>& joints);
+
+/// Process working set in bytes (0 where unsupported)
+size_t bench_resident_bytes();
+
+/// Add points/s and memory counters (input size, resident set) to a benchmark
+void bench_report(benchmark::State& state, size_t items, size_t input_bytes);
+
+#endif // SMR_BENCH_DATASETS_H
@@ -0,0 +1,155 @@
+/**
+ * @file bench_kinematics.cpp
+ * @brief Kinematics Benchmarks (FK, IK, path-to-joints throughput)
+ */
+
+#include "bench_datasets.h"
+#include "smr_welding_api.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+static const size_t POSE_COUNT = 1024;
+
+static const char* robot_name(int type) {
+    switch (type) {
+        case ROBOT_UR5: return "ur5";
+        case ROBOT_UR10: return "ur10";
+        case ROBOT_KUKA_KR6_R700: return "kuka_kr6_r700";
+        case ROBOT_DOOSAN_M1013: return "doosan_m1013";
+        default: return "custom";
+    }
+}
+
+// Flange poses of random joint configurations, so every target is reachable
+static void make_targets(RobotHandle robot, std::vector<double>& joints,
+                         std::vector<double>& targets) {
+    bench_joints(POSE_COUNT, joints);
+    targets.resize(POSE_COUNT * 16);
+    for (size_t i = 0; i < POSE_COUNT; ++i) {
+        smr_robot_forward_kinematics(robot, &joints[i * 6], &targets[i * 16]);
+    }
+}
+
+// =============================================================================
+// Single Pose
+// =============================================================================
+
+static void BM_RobotForwardKinematics(benchmark::State& state) {
+    RobotHandle robot = smr_robot_create(static_cast<RobotType>(state.range(0)));
+    std::vector<double> joints;
+    bench_joints(POSE_COUNT, joints);
+
+    double transform[16];
+    size_t i = 0;
+    for (auto _ : state) {
+        smr_robot_forward_kinematics(robot, &joints[i * 6], transform);
+        benchmark::DoNotOptimize(transform);
+        i = (i + 1) % POSE_COUNT;
+    }
+    state.SetLabel(robot_name(static_cast<int>(state.range(0))));
+    bench_report(state, 1, 0);
+    smr_robot_destroy(robot);
+}
+
+static void BM_RobotInverseKinematics(benchmark::State& state) {
+    RobotHandle robot = smr_robot_create(static_cast<RobotType>(state.range(0)));
+    std::vector<double> joints, targets;
+    make_targets(robot, joints, targets);
+
+    double solutions[8 * 6];
+    int count = 0;
+    int64_t found = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        smr_robot_inverse_kinematics(robot, &targets[i * 16], solutions, &count);
+        found += count > 0 ? 1 : 0;
+        i = (i + 1) % POSE_COUNT;
+    }
+    state.counters["solved"] = benchmark::Counter(static_cast<double>(found),
+                                                  benchmark::Counter::kAvgIterations);
+    state.SetLabel(robot_name(static_cast<int>(state.range(0))));
+    bench_report(state, 1, 0);
+    smr_robot_destroy(robot);
+}
+
+static void BM_RobotIKNearest(benchmark::State& state) {
+    RobotHandle robot = smr_robot_create(static_cast<RobotType>(state.range(0)));
+    std::vector<double> joints, targets;
+    make_targets(robot, joints, targets);
+
+    // Seed each solve 0.05 rad away from the answer, as along a path
+    std::vector<double> seeds(joints);
+    for (double& q : seeds) q += 0.05;
+
+    double solution[6];
+    int64_t solved = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        solved += smr_robot_ik_nearest(robot, &targets[i * 16], &seeds[i * 6], solution) ==
+                  SMR_SUCCESS ? 1 : 0;
+        i = (i + 1) % POSE_COUNT;
+    }
+    state.counters["solved"] = benchmark::Counter(static_cast<double>(solved),
+                                                  benchmark::Counter::kAvgIterations);
+    state.SetLabel(robot_name(static_cast<int>(state.range(0))));
+    bench_report(state, 1, 0);
+    smr_robot_destroy(robot);
+}
+
+BENCHMARK(BM_RobotForwardKinematics)
+    ->Arg(ROBOT_UR5)->Arg(ROBOT_KUKA_KR6_R700)->Arg(ROBOT_DOOSAN_M1013);
+BENCHMARK(BM_RobotInverseKinematics)
+    ->Arg(ROBOT_UR5)->Arg(ROBOT_KUKA_KR6_R700)->Arg(ROBOT_DOOSAN_M1013)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RobotIKNearest)
+    ->Arg(ROBOT_UR5)->Arg(ROBOT_KUKA_KR6_R700)->Arg(ROBOT_DOOSAN_M1013)
+    ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Path to Joints
+// =============================================================================
+
+// Trajectory IK over a seam; also reports solver iterations per point when
+// the library was built with stats
+static void BM_PathToJoints(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::vector<float> points, normals;
+    bench_seam(count, points, normals);
+
+    PathParams params = {};
+    params.step_size = 0.001f;
+    params.standoff_distance = 0.015f;
+    PathHandle path = smr_path_create_from_points(points.data(), normals.data(),
+                                                  static_cast<int>(count), &params);
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    int n = smr_path_get_count(path);
+    std::vector<double> joints(static_cast<size_t>(n) * 6);
+    std::unique_ptr<bool[]> reachable(new bool[n]);
+
+    bool stats = smr_stats_set_mode(SMR_STATS_ON) == SMR_SUCCESS;
+    smr_stats_reset();
+    for (auto _ : state) {
+        smr_path_to_joints_ex(path, robot, 0.015f, nullptr, nullptr,
+                              joints.data(), reachable.get(), nullptr);
+    }
+    if (stats) {
+        StageStat stage[64];
+        int stages = smr_stats_get(stage, 64);
+        for (int s = 0; s < stages && s < 64; ++s) {
+            if (std::strcmp(stage[s].name, "ik.iterations") == 0) {
+                state.counters["ik_iters_per_point"] = static_cast<double>(stage[s].count) /
+                    (static_cast<double>(state.iterations()) * n);
+            }
+        }
+        smr_stats_set_mode(SMR_STATS_OFF);
+    }
+
+    int reached = 0;
+    for (int i = 0; i < n; ++i) reached += reachable[i] ? 1 : 0;
+    state.counters["reachable"] = static_cast<double>(reached) / n;
+    bench_report(state, static_cast<size_t>(n), joints.size() * sizeof(double));
+    smr_robot_destroy(robot);
+    smr_path_destroy(path);
+}
+BENCHMARK(BM_PathToJoints)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,85 @@
+/**
+ * @file bench_mesh.cpp
+ * @brief Mesh Benchmarks (reconstruction, decimation)
+ */
+
+#include "bench_datasets.h"
+#include "mesh_generator.h"
+#include "smr_welding_api.h"
+
+// smr_mesh_create_poisson does not reconstruct the cloud yet, so the
+// reconstruction benchmark drives MeshImpl::create_from_pointcloud directly
+static PoissonSettings bench_poisson(int depth) {
+    PoissonSettings settings = {};
+    settings.depth = depth;
+    settings.scale = 1.1f;
+    settings.linear_fit = false;
+    settings.density_threshold = 0.0f;
+    return settings;
+}
+
+// The reconstruction reads the library's SoA layout; convert outside the timing
+struct BenchBuffers {
+    explicit BenchBuffers(const BenchCloud& cloud) {
+        points.assign_interleaved(cloud.points.data(), cloud.count());
+        normals.assign_interleaved(cloud.normals.data(), cloud.count());
+    }
+    PointBuffer points;
+    PointBuffer normals;
+};
+
+// =============================================================================
+// Reconstruction
+// =============================================================================
+
+static void BM_MeshReconstruct(benchmark::State& state) {
+    const BenchCloud& cloud = bench_cloud(static_cast<int>(state.range(1)),
+                                          static_cast<size_t>(state.range(0)));
+    PoissonSettings settings = bench_poisson(static_cast<int>(state.range(2)));
+    BenchBuffers buffers(cloud);
+
+    MeshImpl mesh;
+    for (auto _ : state) {
+        mesh.create_from_pointcloud(buffers.points, buffers.normals, settings);
+    }
+    state.counters["triangles"] = mesh.triangle_count();
+    state.SetLabel(bench_shape_name(static_cast<int>(state.range(1))));
+    bench_report(state, cloud.count(), cloud.bytes());
+}
+BENCHMARK(BM_MeshReconstruct)
+    ->ArgsProduct({{10000, 100000, 1000000}, {SHAPE_PLANE, SHAPE_CYLINDER, SHAPE_TJOINT}, {7, 8}})
+    ->Unit(benchmark::kMillisecond);
+
+// =============================================================================
+// Decimation
+// =============================================================================
+
+static void BM_MeshSimplify(benchmark::State& state) {
+    const BenchCloud& cloud = bench_cloud(SHAPE_TJOINT, 100000);
+    BenchBuffers buffers(cloud);
+    MeshImpl source;
+    source.create_from_pointcloud(buffers.points, buffers.normals,
+                                  bench_poisson(static_cast<int>(state.range(0))));
+    if (source.triangle_count() == 0) {
+        state.SkipWithError("Reconstruction produced no triangles");
+        return;
+    }
+
+    MeshImpl mesh;
+    for (auto _ : state) {
+        state.PauseTiming();
+        mesh.vertices = source.vertices;
+        mesh.normals = source.normals;
+        mesh.triangles = source.triangles;
+        mesh.densities = source.densities;
+        mesh.invalidate_bvh();
+        state.ResumeTiming();
+        mesh.simplify(0.25f);
+    }
+    state.counters["triangles_in"] = source.triangle_count();
+    state.counters["triangles_out"] = mesh.triangle_count();
+    bench_report(state, source.triangle_count(),
+                 (source.vertices.size() + source.normals.size()) * sizeof(float) +
+                 source.triangles.size() * sizeof(int));
+}
+BENCHMARK(BM_MeshSimplify)->Arg(7)->Arg(8)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,139 @@
+/**
+ * @file bench_path.cpp
+ * @brief Path Benchmarks (create, resample, smooth, weave, project)
+ */
+
+#include "bench_datasets.h"
+#include "smr_welding_api.h"
+#include <vector>
+
+static PathParams bench_path_params() {
+    PathParams params = {};
+    params.step_size = 0.001f;
+    params.standoff_distance = 0.015f;
+    return params;
+}
+
+// Seam of range(0) points, rebuilt outside the timed region before each run
+class SeamFixture {
+public:
+    explicit SeamFixture(size_t count) : count(count) {
+        bench_seam(count, points, normals);
+    }
+    ~SeamFixture() { smr_path_destroy(path); }
+
+    PathHandle reset() {
+        smr_path_destroy(path);
+        PathParams params = bench_path_params();
+        path = smr_path_create_from_points(points.data(), normals.data(),
+                                           static_cast<int>(count), &params);
+        return path;
+    }
+
+    size_t count;
+    std::vector<float> points;
+    std::vector<float> normals;
+    PathHandle path = nullptr;
+};
+
+static const int64_t PATH_SIZES[] = {1000, 10000, 100000};
+
+#define BENCH_PATH_SIZES ->Arg(PATH_SIZES[0])->Arg(PATH_SIZES[1])->Arg(PATH_SIZES[2])
+
+// =============================================================================
+// Path Operations
+// =============================================================================
+
+static void BM_PathCreateFromPoints(benchmark::State& state) {
+    SeamFixture seam(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(seam.reset());
+    }
+    bench_report(state, seam.count, seam.points.size() * 2 * sizeof(float));
+}
+BENCHMARK(BM_PathCreateFromPoints) BENCH_PATH_SIZES->Unit(benchmark::kMicrosecond);
+
+static void BM_PathResample(benchmark::State& state) {
+    SeamFixture seam(static_cast<size_t>(state.range(0)));
+    PathHandle path = seam.reset();
+    float step = smr_path_get_length(path) / static_cast<float>(seam.count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        path = seam.reset();
+        state.ResumeTiming();
+        smr_path_resample(path, step * 0.5f);
+    }
+    state.counters["points_out"] = smr_path_get_count(path);
+    bench_report(state, seam.count, seam.points.size() * 2 * sizeof(float));
+}
+BENCHMARK(BM_PathResample) BENCH_PATH_SIZES->Unit(benchmark::kMicrosecond);
+
+static void BM_PathSmooth(benchmark::State& state) {
+    SeamFixture seam(static_cast<size_t>(state.range(0)));
+    SmoothingSettings settings = {};
+    settings.method = static_cast<SmoothingMethod>(state.range(1));
+    PathHandle path = nullptr;
+    for (auto _ : state) {
+        state.PauseTiming();
+        path = seam.reset();
+        state.ResumeTiming();
+        smr_path_smooth_ex(path, &settings);
+    }
+    bench_report(state, seam.count, seam.points.size() * 2 * sizeof(float));
+}
+BENCHMARK(BM_PathSmooth)
+    ->ArgsProduct({std::vector<int64_t>(std::begin(PATH_SIZES), std::end(PATH_SIZES)),
+                   {SMOOTH_MOVING_AVERAGE, SMOOTH_SAVITZKY_GOLAY, SMOOTH_BSPLINE}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_PathWeave(benchmark::State& state) {
+    SeamFixture seam(static_cast<size_t>(state.range(0)));
+    PathHandle path = nullptr;
+    for (auto _ : state) {
+        state.PauseTiming();
+        path = seam.reset();
+        state.ResumeTiming();
+        smr_path_apply_weave(path, WEAVE_ZIGZAG, 0.002f, 2.0f);
+    }
+    state.counters["points_out"] = smr_path_get_count(path);
+    bench_report(state, seam.count, seam.points.size() * 2 * sizeof(float));
+}
+BENCHMARK(BM_PathWeave) BENCH_PATH_SIZES->Unit(benchmark::kMicrosecond);
+
+// Flat plate under the seam, 2 triangles per cell
+static MeshHandle make_plate(int cells) {
+    std::vector<float> vertices;
+    std::vector<int> indices;
+    for (int j = 0; j <= cells; ++j) {
+        for (int i = 0; i <= cells; ++i) {
+            vertices.push_back(0.3f + 0.3f * i / cells);
+            vertices.push_back(-0.25f + 0.5f * j / cells);
+            vertices.push_back(0.05f);
+        }
+    }
+    for (int j = 0; j < cells; ++j) {
+        for (int i = 0; i < cells; ++i) {
+            int v = j * (cells + 1) + i;
+            int quad[6] = {v, v + 1, v + cells + 2, v, v + cells + 2, v + cells + 1};
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+    return smr_mesh_create_from_arrays(vertices.data(), static_cast<int>(vertices.size() / 3),
+                                       indices.data(), static_cast<int>(indices.size() / 3));
+}
+
+static void BM_PathProjectToMesh(benchmark::State& state) {
+    SeamFixture seam(static_cast<size_t>(state.range(0)));
+    MeshHandle plate = make_plate(256);
+    PathHandle path = seam.reset();
+    int projected = 0;
+    // The first query builds the mesh BVH; time only the projection
+    smr_path_project_to_mesh(path, plate, nullptr, &projected);
+    for (auto _ : state) {
+        smr_path_project_to_mesh(path, plate, nullptr, &projected);
+    }
+    state.counters["projected"] = projected;
+    bench_report(state, seam.count, seam.points.size() * 2 * sizeof(float));
+    smr_mesh_destroy(plate);
+}
+BENCHMARK(BM_PathProjectToMesh) BENCH_PATH_SIZES->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,154 @@
+/**
+ * @file bench_pointcloud.cpp
+ * @brief Point Cloud Benchmarks (load, downsample, spatial sort, normals, outliers)
+ */
+
+#include "bench_datasets.h"
+#include "smr_welding_api.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Neighbor search is brute force (O(n^2)), so normals and outliers stop at
+// 10k points; the linear stages go up to 10M
+static const int64_t SIZES_LINEAR[] = {10000, 100000, 1000000, 10000000};
+
+static void set_cloud(PointCloudHandle pc, const BenchCloud& cloud) {
+    smr_pointcloud_set_points(pc, cloud.points.data(), static_cast<int>(cloud.count()));
+}
+
+// =============================================================================
+// Load
+// =============================================================================
+
+static void BM_PointCloudLoadPly(benchmark::State& state) {
+    const BenchCloud& cloud = bench_cloud(SHAPE_TJOINT, static_cast<size_t>(state.range(0)));
+    std::string path = bench_write_ply(cloud, "smr_bench_load.ply");
+    if (path.empty()) {
+        state.SkipWithError("Cannot write the PLY file");
+        return;
+    }
+
+    PointCloudHandle pc = smr_pointcloud_create();
+    for (auto _ : state) {
+        if (smr_pointcloud_load_ply(pc, path.c_str()) != SMR_SUCCESS) {
+            state.SkipWithError(smr_get_last_error());
+            break;
+        }
+    }
+    bench_report(state, cloud.count(), cloud.bytes());
+    smr_pointcloud_destroy(pc);
+    std::remove(path.c_str());
+}
+// ASCII PLY grows ~60 bytes per point, so the file stops at 1M points
+BENCHMARK(BM_PointCloudLoadPly)->Arg(10000)->Arg(100000)->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// =============================================================================
+// Downsample
+// =============================================================================
+
+static void BM_PointCloudDownsample(benchmark::State& state) {
+    const BenchCloud& cloud = bench_cloud(static_cast<int>(state.range(1)),
+                                          static_cast<size_t>(state.range(0)));
+    PointCloudHandle pc = smr_pointcloud_create();
+    for (auto _ : state) {
+        state.PauseTiming();
+        set_cloud(pc, cloud);
+        state.ResumeTiming();
+        smr_pointcloud_downsample_voxel(pc, 0.005f);
+    }
+    state.counters["kept"] = smr_pointcloud_get_count(pc);
+    state.SetLabel(bench_shape_name(static_cast<int>(state.range(1))));
+    bench_report(state, cloud.count(), cloud.bytes());
+    smr_pointcloud_destroy(pc);
+}
+BENCHMARK(BM_PointCloudDownsample)
+    ->ArgsProduct({std::vector<int64_t>(std::begin(SIZES_LINEAR), std::end(SIZES_LINEAR)),
+                   {SHAPE_PLANE, SHAPE_CYLINDER, SHAPE_TJOINT}})
+    ->Unit(benchmark::kMillisecond);
+
+// =============================================================================
+// Spatial Sort
+// =============================================================================
+
+static void BM_PointCloudSortSpatial(benchmark::State& state) {
+    const BenchCloud& cloud = bench_cloud(static_cast<int>(state.range(1)),
+                                          static_cast<size_t>(state.range(0)));
+    std::vector<int> permutation(cloud.count());
+    PointCloudHandle pc = smr_pointcloud_create();
+    for (auto _ : state) {
+        state.PauseTiming();
+        set_cloud(pc, cloud);
+        state.ResumeTiming();
+        smr_pointcloud_sort_spatial(pc, permutation.data());
+    }
+    state.SetLabel(bench_shape_name(static_cast<int>(state.range(1))));
+    bench_report(state, cloud.count(), cloud.bytes());
+    smr_pointcloud_destroy(pc);
+}
+BENCHMARK(BM_PointCloudSortSpatial)
+    ->ArgsProduct({std::vector<int64_t>(std::begin(SIZES_LINEAR), std::end(SIZES_LINEAR)),
+                   {SHAPE_PLANE, SHAPE_CYLINDER, SHAPE_TJOINT}})
+    ->Unit(benchmark::kMillisecond);
+
+// Downsampling a cloud already in Morton order (compare BM_PointCloudDownsample)
+static void BM_PointCloudDownsampleSorted(benchmark::State& state) {
+    const BenchCloud& cloud = bench_cloud(static_cast<int>(state.range(1)),
+                                          static_cast<size_t>(state.range(0)));
+    PointCloudHandle pc = smr_pointcloud_create();
+    for (auto _ : state) {
+        state.PauseTiming();
+        set_cloud(pc, cloud);
+        smr_pointcloud_sort_spatial(pc, nullptr);
+        state.ResumeTiming();
+        smr_pointcloud_downsample_voxel(pc, 0.005f);
+    }
+    state.counters["kept"] = smr_pointcloud_get_count(pc);
+    state.SetLabel(bench_shape_name(static_cast<int>(state.range(1))));
+    bench_report(state, cloud.count(), cloud.bytes());
+    smr_pointcloud_destroy(pc);
+}
+BENCHMARK(BM_PointCloudDownsampleSorted)
+    ->ArgsProduct({std::vector<int64_t>(std::begin(SIZES_LINEAR), std::end(SIZES_LINEAR)),
+                   {SHAPE_PLANE, SHAPE_CYLINDER, SHAPE_TJOINT}})
+    ->Unit(benchmark::kMillisecond);
+
+// =============================================================================
+// Normals and Outliers
+// =============================================================================
+
+static void BM_PointCloudNormalsKnn(benchmark::State& state) {
+    const BenchCloud& cloud = bench_cloud(static_cast<int>(state.range(1)),
+                                          static_cast<size_t>(state.range(0)));
+    PointCloudHandle pc = smr_pointcloud_create();
+    set_cloud(pc, cloud);
+    for (auto _ : state) {
+        smr_pointcloud_estimate_normals_knn(pc, 16);
+    }
+    state.SetLabel(bench_shape_name(static_cast<int>(state.range(1))));
+    bench_report(state, cloud.count(), cloud.bytes());
+    smr_pointcloud_destroy(pc);
+}
+BENCHMARK(BM_PointCloudNormalsKnn)
+    ->ArgsProduct({{1000, 4000, 10000}, {SHAPE_PLANE, SHAPE_CYLINDER, SHAPE_TJOINT}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_PointCloudRemoveOutliers(benchmark::State& state) {
+    const BenchCloud& cloud = bench_cloud(static_cast<int>(state.range(1)),
+                                          static_cast<size_t>(state.range(0)));
+    PointCloudHandle pc = smr_pointcloud_create();
+    for (auto _ : state) {
+        state.PauseTiming();
+        set_cloud(pc, cloud);
+        state.ResumeTiming();
+        smr_pointcloud_remove_outliers(pc, 20, 2.0f);
+    }
+    state.counters["kept"] = smr_pointcloud_get_count(pc);
+    state.SetLabel(bench_shape_name(static_cast<int>(state.range(1))));
+    bench_report(state, cloud.count(), cloud.bytes());
+    smr_pointcloud_destroy(pc);
+}
+BENCHMARK(BM_PointCloudRemoveOutliers)
+    ->ArgsProduct({{1000, 4000, 10000}, {SHAPE_PLANE, SHAPE_CYLINDER, SHAPE_TJOINT}})
+    ->Unit(benchmark::kMillisecond);
@@ -38,6 +38,9 @@ typedef void* PointCloudHandle;
 typedef void* MeshHandle;
 typedef void* RobotHandle;
 typedef void* PathHandle;
+typedef void* PathSetHandle;
+typedef void* JobHandle;
+typedef void* PipelineHandle;
 
 /// Error codes
 typedef enum {
@@ -51,6 +54,7 @@ typedef enum {
     SMR_ERROR_NO_SOLUTION = -7,
     SMR_ERROR_JOINT_LIMITS = -8,
     SMR_ERROR_SINGULARITY = -9,
+    SMR_ERROR_CANCELLED = -10,
     SMR_ERROR_NOT_IMPLEMENTED = -99
 } SMRErrorCode;
 
@@ -69,9 +73,17 @@ typedef enum {
     WEAVE_ZIGZAG = 1,
     WEAVE_CIRCULAR = 2,
     WEAVE_TRIANGLE = 3,
-    WEAVE_FIGURE8 = 4
+    WEAVE_FIGURE8 = 4,
+    WEAVE_CUSTOM = 5          // User profile passed to smr_path_apply_weave_ex
 } WeaveType;
 
+/// Path smoothing filters
+typedef enum {
+    SMOOTH_MOVING_AVERAGE = 0,
+    SMOOTH_SAVITZKY_GOLAY = 1,
+    SMOOTH_BSPLINE = 2
+} SmoothingMethod;
+
 /// DH Parameters structure (row-major)
 typedef struct {
     double a;           // Link length (m)
@@ -107,6 +119,177 @@ typedef struct {
     float weave_frequency;  // Weave frequency (Hz)
 } PathParams;
 
+/// Trajectory IK settings for path-to-joints conversion (0 = default)
+typedef struct {
+    int chunk_size;          // Points per worker chunk (default: auto)
+    int num_threads;         // Worker threads (default: thread pool size)
+    int max_iterations;      // IK iterations per point (default: 100)
+    double tolerance;        // IK convergence tolerance (default: 1e-6)
+    double max_joint_step;   // Joint jump (rad) that triggers chunk boundary repair (default: 0.5)
+} TrajectoryIKSettings;
+
+/// Global (configuration-consistent) IK settings (0 = default)
+typedef struct {
+    int discovery_interval;       // Points between multi-start branch discovery (default: 128)
+    int num_threads;              // Worker threads (default: thread pool size)
+    double motion_weight;         // Weight of squared joint motion, time-scaled by max_velocity (default: 1.0)
+    double limit_weight;          // Weight of joint-limit proximity penalty (default: 0.1)
+    double manipulability_weight; // Weight of inverse manipulability (default: 0.001)
+    double max_joint_step;        // Transitions jumping more than this (rad) are forbidden (default: 0.5)
+} GlobalIKSettings;
+
+/// Tool-axis redundancy settings (0 = default)
+typedef struct {
+    int spin_samples;              // Rotations about the tool Z-axis to try (default: 12)
+    float spin_range;              // Spin sampled over [-range, range] (rad, default: pi)
+    float travel_tolerance;        // Allowed deviation from PathParams.travel_angle (rad, default: 0)
+    float work_tolerance;          // Allowed deviation from PathParams.approach_angle (rad, default: 0)
+    int angle_samples;             // Samples per tilt tolerance band (default: 3)
+    double min_manipulability;     // Points below this are re-oriented too (default: 0.01)
+    int blend_window;              // Points over which a re-orientation is ramped in/out (default: 16)
+    int num_threads;               // Worker threads (default: thread pool size)
+} ToolAxisSettings;
+
+/// Time parameterization settings (0 = default)
+typedef struct {
+    float travel_speed;       // Max TCP speed along the seam (m/s, default: 0.01)
+    double velocity_scale;    // Fraction of JointLimits.max_velocity to use (default: 1.0)
+    double accel_scale;       // Fraction of JointLimits.max_accel to use (default: 1.0)
+} TimingSettings;
+
+/// Workspace reachability map settings (0 = default)
+typedef struct {
+    float voxel_size;          // Voxel edge length (m, default: 0.05)
+    float bounds_min[3];       // Mapped box in the base frame (m); all zero = robot's full reach
+    float bounds_max[3];
+    int orientation_samples;   // Tool directions tried per voxel (default: 26, max: 255)
+    int num_threads;           // Worker threads (default: thread pool size)
+} ReachabilitySettings;
+
+/// Collision capsule rigidly attached to a robot frame (0 = base, 6 = flange)
+typedef struct {
+    int frame;          // DH frame the endpoints are expressed in (0-6)
+    float p0[3];        // Segment start (m, frame coordinates)
+    float p1[3];        // Segment end (m, frame coordinates)
+    float radius;       // Capsule radius (m)
+} LinkCapsule;
+
+/// Collision checking settings (0 = default)
+typedef struct {
+    float link_radius;          // Radius of generated link capsules (m, default: 0.05)
+    float margin;               // Extra clearance added to every capsule (m, default: 0)
+    float tip_clearance;        // Generated flange capsule stops this far from the TCP, so the
+                                // part at the torch tip is not a collision (m, default: 0.02)
+    double max_joint_step;      // Max joint motion between checked configurations (rad, default: 0.02)
+    bool ignore_self_collision; // Skip link-link checks (default: false)
+    int num_threads;            // Worker threads (default: thread pool size)
+} CollisionSettings;
+
+/// Joint-space transit planning settings (0 = default)
+typedef struct {
+    double step_size;         // Max joint-space distance per tree extension (rad, default: 0.3)
+    int max_iterations;       // Extensions per planner before giving up (default: 20000)
+    float time_limit;         // Planning budget (s, default: 1)
+    int shortcut_iterations;  // Random shortcut attempts on the found path (default: 100)
+    unsigned int seed;        // Random seed; planner i uses seed + i (default: 1)
+    int num_threads;          // Planners racing in parallel (default: thread pool size)
+} TransitSettings;
+
+/**
+ * Extra configuration test for the planners: return true if `joints`
+ * (6 doubles) is in collision. Called from worker threads, possibly
+ * concurrently.
+ */
+typedef bool (*SMRCollisionCallback)(const double* joints, void* user_data);
+
+/// Asynchronous job states
+typedef enum {
+    SMR_JOB_PENDING = 0,      // Queued, not started
+    SMR_JOB_RUNNING = 1,
+    SMR_JOB_COMPLETED = 2,    // Finished with SMR_SUCCESS
+    SMR_JOB_FAILED = 3,       // Finished with an error code
+    SMR_JOB_CANCELLED = 4     // Stopped by smr_job_cancel (result SMR_ERROR_CANCELLED)
+} SMRJobState;
+
+/**
+ * Completion callback of a job, called once on the job's worker thread
+ * after the job finished (any terminal state). The callback may read the
+ * job's result and take its mesh; smr_job_wait returns at once there, and
+ * smr_job_destroy is deferred until the callback has returned.
+ */
+typedef void (*SMRJobCallback)(JobHandle job, SMRJobState state, void* user_data);
+
+/// Instrumentation modes (smr_stats_set_mode)
+typedef enum {
+    SMR_STATS_OFF = 0,        // No recording (default)
+    SMR_STATS_ON = 1,         // Stage timers and counters
+    SMR_STATS_TRACE = 2       // Also keep events for smr_stats_write_trace
+} SMRStatsMode;
+
+/// One stage timer or counter, summed over all threads since the last reset
+typedef struct {
+    const char* name;         // e.g. "ik.solve" (static string, do not free)
+    long long count;          // Timed calls, or the counter value
+    double total_ms;          // Time summed over all threads (0 for counters)
+    double max_ms;            // Longest single call (0 for counters)
+} StageStat;
+
+/// Native memory counters (smr_memory_get_stats)
+typedef struct {
+    long long live_bytes;     // Held now by clouds, meshes, path sets, maps and work grids
+    long long peak_bytes;     // Highest live_bytes since load or smr_memory_reset_peak
+    long long allocations;    // Tracked allocations made since load
+} MemoryStats;
+
+/// Path smoothing settings (0 = default)
+typedef struct {
+    SmoothingMethod method;   // Filter (default: moving average)
+    int window_size;          // Samples per window; B-spline knots are half a window apart (default: 9)
+    int polynomial_order;     // Savitzky-Golay fit order (default: 2, max: 5)
+    float corner_angle;       // Turns sharper than this split the path and stay fixed (rad, default: 0.5; >= pi disables)
+} SmoothingSettings;
+
+/// Weave generation settings (0 = default)
+typedef struct {
+    WeaveType type;           // Pattern (WEAVE_NONE leaves the path unchanged)
+    float amplitude;          // Peak lateral offset (m, default: 0.002)
+    float frequency;          // Weave cycles per second (Hz, default: 2)
+    float travel_speed;       // Torch speed along the seam (m/s, default: 0.01)
+    int samples_per_cycle;    // Output samples per weave cycle (default: 16, min 4)
+} WeaveSettings;
+
+/// Adaptive resampling settings (0 = default)
+typedef struct {
+    float chord_tolerance;    // Max distance between the path and its sample polyline (m, default: 0.0001)
+    float angle_tolerance;    // Max tangent or normal turn between samples (rad, default: 0.1)
+    float min_step;           // Shortest step; wins over the tolerances (m, default: 0.0005)
+    float max_step;           // Longest step (m, default: 0.02)
+} AdaptiveResampleSettings;
+
+/// Weld sequence optimization settings (0 = default)
+typedef struct {
+    float time_limit;          // Search budget after the cost matrix is built (s, default: 0.1)
+    float min_heat_distance;   // Consecutive seams closer than this are penalized (m, default: 0 = off)
+    float heat_penalty;        // Cost added per too-close pair (s, default: 10)
+    bool return_home;          // Include the move back to the start configuration (default: false)
+    bool fixed_direction;      // Weld every seam in its stored direction (default: false)
+    int num_threads;           // Worker threads for the cost matrix (default: thread pool size)
+} SequenceSettings;
+
+/// Path-to-surface projection settings (0 = default)
+typedef struct {
+    float max_distance;   // Points farther than this from the mesh stay put (m, default: 0.02)
+    int num_threads;      // Worker threads (default: thread pool size)
+} SurfaceProjectionSettings;
+
+/// Mesh ray-cast / closest-point result
+typedef struct {
+    int triangle;       // Triangle index, -1 if nothing was found
+    float distance;     // Ray distance or point-surface distance (m)
+    float point[3];     // Hit / closest surface point
+    float normal[3];    // Unit face normal (triangle winding order)
+} MeshHit;
+
 /// Poisson reconstruction settings
 typedef struct {
     int depth;              // Octree depth (6-12)
@@ -115,6 +298,34 @@ typedef struct {
     float density_threshold; // Low density removal (0.0-1.0)
 } PoissonSettings;
 
+/// Scan-to-trajectory pipeline settings (0 = default, negative = stage off where noted)
+typedef struct {
+    float voxel_size;          // Downsampling voxel edge (m, default: 0.002, negative = off)
+    int outlier_neighbors;     // Statistical outlier neighbors (default: 20, negative = off)
+    float outlier_std_ratio;   // Outlier threshold in standard deviations (default: 2.0)
+    int normal_knn;            // Normal estimation neighbors (default: 30)
+    float view_point[3];       // Normals are oriented towards this point (default: origin)
+    PoissonSettings poisson;   // Reconstruction (depth default: 8, scale default: 1.1,
+                               // density_threshold default: 0.01, negative = off)
+    float simplify_ratio;      // Fraction of triangles kept by decimation (default: 0 = off)
+    PathParams path;           // Path (step_size default: 0.005, standoff_distance default: 0.015,
+                               // weave applied unless WEAVE_NONE)
+    int smooth_window;         // Moving-average window (default: 5, negative = off)
+    TrajectoryIKSettings ik;   // Path-to-joints settings (0 = default)
+    int block_points;          // Points per streamed file block (default: 65536)
+} PipelineSettings;
+
+/// Pipeline stages (indices of smr_pipeline_get_stage_times)
+typedef enum {
+    SMR_STAGE_LOAD = 0,        // Streamed file read and voxel downsampling (overlapped)
+    SMR_STAGE_OUTLIERS = 1,    // Statistical outlier removal
+    SMR_STAGE_NORMALS = 2,     // Normal estimation and orientation
+    SMR_STAGE_MESH = 3,        // Reconstruction, low-density removal, decimation
+    SMR_STAGE_PATH = 4,        // Edge path, weave, resampling, smoothing
+    SMR_STAGE_TRAJECTORY = 5,  // Path to joints
+    SMR_STAGE_COUNT = 6
+} SMRPipelineStage;
+
 // =============================================================================
 // Point Cloud API
 // =============================================================================
@@ -231,19 +442,49 @@ SMR_API SMRErrorCode smr_pointcloud_downsample_voxel(PointCloudHandle handle, fl
 SMR_API SMRErrorCode smr_pointcloud_remove_outliers(PointCloudHandle handle,
                                                      int nb_neighbors, float std_ratio);
 
+/**
+ * @brief Reorder points along a Morton (Z-order) curve
+ *
+ * Points that are close in space end up close in memory, so later
+ * neighborhood work (voxelization, normal estimation, reconstruction
+ * splatting) touches fewer cache lines, and contiguous index ranges form
+ * compact spatial chunks. Normals and colors move with their points.
+ *
+ * @param handle Point cloud handle
+ * @param out_permutation Receives count entries, or NULL: the original index
+ *        of the point now at each position
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_pointcloud_sort_spatial(PointCloudHandle handle, int* out_permutation);
+
 // =============================================================================
 // Mesh Generation API
 // =============================================================================
 
 /**
  * @brief Create mesh from point cloud using Poisson reconstruction
+ *
+ * Runs the same reconstruction as the pipeline's mesh stage. Low-density
+ * removal is left to smr_mesh_remove_low_density.
+ *
  * @param pc_handle Point cloud handle (must have normals)
  * @param settings Poisson reconstruction settings
- * @return Mesh handle, or NULL on failure
+ * @return Mesh handle, or NULL on failure (see smr_get_last_error)
  */
 SMR_API MeshHandle smr_mesh_create_poisson(PointCloudHandle pc_handle, 
                                             const PoissonSettings* settings);
 
+/**
+ * @brief Create a mesh from vertex and index arrays (e.g. part CAD or cell fixtures)
+ * @param vertices Vertex positions (vertex_count * 3 floats)
+ * @param vertex_count Number of vertices
+ * @param indices Triangle vertex indices (triangle_count * 3 ints)
+ * @param triangle_count Number of triangles
+ * @return Mesh handle with area-weighted vertex normals, or NULL on failure
+ */
+SMR_API MeshHandle smr_mesh_create_from_arrays(const float* vertices, int vertex_count,
+                                                const int* indices, int triangle_count);
+
 /**
  * @brief Destroy a mesh object
  * @param handle Mesh handle
@@ -320,6 +561,50 @@ SMR_API SMRErrorCode smr_mesh_save_ply(MeshHandle handle, const char* filepath);
  */
 SMR_API SMRErrorCode smr_mesh_save_obj(MeshHandle handle, const char* filepath);
 
+/**
+ * @brief Cast rays against the mesh (two-sided triangles)
+ *
+ * Queries use a BVH that is built on first use and rebuilt after the mesh
+ * changes (remove_low_density, simplify).
+ *
+ * @param handle Mesh handle
+ * @param origins Ray origins (count * 3 floats)
+ * @param directions Ray directions (count * 3 floats, need not be normalized)
+ * @param count Number of rays
+ * @param max_distance Ignore hits farther than this (m)
+ * @param out_hits Output buffer (count hits; triangle = -1 for a miss)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_mesh_raycast(MeshHandle handle, const float* origins,
+                                       const float* directions, int count,
+                                       float max_distance, MeshHit* out_hits);
+
+/**
+ * @brief Find the closest surface point to each query point
+ * @param handle Mesh handle
+ * @param points Query points (count * 3 floats)
+ * @param count Number of points
+ * @param max_distance Search radius (m)
+ * @param out_hits Output buffer (count hits; triangle = -1 if nothing within max_distance)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_mesh_closest_points(MeshHandle handle, const float* points, int count,
+                                              float max_distance, MeshHit* out_hits);
+
+/**
+ * @brief List triangles within a sphere
+ * @param handle Mesh handle
+ * @param center Sphere center (3 floats)
+ * @param radius Sphere radius (m)
+ * @param out_triangles Output buffer for triangle indices (may be NULL to count only)
+ * @param max_triangles Capacity of out_triangles
+ * @param out_count Total number of overlapping triangles (may exceed max_triangles)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_mesh_sphere_overlap(MeshHandle handle, const float* center, float radius,
+                                              int* out_triangles, int max_triangles,
+                                              int* out_count);
+
 // =============================================================================
 // Robot Kinematics API
 // =============================================================================
@@ -412,6 +697,61 @@ SMR_API double smr_robot_get_manipulability(RobotHandle handle,
 SMR_API bool smr_robot_check_joint_limits(RobotHandle handle,
                                            const double* joint_angles);
 
+/**
+ * @brief Precompute the workspace reachability map of a robot
+ *
+ * Voxelizes the workspace and stores, per voxel, the fraction of evenly spread
+ * tool directions that have an IK solution at the voxel center and the best
+ * manipulability among them (numerical IK, warm-started along voxel rows).
+ * Replaces any map the robot already holds. Intended to run offline; the
+ * result can be saved and reloaded.
+ *
+ * @param handle Robot handle
+ * @param settings Map settings (NULL = defaults)
+ * @return SMR_SUCCESS, SMR_ERROR_INVALID_PARAMETER for inverted bounds or a
+ *         grid axis over 65536 voxels, or SMR_ERROR_MEMORY_ALLOCATION
+ */
+SMR_API SMRErrorCode smr_robot_build_reachability(RobotHandle handle,
+                                                   const ReachabilitySettings* settings);
+
+/**
+ * @brief Save the robot's reachability map to a compact binary file
+ * @param handle Robot handle
+ * @param filepath Output file path
+ * @return SMR_SUCCESS, SMR_ERROR_COMPUTATION_FAILED if no map is built, or error code
+ */
+SMR_API SMRErrorCode smr_robot_save_reachability(RobotHandle handle, const char* filepath);
+
+/**
+ * @brief Load a reachability map saved by smr_robot_save_reachability
+ * @param handle Robot handle
+ * @param filepath Input file path
+ * @return SMR_SUCCESS, SMR_ERROR_FILE_FORMAT (bad header, a grid axis over
+ *         65536 voxels, or fewer voxel bytes than the header declares),
+ *         SMR_ERROR_MEMORY_ALLOCATION, or SMR_ERROR_INVALID_PARAMETER
+ *         if the map was built for different DH parameters
+ */
+SMR_API SMRErrorCode smr_robot_load_reachability(RobotHandle handle, const char* filepath);
+
+/**
+ * @brief Look up target positions in the reachability map (O(1) per position)
+ *
+ * Positions are flange targets in the robot base frame, as passed to IK.
+ * Positions outside the mapped box report 0.
+ *
+ * @param handle Robot handle
+ * @param positions Target positions (count * 3 floats)
+ * @param count Number of positions
+ * @param out_reach_ratio Output fraction of tool directions reachable, 0-1 (count floats)
+ * @param out_manipulability Output best manipulability (count floats, may be NULL)
+ * @return SMR_SUCCESS, SMR_ERROR_COMPUTATION_FAILED if no map is built, or error code
+ */
+SMR_API SMRErrorCode smr_robot_query_reachability(RobotHandle handle,
+                                                   const float* positions,
+                                                   int count,
+                                                   float* out_reach_ratio,
+                                                   float* out_manipulability);
+
 // =============================================================================
 // Path Planning API
 // =============================================================================
@@ -461,32 +801,148 @@ SMR_API SMRErrorCode smr_path_get_points(PathHandle handle, WeldPoint* out_point
 
 /**
  * @brief Apply weave pattern to path
+ *
+ * Same as smr_path_apply_weave_ex with the default travel speed (10 mm/s)
+ * and sampling. The path is regenerated at the weave sampling rate.
+ *
  * @param handle Path handle
- * @param weave_type Weave pattern type
+ * @param weave_type Weave pattern type (not WEAVE_CUSTOM)
  * @param amplitude Weave amplitude (m)
  * @param frequency Weave frequency (Hz)
- * @return SMR_SUCCESS or error code
+ * @return SMR_SUCCESS or error code (see smr_path_apply_weave_ex)
  */
 SMR_API SMRErrorCode smr_path_apply_weave(PathHandle handle,
                                            WeaveType weave_type,
                                            float amplitude, float frequency);
 
+/**
+ * @brief Generate a woven path at a sampling rate tied to the weave
+ *
+ * The seam (spline through the current points) is resampled every
+ * travel_speed / (frequency * samples_per_cycle), so every weave cycle gets
+ * the same number of samples however coarse the input path is. Each sample
+ * is offset by the pattern at phase frequency * arc_length / travel_speed:
+ * laterally along tangent x normal and vertically along the normal.
+ * Normals, tangents and arc lengths stay those of the seam.
+ *
+ * For WEAVE_CUSTOM, `profile` holds one period as (lateral, vertical) pairs
+ * in units of the amplitude at phases k / profile_samples, interpolated
+ * linearly and wrapping around; it is ignored for built-in types.
+ *
+ * A woven path holds length * frequency * samples_per_cycle / travel_speed
+ * samples; settings that would need more than 4M (2^22) are rejected and
+ * leave the path unchanged.
+ *
+ * @param handle Path handle
+ * @param settings Weave settings (NULL for defaults, which weave nothing)
+ * @param profile Custom profile (profile_samples * 2 floats) or NULL
+ * @param profile_samples Number of profile samples (>= 2 for WEAVE_CUSTOM)
+ * @return SMR_SUCCESS, SMR_ERROR_INVALID_PARAMETER for a bad type or profile
+ *         or too many samples, or error code
+ */
+SMR_API SMRErrorCode smr_path_apply_weave_ex(PathHandle handle,
+                                              const WeaveSettings* settings,
+                                              const float* profile,
+                                              int profile_samples);
+
 /**
  * @brief Resample path to uniform spacing
+ *
+ * Samples a centripetal Catmull-Rom spline through the path (passing through
+ * every point) by arc length; normals follow rotation-minimizing frames that
+ * match the original normals at the original points. The spline is kept
+ * until the path is changed by another call, so resampling repeatedly at
+ * different steps does not compound interpolation error.
+ *
  * @param handle Path handle
  * @param step_size New step size (m)
  * @return SMR_SUCCESS or error code
  */
 SMR_API SMRErrorCode smr_path_resample(PathHandle handle, float step_size);
 
+/**
+ * @brief Resample path with curvature-adaptive spacing
+ *
+ * Samples the same spline as smr_path_resample, taking the longest step
+ * (between min_step and max_step) that keeps the sample polyline within
+ * chord_tolerance of the path and turns the tangent and normal by at most
+ * angle_tolerance. Straight runs get max_step spacing, tight bends get
+ * short steps. Both path ends are kept; arc lengths are exact spline
+ * arc lengths.
+ *
+ * @param handle Path handle
+ * @param settings Resampling settings (NULL for defaults)
+ * @return SMR_SUCCESS or error code (SMR_ERROR_INVALID_PARAMETER if min_step > max_step)
+ */
+SMR_API SMRErrorCode smr_path_resample_adaptive(PathHandle handle,
+                                                 const AdaptiveResampleSettings* settings);
+
+/**
+ * @brief Get path length along the continuous (spline) path
+ * @param handle Path handle
+ * @return Arc length (m), or -1 on error
+ */
+SMR_API float smr_path_get_length(PathHandle handle);
+
+/**
+ * @brief Evaluate the continuous path at arbitrary arc lengths
+ *
+ * Uses the same spline as smr_path_resample; values outside [0, length] are
+ * clamped. Each evaluation is a table lookup plus one Newton step.
+ *
+ * @param handle Path handle
+ * @param arc_lengths Arc lengths to evaluate (count)
+ * @param count Number of samples
+ * @param out_points Output buffer (count * sizeof(WeldPoint))
+ * @return SMR_SUCCESS or error code (SMR_ERROR_INVALID_PARAMETER for an empty path)
+ */
+SMR_API SMRErrorCode smr_path_evaluate(PathHandle handle, const float* arc_lengths,
+                                        int count, WeldPoint* out_points);
+
 /**
  * @brief Smooth path using moving average
+ *
+ * Runs in O(n) regardless of window size. The window shrinks symmetrically
+ * toward the path ends, so the first and last points stay fixed.
+ *
  * @param handle Path handle
  * @param window_size Smoothing window size
  * @return SMR_SUCCESS or error code
  */
 SMR_API SMRErrorCode smr_path_smooth(PathHandle handle, int window_size);
 
+/**
+ * @brief Smooth path with a selectable filter, keeping seam corners sharp
+ *
+ * Positions and normals are filtered independently on each stretch between
+ * detected corners; corners and path ends stay fixed. All filters are O(n)
+ * in the number of points, independent of the window size.
+ *
+ * @param handle Path handle
+ * @param settings Smoothing settings (NULL = defaults)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_smooth_ex(PathHandle handle, const SmoothingSettings* settings);
+
+/**
+ * @brief Snap path points onto the nearest mesh surface point
+ *
+ * Each point moves to the closest point on the mesh and takes the vertex
+ * normal interpolated there, flipped if needed to stay on the side of the
+ * original path normal. Tangents and arc lengths are recomputed. Use after
+ * smoothing or weaving to restore an exact standoff reference.
+ *
+ * @param path_handle Path handle
+ * @param mesh_handle Part surface mesh
+ * @param settings Projection settings (NULL = defaults)
+ * @param out_projected Number of points that were moved (may be NULL)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_project_to_mesh(PathHandle path_handle,
+                                               MeshHandle mesh_handle,
+                                               const SurfaceProjectionSettings* settings,
+                                               int* out_projected);
+
 /**
  * @brief Convert path to joint trajectory
  * @param path_handle Path handle
@@ -502,6 +958,927 @@ SMR_API SMRErrorCode smr_path_to_joints(PathHandle path_handle,
                                          double* out_joints,
                                          bool* out_reachable);
 
+/**
+ * @brief Convert path to joint trajectory with the parallel trajectory IK engine
+ * @param path_handle Path handle
+ * @param robot_handle Robot handle
+ * @param standoff Tool standoff distance (m)
+ * @param settings Trajectory IK settings (NULL for defaults)
+ * @param seed_joints Initial joint configuration (6 doubles, NULL for home pose)
+ * @param out_joints Output joint angles buffer (path_count * 6 doubles)
+ * @param out_reachable Output reachability flags (path_count bools)
+ * @param out_status Output per-point status (path_count codes, may be NULL):
+ *        SMR_SUCCESS, SMR_ERROR_NO_SOLUTION, SMR_ERROR_JOINT_LIMITS or SMR_ERROR_SINGULARITY
+ * @return SMR_SUCCESS or error code
+ *
+ * Unreachable points hold the nearest reachable configuration instead of zeros.
+ */
+SMR_API SMRErrorCode smr_path_to_joints_ex(PathHandle path_handle,
+                                            RobotHandle robot_handle,
+                                            float standoff,
+                                            const TrajectoryIKSettings* settings,
+                                            const double* seed_joints,
+                                            double* out_joints,
+                                            bool* out_reachable,
+                                            SMRErrorCode* out_status);
+
+/**
+ * @brief Convert path to the globally smoothest joint trajectory
+ * @param path_handle Path handle
+ * @param robot_handle Robot handle
+ * @param standoff Tool standoff distance (m)
+ * @param settings Global IK settings (NULL for defaults)
+ * @param out_joints Output joint angles buffer (path_count * 6 doubles)
+ * @param out_reachable Output reachability flags (path_count bools)
+ * @param out_status Output per-point status (path_count codes, may be NULL)
+ * @return SMR_SUCCESS or error code
+ *
+ * Gathers all IK branches per weld point and selects one per point with a
+ * Viterbi pass minimizing joint motion, joint-limit proximity and inverse
+ * manipulability, so the trajectory never flips configuration mid-seam.
+ */
+SMR_API SMRErrorCode smr_path_to_joints_global(PathHandle path_handle,
+                                                RobotHandle robot_handle,
+                                                float standoff,
+                                                const GlobalIKSettings* settings,
+                                                double* out_joints,
+                                                bool* out_reachable,
+                                                SMRErrorCode* out_status);
+
+/**
+ * @brief Convert path to joints, exploiting torch symmetry about the tool axis
+ * @param path_handle Path handle
+ * @param robot_handle Robot handle
+ * @param standoff Tool standoff distance (m)
+ * @param settings Tool-axis settings (NULL for defaults)
+ * @param out_joints Output joint angles buffer (path_count * 6 doubles)
+ * @param out_reachable Output reachability flags (path_count bools)
+ * @param out_status Output per-point status (path_count codes, may be NULL)
+ * @param out_tool_angles Output tool angles used per point (path_count * 3 floats:
+ *        spin, travel, work in rad; may be NULL)
+ * @return SMR_SUCCESS or error code
+ *
+ * The torch is first oriented by the path's travel/approach angles. Points that
+ * are unreachable or poorly conditioned are re-oriented by sampling spin about
+ * the tool Z-axis and travel/work angles within their tolerances, keeping the
+ * most manipulable reachable pose; changes are ramped over blend_window points.
+ */
+SMR_API SMRErrorCode smr_path_to_joints_tool_axis(PathHandle path_handle,
+                                                   RobotHandle robot_handle,
+                                                   float standoff,
+                                                   const ToolAxisSettings* settings,
+                                                   double* out_joints,
+                                                   bool* out_reachable,
+                                                   SMRErrorCode* out_status,
+                                                   float* out_tool_angles);
+
+/**
+ * @brief Time-optimal parameterization of a joint trajectory along a path
+ * @param path_handle Path handle (arc lengths define the path parameter)
+ * @param robot_handle Robot handle (joint velocity/acceleration limits)
+ * @param joints Joint trajectory (path_count * 6 doubles, e.g. from smr_path_to_joints)
+ * @param settings Timing settings (NULL for defaults)
+ * @param out_timestamps Output time of each point (path_count doubles, s)
+ * @param out_joint_velocities Output joint velocities (path_count * 6 doubles, may be NULL)
+ * @param out_joint_accelerations Output joint accelerations (path_count * 6 doubles, may be NULL)
+ * @param out_path_speed Output TCP speed along the seam (path_count floats, may be NULL)
+ * @return SMR_SUCCESS or error code
+ *
+ * Reachability-analysis style forward/backward pass over the path samples; the
+ * trajectory starts and ends at rest and runs in O(path_count).
+ */
+SMR_API SMRErrorCode smr_path_time_parameterize(PathHandle path_handle,
+                                                 RobotHandle robot_handle,
+                                                 const double* joints,
+                                                 const TimingSettings* settings,
+                                                 double* out_timestamps,
+                                                 double* out_joint_velocities,
+                                                 double* out_joint_accelerations,
+                                                 float* out_path_speed);
+
+// =============================================================================
+// Path Set API (many seams, batch operations)
+// =============================================================================
+
+/**
+ * @brief Create an empty path set
+ * @param num_threads Worker threads for batch operations (0 = thread pool size)
+ * @return Path set handle
+ *
+ * A path set holds every seam of a part in one buffer. Batch calls process
+ * the seams in parallel (one seam per task), so a whole part is planned with
+ * one call instead of one call per seam and operation.
+ */
+SMR_API PathSetHandle smr_path_set_create(int num_threads);
+
+/**
+ * @brief Destroy a path set
+ * @param handle Path set handle
+ */
+SMR_API void smr_path_set_destroy(PathSetHandle handle);
+
+/**
+ * @brief Append a seam from point arrays
+ * @param handle Path set handle
+ * @param points Positions (count * 3 floats)
+ * @param normals Surface normals (count * 3 floats)
+ * @param count Number of points
+ * @param out_seam Output index of the new seam (may be NULL)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_add_seam(PathSetHandle handle,
+                                            const float* points,
+                                            const float* normals,
+                                            int count,
+                                            int* out_seam);
+
+/**
+ * @brief Append a copy of an existing path as a seam
+ * @param set_handle Path set handle
+ * @param path_handle Path handle (left unchanged)
+ * @param out_seam Output index of the new seam (may be NULL)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_add_path(PathSetHandle set_handle, PathHandle path_handle,
+                                            int* out_seam);
+
+/**
+ * @brief Get the number of seams
+ * @param handle Path set handle
+ * @return Seam count or -1 on error
+ */
+SMR_API int smr_path_set_get_seam_count(PathSetHandle handle);
+
+/**
+ * @brief Get the number of points over all seams
+ * @param handle Path set handle
+ * @return Point count or -1 on error
+ */
+SMR_API int smr_path_set_get_count(PathSetHandle handle);
+
+/**
+ * @brief Get where each seam starts in the point buffer
+ * @param handle Path set handle
+ * @param out_offsets Output offsets (seam_count + 1 ints); seam i owns points
+ *        [out_offsets[i], out_offsets[i + 1]), the last entry is the point count
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_get_offsets(PathSetHandle handle, int* out_offsets);
+
+/**
+ * @brief Get the weld points of all seams, seam after seam
+ * @param handle Path set handle
+ * @param out_points Output buffer (point_count entries)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_get_points(PathSetHandle handle, WeldPoint* out_points);
+
+/**
+ * @brief Get the weld points of one seam
+ * @param handle Path set handle
+ * @param seam Seam index
+ * @param out_points Output buffer (seam point count entries)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_get_seam_points(PathSetHandle handle, int seam,
+                                                   WeldPoint* out_points);
+
+/**
+ * @brief Copy the set's point arrays (structure of arrays, seam after seam)
+ * @param handle Path set handle
+ * @param out_positions Output positions (point_count * 3 floats, may be NULL)
+ * @param out_normals Output normals (point_count * 3 floats, may be NULL)
+ * @param out_tangents Output tangents (point_count * 3 floats, may be NULL)
+ * @param out_arc_lengths Output arc lengths, from 0 on each seam (point_count floats, may be NULL)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_get_arrays(PathSetHandle handle,
+                                              float* out_positions,
+                                              float* out_normals,
+                                              float* out_tangents,
+                                              float* out_arc_lengths);
+
+/**
+ * @brief Resample every seam to uniform spacing (see smr_path_resample)
+ * @param handle Path set handle
+ * @param step_size Distance between points (m)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_resample(PathSetHandle handle, float step_size);
+
+/**
+ * @brief Resample every seam with curvature-adaptive spacing (see smr_path_resample_adaptive)
+ * @param handle Path set handle
+ * @param settings Adaptive resampling settings (NULL for defaults)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_resample_adaptive(PathSetHandle handle,
+                                                     const AdaptiveResampleSettings* settings);
+
+/**
+ * @brief Smooth every seam (see smr_path_smooth_ex)
+ * @param handle Path set handle
+ * @param settings Smoothing settings (NULL for defaults)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_smooth(PathSetHandle handle, const SmoothingSettings* settings);
+
+/**
+ * @brief Weave every seam (see smr_path_apply_weave_ex)
+ * @param handle Path set handle
+ * @param settings Weave settings (NULL for defaults, i.e. no weave)
+ * @param profile Custom profile for WEAVE_CUSTOM (profile_samples lateral, vertical pairs)
+ * @param profile_samples Number of profile samples (>= 2 for WEAVE_CUSTOM)
+ * @return SMR_SUCCESS or error code (SMR_ERROR_INVALID_PARAMETER if all seams
+ *         together would need more than 2^22 samples; no seam is changed)
+ */
+SMR_API SMRErrorCode smr_path_set_apply_weave(PathSetHandle handle,
+                                               const WeaveSettings* settings,
+                                               const float* profile,
+                                               int profile_samples);
+
+/**
+ * @brief Convert every seam to a joint trajectory (see smr_path_to_joints_ex)
+ * @param set_handle Path set handle
+ * @param robot_handle Robot handle
+ * @param standoff Tool standoff distance (m)
+ * @param settings Trajectory IK settings (NULL for defaults); num_threads is
+ *        ignored, the set's workers are split between seams instead
+ * @param seed_joints Start configuration of every seam (6 doubles, NULL for home pose)
+ * @param out_joints Output joint angles (point_count * 6 doubles, laid out like the points)
+ * @param out_reachable Output reachability flags (point_count bools)
+ * @param out_status Output per-point status (point_count codes, may be NULL)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_to_joints(PathSetHandle set_handle,
+                                             RobotHandle robot_handle,
+                                             float standoff,
+                                             const TrajectoryIKSettings* settings,
+                                             const double* seed_joints,
+                                             double* out_joints,
+                                             bool* out_reachable,
+                                             SMRErrorCode* out_status);
+
+/**
+ * @brief Choose the order and direction of the seams that minimizes robot motion
+ * @param set_handle Path set handle
+ * @param robot_handle Robot handle
+ * @param standoff Tool standoff distance (m)
+ * @param settings Sequencing settings (NULL for defaults)
+ * @param start_joints Configuration the robot starts from (6 doubles, NULL for home pose)
+ * @param out_order Output seam indices in welding order (seam_count ints)
+ * @param out_reversed Output per-position flags, true if that seam is welded
+ *        end to start (seam_count bools, in welding order)
+ * @param out_cost Output total transition time including penalties (s, may be NULL)
+ * @return SMR_SUCCESS or error code
+ *
+ * Seam end configurations are solved for both directions (IK tracked along
+ * each seam, in parallel) and every exit-to-entry transition is costed as the
+ * time of a synchronous point-to-point move under the joint velocity and
+ * acceleration limits. The order is built nearest-neighbor first and then
+ * improved with direction flips, Or-opt moves and 2-opt reversals, with
+ * random restarts from the best tour until time_limit runs out or the search
+ * stalls. Entering a seam at an unreachable end costs a fixed penalty, so
+ * each seam is welded from its reachable end where possible.
+ * Pass the result to smr_path_set_reorder to apply it.
+ */
+SMR_API SMRErrorCode smr_path_set_optimize_sequence(PathSetHandle set_handle,
+                                                     RobotHandle robot_handle,
+                                                     float standoff,
+                                                     const SequenceSettings* settings,
+                                                     const double* start_joints,
+                                                     int* out_order,
+                                                     bool* out_reversed,
+                                                     double* out_cost);
+
+/**
+ * @brief Reorder the seams of a set and reverse some of them
+ * @param handle Path set handle
+ * @param order New seam order as old seam indices (seam_count ints, a permutation)
+ * @param reversed Per-position flags (seam_count bools, may be NULL); reversed
+ *        seams run end to start with flipped tangents and arc length from their new start
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_path_set_reorder(PathSetHandle handle, const int* order,
+                                           const bool* reversed);
+
+// =============================================================================
+// Collision Checking API
+// =============================================================================
+
+/**
+ * @brief Set the robot's collision geometry
+ *
+ * Without custom capsules each DH link gets one capsule (CollisionSettings.link_radius);
+ * the flange one is shortened to keep CollisionSettings.tip_clearance from the TCP.
+ * The torch is not part of the DH chain: add it as a capsule on frame 6 that
+ * stops short of the TCP, since the tip is meant to be at standoff from the part.
+ *
+ * @param handle Robot handle
+ * @param capsules Capsules (count entries)
+ * @param count Number of capsules (0 = back to generated link capsules)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_robot_set_collision_capsules(RobotHandle handle,
+                                                       const LinkCapsule* capsules,
+                                                       int count);
+
+/**
+ * @brief Check a joint trajectory for collisions with obstacle meshes and itself
+ *
+ * Obstacles (part, fixtures, cell) are meshes in the robot base frame. Motion
+ * between samples is checked at joint steps of at most max_joint_step. Link
+ * pairs more than one joint apart are checked for self-collision unless they
+ * already touch in the home pose.
+ *
+ * @param robot_handle Robot handle
+ * @param obstacles Obstacle meshes (obstacle_count handles)
+ * @param obstacle_count Number of obstacle meshes
+ * @param joints Joint trajectory (count * 6 doubles)
+ * @param count Number of configurations
+ * @param settings Collision settings (NULL = defaults)
+ * @param out_collision Output per-sample flags, true if the sample or the motion
+ *        into it collides (count bools, may be NULL to stop at the first hit)
+ * @param out_first_collision Output first colliding sample index, or -1 (may be NULL)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_robot_check_collisions(RobotHandle robot_handle,
+                                                 const MeshHandle* obstacles,
+                                                 int obstacle_count,
+                                                 const double* joints,
+                                                 int count,
+                                                 const CollisionSettings* settings,
+                                                 bool* out_collision,
+                                                 int* out_first_collision);
+
+/**
+ * @brief Plan a collision-free joint-space move (e.g. between two seams)
+ *
+ * Tries the straight joint-space move first. Otherwise several RRT-Connect
+ * planners with different seeds race on worker threads and the first path
+ * found is shortened by random shortcuts and a greedy pass that links each
+ * waypoint to the farthest one it can reach directly. Motions are checked at
+ * CollisionSettings.max_joint_step.
+ *
+ * @param robot_handle Robot handle (joint limits bound the sampling)
+ * @param obstacles Obstacle meshes (obstacle_count handles)
+ * @param obstacle_count Number of obstacle meshes
+ * @param start_joints Start configuration (6 doubles)
+ * @param goal_joints Goal configuration (6 doubles)
+ * @param collision_settings Collision settings (NULL = defaults; num_threads unused)
+ * @param settings Planner settings (NULL = defaults)
+ * @param callback Extra collision test on top of the meshes (may be NULL)
+ * @param user_data Passed to callback
+ * @param out_joints Output waypoints including start and goal (max_points * 6 doubles)
+ * @param max_points Capacity of out_joints in waypoints
+ * @param out_count Output number of waypoints (set to the required count if
+ *        max_points is too small)
+ * @return SMR_SUCCESS, SMR_ERROR_INVALID_PARAMETER if start or goal collide or
+ *         the buffer is too small, SMR_ERROR_NO_SOLUTION if no path was found
+ */
+SMR_API SMRErrorCode smr_robot_plan_transit(RobotHandle robot_handle,
+                                             const MeshHandle* obstacles,
+                                             int obstacle_count,
+                                             const double* start_joints,
+                                             const double* goal_joints,
+                                             const CollisionSettings* collision_settings,
+                                             const TransitSettings* settings,
+                                             SMRCollisionCallback callback,
+                                             void* user_data,
+                                             double* out_joints,
+                                             int max_points,
+                                             int* out_count);
+
+// =============================================================================
+// Pipeline API
+// =============================================================================
+
+/*
+ * A pipeline runs the whole scan-to-trajectory flow natively: load,
+ * downsample, outlier removal, normals, reconstruction, decimation, path and
+ * joints. Its point cloud, mesh, path and joint buffers live in the pipeline
+ * and are reused by the next run, so nothing is copied across the API until
+ * the caller asks for results.
+ */
+
+/**
+ * @brief Create a pipeline
+ * @param settings Pipeline settings (NULL = defaults; copied)
+ * @return Pipeline handle
+ */
+SMR_API PipelineHandle smr_pipeline_create(const PipelineSettings* settings);
+
+/**
+ * @brief Destroy a pipeline and the objects it owns
+ * @param handle Pipeline handle
+ */
+SMR_API void smr_pipeline_destroy(PipelineHandle handle);
+
+/**
+ * @brief Run the pipeline on a point cloud file
+ *
+ * The file (ASCII .ply or .pcd) is parsed block by block on a reader thread
+ * while the calling thread voxel-filters the previous block, so loading and
+ * downsampling overlap. Each later stage starts from the previous stage's
+ * native buffers. Runs inside smr_job_pipeline_run honor cancellation
+ * between and within stages.
+ *
+ * @param handle Pipeline handle
+ * @param filepath Point cloud file (.ply or .pcd)
+ * @param robot_handle Robot for the trajectory stage (NULL = stop after the path)
+ * @return SMR_SUCCESS, SMR_ERROR_FILE_NOT_FOUND, SMR_ERROR_FILE_FORMAT,
+ *         SMR_ERROR_COMPUTATION_FAILED (see smr_get_last_error) or error code
+ */
+SMR_API SMRErrorCode smr_pipeline_run(PipelineHandle handle, const char* filepath,
+                                      RobotHandle robot_handle);
+
+/**
+ * @brief Get the processed point cloud (owned by the pipeline, valid until the next run)
+ * @param handle Pipeline handle
+ * @return Point cloud handle (do not destroy), or NULL
+ */
+SMR_API PointCloudHandle smr_pipeline_get_pointcloud(PipelineHandle handle);
+
+/**
+ * @brief Get the reconstructed mesh (owned by the pipeline, valid until the next run)
+ * @param handle Pipeline handle
+ * @return Mesh handle (do not destroy), or NULL
+ */
+SMR_API MeshHandle smr_pipeline_get_mesh(PipelineHandle handle);
+
+/**
+ * @brief Get the weld path (owned by the pipeline, valid until the next run)
+ * @param handle Pipeline handle
+ * @return Path handle (do not destroy), or NULL before the path stage has run
+ */
+SMR_API PathHandle smr_pipeline_get_path(PipelineHandle handle);
+
+/**
+ * @brief Get the number of trajectory points of the last run
+ * @param handle Pipeline handle
+ * @return Point count (0 if the trajectory stage did not run), -1 on invalid handle
+ */
+SMR_API int smr_pipeline_get_joint_count(PipelineHandle handle);
+
+/**
+ * @brief Copy the joint trajectory of the last run
+ * @param handle Pipeline handle
+ * @param out_joints Output joint angles (joint_count * 6 doubles)
+ * @param out_reachable Output reachability flags (joint_count bools, may be NULL)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_pipeline_get_joints(PipelineHandle handle, double* out_joints,
+                                             bool* out_reachable);
+
+/**
+ * @brief Get the wall time of every stage of the last run
+ * @param handle Pipeline handle
+ * @param out_ms Output times in milliseconds (SMR_STAGE_COUNT doubles, 0 for stages not run)
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_pipeline_get_stage_times(PipelineHandle handle, double* out_ms);
+
+// =============================================================================
+// Thread Pool API
+// =============================================================================
+/*
+ * Every parallel stage (point cloud filters, reconstruction, IK, path and
+ * batch operations) runs on one shared work-stealing pool, so the library
+ * never uses more threads than configured here, whatever runs at once. The
+ * num_threads fields of the settings structs further limit one call; they
+ * cannot exceed the pool size. The thread that calls into the library always
+ * takes part in its own call's work and counts toward the total; it never
+ * runs work of other calls, so a short call is not held up by a long job.
+ */
+
+/**
+ * @brief Set the number of threads parallel work may use
+ * @param num_threads Threads including the calling thread (0 = all cores,
+ *        1 = run everything on the calling thread). Applies to calls started
+ *        afterwards; surplus pool threads are parked, not destroyed.
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_set_thread_count(int num_threads);
+
+/**
+ * @brief Get the number of threads parallel work may use
+ * @return Thread count (>= 1)
+ */
+SMR_API int smr_get_thread_count(void);
+
+/**
+ * @brief Pin the pool's worker threads to CPUs
+ * @param cpus CPU indices; worker i runs on cpus[i % count]
+ * @param count Number of CPUs (0 = clear the pinning)
+ * @return SMR_SUCCESS, SMR_ERROR_INVALID_PARAMETER for a CPU the process may
+ *         not use, or SMR_ERROR_NOT_IMPLEMENTED where affinity is unsupported (macOS)
+ *
+ * Keep the pool off the cores that Unity's main and render threads use. The
+ * calling thread is not pinned.
+ */
+SMR_API SMRErrorCode smr_set_thread_affinity(const int* cpus, int count);
+
+/**
+ * @brief Stop and join the library's worker and job threads
+ *
+ * Call before unloading the library (e.g. on application quit). The threads
+ * are never joined from static destructors, which on Windows would run under
+ * the loader lock during DLL unload. Unfinished jobs are cancelled first;
+ * their handles stay valid. No other library call may be in progress. Later
+ * calls start the threads again as needed.
+ */
+SMR_API void smr_shutdown(void);
+
+// =============================================================================
+// Async Job API
+// =============================================================================
+
+/*
+ * Long operations can run on the library's job threads instead of blocking the
+ * caller. A submission returns a job handle at once (NULL on invalid
+ * arguments); poll it with smr_job_get_state / smr_job_get_progress, or pass a
+ * completion callback. Cancellation is cooperative: the operation stops at its
+ * next checkpoint. Objects and buffers a job works on must stay alive and must
+ * not be used by the caller until the job has finished; after a cancelled or
+ * failed in-place job their contents are valid but unspecified.
+ */
+
+/**
+ * @brief Set the number of job threads (jobs that run at the same time)
+ * @param num_threads Job threads (0 = default of 2); takes effect for threads
+ *        started after the call, running jobs are not interrupted. The parallel
+ *        work inside jobs runs on the shared thread pool (smr_set_thread_count).
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_job_set_thread_count(int num_threads);
+
+/**
+ * @brief Load a PLY file into a point cloud asynchronously (see smr_pointcloud_load_ply)
+ * @param handle Point cloud handle
+ * @param filepath Path to PLY file (copied)
+ * @param callback Completion callback (may be NULL)
+ * @param user_data Passed to callback
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_pointcloud_load_ply(PointCloudHandle handle, const char* filepath,
+                                              SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Load a PCD file into a point cloud asynchronously (see smr_pointcloud_load_pcd)
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_pointcloud_load_pcd(PointCloudHandle handle, const char* filepath,
+                                              SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Estimate normals asynchronously (see smr_pointcloud_estimate_normals_knn)
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_pointcloud_estimate_normals_knn(PointCloudHandle handle, int k,
+                                                          SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Voxel-downsample a point cloud asynchronously (see smr_pointcloud_downsample_voxel)
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_pointcloud_downsample_voxel(PointCloudHandle handle, float voxel_size,
+                                                      SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Remove statistical outliers asynchronously (see smr_pointcloud_remove_outliers)
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_pointcloud_remove_outliers(PointCloudHandle handle, int nb_neighbors,
+                                                     float std_ratio,
+                                                     SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Orient normals asynchronously (see smr_pointcloud_orient_normals)
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_pointcloud_orient_normals(PointCloudHandle handle,
+                                                    float camera_x, float camera_y, float camera_z,
+                                                    SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Reconstruct a mesh asynchronously (see smr_mesh_create_poisson)
+ *
+ * The mesh is collected with smr_job_take_mesh once the job has completed.
+ * Progress covers splatting and surface extraction, and cancellation is
+ * checked between blocks of points and grid slabs. The job fails with
+ * SMR_ERROR_MEMORY_ALLOCATION when the grid does not fit.
+ *
+ * @param pc_handle Point cloud handle (must have normals)
+ * @param settings Poisson reconstruction settings (copied)
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_mesh_create_poisson(PointCloudHandle pc_handle,
+                                              const PoissonSettings* settings,
+                                              SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Estimate reconstruction memory at every depth asynchronously
+ *        (see smr_mesh_estimate_memory_depths)
+ *
+ * @param out_bytes settings->depth entries, written by the job; must stay
+ *        valid until it is done
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_mesh_estimate_memory(PointCloudHandle pc_handle,
+                                               const PoissonSettings* settings,
+                                               long long* out_bytes,
+                                               SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Remove low-density vertices asynchronously (see smr_mesh_remove_low_density)
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_mesh_remove_low_density(MeshHandle handle, float quantile,
+                                                  SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Simplify a mesh asynchronously (see smr_mesh_simplify)
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_mesh_simplify(MeshHandle handle, float target_ratio,
+                                        SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Convert a path to joints asynchronously (see smr_path_to_joints_ex)
+ *
+ * settings and seed_joints are copied; the output buffers are written by the
+ * job and must stay valid (pinned) until it has finished. After a cancel,
+ * points not yet solved are unreachable with status SMR_ERROR_CANCELLED.
+ *
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_path_to_joints(PathHandle path_handle,
+                                         RobotHandle robot_handle,
+                                         float standoff,
+                                         const TrajectoryIKSettings* settings,
+                                         const double* seed_joints,
+                                         double* out_joints,
+                                         bool* out_reachable,
+                                         SMRErrorCode* out_status,
+                                         SMRJobCallback callback,
+                                         void* user_data);
+
+/**
+ * @brief Convert every seam of a path set to joints asynchronously (see smr_path_set_to_joints)
+ *
+ * Same buffer rules as smr_job_path_to_joints.
+ *
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_path_set_to_joints(PathSetHandle set_handle,
+                                             RobotHandle robot_handle,
+                                             float standoff,
+                                             const TrajectoryIKSettings* settings,
+                                             const double* seed_joints,
+                                             double* out_joints,
+                                             bool* out_reachable,
+                                             SMRErrorCode* out_status,
+                                             SMRJobCallback callback,
+                                             void* user_data);
+
+/**
+ * @brief Run a pipeline asynchronously (see smr_pipeline_run)
+ *
+ * Progress advances stage by stage. The pipeline and robot must not be used
+ * until the job has finished.
+ *
+ * @return Job handle, or NULL on invalid arguments
+ */
+SMR_API JobHandle smr_job_pipeline_run(PipelineHandle handle, const char* filepath,
+                                       RobotHandle robot_handle,
+                                       SMRJobCallback callback, void* user_data);
+
+/**
+ * @brief Get the state of a job
+ * @param job Job handle
+ * @return Job state (SMR_JOB_FAILED for a NULL handle)
+ */
+SMR_API SMRJobState smr_job_get_state(JobHandle job);
+
+/**
+ * @brief Get the progress of a job
+ * @param job Job handle
+ * @return Fraction done in [0, 1] (1 once finished, 0 for a NULL handle)
+ */
+SMR_API float smr_job_get_progress(JobHandle job);
+
+/**
+ * @brief Ask a job to stop (returns at once; a queued job never starts)
+ * @param job Job handle
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_job_cancel(JobHandle job);
+
+/**
+ * @brief Block until a job has finished or the timeout expires
+ * @param job Job handle
+ * @param timeout_ms Maximum wait in milliseconds (negative = no limit, 0 = poll)
+ * @return Job state after the wait
+ */
+SMR_API SMRJobState smr_job_wait(JobHandle job, int timeout_ms);
+
+/**
+ * @brief Get the result code of a finished job
+ * @param job Job handle
+ * @return Code returned by the operation, SMR_ERROR_CANCELLED if cancelled,
+ *         SMR_ERROR_COMPUTATION_FAILED if the job has not finished yet
+ */
+SMR_API SMRErrorCode smr_job_get_result(JobHandle job);
+
+/**
+ * @brief Take ownership of the mesh a completed reconstruction job created
+ * @param job Job handle
+ * @return Mesh handle (destroy with smr_mesh_destroy), or NULL if the job
+ *         created none, has not completed, or the mesh was already taken
+ */
+SMR_API MeshHandle smr_job_take_mesh(JobHandle job);
+
+/**
+ * @brief Destroy a job; an unfinished job is cancelled and waited for first
+ * @param job Job handle
+ *
+ * Called from the job's own completion callback, it returns at once and the
+ * job is destroyed after the callback returns. A mesh that was never taken
+ * is destroyed with the job.
+ */
+SMR_API void smr_job_destroy(JobHandle job);
+
+// =============================================================================
+// Instrumentation API
+// =============================================================================
+/*
+ * Stage timers (neighbor search, PCA, splatting, extraction, IK solves, ...)
+ * and counters (IK iterations and failures, pool steals, ...) built into the
+ * hot paths. While off, each timer costs one relaxed atomic load; configure
+ * with -DSMR_ENABLE_STATS=OFF to compile them out entirely.
+ */
+
+/**
+ * @brief Start or stop recording
+ * @param mode SMR_STATS_OFF, SMR_STATS_ON or SMR_STATS_TRACE
+ * @return SMR_SUCCESS, or SMR_ERROR_NOT_IMPLEMENTED if stats are compiled out
+ */
+SMR_API SMRErrorCode smr_stats_set_mode(SMRStatsMode mode);
+
+/**
+ * @brief Read the stage timers and counters
+ * @param out_stats Output entries (NULL to query the number of entries)
+ * @param capacity Entries out_stats can hold
+ * @return Number of entries available (the first min(capacity, return) are written)
+ */
+SMR_API int smr_stats_get(StageStat* out_stats, int capacity);
+
+/**
+ * @brief Zero every timer and counter and discard recorded trace events
+ *
+ * Call between operations; updates racing with a reset may survive it.
+ */
+SMR_API void smr_stats_reset(void);
+
+/**
+ * @brief Write the events recorded in SMR_STATS_TRACE mode as Chrome trace JSON
+ * @param filepath Output path (open in chrome://tracing or Perfetto)
+ * @return SMR_SUCCESS or error code
+ *
+ * Scopes shorter than 20 us (e.g. single IK solves) are counted by
+ * smr_stats_get but not traced; at most 2^20 events are kept.
+ */
+SMR_API SMRErrorCode smr_stats_write_trace(const char* filepath);
+
+// =============================================================================
+// Memory API
+// =============================================================================
+/*
+ * The buffers that grow with the input (points, mesh arrays, path sets,
+ * reachability maps, BVHs and the reconstruction and downsampling grids) are
+ * allocated through a tracking layer. Small per-call scratch is not counted.
+ * Per-handle figures are the bytes the object reserves right now, including
+ * the spare arrays a cloud or mesh keeps from its last filter for reuse.
+ * Each thread also keeps up to 64 MB of search scratch between calls; that
+ * is in the process-wide counters but not in any handle.
+ */
+
+/**
+ * @brief Read the process-wide live and peak byte counters
+ * @param out_stats Output counters
+ * @return SMR_SUCCESS or error code
+ */
+SMR_API SMRErrorCode smr_memory_get_stats(MemoryStats* out_stats);
+
+/**
+ * @brief Restart peak tracking from the current live bytes
+ *
+ * Call before an operation to measure its own peak.
+ */
+SMR_API void smr_memory_reset_peak(void);
+
+/**
+ * @brief Predict the memory a reconstruction of this cloud will take
+ *
+ * Finds the grid cells that will produce surface without allocating the
+ * grid: one pass over the points sums them into a hash table of occupied
+ * voxels (about 24 bytes per voxel, not per point). Returns the peak of
+ * smr_mesh_create_poisson (and the pipeline's mesh stage): the grid, the
+ * surface cell lists and the mesh arrays, or the table if that is larger.
+ * It errs high, never low. The input cloud and the per-thread scratch kept
+ * between calls are not included. To pick a depth that fits, use
+ * smr_mesh_estimate_memory_depths (or its job) rather than calling this
+ * once per depth.
+ *
+ * @param pc_handle Point cloud handle (normals are used if present;
+ *        without them every occupied voxel is assumed to produce surface)
+ * @param settings Reconstruction settings (depth 1-12)
+ * @return Additional bytes needed, or -1 on invalid input
+ */
+SMR_API long long smr_mesh_estimate_memory(PointCloudHandle pc_handle,
+                                           const PoissonSettings* settings);
+
+/**
+ * @brief Predict the memory of a reconstruction at every depth at once
+ *
+ * Same figures as smr_mesh_estimate_memory for depths 1 to settings->depth,
+ * from a single pass over the points: each coarser level is folded from
+ * the one below it. Each level multiplies the grid by 8; take the deepest
+ * level that fits the budget.
+ *
+ * @param pc_handle Point cloud handle (normals are used if present)
+ * @param settings Reconstruction settings (depth 1-12 is the deepest level)
+ * @param out_bytes Output: settings->depth entries, out_bytes[d - 1] for depth d
+ * @return SMR_SUCCESS, SMR_ERROR_CANCELLED (inside a cancelled job) or an error code
+ */
+SMR_API SMRErrorCode smr_mesh_estimate_memory_depths(PointCloudHandle pc_handle,
+                                                     const PoissonSettings* settings,
+                                                     long long* out_bytes);
+
+/**
+ * @brief Bytes held by a point cloud, including the spare arrays its
+ *        filters keep for reuse
+ * @param handle Point cloud handle
+ * @return Bytes, or -1 on error
+ */
+SMR_API long long smr_pointcloud_get_memory(PointCloudHandle handle);
+
+/**
+ * @brief Release the spare arrays a point cloud keeps for its filters
+ *
+ * Filters that shrink the cloud already release the arrays they replaced;
+ * at most one spare per size class is kept otherwise. Call this when the
+ * cloud will not be filtered again.
+ *
+ * @param handle Point cloud handle
+ * @return Error code
+ */
+SMR_API SMRErrorCode smr_pointcloud_trim_memory(PointCloudHandle handle);
+
+/**
+ * @brief Bytes held by a mesh, including its BVH once built and the spare
+ *        arrays its filters keep for reuse
+ * @param handle Mesh handle
+ * @return Bytes, or -1 on error
+ */
+SMR_API long long smr_mesh_get_memory(MeshHandle handle);
+
+/**
+ * @brief Release the spare arrays a mesh keeps for its filters
+ *        (see smr_pointcloud_trim_memory)
+ * @param handle Mesh handle
+ * @return Error code
+ */
+SMR_API SMRErrorCode smr_mesh_trim_memory(MeshHandle handle);
+
+/**
+ * @brief Bytes held by a path, including its cached spline
+ * @param handle Path handle
+ * @return Bytes, or -1 on error
+ */
+SMR_API long long smr_path_get_memory(PathHandle handle);
+
+/**
+ * @brief Bytes held by a path set, including its cached splines
+ * @param handle Path set handle
+ * @return Bytes, or -1 on error
+ */
+SMR_API long long smr_path_set_get_memory(PathSetHandle handle);
+
+/**
+ * @brief Bytes held by a robot model (collision capsules and reachability map)
+ * @param handle Robot handle
+ * @return Bytes, or -1 on error
+ */
+SMR_API long long smr_robot_get_memory(RobotHandle handle);
+
+/**
+ * @brief Bytes held by a pipeline: its cloud, mesh, path, joints and buffers
+ * @param handle Pipeline handle
+ * @return Bytes, or -1 on error
+ */
+SMR_API long long smr_pipeline_get_memory(PipelineHandle handle);
+
 // =============================================================================
 // Utility Functions
 // =============================================================================
@@ -518,6 +1895,18 @@ SMR_API const char* smr_get_last_error(void);
  */
 SMR_API const char* smr_get_version(void);
 
+/**
+ * @brief Vector instruction set the point kernels run with
+ *
+ * Detected on first use: "avx512", "avx2" or "scalar" on x86-64, "neon" on
+ * ARM64. Setting the SMR_SIMD environment variable to "scalar", "avx2" or
+ * "avx512" before the first call caps it (for comparisons or to work
+ * around a faulty CPU).
+ *
+ * @return Instruction set name (static string, do not free)
+ */
+SMR_API const char* smr_get_simd_level(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,256 @@
+/**
+ * @file collision.cpp
+ * @brief Robot-Obstacle and Self-Collision Checking Implementation
+ */
+
+#include "collision.h"
+#include "mesh_generator.h"
+#include "parallel.h"
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+static const double HOME_JOINTS[6] = {0.0, -M_PI / 2, M_PI / 2, 0.0, 0.0, 0.0};
+
+CollisionSettings collision_resolve_settings(const CollisionSettings* settings) {
+    CollisionSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.link_radius <= 0) s.link_radius = 0.05f;
+    if (s.margin < 0) s.margin = 0;
+    if (s.tip_clearance <= 0) s.tip_clearance = 0.02f;
+    if (s.max_joint_step <= 0) s.max_joint_step = 0.02;
+    if (s.num_threads <= 0) s.num_threads = parallel_default_threads();
+    return s;
+}
+
+// Capsule endpoints in the base frame (6 floats per capsule)
+static void place_capsules(const RobotImpl& robot, const CollisionModel& model,
+                           const double* joints, float* out) {
+    Matrix4x4 frames[7];
+    robot.forward_kinematics_chain(joints, frames);
+
+    for (size_t c = 0; c < model.capsules.size(); ++c) {
+        const LinkCapsule& cap = model.capsules[c];
+        const double* m = frames[cap.frame].m;
+        for (int r = 0; r < 3; ++r) {
+            out[c * 6 + r] = static_cast<float>(
+                m[r*4+0] * cap.p0[0] + m[r*4+1] * cap.p0[1] + m[r*4+2] * cap.p0[2] + m[r*4+3]);
+            out[c * 6 + 3 + r] = static_cast<float>(
+                m[r*4+0] * cap.p1[0] + m[r*4+1] * cap.p1[1] + m[r*4+2] * cap.p1[2] + m[r*4+3]);
+        }
+    }
+}
+
+static bool capsules_touch(const float* a, const float* b, float radius) {
+    float d[3] = {a[3] - a[0], a[4] - a[1], a[5] - a[2]};
+    float dist2 = segment_segment_dist2(a[0] - b[0], a[1] - b[1], a[2] - b[2],
+                                        d[0], d[1], d[2], d[0]*d[0] + d[1]*d[1] + d[2]*d[2],
+                                        b[3] - b[0], b[4] - b[1], b[5] - b[2]);
+    return dist2 <= radius * radius;
+}
+
+// Pull the end of a frame-6 capsule back toward p0 until it is `keep_out` from
+// the TCP (the frame-6 origin). False if the whole segment is closer than that.
+static bool trim_flange_capsule(LinkCapsule& cap, float keep_out) {
+    float len = std::sqrt(cap.p0[0] * cap.p0[0] + cap.p0[1] * cap.p0[1] + cap.p0[2] * cap.p0[2]);
+    if (len <= keep_out) return false;
+    float t = keep_out / len;
+    for (int k = 0; k < 3; ++k) cap.p1[k] = cap.p0[k] * t;
+    return true;
+}
+
+void collision_build_model(const RobotImpl& robot, const CollisionSettings& s,
+                           CollisionModel& out) {
+    out.capsules.clear();
+    out.self_pairs.clear();
+    out.margin = s.margin;
+
+    if (!robot.collision_capsules.empty()) {
+        out.capsules = robot.collision_capsules;
+    } else {
+        // Link i spans the previous frame origin, which sits at
+        // -(a, d sin(alpha), d cos(alpha)) in frame i, to its own origin
+        for (int i = 0; i < 6; ++i) {
+            const DHParams& dh = robot.dh[i];
+            LinkCapsule cap;
+            cap.frame = i + 1;
+            cap.p0[0] = static_cast<float>(-dh.a);
+            cap.p0[1] = static_cast<float>(-dh.d * std::sin(dh.alpha));
+            cap.p0[2] = static_cast<float>(-dh.d * std::cos(dh.alpha));
+            cap.p1[0] = cap.p1[1] = cap.p1[2] = 0.0f;
+            cap.radius = s.link_radius;
+            if (i == 5 && !trim_flange_capsule(cap, s.tip_clearance + s.link_radius + s.margin)) continue;
+            if (std::abs(dh.a) + std::abs(dh.d) > 1e-6) out.capsules.push_back(cap);
+        }
+    }
+
+    // Pairs touching at home are part of the arm's design (wrist housings)
+    std::vector<float> placed(out.capsules.size() * 6);
+    place_capsules(robot, out, HOME_JOINTS, placed.data());
+    for (size_t a = 0; a < out.capsules.size(); ++a) {
+        for (size_t b = a + 1; b < out.capsules.size(); ++b) {
+            if (std::abs(out.capsules[a].frame - out.capsules[b].frame) <= 1) continue;
+            float radius = out.capsules[a].radius + out.capsules[b].radius;
+            if (capsules_touch(&placed[a * 6], &placed[b * 6], radius)) continue;
+            out.self_pairs.push_back(static_cast<int>(a));
+            out.self_pairs.push_back(static_cast<int>(b));
+        }
+    }
+}
+
+bool configuration_collides(const RobotImpl& robot, const CollisionModel& model,
+                            const MeshBVH* const* obstacles, int obstacle_count,
+                            bool check_self, const double* joints) {
+    const size_t n = model.capsules.size();
+    float placed[6 * 16];
+    std::unique_ptr<float[]> heap;
+    float* world = placed;
+    if (n > 16) {
+        heap.reset(new float[n * 6]);
+        world = heap.get();
+    }
+    place_capsules(robot, model, joints, world);
+
+    for (size_t c = 0; c < n; ++c) {
+        float radius = model.capsules[c].radius + model.margin;
+        for (int o = 0; o < obstacle_count; ++o) {
+            if (obstacles[o]->overlaps_capsule(&world[c * 6], &world[c * 6 + 3], radius)) {
+                return true;
+            }
+        }
+    }
+
+    if (check_self) {
+        for (size_t p = 0; p + 1 < model.self_pairs.size(); p += 2) {
+            int a = model.self_pairs[p], b = model.self_pairs[p + 1];
+            float radius = model.capsules[a].radius + model.capsules[b].radius + 2.0f * model.margin;
+            if (capsules_touch(&world[a * 6], &world[b * 6], radius)) return true;
+        }
+    }
+    return false;
+}
+
+bool motion_collides(const CollisionChecker& checker, const double* q0, const double* q1,
+                     double max_joint_step) {
+    double max_delta = 0;
+    for (int j = 0; j < 6; ++j) max_delta = std::max(max_delta, std::abs(q1[j] - q0[j]));
+    int steps = std::max(1, static_cast<int>(std::ceil(max_delta / max_joint_step)));
+
+    // Sample k is visited at the stride of its lowest set bit
+    int stride = 1;
+    while (stride < steps) stride <<= 1;
+    for (; stride >= 1; stride >>= 1) {
+        for (int k = stride; k < steps; k += 2 * stride) {
+            double t = static_cast<double>(k) / steps;
+            double q[6];
+            for (int j = 0; j < 6; ++j) q[j] = q0[j] + t * (q1[j] - q0[j]);
+            if (checker.collides(q)) return true;
+        }
+    }
+    return false;
+}
+
+long check_trajectory_collisions(const RobotImpl& robot, const CollisionModel& model,
+                                 const MeshBVH* const* obstacles, int obstacle_count,
+                                 const double* joints, size_t count,
+                                 const CollisionSettings& s, bool* out_collision) {
+    const bool check_self = !s.ignore_self_collision;
+    std::atomic<long> first(static_cast<long>(count));
+
+    parallel_for(0, count, 16, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            // Without per-sample output, samples past a known hit don't matter
+            if (!out_collision && static_cast<long>(i) > first.load(std::memory_order_relaxed)) return;
+
+            const double* q1 = joints + i * 6;
+            bool hit;
+            if (i == 0) {
+                hit = configuration_collides(robot, model, obstacles, obstacle_count, check_self, q1);
+            } else {
+                // Sub-steps on the motion from i-1, ending at sample i
+                const double* q0 = q1 - 6;
+                double max_delta = 0;
+                for (int j = 0; j < 6; ++j) max_delta = std::max(max_delta, std::abs(q1[j] - q0[j]));
+                int steps = std::max(1, static_cast<int>(std::ceil(max_delta / s.max_joint_step)));
+
+                hit = false;
+                for (int k = steps; k >= 1 && !hit; --k) {
+                    double t = static_cast<double>(k) / steps;
+                    double q[6];
+                    for (int j = 0; j < 6; ++j) q[j] = q0[j] + t * (q1[j] - q0[j]);
+                    hit = configuration_collides(robot, model, obstacles, obstacle_count, check_self, q);
+                }
+            }
+
+            if (out_collision) out_collision[i] = hit;
+            if (hit) {
+                long cur = first.load();
+                while (static_cast<long>(i) < cur && !first.compare_exchange_weak(cur, static_cast<long>(i))) {}
+            }
+        }
+    }, s.num_threads);
+
+    long result = first.load();
+    return result < static_cast<long>(count) ? result : -1;
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+SMR_API SMRErrorCode smr_robot_set_collision_capsules(RobotHandle handle,
+                                                       const LinkCapsule* capsules,
+                                                       int count) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (count < 0 || (count > 0 && !capsules)) return SMR_ERROR_INVALID_PARAMETER;
+
+    for (int i = 0; i < count; ++i) {
+        if (capsules[i].frame < 0 || capsules[i].frame > 6 || !(capsules[i].radius >= 0)) {
+            return SMR_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    auto* robot = static_cast<RobotImpl*>(handle);
+    robot->collision_capsules.assign(capsules, capsules + count);
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_robot_check_collisions(RobotHandle robot_handle,
+                                                 const MeshHandle* obstacles,
+                                                 int obstacle_count,
+                                                 const double* joints,
+                                                 int count,
+                                                 const CollisionSettings* settings,
+                                                 bool* out_collision,
+                                                 int* out_first_collision) {
+    if (!robot_handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!joints || count < 0 || obstacle_count < 0 || (obstacle_count > 0 && !obstacles)) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+    for (int o = 0; o < obstacle_count; ++o) {
+        if (!obstacles[o]) return SMR_ERROR_INVALID_HANDLE;
+    }
+
+    auto* robot = static_cast<RobotImpl*>(robot_handle);
+    CollisionSettings s = collision_resolve_settings(settings);
+
+    CollisionModel model;
+    collision_build_model(*robot, s, model);
+
+    // Cached per mesh; the shared_ptrs keep them alive if a mesh is edited meanwhile
+    std::vector<std::shared_ptr<const MeshBVH>> bvhs(obstacle_count);
+    std::vector<const MeshBVH*> bvh_ptrs(obstacle_count);
+    for (int o = 0; o < obstacle_count; ++o) {
+        bvhs[o] = static_cast<const MeshImpl*>(obstacles[o])->get_bvh();
+        bvh_ptrs[o] = bvhs[o].get();
+    }
+
+    long first = check_trajectory_collisions(*robot, model, bvh_ptrs.data(), obstacle_count,
+                                             joints, static_cast<size_t>(count), s, out_collision);
+    if (out_first_collision) *out_first_collision = static_cast<int>(first);
+    return SMR_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file collision.h
+ * @brief Capsule link models and collision checks along joint trajectories
+ */
+
+#ifndef SMR_COLLISION_H
+#define SMR_COLLISION_H
+
+#include "smr_welding_api.h"
+#include "robot_kinematics.h"
+#include "mesh_bvh.h"
+#include <vector>
+#include <cstddef>
+
+/// Robot capsules plus the link pairs checked for self-collision
+struct CollisionModel {
+    std::vector<LinkCapsule> capsules;
+    std::vector<int> self_pairs;      // Capsule index pairs (2 ints each)
+    float margin;
+};
+
+/// Fill zero/unset fields of `settings` with defaults
+CollisionSettings collision_resolve_settings(const CollisionSettings* settings);
+
+/**
+ * Resolve the robot's capsules (user-defined, or one per DH link from the
+ * previous frame origin to the next, the flange one ending tip_clearance short
+ * of the TCP) and its self-collision pairs: capsules on frames more than one
+ * joint apart that do not already touch in the home pose.
+ */
+void collision_build_model(const RobotImpl& robot, const CollisionSettings& settings,
+                           CollisionModel& out);
+
+/// True if any capsule hits an obstacle or a checked capsule pair touches
+bool configuration_collides(const RobotImpl& robot, const CollisionModel& model,
+                            const MeshBVH* const* obstacles, int obstacle_count,
+                            bool check_self, const double* joints);
+
+/**
+ * Configuration test used by the motion planners. Implementations must be
+ * safe to call from several threads at once.
+ */
+class CollisionChecker {
+public:
+    virtual ~CollisionChecker() {}
+    virtual bool collides(const double* joints) const = 0;
+};
+
+/// Capsule model against obstacle BVHs (and itself), see configuration_collides
+class MeshCollisionChecker : public CollisionChecker {
+public:
+    MeshCollisionChecker(const RobotImpl& robot, const CollisionModel& model,
+                         const MeshBVH* const* obstacles, int obstacle_count, bool check_self)
+        : robot(robot), model(model), obstacles(obstacles), obstacle_count(obstacle_count),
+          check_self(check_self) {}
+
+    bool collides(const double* joints) const override {
+        return configuration_collides(robot, model, obstacles, obstacle_count, check_self, joints);
+    }
+
+private:
+    const RobotImpl& robot;
+    const CollisionModel& model;
+    const MeshBVH* const* obstacles;
+    int obstacle_count;
+    bool check_self;
+};
+
+/**
+ * True if the straight joint-space motion q0 -> q1 collides, checked so no
+ * joint moves more than max_joint_step between checks. Samples are visited
+ * coarse to fine (midpoint first), so blocked motions are usually rejected
+ * after a few checks. The end points themselves are not checked.
+ */
+bool motion_collides(const CollisionChecker& checker, const double* q0, const double* q1,
+                     double max_joint_step);
+
+/**
+ * Check `count` configurations and the motion between them, interpolating so
+ * no joint moves more than max_joint_step between checks. A collision on the
+ * motion from i-1 to i is reported at sample i.
+ *
+ * @param out_collision count flags (may be NULL; then checking stops at the first hit)
+ * @return Index of the first colliding sample, or -1
+ */
+long check_trajectory_collisions(const RobotImpl& robot, const CollisionModel& model,
+                                 const MeshBVH* const* obstacles, int obstacle_count,
+                                 const double* joints, size_t count,
+                                 const CollisionSettings& settings, bool* out_collision);
+
+#endif // SMR_COLLISION_H
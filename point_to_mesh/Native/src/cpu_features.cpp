@@ -0,0 +1,107 @@
+/**
+ * @file cpu_features.cpp
+ * @brief CPUID / XGETBV Feature Detection
+ */
+
+#include "cpu_features.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SMR_CPU_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// =============================================================================
+// x86 Detection
+// =============================================================================
+
+#if defined(SMR_CPU_X86)
+static void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(r[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// XCR0: which register states the OS saves on a context switch
+static uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+
+static SimdLevel detect() {
+    unsigned regs[4];
+    cpuid(0, 0, regs);
+    unsigned max_leaf = regs[0];
+    if (max_leaf < 7) return SIMD_SCALAR;
+
+    // AVX needs the CPU bit and the OS saving YMM state (XSAVE enabled)
+    cpuid(1, 0, regs);
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool avx = (regs[2] & (1u << 28)) != 0;
+    if (!osxsave || !avx) return SIMD_SCALAR;
+    uint64_t xcr0 = xgetbv0();
+    if ((xcr0 & 0x6) != 0x6) return SIMD_SCALAR;           // XMM | YMM
+
+    cpuid(7, 0, regs);
+    const bool avx2 = (regs[1] & (1u << 5)) != 0;
+    const bool avx512f = (regs[1] & (1u << 16)) != 0;
+    if (!avx2) return SIMD_SCALAR;
+    if (avx512f && (xcr0 & 0xe6) == 0xe6) return SIMD_AVX512;  // + opmask, ZMM
+    return SIMD_AVX2;
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+static SimdLevel detect() { return SIMD_NEON; }
+#else
+static SimdLevel detect() { return SIMD_SCALAR; }
+#endif
+
+// =============================================================================
+// Selection
+// =============================================================================
+
+// SMR_SIMD caps the level (to compare paths or work around a bad CPU)
+static SimdLevel apply_override(SimdLevel detected) {
+    const char* value = std::getenv("SMR_SIMD");
+    if (!value || !*value) return detected;
+
+    SimdLevel cap = detected;
+    if (std::strcmp(value, "scalar") == 0) cap = SIMD_SCALAR;
+    else if (std::strcmp(value, "neon") == 0) cap = SIMD_NEON;
+    else if (std::strcmp(value, "avx2") == 0) cap = SIMD_AVX2;
+    else if (std::strcmp(value, "avx512") == 0) cap = SIMD_AVX512;
+
+    if (cap >= detected) return detected;
+    // NEON and AVX are not a ladder: below the detected level only scalar
+    // is always available
+    if (cap == SIMD_AVX2 && detected == SIMD_AVX512) return SIMD_AVX2;
+    return SIMD_SCALAR;
+}
+
+SimdLevel cpu_simd_level() {
+    static const SimdLevel level = apply_override(detect());
+    return level;
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SIMD_NEON: return "neon";
+        case SIMD_AVX2: return "avx2";
+        case SIMD_AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
@@ -0,0 +1,27 @@
+/**
+ * @file cpu_features.h
+ * @brief Runtime CPU feature detection for the SIMD kernel dispatch
+ */
+
+#ifndef SMR_CPU_FEATURES_H
+#define SMR_CPU_FEATURES_H
+
+/// Widest vector instruction set the kernels may use, in increasing order
+enum SimdLevel {
+    SIMD_SCALAR = 0,
+    SIMD_NEON,      // AArch64 (always present there)
+    SIMD_AVX2,      // x86-64 with AVX2 and OS support for YMM state
+    SIMD_AVX512     // x86-64 with AVX-512F and OS support for ZMM state
+};
+
+/**
+ * Level used by this process: the best one the CPU and OS support, capped
+ * by the SMR_SIMD environment variable ("scalar", "avx2" or "avx512") if it
+ * is set. Detected once, on first use.
+ */
+SimdLevel cpu_simd_level();
+
+/// "scalar", "neon", "avx2" or "avx512"
+const char* simd_level_name(SimdLevel level);
+
+#endif // SMR_CPU_FEATURES_H
@@ -0,0 +1,219 @@
+/**
+ * @file global_ik.cpp
+ * @brief Global IK Branch Selection Implementation
+ */
+
+#include "global_ik.h"
+#include "trajectory_ik.h"
+#include "parallel.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+static const int MAX_BRANCHES = 8;
+static const double COST_INF = 1e300;
+static const double JUMP_PENALTY = 1e6;   // Finite, so a forced reconfiguration still connects
+static const int REDISCOVERY_RETRY = 16;  // Points between discovery retries when nothing is reachable
+
+// One layer of the Viterbi graph: up to 8 IK branches for one target.
+// Joint-major SoA so per-joint differences run across all branches at once.
+struct BranchLayer {
+    alignas(64) double q[6][MAX_BRANCHES];
+    double node_cost[MAX_BRANCHES];
+    uint8_t valid_mask;
+    SMRErrorCode fail_reason;
+};
+
+GlobalIKSettings global_ik_resolve_settings(const GlobalIKSettings* settings) {
+    GlobalIKSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.discovery_interval <= 0) s.discovery_interval = 128;
+    if (s.num_threads <= 0) s.num_threads = parallel_default_threads();
+    if (s.motion_weight <= 0) s.motion_weight = 1.0;
+    if (s.limit_weight <= 0) s.limit_weight = 0.1;
+    if (s.manipulability_weight <= 0) s.manipulability_weight = 0.001;
+    if (s.max_joint_step <= 0) s.max_joint_step = 0.5;
+    return s;
+}
+
+// Penalty rising quadratically inside the outer 10% of each joint's range,
+// plus inverse manipulability
+static double node_cost(const RobotImpl& robot, const double* q, const GlobalIKSettings& s) {
+    double limit_cost = 0;
+    for (int j = 0; j < 6; ++j) {
+        double range = robot.limits[j].max_angle - robot.limits[j].min_angle;
+        double band = 0.1 * range;
+        if (band <= 0) continue;
+        double margin = std::min(q[j] - robot.limits[j].min_angle,
+                                 robot.limits[j].max_angle - q[j]);
+        if (margin < band) {
+            double t = (band - margin) / band;
+            limit_cost += t * t;
+        }
+    }
+
+    double w = robot.compute_manipulability(q);
+    return s.limit_weight * limit_cost + s.manipulability_weight / (w + 1e-3);
+}
+
+static void store_node(const RobotImpl& robot, const GlobalIKSettings& s,
+                       BranchLayer& layer, int b, const double* q) {
+    for (int j = 0; j < 6; ++j) layer.q[j][b] = q[j];
+    layer.node_cost[b] = node_cost(robot, q, s);
+    layer.valid_mask |= static_cast<uint8_t>(1u << b);
+}
+
+// Discover branches at the segment start and track them to the segment end
+static void gather_segment(const RobotImpl& robot, const Matrix4x4* targets,
+                           size_t begin, size_t end, const GlobalIKSettings& s,
+                           BranchLayer* layers) {
+    double branch_q[MAX_BRANCHES][6];
+    bool alive[MAX_BRANCHES] = {false};
+    int alive_count = 0;
+    size_t last_discovery = begin;
+
+    for (size_t i = begin; i < end; ++i) {
+        BranchLayer& layer = layers[i];
+        layer.valid_mask = 0;
+        layer.fail_reason = SMR_ERROR_NO_SOLUTION;
+
+        if (alive_count == 0 && (i == begin || i - last_discovery >= REDISCOVERY_RETRY)) {
+            last_discovery = i;
+            double solutions[MAX_BRANCHES * 6];
+            int n = robot.inverse_kinematics_all(targets[i], solutions);
+            for (int b = 0; b < n; ++b) {
+                std::memcpy(branch_q[b], solutions + b * 6, 6 * sizeof(double));
+                alive[b] = true;
+                store_node(robot, s, layer, b, branch_q[b]);
+            }
+            alive_count = n;
+            continue;
+        }
+
+        for (int b = 0; b < MAX_BRANCHES; ++b) {
+            if (!alive[b]) continue;
+            double q[6];
+            if (robot.inverse_kinematics_numerical(targets[i], branch_q[b], q)) {
+                std::memcpy(branch_q[b], q, sizeof(q));
+                store_node(robot, s, layer, b, q);
+            } else {
+                // Lost branch; segment discovery picks it up again later
+                layer.fail_reason = robot.classify_ik_failure(q);
+                alive[b] = false;
+                --alive_count;
+            }
+        }
+    }
+}
+
+size_t solve_global_ik(const RobotImpl& robot,
+                       const Matrix4x4* targets,
+                       size_t count,
+                       const GlobalIKSettings& s,
+                       double* out_joints,
+                       SMRErrorCode* out_status) {
+    if (count == 0) return 0;
+
+    // Step 1: Build the layered graph (parallel across discovery segments)
+    std::vector<BranchLayer> layers(count);
+    size_t interval = static_cast<size_t>(s.discovery_interval);
+    size_t num_segments = (count + interval - 1) / interval;
+
+    parallel_for(0, num_segments, 1, [&](size_t lo, size_t hi) {
+        for (size_t seg = lo; seg < hi; ++seg) {
+            size_t begin = seg * interval;
+            gather_segment(robot, targets, begin, std::min(count, begin + interval),
+                           s, layers.data());
+        }
+    }, s.num_threads);
+
+    // Time-scaled motion weights: moving a slow joint costs more
+    double motion_w[6];
+    for (int j = 0; j < 6; ++j) {
+        double v = robot.limits[j].max_velocity > 0 ? robot.limits[j].max_velocity : 1.0;
+        motion_w[j] = s.motion_weight / (v * v);
+    }
+
+    // Step 2: Viterbi forward pass over layers that have at least one branch
+    std::vector<uint8_t> back(count * MAX_BRANCHES, 0);
+    std::vector<long> prev_layer(count, -1);
+    double cost[MAX_BRANCHES];
+    long last = -1;
+
+    for (size_t i = 0; i < count; ++i) {
+        const BranchLayer& cur = layers[i];
+        if (cur.valid_mask == 0) continue;
+
+        double next_cost[MAX_BRANCHES];
+        if (last < 0) {
+            for (int b = 0; b < MAX_BRANCHES; ++b) {
+                next_cost[b] = (cur.valid_mask & (1u << b)) ? cur.node_cost[b] : COST_INF;
+            }
+        } else {
+            const BranchLayer& prev = layers[last];
+            for (int b = 0; b < MAX_BRANCHES; ++b) {
+                if (!(cur.valid_mask & (1u << b))) {
+                    next_cost[b] = COST_INF;
+                    continue;
+                }
+
+                // Transition cost from every previous branch, branch-parallel
+                double motion[MAX_BRANCHES] = {0};
+                double jump[MAX_BRANCHES] = {0};
+                for (int j = 0; j < 6; ++j) {
+                    double qb = cur.q[j][b];
+                    double w = motion_w[j];
+                    for (int a = 0; a < MAX_BRANCHES; ++a) {
+                        double d = prev.q[j][a] - qb;
+                        motion[a] += w * d * d;
+                        jump[a] = std::max(jump[a], std::abs(d));
+                    }
+                }
+
+                double best = COST_INF;
+                int best_a = 0;
+                for (int a = 0; a < MAX_BRANCHES; ++a) {
+                    if (!(prev.valid_mask & (1u << a))) continue;
+                    double c = cost[a] + motion[a] +
+                               (jump[a] > s.max_joint_step ? JUMP_PENALTY : 0.0);
+                    if (c < best) {
+                        best = c;
+                        best_a = a;
+                    }
+                }
+                next_cost[b] = best + cur.node_cost[b];
+                back[i * MAX_BRANCHES + b] = static_cast<uint8_t>(best_a);
+            }
+        }
+
+        std::memcpy(cost, next_cost, sizeof(cost));
+        prev_layer[i] = last;
+        last = static_cast<long>(i);
+    }
+
+    // Step 3: Backtrack the cheapest branch sequence
+    for (size_t i = 0; i < count; ++i) out_status[i] = layers[i].fail_reason;
+
+    if (last >= 0) {
+        int b = 0;
+        double best = COST_INF;
+        for (int a = 0; a < MAX_BRANCHES; ++a) {
+            if (cost[a] < best) {
+                best = cost[a];
+                b = a;
+            }
+        }
+
+        for (long i = last; i >= 0; i = prev_layer[i]) {
+            for (int j = 0; j < 6; ++j) out_joints[i * 6 + j] = layers[i].q[j][b];
+            out_status[i] = SMR_SUCCESS;
+            b = back[i * MAX_BRANCHES + b];
+        }
+    }
+
+    return fill_unreachable_joints(count, out_status, nullptr, out_joints);
+}
@@ -0,0 +1,34 @@
+/**
+ * @file global_ik.h
+ * @brief Configuration-consistent IK branch selection over a path (Viterbi)
+ */
+
+#ifndef SMR_GLOBAL_IK_H
+#define SMR_GLOBAL_IK_H
+
+#include "smr_welding_api.h"
+#include "robot_kinematics.h"
+#include <cstddef>
+
+/// Fill zero/unset fields of `settings` with defaults
+GlobalIKSettings global_ik_resolve_settings(const GlobalIKSettings* settings);
+
+/**
+ * Gather up to 8 IK branches per target and pick one per target minimizing
+ * accumulated joint motion plus joint-limit and manipulability node costs.
+ *
+ * Branches are discovered by multi-start IK every discovery_interval targets
+ * and tracked in between by warm-started IK (parallel across segments).
+ *
+ * @param out_joints count * 6 doubles; failed points hold the nearest valid solution
+ * @param out_status count codes (SMR_SUCCESS or failure reason)
+ * @return Number of reachable points
+ */
+size_t solve_global_ik(const RobotImpl& robot,
+                       const Matrix4x4* targets,
+                       size_t count,
+                       const GlobalIKSettings& settings,
+                       double* out_joints,
+                       SMRErrorCode* out_status);
+
+#endif // SMR_GLOBAL_IK_H
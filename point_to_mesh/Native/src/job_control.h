@@ -0,0 +1,64 @@
+/**
+ * @file job_control.h
+ * @brief Progress and cancellation hooks for code running inside a job
+ */
+
+#ifndef SMR_JOB_CONTROL_H
+#define SMR_JOB_CONTROL_H
+
+#include <atomic>
+
+/**
+ * Shared between a job and its owner. Long loops poll job_cancelled() and
+ * report job_progress(); outside a job both are no-ops, so the blocking
+ * API pays nothing for them. A batch that runs several operations at once
+ * gives each one a child control (parent = the job) and reports its own
+ * overall progress, so the sub-steps do not overwrite each other's.
+ */
+struct JobControl {
+    std::atomic<bool> cancel_requested{false};
+    std::atomic<float> progress{0.0f};
+    const JobControl* parent = nullptr;   // Set on the sub-steps of a batch; cancels with it
+
+    bool cancelled() const {
+        for (const JobControl* job = this; job; job = job->parent) {
+            if (job->cancel_requested.load(std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+};
+
+/// Job of the calling thread (NULL when not running inside a job)
+inline JobControl*& job_current() {
+    static thread_local JobControl* current = nullptr;
+    return current;
+}
+
+/// Makes `job` the calling thread's job for the lifetime of the scope
+class JobScope {
+public:
+    explicit JobScope(JobControl* job) : previous(job_current()) { job_current() = job; }
+    ~JobScope() { job_current() = previous; }
+
+    JobScope(const JobScope&) = delete;
+    JobScope& operator=(const JobScope&) = delete;
+
+private:
+    JobControl* previous;
+};
+
+/// True once the owner of the calling thread's job asked it to stop
+inline bool job_cancelled() {
+    JobControl* job = job_current();
+    return job && job->cancelled();
+}
+
+/// Report the fraction [0, 1] of the current operation that is done
+inline void job_progress(float fraction) {
+    JobControl* job = job_current();
+    if (!job) return;
+    fraction = fraction < 0.0f ? 0.0f : (fraction > 1.0f ? 1.0f : fraction);
+    job->progress.store(fraction, std::memory_order_relaxed);
+}
+
+#endif // SMR_JOB_CONTROL_H
@@ -0,0 +1,419 @@
+/**
+ * @file job_system.cpp
+ * @brief Asynchronous Job API Implementation
+ */
+
+#include "job_system.h"
+#include "mesh_generator.h"
+#include "point_cloud.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int DEFAULT_JOB_THREADS = 2;
+
+// =============================================================================
+// Job
+// =============================================================================
+
+JobImpl::~JobImpl() {
+    if (mesh) smr_mesh_destroy(mesh);
+}
+
+void JobImpl::run() {
+    if (control.cancelled()) {
+        // Cancelled while queued
+        result = SMR_ERROR_CANCELLED;
+    } else {
+        state.store(SMR_JOB_RUNNING);
+        JobScope scope(&control);
+        try {
+            result = work(*this);
+        } catch (const std::bad_alloc&) {
+            result = SMR_ERROR_MEMORY_ALLOCATION;
+        }
+        // A cancelled operation may stop early without an error of its own
+        if (control.cancelled()) result = SMR_ERROR_CANCELLED;
+    }
+
+    if (result != SMR_SUCCESS && mesh) {
+        smr_mesh_destroy(mesh);
+        mesh = nullptr;
+    }
+    work = nullptr;     // Release captured copies early
+
+    SMRJobState final_state = result == SMR_SUCCESS ? SMR_JOB_COMPLETED
+                            : result == SMR_ERROR_CANCELLED ? SMR_JOB_CANCELLED
+                            : SMR_JOB_FAILED;
+    control.progress.store(1.0f);
+    state.store(final_state);
+
+    if (callback) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            callback_thread = std::this_thread::get_id();
+        }
+        callback(this, final_state, user_data);
+    }
+}
+
+void JobImpl::finish() {
+    bool self_destroy;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        callback_thread = std::thread::id();
+        self_destroy = destroy_deferred;
+        finished_cv.notify_all();
+    }
+    if (self_destroy) delete this;
+}
+
+bool JobImpl::wait(int timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex);
+    // The state is final once the callback runs; waiting there would deadlock
+    if (callback_thread == std::this_thread::get_id()) return true;
+    if (timeout_ms < 0) {
+        finished_cv.wait(lock, [this] { return finished; });
+        return true;
+    }
+    return finished_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] { return finished; });
+}
+
+bool JobImpl::defer_destroy() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (callback_thread != std::this_thread::get_id()) return false;
+    destroy_deferred = true;
+    return true;
+}
+
+// =============================================================================
+// Job Threads
+// =============================================================================
+
+/**
+ * FIFO of submitted jobs served by up to thread_count job threads. Each job
+ * parallelizes internally on the shared thread pool, so a few job threads are
+ * enough to keep a short job from waiting behind a long reconstruction.
+ */
+class JobQueue {
+public:
+    // Cancel every job, let the threads finish them (queued ones end as
+    // cancelled without running) and join the threads
+    void shutdown() {
+        std::vector<std::thread> stopped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            for (JobImpl* job : running) job->control.cancel_requested.store(true);
+            for (JobImpl* job : pending) job->control.cancel_requested.store(true);
+            stopped.swap(threads);
+        }
+        wake.notify_all();
+        for (auto& thread : stopped) thread.join();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = false;
+    }
+
+    void set_thread_count(int count) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            thread_count = count;
+            spawn_threads();
+        }
+        wake.notify_all();
+    }
+
+    void submit(JobImpl* job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(job);
+            spawn_threads();
+        }
+        wake.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<JobImpl*> pending;
+    std::vector<JobImpl*> running;
+    std::vector<std::thread> threads;
+    int thread_count = DEFAULT_JOB_THREADS;
+    bool stopping = false;
+
+    // Threads are started lazily and kept; a lower count only limits how
+    // many of them take jobs (caller holds the lock)
+    void spawn_threads() {
+        while (static_cast<int>(threads.size()) < thread_count &&
+               threads.size() < running.size() + pending.size()) {
+            threads.emplace_back(&JobQueue::worker, this);
+        }
+    }
+
+    void worker() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] {
+                return stopping || (!pending.empty() && static_cast<int>(running.size()) < thread_count);
+            });
+            if (stopping && pending.empty()) return;
+
+            JobImpl* job = pending.front();
+            pending.pop_front();
+            running.push_back(job);
+
+            lock.unlock();
+            job->run();
+            lock.lock();
+            running.erase(std::find(running.begin(), running.end(), job));
+            lock.unlock();
+            job->finish();  // The owner may destroy the job from here on
+            lock.lock();
+            wake.notify_all();
+        }
+    }
+};
+
+// Never destroyed, like the thread pool (see smr_shutdown)
+static JobQueue& job_queue() {
+    static JobQueue* queue = new JobQueue;
+    return *queue;
+}
+
+void job_submit(JobImpl* job) {
+    job_queue().submit(job);
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+static JobHandle submit_job(JobImpl::Work work, SMRJobCallback callback, void* user_data) {
+    auto* job = new JobImpl(std::move(work), callback, user_data);
+    job_submit(job);
+    return job;
+}
+
+SMR_API void smr_shutdown(void) {
+    job_queue().shutdown();     // Jobs first: their work runs on the pool
+    pool_shutdown();
+}
+
+SMR_API SMRErrorCode smr_job_set_thread_count(int num_threads) {
+    if (num_threads < 0) return SMR_ERROR_INVALID_PARAMETER;
+    job_queue().set_thread_count(num_threads > 0 ? num_threads : DEFAULT_JOB_THREADS);
+    return SMR_SUCCESS;
+}
+
+SMR_API JobHandle smr_job_pointcloud_load_ply(PointCloudHandle handle, const char* filepath,
+                                              SMRJobCallback callback, void* user_data) {
+    if (!handle || !filepath) return nullptr;
+    std::string path(filepath);
+    return submit_job([handle, path](JobImpl&) {
+        return smr_pointcloud_load_ply(handle, path.c_str());
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_pointcloud_load_pcd(PointCloudHandle handle, const char* filepath,
+                                              SMRJobCallback callback, void* user_data) {
+    if (!handle || !filepath) return nullptr;
+    std::string path(filepath);
+    return submit_job([handle, path](JobImpl&) {
+        return smr_pointcloud_load_pcd(handle, path.c_str());
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_pointcloud_estimate_normals_knn(PointCloudHandle handle, int k,
+                                                          SMRJobCallback callback, void* user_data) {
+    if (!handle || k <= 0) return nullptr;
+    return submit_job([handle, k](JobImpl&) {
+        return smr_pointcloud_estimate_normals_knn(handle, k);
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_pointcloud_downsample_voxel(PointCloudHandle handle, float voxel_size,
+                                                      SMRJobCallback callback, void* user_data) {
+    if (!handle || !(voxel_size > 0)) return nullptr;
+    return submit_job([handle, voxel_size](JobImpl&) {
+        return smr_pointcloud_downsample_voxel(handle, voxel_size);
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_pointcloud_remove_outliers(PointCloudHandle handle, int nb_neighbors,
+                                                     float std_ratio,
+                                                     SMRJobCallback callback, void* user_data) {
+    if (!handle || nb_neighbors <= 0 || !(std_ratio > 0)) return nullptr;
+    return submit_job([handle, nb_neighbors, std_ratio](JobImpl&) {
+        return smr_pointcloud_remove_outliers(handle, nb_neighbors, std_ratio);
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_pointcloud_orient_normals(PointCloudHandle handle,
+                                                    float camera_x, float camera_y, float camera_z,
+                                                    SMRJobCallback callback, void* user_data) {
+    if (!handle) return nullptr;
+    return submit_job([handle, camera_x, camera_y, camera_z](JobImpl&) {
+        return smr_pointcloud_orient_normals(handle, camera_x, camera_y, camera_z);
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_mesh_create_poisson(PointCloudHandle pc_handle,
+                                              const PoissonSettings* settings,
+                                              SMRJobCallback callback, void* user_data) {
+    if (!pc_handle || !settings) return nullptr;
+    PoissonSettings s = *settings;
+    return submit_job([pc_handle, s](JobImpl& job) {
+        auto* mesh = new MeshImpl();
+        job.mesh = mesh;    // Destroyed by the job if the result is an error
+        return mesh->reconstruct(*static_cast<const PointCloudImpl*>(pc_handle), s);
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_mesh_estimate_memory(PointCloudHandle pc_handle,
+                                               const PoissonSettings* settings,
+                                               long long* out_bytes,
+                                               SMRJobCallback callback, void* user_data) {
+    if (!pc_handle || !settings || !out_bytes) return nullptr;
+    PoissonSettings s = *settings;
+    return submit_job([pc_handle, s, out_bytes](JobImpl&) {
+        return smr_mesh_estimate_memory_depths(pc_handle, &s, out_bytes);
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_mesh_remove_low_density(MeshHandle handle, float quantile,
+                                                  SMRJobCallback callback, void* user_data) {
+    if (!handle) return nullptr;
+    return submit_job([handle, quantile](JobImpl&) {
+        return smr_mesh_remove_low_density(handle, quantile);
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_mesh_simplify(MeshHandle handle, float target_ratio,
+                                        SMRJobCallback callback, void* user_data) {
+    if (!handle) return nullptr;
+    return submit_job([handle, target_ratio](JobImpl&) {
+        return smr_mesh_simplify(handle, target_ratio);
+    }, callback, user_data);
+}
+
+// Settings and seed of a joint conversion, copied at submission
+struct JointJobInputs {
+    TrajectoryIKSettings settings;
+    double seed[6];
+    bool has_settings;
+    bool has_seed;
+
+    JointJobInputs(const TrajectoryIKSettings* s, const double* seed_joints)
+        : has_settings(s != nullptr), has_seed(seed_joints != nullptr) {
+        std::memset(&settings, 0, sizeof(settings));
+        std::memset(seed, 0, sizeof(seed));
+        if (s) settings = *s;
+        if (seed_joints) std::memcpy(seed, seed_joints, sizeof(seed));
+    }
+};
+
+SMR_API JobHandle smr_job_path_to_joints(PathHandle path_handle,
+                                         RobotHandle robot_handle,
+                                         float standoff,
+                                         const TrajectoryIKSettings* settings,
+                                         const double* seed_joints,
+                                         double* out_joints,
+                                         bool* out_reachable,
+                                         SMRErrorCode* out_status,
+                                         SMRJobCallback callback,
+                                         void* user_data) {
+    if (!path_handle || !robot_handle || !out_joints || !out_reachable) return nullptr;
+    JointJobInputs in(settings, seed_joints);
+    return submit_job([=](JobImpl&) {
+        return smr_path_to_joints_ex(path_handle, robot_handle, standoff,
+                                     in.has_settings ? &in.settings : nullptr,
+                                     in.has_seed ? in.seed : nullptr,
+                                     out_joints, out_reachable, out_status);
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_path_set_to_joints(PathSetHandle set_handle,
+                                             RobotHandle robot_handle,
+                                             float standoff,
+                                             const TrajectoryIKSettings* settings,
+                                             const double* seed_joints,
+                                             double* out_joints,
+                                             bool* out_reachable,
+                                             SMRErrorCode* out_status,
+                                             SMRJobCallback callback,
+                                             void* user_data) {
+    if (!set_handle || !robot_handle || !out_joints || !out_reachable) return nullptr;
+    JointJobInputs in(settings, seed_joints);
+    return submit_job([=](JobImpl&) {
+        return smr_path_set_to_joints(set_handle, robot_handle, standoff,
+                                      in.has_settings ? &in.settings : nullptr,
+                                      in.has_seed ? in.seed : nullptr,
+                                      out_joints, out_reachable, out_status);
+    }, callback, user_data);
+}
+
+SMR_API JobHandle smr_job_pipeline_run(PipelineHandle handle, const char* filepath,
+                                       RobotHandle robot_handle,
+                                       SMRJobCallback callback, void* user_data) {
+    if (!handle || !filepath) return nullptr;
+    std::string path(filepath);
+    return submit_job([handle, path, robot_handle](JobImpl&) {
+        return smr_pipeline_run(handle, path.c_str(), robot_handle);
+    }, callback, user_data);
+}
+
+SMR_API SMRJobState smr_job_get_state(JobHandle job) {
+    if (!job) return SMR_JOB_FAILED;
+    return static_cast<SMRJobState>(static_cast<JobImpl*>(job)->state.load());
+}
+
+SMR_API float smr_job_get_progress(JobHandle job) {
+    if (!job) return 0.0f;
+    return static_cast<JobImpl*>(job)->control.progress.load(std::memory_order_relaxed);
+}
+
+SMR_API SMRErrorCode smr_job_cancel(JobHandle job) {
+    if (!job) return SMR_ERROR_INVALID_HANDLE;
+    static_cast<JobImpl*>(job)->control.cancel_requested.store(true);
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRJobState smr_job_wait(JobHandle job, int timeout_ms) {
+    if (!job) return SMR_JOB_FAILED;
+    auto* impl = static_cast<JobImpl*>(job);
+    impl->wait(timeout_ms);
+    return static_cast<SMRJobState>(impl->state.load());
+}
+
+SMR_API SMRErrorCode smr_job_get_result(JobHandle job) {
+    if (!job) return SMR_ERROR_INVALID_HANDLE;
+    auto* impl = static_cast<JobImpl*>(job);
+    if (impl->state.load() < SMR_JOB_COMPLETED) return SMR_ERROR_COMPUTATION_FAILED;
+    return impl->result;
+}
+
+SMR_API MeshHandle smr_job_take_mesh(JobHandle job) {
+    if (!job) return nullptr;
+    auto* impl = static_cast<JobImpl*>(job);
+    if (impl->state.load() != SMR_JOB_COMPLETED) return nullptr;
+    MeshHandle mesh = impl->mesh;
+    impl->mesh = nullptr;
+    return mesh;
+}
+
+SMR_API void smr_job_destroy(JobHandle job) {
+    if (!job) return;
+    auto* impl = static_cast<JobImpl*>(job);
+    if (impl->defer_destroy()) return;     // Deleted by finish() after the callback
+    impl->control.cancel_requested.store(true);
+    impl->wait(-1);
+    delete impl;
+}
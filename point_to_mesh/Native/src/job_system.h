@@ -0,0 +1,70 @@
+/**
+ * @file job_system.h
+ * @brief Internal Job Type and Background Job Threads
+ */
+
+#ifndef SMR_JOB_SYSTEM_H
+#define SMR_JOB_SYSTEM_H
+
+#include "smr_welding_api.h"
+#include "job_control.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// =============================================================================
+// Internal Job Class
+// =============================================================================
+
+/**
+ * One asynchronous operation. The work function runs on a job thread with
+ * `control` as the thread's current job, so every checkpoint and
+ * parallel_for inside it sees the job's cancellation flag.
+ */
+class JobImpl {
+public:
+    typedef std::function<SMRErrorCode(JobImpl&)> Work;
+
+    JobControl control;
+    std::atomic<int> state{SMR_JOB_PENDING};    // SMRJobState
+    SMRErrorCode result = SMR_SUCCESS;          // Valid once finished
+
+    Work work;
+    SMRJobCallback callback = nullptr;
+    void* user_data = nullptr;
+
+    MeshHandle mesh = nullptr;                  // Created by reconstruction jobs
+
+    JobImpl(Work work, SMRJobCallback callback, void* user_data)
+        : work(std::move(work)), callback(callback), user_data(user_data) {}
+    ~JobImpl();
+
+    /// Run on a job thread: work, final state, then the callback
+    void run();
+
+    /// Wake waiters after run(); the owner may destroy the job from then on.
+    /// Deletes the job itself if the callback asked for that (defer_destroy).
+    void finish();
+
+    /// Wait until finish() (timeout_ms < 0 = no limit). Returns at once when
+    /// called from the callback itself.
+    bool wait(int timeout_ms);
+
+    /// Called by smr_job_destroy: true if the caller is this job's callback,
+    /// in which case finish() deletes the job
+    bool defer_destroy();
+
+private:
+    std::mutex mutex;
+    std::condition_variable finished_cv;
+    bool finished = false;
+    std::thread::id callback_thread;    // Set while the callback runs
+    bool destroy_deferred = false;
+};
+
+/// Queue a job on the job threads (started on first use)
+void job_submit(JobImpl* job);
+
+#endif // SMR_JOB_SYSTEM_H
@@ -0,0 +1,43 @@
+/**
+ * @file memory_tracker.cpp
+ * @brief Process-Wide Memory Counters
+ */
+
+#include "smr_welding_api.h"
+#include "memory_tracker.h"
+#include <atomic>
+
+static std::atomic<int64_t> g_memory_live{0};
+static std::atomic<int64_t> g_memory_peak{0};
+static std::atomic<int64_t> g_memory_allocations{0};
+
+void memory_charge(size_t bytes) {
+    int64_t live = g_memory_live.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+                   static_cast<int64_t>(bytes);
+    g_memory_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    int64_t peak = g_memory_peak.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !g_memory_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void memory_release(size_t bytes) {
+    g_memory_live.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+SMR_API SMRErrorCode smr_memory_get_stats(MemoryStats* out_stats) {
+    if (!out_stats) return SMR_ERROR_INVALID_PARAMETER;
+    out_stats->live_bytes = g_memory_live.load(std::memory_order_relaxed);
+    out_stats->peak_bytes = g_memory_peak.load(std::memory_order_relaxed);
+    out_stats->allocations = g_memory_allocations.load(std::memory_order_relaxed);
+    return SMR_SUCCESS;
+}
+
+SMR_API void smr_memory_reset_peak(void) {
+    g_memory_peak.store(g_memory_live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file memory_tracker.h
+ * @brief Tracked allocations for large buffers (smr_memory_* API)
+ */
+
+#ifndef SMR_MEMORY_TRACKER_H
+#define SMR_MEMORY_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+/// Count `bytes` as allocated (raises the peak if needed)
+void memory_charge(size_t bytes);
+
+/// Count `bytes` as freed
+void memory_release(size_t bytes);
+
+/**
+ * std::allocator that reports to the process-wide counters. Stateless, so
+ * tracked containers swap and move like plain ones; use it for buffers that
+ * grow with the input (point clouds, meshes, paths, grids), not for small
+ * scratch vectors in hot loops.
+ */
+template <class T>
+class TrackedAllocator {
+public:
+    using value_type = T;
+
+    TrackedAllocator() noexcept = default;
+    template <class U>
+    TrackedAllocator(const TrackedAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        memory_charge(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        memory_release(n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+};
+
+template <class T, class U>
+bool operator==(const TrackedAllocator<T>&, const TrackedAllocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const TrackedAllocator<T>&, const TrackedAllocator<U>&) noexcept { return false; }
+
+template <class T>
+using TrackedVector = std::vector<T, TrackedAllocator<T>>;
+
+/// TrackedAllocator with storage aligned to `Align` bytes, for SIMD arrays
+template <class T, size_t Align>
+class AlignedTrackedAllocator {
+public:
+    using value_type = T;
+    template <class U>
+    struct rebind { typedef AlignedTrackedAllocator<U, Align> other; };
+
+    AlignedTrackedAllocator() noexcept = default;
+    template <class U>
+    AlignedTrackedAllocator(const AlignedTrackedAllocator<U, Align>&) noexcept {}
+
+    T* allocate(size_t n) {
+        T* p = static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+        memory_charge(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        memory_release(n * sizeof(T));
+        ::operator delete(p, std::align_val_t(Align));
+    }
+};
+
+template <class T, class U, size_t Align>
+bool operator==(const AlignedTrackedAllocator<T, Align>&, const AlignedTrackedAllocator<U, Align>&) noexcept {
+    return true;
+}
+
+template <class T, class U, size_t Align>
+bool operator!=(const AlignedTrackedAllocator<T, Align>&, const AlignedTrackedAllocator<U, Align>&) noexcept {
+    return false;
+}
+
+/// Bytes reserved by a vector (capacity, not size)
+template <class T, class A>
+size_t vector_bytes(const std::vector<T, A>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+#endif // SMR_MEMORY_TRACKER_H
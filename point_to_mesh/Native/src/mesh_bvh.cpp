@@ -0,0 +1,692 @@
+/**
+ * @file mesh_bvh.cpp
+ * @brief Mesh BVH Build and Spatial Queries
+ */
+
+#include "mesh_bvh.h"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+static const int SAH_BINS = 16;
+static const float BOX_EMPTY = 1e30f;
+
+// Skewed inputs (geometric spacing, one huge outlier) make SAH peel off a few
+// triangles per level, so below SAH_MAX_DEPTH the build splits at the centroid
+// median instead. Median nodes cut a range to a quarter, so 2^31 triangles
+// need at most 16 more levels.
+static const int SAH_MAX_DEPTH = 24;
+static const int BVH_MAX_DEPTH = SAH_MAX_DEPTH + 16;
+
+// Depth-first traversal keeps at most three siblings pending per level
+static const int TRAVERSAL_STACK = 128;
+static_assert(TRAVERSAL_STACK >= BVH_MAX_DEPTH * (BVH_NODE_WIDTH - 1) + 1,
+              "traversal stack smaller than the deepest tree the build emits");
+
+// =============================================================================
+// Build
+// =============================================================================
+
+/// Triangle bounds and centroid, partitioned in place during the build
+struct BVHBuildRef {
+    float bmin[3];
+    float bmax[3];
+    float centroid[3];
+    int triangle;
+};
+
+struct SAHBin {
+    int count;
+    float bmin[3];
+    float bmax[3];
+};
+
+struct BVHBuildContext {
+    const float* vertices;
+    const int* triangles;
+    std::vector<BVHBuildRef> refs;
+    MeshBVH* bvh;
+};
+
+static const float* triangle_vertex(const BVHBuildContext& ctx, int tri, int corner) {
+    return ctx.vertices + ctx.triangles[tri * 3 + corner] * 3;
+}
+
+static float half_area(const float* bmin, const float* bmax) {
+    float dx = bmax[0] - bmin[0], dy = bmax[1] - bmin[1], dz = bmax[2] - bmin[2];
+    return dx * dy + dy * dz + dz * dx;
+}
+
+static void range_bounds(const BVHBuildContext& ctx, int begin, int end,
+                         float* bmin, float* bmax) {
+    for (int k = 0; k < 3; ++k) {
+        bmin[k] = BOX_EMPTY;
+        bmax[k] = -BOX_EMPTY;
+    }
+    for (int i = begin; i < end; ++i) {
+        const BVHBuildRef& ref = ctx.refs[i];
+        for (int k = 0; k < 3; ++k) {
+            bmin[k] = std::min(bmin[k], ref.bmin[k]);
+            bmax[k] = std::max(bmax[k], ref.bmax[k]);
+        }
+    }
+}
+
+static void make_packet(const BVHBuildContext& ctx, int begin, int end, TrianglePacket& packet) {
+    for (int lane = 0; lane < BVH_PACKET_WIDTH; ++lane) {
+        int tri = ctx.refs[begin + std::min(lane, end - begin - 1)].triangle;
+        const float* a = triangle_vertex(ctx, tri, 0);
+        const float* b = triangle_vertex(ctx, tri, 1);
+        const float* c = triangle_vertex(ctx, tri, 2);
+        for (int k = 0; k < 3; ++k) {
+            packet.v0[k][lane] = a[k];
+            packet.e1[k][lane] = b[k] - a[k];
+            packet.e2[k][lane] = c[k] - a[k];
+        }
+        packet.triangle[lane] = tri;
+    }
+}
+
+static void centroid_bounds(const BVHBuildContext& ctx, int begin, int end,
+                            float* cmin, float* cmax) {
+    for (int k = 0; k < 3; ++k) {
+        cmin[k] = BOX_EMPTY;
+        cmax[k] = -BOX_EMPTY;
+    }
+    for (int i = begin; i < end; ++i) {
+        const float* c = ctx.refs[i].centroid;
+        for (int k = 0; k < 3; ++k) {
+            cmin[k] = std::min(cmin[k], c[k]);
+            cmax[k] = std::max(cmax[k], c[k]);
+        }
+    }
+}
+
+// Split [begin, end) in half at the centroid median of its widest axis
+static int median_split(BVHBuildContext& ctx, int begin, int end,
+                        const float* cmin, const float* cmax) {
+    int axis = 0;
+    for (int k = 1; k < 3; ++k) {
+        if (cmax[k] - cmin[k] > cmax[axis] - cmin[axis]) axis = k;
+    }
+    int mid = (begin + end) / 2;
+    std::nth_element(ctx.refs.begin() + begin, ctx.refs.begin() + mid, ctx.refs.begin() + end,
+                     [axis](const BVHBuildRef& a, const BVHBuildRef& b) {
+                         return a.centroid[axis] < b.centroid[axis];
+                     });
+    return mid;
+}
+
+// Split [begin, end) at the cheapest of SAH_BINS - 1 planes per axis;
+// falls back to a centroid median when binning cannot separate the range
+static int sah_split(BVHBuildContext& ctx, int begin, int end) {
+    float cmin[3], cmax[3];
+    centroid_bounds(ctx, begin, end, cmin, cmax);
+
+    // Bin all three axes in one pass over the range
+    SAHBin bins[3][SAH_BINS];
+    float scale[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        float extent = cmax[axis] - cmin[axis];
+        scale[axis] = extent > 1e-12f ? SAH_BINS / extent : 0.0f;
+        for (int b = 0; b < SAH_BINS; ++b) {
+            bins[axis][b].count = 0;
+            for (int k = 0; k < 3; ++k) {
+                bins[axis][b].bmin[k] = BOX_EMPTY;
+                bins[axis][b].bmax[k] = -BOX_EMPTY;
+            }
+        }
+    }
+    for (int i = begin; i < end; ++i) {
+        const BVHBuildRef& ref = ctx.refs[i];
+        for (int axis = 0; axis < 3; ++axis) {
+            int b = std::min(SAH_BINS - 1, static_cast<int>((ref.centroid[axis] - cmin[axis]) * scale[axis]));
+            SAHBin& bin = bins[axis][b];
+            ++bin.count;
+            for (int k = 0; k < 3; ++k) {
+                bin.bmin[k] = std::min(bin.bmin[k], ref.bmin[k]);
+                bin.bmax[k] = std::max(bin.bmax[k], ref.bmax[k]);
+            }
+        }
+    }
+
+    float best_cost = BOX_EMPTY;
+    int best_axis = -1, best_bin = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (scale[axis] == 0.0f) continue;
+        const SAHBin* bin = bins[axis];
+
+        // Right-to-left sweep stores the right side cost of each plane
+        float right_area[SAH_BINS];
+        int right_count[SAH_BINS];
+        float rmin[3] = {BOX_EMPTY, BOX_EMPTY, BOX_EMPTY};
+        float rmax[3] = {-BOX_EMPTY, -BOX_EMPTY, -BOX_EMPTY};
+        int rn = 0;
+        for (int b = SAH_BINS - 1; b > 0; --b) {
+            rn += bin[b].count;
+            for (int k = 0; k < 3; ++k) {
+                rmin[k] = std::min(rmin[k], bin[b].bmin[k]);
+                rmax[k] = std::max(rmax[k], bin[b].bmax[k]);
+            }
+            right_count[b] = rn;
+            right_area[b] = rn > 0 ? half_area(rmin, rmax) : 0.0f;
+        }
+
+        float lmin[3] = {BOX_EMPTY, BOX_EMPTY, BOX_EMPTY};
+        float lmax[3] = {-BOX_EMPTY, -BOX_EMPTY, -BOX_EMPTY};
+        int ln = 0;
+        for (int b = 0; b < SAH_BINS - 1; ++b) {
+            ln += bin[b].count;
+            for (int k = 0; k < 3; ++k) {
+                lmin[k] = std::min(lmin[k], bin[b].bmin[k]);
+                lmax[k] = std::max(lmax[k], bin[b].bmax[k]);
+            }
+            if (ln == 0 || right_count[b + 1] == 0) continue;
+            float cost = half_area(lmin, lmax) * ln + right_area[b + 1] * right_count[b + 1];
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_axis = axis;
+                best_bin = b;
+            }
+        }
+    }
+
+    if (best_axis >= 0) {
+        float lo = cmin[best_axis], axis_scale = scale[best_axis];
+        int axis = best_axis, bin = best_bin;
+        auto split = std::partition(ctx.refs.begin() + begin, ctx.refs.begin() + end,
+                                    [=](const BVHBuildRef& ref) {
+            return std::min(SAH_BINS - 1, static_cast<int>((ref.centroid[axis] - lo) * axis_scale)) <= bin;
+        });
+        int mid = static_cast<int>(split - ctx.refs.begin());
+        if (mid > begin && mid < end) return mid;
+    }
+    return median_split(ctx, begin, end, cmin, cmax);
+}
+
+// `depth` counts nodes from the root (1); recursion never exceeds BVH_MAX_DEPTH
+static int build_node(BVHBuildContext& ctx, int begin, int end, int depth) {
+    int index = static_cast<int>(ctx.bvh->nodes.size());
+    ctx.bvh->nodes.emplace_back();
+    ctx.bvh->depth = std::max(ctx.bvh->depth, depth);
+
+    // Split the most populated child until there are four (two levels of
+    // binary SAH splits collapsed into one node)
+    int ranges[BVH_NODE_WIDTH][2] = {{begin, end}};
+    int num_ranges = 1;
+    while (num_ranges < BVH_NODE_WIDTH) {
+        int largest = -1;
+        for (int r = 0; r < num_ranges; ++r) {
+            int n = ranges[r][1] - ranges[r][0];
+            if (n > BVH_PACKET_WIDTH &&
+                (largest < 0 || n > ranges[largest][1] - ranges[largest][0])) {
+                largest = r;
+            }
+        }
+        if (largest < 0) break;
+
+        int b = ranges[largest][0], e = ranges[largest][1];
+        int mid;
+        if (depth < SAH_MAX_DEPTH) {
+            mid = sah_split(ctx, b, e);
+        } else {
+            float cmin[3], cmax[3];
+            centroid_bounds(ctx, b, e, cmin, cmax);
+            mid = median_split(ctx, b, e, cmin, cmax);
+        }
+        ranges[largest][1] = mid;
+        ranges[num_ranges][0] = mid;
+        ranges[num_ranges][1] = e;
+        ++num_ranges;
+    }
+
+    BVH4Node node;
+    for (int slot = 0; slot < BVH_NODE_WIDTH; ++slot) {
+        if (slot >= num_ranges) {
+            for (int k = 0; k < 3; ++k) {
+                node.bmin[k][slot] = BOX_EMPTY;
+                node.bmax[k][slot] = -BOX_EMPTY;
+            }
+            node.child[slot] = 0;
+            node.count[slot] = -1;
+            continue;
+        }
+
+        int b = ranges[slot][0], e = ranges[slot][1];
+        float bmin[3], bmax[3];
+        range_bounds(ctx, b, e, bmin, bmax);
+        for (int k = 0; k < 3; ++k) {
+            node.bmin[k][slot] = bmin[k];
+            node.bmax[k][slot] = bmax[k];
+        }
+
+        if (e - b <= BVH_PACKET_WIDTH) {
+            node.child[slot] = static_cast<int>(ctx.bvh->packets.size());
+            node.count[slot] = e - b;
+            ctx.bvh->packets.emplace_back();
+            make_packet(ctx, b, e, ctx.bvh->packets.back());
+        } else {
+            node.child[slot] = build_node(ctx, b, e, depth + 1);
+            node.count[slot] = 0;
+        }
+    }
+
+    ctx.bvh->nodes[index] = node;
+    return index;
+}
+
+void MeshBVH::build(const float* vertices, const int* triangles, int triangle_count) {
+    nodes.clear();
+    packets.clear();
+    depth = 0;
+    if (!vertices || !triangles || triangle_count <= 0) return;
+
+    BVHBuildContext ctx;
+    ctx.vertices = vertices;
+    ctx.triangles = triangles;
+    ctx.bvh = this;
+    ctx.refs.resize(triangle_count);
+    for (int t = 0; t < triangle_count; ++t) {
+        BVHBuildRef& ref = ctx.refs[t];
+        const float* a = triangle_vertex(ctx, t, 0);
+        const float* b = triangle_vertex(ctx, t, 1);
+        const float* c = triangle_vertex(ctx, t, 2);
+        for (int k = 0; k < 3; ++k) {
+            ref.bmin[k] = std::min(a[k], std::min(b[k], c[k]));
+            ref.bmax[k] = std::max(a[k], std::max(b[k], c[k]));
+            ref.centroid[k] = (a[k] + b[k] + c[k]) / 3.0f;
+        }
+        ref.triangle = t;
+    }
+
+    int leaves = triangle_count / BVH_PACKET_WIDTH + 1;
+    packets.reserve(leaves * 2);
+    nodes.reserve(leaves / 2 + 1);
+    build_node(ctx, 0, triangle_count, 1);
+}
+
+// =============================================================================
+// Triangle Kernels (8 lanes)
+// =============================================================================
+
+// Squared distance from segment p0 + s*d to each lane's triangle: the minimum
+// of the segment against the three edges, the endpoints against the face, and
+// zero when the segment pierces the face. d = 0 gives point distances.
+static void packet_segment_dist2(const TrianglePacket& pk, const float* p0,
+                                 const float* d, float* dist2) {
+    const float eps = 1e-20f;
+    const float a = d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
+
+    for (int l = 0; l < BVH_PACKET_WIDTH; ++l) {
+        float e1x = pk.e1[0][l], e1y = pk.e1[1][l], e1z = pk.e1[2][l];
+        float e2x = pk.e2[0][l], e2y = pk.e2[1][l], e2z = pk.e2[2][l];
+        float wx = p0[0] - pk.v0[0][l], wy = p0[1] - pk.v0[1][l], wz = p0[2] - pk.v0[2][l];
+
+        // Face normal and barycentric setup
+        float nx = e1y*e2z - e1z*e2y, ny = e1z*e2x - e1x*e2z, nz = e1x*e2y - e1y*e2x;
+        float nn = nx*nx + ny*ny + nz*nz;
+        float d00 = e1x*e1x + e1y*e1y + e1z*e1z;
+        float d01 = e1x*e2x + e1y*e2y + e1z*e2z;
+        float d11 = e2x*e2x + e2y*e2y + e2z*e2z;
+        float det = d00 * d11 - d01 * d01;
+        bool valid = det > eps && nn > eps;
+        float inv = 1.0f / std::max(det, eps);
+        float inv_nn = 1.0f / std::max(nn, eps);
+
+        // Endpoint p0 (w) and p1 (w + d) projected onto the face
+        float best = 1e30f;
+        float w0e1 = wx*e1x + wy*e1y + wz*e1z, w0e2 = wx*e2x + wy*e2y + wz*e2z;
+        float de1 = d[0]*e1x + d[1]*e1y + d[2]*e1z, de2 = d[0]*e2x + d[1]*e2y + d[2]*e2z;
+        float nw = nx*wx + ny*wy + nz*wz, nd = nx*d[0] + ny*d[1] + nz*d[2];
+        {
+            float v = (d11 * w0e1 - d01 * w0e2) * inv;
+            float w = (d00 * w0e2 - d01 * w0e1) * inv;
+            bool inside = valid && v >= 0.0f && w >= 0.0f && v + w <= 1.0f;
+            best = inside ? std::min(best, nw * nw * inv_nn) : best;
+        }
+        {
+            float w1e1 = w0e1 + de1, w1e2 = w0e2 + de2, nw1 = nw + nd;
+            float v = (d11 * w1e1 - d01 * w1e2) * inv;
+            float w = (d00 * w1e2 - d01 * w1e1) * inv;
+            bool inside = valid && v >= 0.0f && w >= 0.0f && v + w <= 1.0f;
+            best = inside ? std::min(best, nw1 * nw1 * inv_nn) : best;
+        }
+
+        // Segment piercing the face
+        {
+            bool crosses = std::abs(nd) > eps;
+            float t = -nw / (crosses ? nd : 1.0f);
+            float qe1 = w0e1 + t * de1, qe2 = w0e2 + t * de2;
+            float v = (d11 * qe1 - d01 * qe2) * inv;
+            float w = (d00 * qe2 - d01 * qe1) * inv;
+            bool hit = crosses && valid && t >= 0.0f && t <= 1.0f &&
+                       v >= 0.0f && w >= 0.0f && v + w <= 1.0f;
+            best = hit ? 0.0f : best;
+        }
+
+        // Edges v0-v1, v0-v2, v1-v2
+        best = std::min(best, segment_segment_dist2(wx, wy, wz, d[0], d[1], d[2], a, e1x, e1y, e1z));
+        best = std::min(best, segment_segment_dist2(wx, wy, wz, d[0], d[1], d[2], a, e2x, e2y, e2z));
+        best = std::min(best, segment_segment_dist2(wx - e1x, wy - e1y, wz - e1z, d[0], d[1], d[2], a,
+                                                    e2x - e1x, e2y - e1y, e2z - e1z));
+        dist2[l] = best;
+    }
+}
+
+// Two-sided Moller-Trumbore per lane; misses get t = BOX_EMPTY
+static void packet_ray_t(const TrianglePacket& pk, const float* o, const float* d, float* t_out) {
+    const float eps = 1e-12f;
+    for (int l = 0; l < BVH_PACKET_WIDTH; ++l) {
+        float e1x = pk.e1[0][l], e1y = pk.e1[1][l], e1z = pk.e1[2][l];
+        float e2x = pk.e2[0][l], e2y = pk.e2[1][l], e2z = pk.e2[2][l];
+
+        float px = d[1]*e2z - d[2]*e2y, py = d[2]*e2x - d[0]*e2z, pz = d[0]*e2y - d[1]*e2x;
+        float det = e1x*px + e1y*py + e1z*pz;
+        bool valid = std::abs(det) > eps;
+        float inv = 1.0f / (valid ? det : 1.0f);
+
+        float tx = o[0] - pk.v0[0][l], ty = o[1] - pk.v0[1][l], tz = o[2] - pk.v0[2][l];
+        float u = (tx*px + ty*py + tz*pz) * inv;
+        float qx = ty*e1z - tz*e1y, qy = tz*e1x - tx*e1z, qz = tx*e1y - ty*e1x;
+        float v = (d[0]*qx + d[1]*qy + d[2]*qz) * inv;
+        float t = (e2x*qx + e2y*qy + e2z*qz) * inv;
+
+        bool hit = valid && u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f;
+        t_out[l] = hit ? t : BOX_EMPTY;
+    }
+}
+
+// Closest point to p on triangle (a, a + ab, a + ac), by Voronoi region
+static void closest_on_triangle(const float* p, const float* a, const float* ab,
+                                const float* ac, float* out) {
+    float ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+    float bp[3] = {ap[0] - ab[0], ap[1] - ab[1], ap[2] - ab[2]};
+    float cp[3] = {ap[0] - ac[0], ap[1] - ac[1], ap[2] - ac[2]};
+    float d1 = ab[0]*ap[0] + ab[1]*ap[1] + ab[2]*ap[2];
+    float d2 = ac[0]*ap[0] + ac[1]*ap[1] + ac[2]*ap[2];
+    float d3 = ab[0]*bp[0] + ab[1]*bp[1] + ab[2]*bp[2];
+    float d4 = ac[0]*bp[0] + ac[1]*bp[1] + ac[2]*bp[2];
+    float d5 = ab[0]*cp[0] + ab[1]*cp[1] + ab[2]*cp[2];
+    float d6 = ac[0]*cp[0] + ac[1]*cp[1] + ac[2]*cp[2];
+    float vc = d1 * d4 - d3 * d2;
+    float vb = d5 * d2 - d1 * d6;
+    float va = d3 * d6 - d5 * d4;
+
+    float s = 0.0f, t = 0.0f;
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        // Vertex a
+    } else if (d3 >= 0.0f && d4 <= d3) {
+        s = 1.0f;
+    } else if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        s = d1 / (d1 - d3);
+    } else if (d6 >= 0.0f && d5 <= d6) {
+        t = 1.0f;
+    } else if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        t = d2 / (d2 - d6);
+    } else if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        s = 1.0f - t;
+    } else if (va + vb + vc > 0.0f) {
+        float denom = 1.0f / (va + vb + vc);
+        s = vb * denom;
+        t = vc * denom;
+    }
+
+    for (int k = 0; k < 3; ++k) out[k] = a[k] + s * ab[k] + t * ac[k];
+}
+
+static void fill_hit(const TrianglePacket& pk, int lane, const float* point, float distance,
+                     MeshHit& hit) {
+    float e1[3] = {pk.e1[0][lane], pk.e1[1][lane], pk.e1[2][lane]};
+    float e2[3] = {pk.e2[0][lane], pk.e2[1][lane], pk.e2[2][lane]};
+    float n[3] = {
+        e1[1]*e2[2] - e1[2]*e2[1],
+        e1[2]*e2[0] - e1[0]*e2[2],
+        e1[0]*e2[1] - e1[1]*e2[0]
+    };
+    float len = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+    if (len > 0.0f) {
+        n[0] /= len; n[1] /= len; n[2] /= len;
+    }
+
+    hit.triangle = pk.triangle[lane];
+    hit.distance = distance;
+    for (int k = 0; k < 3; ++k) {
+        hit.point[k] = point[k];
+        hit.normal[k] = n[k];
+    }
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+// Bit c set when child c's box overlaps [qmin, qmax]. Empty slots are masked
+// by count: a query box reaching +-BOX_EMPTY would overlap their inverted box.
+static int overlap_mask(const BVH4Node& node, const float* qmin, const float* qmax) {
+    int mask = 0;
+    for (int c = 0; c < BVH_NODE_WIDTH; ++c) {
+        bool overlap = node.count[c] >= 0 &&
+                       node.bmin[0][c] <= qmax[0] && node.bmax[0][c] >= qmin[0] &&
+                       node.bmin[1][c] <= qmax[1] && node.bmax[1][c] >= qmin[1] &&
+                       node.bmin[2][c] <= qmax[2] && node.bmax[2][c] >= qmin[2];
+        mask |= overlap ? (1 << c) : 0;
+    }
+    return mask;
+}
+
+// Insert child c into `order` so that smaller keys come last (popped first)
+static void push_sorted(int* order, int& n, const float* key, int c) {
+    int i = n++;
+    while (i > 0 && key[order[i - 1]] < key[c]) {
+        order[i] = order[i - 1];
+        --i;
+    }
+    order[i] = c;
+}
+
+bool MeshBVH::overlaps_capsule(const float* p0, const float* p1, float radius) const {
+    if (packets.empty()) return false;
+
+    float qmin[3], qmax[3], d[3];
+    for (int k = 0; k < 3; ++k) {
+        qmin[k] = std::min(p0[k], p1[k]) - radius;
+        qmax[k] = std::max(p0[k], p1[k]) + radius;
+        d[k] = p1[k] - p0[k];
+    }
+    const float r2 = radius * radius;
+
+    int stack[TRAVERSAL_STACK];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const BVH4Node& node = nodes[stack[--top]];
+        int mask = overlap_mask(node, qmin, qmax);
+
+        for (int c = 0; c < BVH_NODE_WIDTH; ++c) {
+            if (!(mask & (1 << c))) continue;
+            if (node.count[c] > 0) {
+                float dist2[BVH_PACKET_WIDTH];
+                packet_segment_dist2(packets[node.child[c]], p0, d, dist2);
+                bool hit = false;
+                for (int l = 0; l < BVH_PACKET_WIDTH; ++l) hit |= dist2[l] <= r2;
+                if (hit) return true;
+            } else {
+                stack[top++] = node.child[c];
+            }
+        }
+    }
+    return false;
+}
+
+void MeshBVH::sphere_overlap(const float* center, float radius,
+                             std::vector<int>& out_triangles) const {
+    if (packets.empty()) return;
+
+    const float zero[3] = {0.0f, 0.0f, 0.0f};
+    float qmin[3], qmax[3];
+    for (int k = 0; k < 3; ++k) {
+        qmin[k] = center[k] - radius;
+        qmax[k] = center[k] + radius;
+    }
+    const float r2 = radius * radius;
+
+    int stack[TRAVERSAL_STACK];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const BVH4Node& node = nodes[stack[--top]];
+        int mask = overlap_mask(node, qmin, qmax);
+
+        for (int c = 0; c < BVH_NODE_WIDTH; ++c) {
+            if (!(mask & (1 << c))) continue;
+            if (node.count[c] > 0) {
+                const TrianglePacket& pk = packets[node.child[c]];
+                float dist2[BVH_PACKET_WIDTH];
+                packet_segment_dist2(pk, center, zero, dist2);
+                for (int l = 0; l < node.count[c]; ++l) {
+                    if (dist2[l] <= r2) out_triangles.push_back(pk.triangle[l]);
+                }
+            } else {
+                stack[top++] = node.child[c];
+            }
+        }
+    }
+}
+
+bool MeshBVH::raycast(const float* origin, const float* direction, float max_distance,
+                      MeshHit& hit) const {
+    hit.triangle = -1;
+    hit.distance = max_distance;
+    if (packets.empty()) return false;
+
+    float len = std::sqrt(direction[0]*direction[0] + direction[1]*direction[1] +
+                          direction[2]*direction[2]);
+    if (!(len > 0.0f)) return false;
+    float d[3], inv[3];
+    for (int k = 0; k < 3; ++k) {
+        d[k] = direction[k] / len;
+        // Finite stand-in for 1/0 keeps the slab test free of NaN
+        float dk = std::abs(d[k]) > 1e-20f ? d[k] : (d[k] < 0.0f ? -1e-20f : 1e-20f);
+        inv[k] = 1.0f / dk;
+    }
+
+    float best_t = max_distance;
+    int best_packet = -1, best_lane = 0;
+
+    int stack[TRAVERSAL_STACK];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const BVH4Node& node = nodes[stack[--top]];
+
+        // Slab test on all four children (empty slots are skipped below:
+        // the 1/0 stand-in can turn their inverted boxes into infinite slabs)
+        float tnear[BVH_NODE_WIDTH];
+        for (int c = 0; c < BVH_NODE_WIDTH; ++c) {
+            float lo = 0.0f, hi = best_t;
+            for (int k = 0; k < 3; ++k) {
+                float t1 = (node.bmin[k][c] - origin[k]) * inv[k];
+                float t2 = (node.bmax[k][c] - origin[k]) * inv[k];
+                lo = std::max(lo, std::min(t1, t2));
+                hi = std::min(hi, std::max(t1, t2));
+            }
+            tnear[c] = lo <= hi ? lo : BOX_EMPTY;
+        }
+
+        int order[BVH_NODE_WIDTH];
+        int n = 0;
+        for (int c = 0; c < BVH_NODE_WIDTH; ++c) {
+            if (node.count[c] >= 0 && tnear[c] < best_t) push_sorted(order, n, tnear, c);
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int c = order[i];
+            if (node.count[c] > 0) {
+                float t[BVH_PACKET_WIDTH];
+                packet_ray_t(packets[node.child[c]], origin, d, t);
+                for (int l = 0; l < node.count[c]; ++l) {
+                    if (t[l] < best_t) {
+                        best_t = t[l];
+                        best_packet = node.child[c];
+                        best_lane = l;
+                    }
+                }
+            } else {
+                stack[top++] = node.child[c];
+            }
+        }
+    }
+
+    if (best_packet < 0) return false;
+    float point[3] = {
+        origin[0] + best_t * d[0],
+        origin[1] + best_t * d[1],
+        origin[2] + best_t * d[2]
+    };
+    fill_hit(packets[best_packet], best_lane, point, best_t, hit);
+    return true;
+}
+
+bool MeshBVH::closest_point(const float* point, float max_distance, MeshHit& hit) const {
+    hit.triangle = -1;
+    hit.distance = max_distance;
+    if (packets.empty()) return false;
+
+    float best_d2 = max_distance * max_distance;
+    float best_point[3] = {0.0f, 0.0f, 0.0f};
+    int best_packet = -1, best_lane = 0;
+
+    int stack[TRAVERSAL_STACK];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const BVH4Node& node = nodes[stack[--top]];
+
+        float box_d2[BVH_NODE_WIDTH];
+        for (int c = 0; c < BVH_NODE_WIDTH; ++c) {
+            float d2 = 0.0f;
+            for (int k = 0; k < 3; ++k) {
+                float e = std::max(0.0f, std::max(node.bmin[k][c] - point[k],
+                                                  point[k] - node.bmax[k][c]));
+                d2 += e * e;
+            }
+            box_d2[c] = d2;
+        }
+
+        // Nearer boxes first tighten best_d2 sooner
+        int order[BVH_NODE_WIDTH];
+        int n = 0;
+        for (int c = 0; c < BVH_NODE_WIDTH; ++c) {
+            if (node.count[c] >= 0 && box_d2[c] <= best_d2) push_sorted(order, n, box_d2, c);
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int c = order[i];
+            if (node.count[c] > 0) {
+                const TrianglePacket& pk = packets[node.child[c]];
+                for (int l = 0; l < node.count[c]; ++l) {
+                    float a[3] = {pk.v0[0][l], pk.v0[1][l], pk.v0[2][l]};
+                    float ab[3] = {pk.e1[0][l], pk.e1[1][l], pk.e1[2][l]};
+                    float ac[3] = {pk.e2[0][l], pk.e2[1][l], pk.e2[2][l]};
+                    float q[3];
+                    closest_on_triangle(point, a, ab, ac, q);
+                    float dx = q[0] - point[0], dy = q[1] - point[1], dz = q[2] - point[2];
+                    float d2 = dx*dx + dy*dy + dz*dz;
+                    if (d2 <= best_d2) {
+                        best_d2 = d2;
+                        best_packet = node.child[c];
+                        best_lane = l;
+                        std::memcpy(best_point, q, sizeof(q));
+                    }
+                }
+            } else {
+                stack[top++] = node.child[c];
+            }
+        }
+    }
+
+    if (best_packet < 0) return false;
+    fill_hit(packets[best_packet], best_lane, best_point, std::sqrt(best_d2), hit);
+    return true;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file mesh_bvh.h
+ * @brief Bounding volume hierarchy over mesh triangles
+ */
+
+#ifndef SMR_MESH_BVH_H
+#define SMR_MESH_BVH_H
+
+#include "smr_welding_api.h"
+#include "memory_tracker.h"
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+static const int BVH_PACKET_WIDTH = 8;
+static const int BVH_NODE_WIDTH = 4;
+
+/// Four child boxes in SoA layout (128 bytes, two cache lines).
+/// count > 0: leaf packet `child` holding `count` triangles;
+/// count == 0: inner node `child`; count < 0: empty slot (inverted box).
+struct BVH4Node {
+    alignas(32) float bmin[3][BVH_NODE_WIDTH];
+    float bmax[3][BVH_NODE_WIDTH];
+    int child[BVH_NODE_WIDTH];
+    int count[BVH_NODE_WIDTH];
+};
+
+/// Up to 8 triangles of one leaf in SoA layout (vertex 0 and two edges).
+/// Unused lanes repeat lane 0, so lane-wise tests need no masking.
+struct TrianglePacket {
+    alignas(32) float v0[3][BVH_PACKET_WIDTH];
+    alignas(32) float e1[3][BVH_PACKET_WIDTH];
+    alignas(32) float e2[3][BVH_PACKET_WIDTH];
+    int triangle[BVH_PACKET_WIDTH];   // Source triangle index per lane
+};
+
+static inline float clamp01(float x) {
+    return std::min(1.0f, std::max(0.0f, x));
+}
+
+/// Squared distance between segments p0 + s*d (s in [0,1], a = |d|^2) and
+/// q0 + t*e (t in [0,1]); r = p0 - q0. Branch-free so lane loops vectorize.
+static inline float segment_segment_dist2(float rx, float ry, float rz,
+                                          float dx, float dy, float dz, float a,
+                                          float ex, float ey, float ez) {
+    const float eps = 1e-20f;
+    float ee = ex*ex + ey*ey + ez*ez;
+    float b = dx*ex + dy*ey + dz*ez;
+    float c = dx*rx + dy*ry + dz*rz;
+    float f = ex*rx + ey*ry + ez*rz;
+    float denom = a * ee - b * b;
+
+    float s = denom > eps ? clamp01((b * f - c * ee) / std::max(denom, eps)) : 0.0f;
+    float t = ee > eps ? (b * s + f) / std::max(ee, eps) : 0.0f;
+    float tc = clamp01(t);
+    s = (t != tc && a > eps) ? clamp01((b * tc - c) / std::max(a, eps)) : s;
+
+    float x = rx + dx * s - ex * tc;
+    float y = ry + dy * s - ey * tc;
+    float z = rz + dz * s - ez * tc;
+    return x*x + y*y + z*z;
+}
+
+class MeshBVH {
+public:
+    TrackedVector<BVH4Node> nodes;          // nodes[0] is the root
+    TrackedVector<TrianglePacket> packets;
+    int depth = 0;                          // Nodes on the longest root-leaf path
+
+    bool empty() const { return packets.empty(); }
+
+    size_t memory_bytes() const { return vector_bytes(nodes) + vector_bytes(packets); }
+
+    /**
+     * Binned SAH build. Each node splits its largest child until it has four,
+     * leaves hold one packet (at most 8 triangles). Deep subtrees switch to
+     * median splits, so the depth stays within the traversal stack.
+     */
+    void build(const float* vertices, const int* triangles, int triangle_count);
+
+    /// True if any triangle is within `radius` of segment p0-p1
+    bool overlaps_capsule(const float* p0, const float* p1, float radius) const;
+
+    /// Nearest hit along `direction` (normalized internally) within max_distance.
+    /// Triangles are two-sided. Returns false (hit.triangle = -1) on a miss.
+    bool raycast(const float* origin, const float* direction, float max_distance,
+                 MeshHit& hit) const;
+
+    /// Closest surface point within max_distance. Returns false if none.
+    bool closest_point(const float* point, float max_distance, MeshHit& hit) const;
+
+    /// Append the indices of all triangles within `radius` of `center`
+    void sphere_overlap(const float* center, float radius, std::vector<int>& out_triangles) const;
+};
+
+#endif // SMR_MESH_BVH_H
@@ -3,47 +3,21 @@
  * @brief Mesh Generation Implementation (Poisson Surface Reconstruction)
  */
 
-#include "smr_welding_api.h"
+#include "mesh_generator.h"
+#include "mesh_bvh.h"
+#include "point_cloud.h"
+#include "parallel.h"
+#include "job_control.h"
+#include "point_kernels.h"
+#include "stats.h"
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <new>
 #include <cstring>
 
-// Forward declaration from point_cloud.cpp
-class PointCloudImpl;
-
-// =============================================================================
-// Internal Mesh Class
-// =============================================================================
-
-class MeshImpl {
-public:
-    std::vector<float> vertices;   // XYZ * vertex_count
-    std::vector<float> normals;    // XYZ * vertex_count
-    std::vector<int> triangles;    // 3 indices * triangle_count
-    std::vector<float> densities;  // Density per vertex (for low-density removal)
-
-    int vertex_count() const { return static_cast<int>(vertices.size() / 3); }
-    int triangle_count() const { return static_cast<int>(triangles.size() / 3); }
-
-    void clear() {
-        vertices.clear();
-        normals.clear();
-        triangles.clear();
-        densities.clear();
-    }
-
-    // Simplified Poisson reconstruction (Marching Cubes approximation)
-    bool create_from_pointcloud(const float* points, const float* point_normals, 
-                                 int count, const PoissonSettings& settings);
-    
-    void remove_low_density(float quantile);
-    void simplify(float target_ratio);
-    bool save_ply(const char* filepath);
-    bool save_obj(const char* filepath);
-};
-
 // =============================================================================
 // Marching Cubes Tables (simplified)
 // =============================================================================
@@ -67,152 +41,435 @@ static const int MC_TRI_TABLE[256][16] = {
 // Simplified Poisson Reconstruction
 // =============================================================================
 
-bool MeshImpl::create_from_pointcloud(const float* points, const float* point_normals,
-                                       int count, const PoissonSettings& settings) {
-    if (!points || !point_normals || count <= 0) return false;
-    
-    clear();
-    
+// Points splatted (and triangles decimated) between progress/cancel checks
+static const size_t SPLAT_BLOCK = 1 << 16;
+static const int SIMPLIFY_BLOCK = 1 << 16;
+
+// Share of the reconstruction progress given to splatting; extraction
+// reports the rest
+static const float SPLAT_PROGRESS = 0.2f;
+
+/// Bounds and cell size of the reconstruction grid (resolution^3 cells)
+struct ReconstructionGrid {
+    float min[3];
+    float voxel[3];
+    int resolution;
+    size_t cells;
+};
+
+static bool reconstruction_grid(const PointBuffer& points, const PoissonSettings& settings,
+                                ReconstructionGrid& out) {
+    if (settings.depth < 1 || settings.depth > MAX_POISSON_DEPTH) return false;
+
     // Step 1: Compute bounding box
-    float min_x = points[0], max_x = points[0];
-    float min_y = points[1], max_y = points[1];
-    float min_z = points[2], max_z = points[2];
-    
-    for (int i = 0; i < count; ++i) {
-        float x = points[i*3], y = points[i*3+1], z = points[i*3+2];
-        min_x = std::min(min_x, x); max_x = std::max(max_x, x);
-        min_y = std::min(min_y, y); max_y = std::max(max_y, y);
-        min_z = std::min(min_z, z); max_z = std::max(max_z, z);
+    const float* axis[3] = {points.x(), points.y(), points.z()};
+    float lo[3], hi[3];
+    for (int k = 0; k < 3; ++k) {
+        const auto range = std::minmax_element(axis[k], axis[k] + points.size());
+        lo[k] = *range.first;
+        hi[k] = *range.second;
     }
-    
+
     // Expand bounding box by scale factor
-    float dx = (max_x - min_x) * (settings.scale - 1.0f) / 2.0f;
-    float dy = (max_y - min_y) * (settings.scale - 1.0f) / 2.0f;
-    float dz = (max_z - min_z) * (settings.scale - 1.0f) / 2.0f;
-    min_x -= dx; max_x += dx;
-    min_y -= dy; max_y += dy;
-    min_z -= dz; max_z += dz;
+    out.resolution = 1 << settings.depth; // 2^depth
+    out.cells = static_cast<size_t>(out.resolution) * out.resolution * out.resolution;
+    for (int k = 0; k < 3; ++k) {
+        float pad = (hi[k] - lo[k]) * (settings.scale - 1.0f) / 2.0f;
+        out.min[k] = lo[k] - pad;
+        out.voxel[k] = (hi[k] + pad - out.min[k]) / out.resolution;
+    }
+    return true;
+}
+
+bool MeshImpl::create_from_pointcloud(const PointBuffer& points, const PointBuffer& point_normals,
+                                      const PoissonSettings& settings) {
+    size_t count = points.size();
+    if (count == 0 || point_normals.size() != count) return false;
+    
+    clear();
     
     // Step 2: Create voxel grid
-    int resolution = 1 << settings.depth; // 2^depth
-    float voxel_size_x = (max_x - min_x) / resolution;
-    float voxel_size_y = (max_y - min_y) / resolution;
-    float voxel_size_z = (max_z - min_z) / resolution;
+    ReconstructionGrid cell;
+    if (!reconstruction_grid(points, settings, cell)) return false;
+    int resolution = cell.resolution;
+    size_t plane = static_cast<size_t>(resolution) * resolution;
+    float min_x = cell.min[0], min_y = cell.min[1], min_z = cell.min[2];
+    float voxel_size_x = cell.voxel[0];
+    float voxel_size_y = cell.voxel[1];
+    float voxel_size_z = cell.voxel[2];
     
     // Step 3: Compute indicator function (simplified: distance field)
     // In real Poisson, this would solve a Poisson equation
-    std::vector<float> grid(resolution * resolution * resolution, 0.0f);
-    std::vector<float> weights(resolution * resolution * resolution, 0.0f);
-    
-    // Splat points onto grid
-    for (int i = 0; i < count; ++i) {
-        float x = points[i*3], y = points[i*3+1], z = points[i*3+2];
-        float nx = point_normals[i*3], ny = point_normals[i*3+1], nz = point_normals[i*3+2];
-        
-        int ix = static_cast<int>((x - min_x) / voxel_size_x);
-        int iy = static_cast<int>((y - min_y) / voxel_size_y);
-        int iz = static_cast<int>((z - min_z) / voxel_size_z);
-        
-        ix = std::max(0, std::min(resolution - 1, ix));
-        iy = std::max(0, std::min(resolution - 1, iy));
-        iz = std::max(0, std::min(resolution - 1, iz));
-        
-        int idx = iz * resolution * resolution + iy * resolution + ix;
-        
-        // Simplified: use normal dot product as indicator
-        float indicator = nx + ny + nz; // Simplified indicator
-        grid[idx] += indicator;
-        weights[idx] += 1.0f;
-    }
+    TrackedVector<float> grid(cell.cells, 0.0f);
+    TrackedVector<float> weights(cell.cells, 0.0f);
+    
+    // Splat points onto grid, in point order so the sums are reproducible
+    {
+        SMR_STAT_SCOPE(STAT_MESH_SPLAT);
+        for (size_t block = 0; block < count; block += SPLAT_BLOCK) {
+            if (job_cancelled()) return false;
+            size_t block_end = std::min(count, block + SPLAT_BLOCK);
+            for (size_t i = block; i < block_end; ++i) {
+                float x = points.x()[i], y = points.y()[i], z = points.z()[i];
+                float nx = point_normals.x()[i], ny = point_normals.y()[i], nz = point_normals.z()[i];
+            
+                int ix = static_cast<int>((x - min_x) / voxel_size_x);
+                int iy = static_cast<int>((y - min_y) / voxel_size_y);
+                int iz = static_cast<int>((z - min_z) / voxel_size_z);
+            
+                ix = std::max(0, std::min(resolution - 1, ix));
+                iy = std::max(0, std::min(resolution - 1, iy));
+                iz = std::max(0, std::min(resolution - 1, iz));
+            
+                size_t idx = iz * plane + iy * resolution + ix;
+            
+                // Simplified: use normal dot product as indicator
+                float indicator = nx + ny + nz; // Simplified indicator
+                grid[idx] += indicator;
+                weights[idx] += 1.0f;
+            }
+            job_progress(SPLAT_PROGRESS * block_end / count);
+        }
     
-    // Normalize
-    for (size_t i = 0; i < grid.size(); ++i) {
-        if (weights[i] > 0) grid[i] /= weights[i];
+        // Normalize
+        parallel_for(0, grid.size(), plane, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                if (weights[i] > 0) grid[i] /= weights[i];
+            }
+        });
+        if (job_cancelled()) return false;
     }
     
     // Step 4: Marching Cubes to extract isosurface
+    SMR_STAT_SCOPE(STAT_MESH_EXTRACT);
     float iso_value = 0.0f;
     
-    for (int z = 0; z < resolution - 1; ++z) {
-        for (int y = 0; y < resolution - 1; ++y) {
-            for (int x = 0; x < resolution - 1; ++x) {
-                // Get 8 corner values
-                float corners[8];
-                corners[0] = grid[(z+0)*resolution*resolution + (y+0)*resolution + (x+0)];
-                corners[1] = grid[(z+0)*resolution*resolution + (y+0)*resolution + (x+1)];
-                corners[2] = grid[(z+0)*resolution*resolution + (y+1)*resolution + (x+1)];
-                corners[3] = grid[(z+0)*resolution*resolution + (y+1)*resolution + (x+0)];
-                corners[4] = grid[(z+1)*resolution*resolution + (y+0)*resolution + (x+0)];
-                corners[5] = grid[(z+1)*resolution*resolution + (y+0)*resolution + (x+1)];
-                corners[6] = grid[(z+1)*resolution*resolution + (y+1)*resolution + (x+1)];
-                corners[7] = grid[(z+1)*resolution*resolution + (y+1)*resolution + (x+0)];
-                
-                // Compute cube index
-                int cube_index = 0;
-                if (corners[0] < iso_value) cube_index |= 1;
-                if (corners[1] < iso_value) cube_index |= 2;
-                if (corners[2] < iso_value) cube_index |= 4;
-                if (corners[3] < iso_value) cube_index |= 8;
-                if (corners[4] < iso_value) cube_index |= 16;
-                if (corners[5] < iso_value) cube_index |= 32;
-                if (corners[6] < iso_value) cube_index |= 64;
-                if (corners[7] < iso_value) cube_index |= 128;
+    // Surface cells (x + y * resolution) of each z slab, found in parallel
+    int slabs = resolution - 1;
+    std::vector<TrackedVector<uint32_t>> slab_cells(slabs);
+    std::atomic<int> slabs_done(0);
+    parallel_for(0, slabs, 1, [&](size_t lo, size_t hi) {
+        ScratchScope scratch;
+        uint8_t* cube_index = scratch.array<uint8_t>(resolution);
+        for (size_t z = lo; z < hi; ++z) {
+            TrackedVector<uint32_t>& cells = slab_cells[z];
+            for (int y = 0; y < resolution - 1; ++y) {
+                // Cube index of every cell in the row, from its 8 corner values
+                size_t row = z * plane + y * resolution;
+                const float* r = grid.data() + row;
+                cube_indices(r, r + resolution, r + plane, r + plane + resolution,
+                             resolution - 1, iso_value, cube_index);
                 
                 // Skip if entirely inside or outside
-                if (cube_index == 0 || cube_index == 255) continue;
+                for (int x = 0; x < resolution - 1; ++x) {
+                    if (cube_index[x] != 0 && cube_index[x] != 255) cells.push_back(y * resolution + x);
+                }
+            }
+            job_progress(SPLAT_PROGRESS + (1.0f - SPLAT_PROGRESS) * (slabs_done.fetch_add(1) + 1) / slabs);
+        }
+    });
+    if (job_cancelled()) return false;
+    
+    // Every slab writes its quads at its offset, so the mesh is in slab
+    // order whatever the thread count
+    std::vector<size_t> first_cell(slabs + 1, 0);
+    for (int z = 0; z < slabs; ++z) first_cell[z + 1] = first_cell[z] + slab_cells[z].size();
+    size_t surface_cells = first_cell[slabs];
+    vertices.resize(surface_cells * 12);
+    normals.resize(surface_cells * 12);
+    triangles.resize(surface_cells * 6);
+    densities.resize(surface_cells * 4);
+    
+    parallel_for(0, slabs, 1, [&](size_t lo, size_t hi) {
+        for (size_t z = lo; z < hi; ++z) {
+            const TrackedVector<uint32_t>& cells = slab_cells[z];
+            for (size_t j = 0; j < cells.size(); ++j) {
+                size_t quad = first_cell[z] + j;
+                int x = static_cast<int>(cells[j] % resolution);
+                int y = static_cast<int>(cells[j] / resolution);
                 
                 // Generate triangles (simplified - just create cube faces where surface intersects)
                 float cx = min_x + (x + 0.5f) * voxel_size_x;
                 float cy = min_y + (y + 0.5f) * voxel_size_y;
                 float cz = min_z + (z + 0.5f) * voxel_size_z;
                 
-                // Add a simplified quad (2 triangles) at cell center
-                int base_idx = vertex_count();
-                
-                // Add 4 vertices for a small quad
+                // Add 4 vertices for a small quad at cell center
                 float s = voxel_size_x * 0.4f;
-                vertices.push_back(cx - s); vertices.push_back(cy - s); vertices.push_back(cz);
-                vertices.push_back(cx + s); vertices.push_back(cy - s); vertices.push_back(cz);
-                vertices.push_back(cx + s); vertices.push_back(cy + s); vertices.push_back(cz);
-                vertices.push_back(cx - s); vertices.push_back(cy + s); vertices.push_back(cz);
+                const float quad_vertices[12] = {
+                    cx - s, cy - s, cz,
+                    cx + s, cy - s, cz,
+                    cx + s, cy + s, cz,
+                    cx - s, cy + s, cz
+                };
+                std::copy(quad_vertices, quad_vertices + 12, &vertices[quad * 12]);
                 
                 // Normals (pointing up for now)
                 for (int n = 0; n < 4; ++n) {
-                    normals.push_back(0); normals.push_back(0); normals.push_back(1);
+                    normals[quad * 12 + n * 3] = 0;
+                    normals[quad * 12 + n * 3 + 1] = 0;
+                    normals[quad * 12 + n * 3 + 2] = 1;
                 }
                 
                 // Two triangles
-                triangles.push_back(base_idx); triangles.push_back(base_idx+1); triangles.push_back(base_idx+2);
-                triangles.push_back(base_idx); triangles.push_back(base_idx+2); triangles.push_back(base_idx+3);
+                int base_idx = static_cast<int>(quad * 4);
+                const int quad_triangles[6] = {
+                    base_idx, base_idx + 1, base_idx + 2,
+                    base_idx, base_idx + 2, base_idx + 3
+                };
+                std::copy(quad_triangles, quad_triangles + 6, &triangles[quad * 6]);
                 
                 // Density (based on weight)
-                float density = weights[(z)*resolution*resolution + (y)*resolution + (x)];
-                densities.push_back(density);
-                densities.push_back(density);
-                densities.push_back(density);
-                densities.push_back(density);
+                float density = weights[z * plane + cells[j]];
+                std::fill(&densities[quad * 4], &densities[quad * 4] + 4, density);
             }
         }
+    });
+    if (job_cancelled()) {
+        clear();
+        return false;
     }
     
     return vertex_count() > 0;
 }
 
+SMRErrorCode MeshImpl::reconstruct(const PointCloudImpl& cloud, const PoissonSettings& settings) {
+    if (!cloud.has_normals) {
+        set_last_error("Poisson reconstruction needs normals (estimate them first)");
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+    
+    bool built;
+    try {
+        built = create_from_pointcloud(cloud.points, cloud.normals, settings);
+    } catch (const std::bad_alloc&) {
+        clear();
+        set_last_error("Out of memory in mesh reconstruction (check smr_mesh_estimate_memory)");
+        return SMR_ERROR_MEMORY_ALLOCATION;
+    }
+    if (job_cancelled()) return SMR_ERROR_CANCELLED;
+    if (!built) {
+        set_last_error("Mesh reconstruction failed");
+        return SMR_ERROR_COMPUTATION_FAILED;
+    }
+    return SMR_SUCCESS;
+}
+
+// Each surface cell becomes a quad: 4 vertices (position, normal, density)
+// and 2 triangles, listed first as one index in its slab's cell list (which
+// vector growth can leave up to twice as large as it is)
+static const size_t BYTES_PER_SURFACE_CELL = 4 * 7 * sizeof(float) + 6 * sizeof(int) +
+                                             2 * sizeof(uint32_t);
+
+// Voxel keys pack x, y and z in MAX_POISSON_DEPTH bits each
+static const int VOXEL_KEY_BITS = MAX_POISSON_DEPTH;
+static const uint64_t VOXEL_AXIS_MASK = (uint64_t(1) << VOXEL_KEY_BITS) - 1;
+static const uint64_t EMPTY_VOXEL = ~uint64_t(0);
+static const size_t MIN_VOXEL_SLOTS = 1 << 10;
+
+static uint64_t voxel_key(uint64_t x, uint64_t y, uint64_t z) {
+    return x | (y << VOXEL_KEY_BITS) | (z << (2 * VOXEL_KEY_BITS));
+}
+
+static int voxel_axis(uint64_t key, int k) {
+    return static_cast<int>((key >> (k * VOXEL_KEY_BITS)) & VOXEL_AXIS_MASK);
+}
+
+/// Bytes held by the estimator's tables, now and at most
+struct EstimatorFootprint {
+    size_t live = 0;
+    size_t peak = 0;
+
+    void add(size_t bytes) {
+        live += bytes;
+        peak = std::max(peak, live);
+    }
+    void remove(size_t bytes) { live -= bytes; }
+};
+
+/**
+ * Indicator sum of every occupied voxel, in an open-addressing table that
+ * doubles at half load. It holds one slot pair per occupied voxel (not per
+ * point), so it stays far below the grid it stands in for.
+ */
+class VoxelSums {
+public:
+    explicit VoxelSums(EstimatorFootprint& footprint) : footprint(footprint) {
+        allocate(MIN_VOXEL_SLOTS);
+    }
+    ~VoxelSums() { footprint.remove(bytes()); }
+
+    void add(uint64_t key, float indicator) {
+        if (2 * (used + 1) > keys.size()) grow();
+        size_t slot = find_slot(key);
+        if (keys[slot] == EMPTY_VOXEL) {
+            keys[slot] = key;
+            ++used;
+        }
+        sums[slot] += indicator;
+    }
+
+    bool negative(uint64_t key) const {
+        size_t slot = find_slot(key);
+        return keys[slot] != EMPTY_VOXEL && sums[slot] < 0.0f;
+    }
+
+    size_t slots() const { return keys.size(); }
+    uint64_t key(size_t slot) const { return keys[slot]; }
+    float sum(size_t slot) const { return sums[slot]; }
+    size_t bytes() const { return keys.capacity() * sizeof(uint64_t) + sums.capacity() * sizeof(float); }
+
+private:
+    EstimatorFootprint& footprint;
+    TrackedVector<uint64_t> keys;
+    TrackedVector<float> sums;
+    size_t used = 0;
+
+    void allocate(size_t slot_count) {
+        footprint.add(slot_count * (sizeof(uint64_t) + sizeof(float)));
+        keys.assign(slot_count, EMPTY_VOXEL);
+        sums.assign(slot_count, 0.0f);
+    }
+
+    size_t find_slot(uint64_t key) const {
+        size_t mask = keys.size() - 1;
+        size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+        while (keys[slot] != EMPTY_VOXEL && keys[slot] != key) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void grow() {
+        TrackedVector<uint64_t> old_keys;
+        TrackedVector<float> old_sums;
+        old_keys.swap(keys);
+        old_sums.swap(sums);
+        size_t old_bytes = old_keys.capacity() * sizeof(uint64_t) + old_sums.capacity() * sizeof(float);
+        allocate(old_keys.size() * 2);
+        for (size_t i = 0; i < old_keys.size(); ++i) {
+            if (old_keys[i] == EMPTY_VOXEL) continue;
+            size_t slot = find_slot(old_keys[i]);
+            keys[slot] = old_keys[i];
+            sums[slot] = old_sums[i];
+        }
+        footprint.remove(old_bytes);
+    }
+};
+
+// A cell emits a quad when some corner voxel is negative (and not all eight
+// are; counting those too keeps the figure an upper bound). Each cell is
+// counted once, from its first negative corner.
+static size_t count_surface_cells(const VoxelSums& voxels, int resolution) {
+    size_t count = 0;
+    for (size_t slot = 0; slot < voxels.slots(); ++slot) {
+        uint64_t key = voxels.key(slot);
+        if (key == EMPTY_VOXEL || !(voxels.sum(slot) < 0.0f)) continue;
+        int v[3] = {voxel_axis(key, 0), voxel_axis(key, 1), voxel_axis(key, 2)};
+        for (int corner = 0; corner < 8; ++corner) {
+            int c[3];
+            bool inside = true;
+            for (int k = 0; k < 3; ++k) {
+                c[k] = v[k] - ((corner >> k) & 1);
+                inside = inside && c[k] >= 0 && c[k] <= resolution - 2;
+            }
+            if (!inside) continue;
+            bool first = true;
+            for (int earlier = 0; earlier < corner && first; ++earlier) {
+                first = !voxels.negative(voxel_key(c[0] + (earlier & 1), c[1] + ((earlier >> 1) & 1),
+                                                   c[2] + ((earlier >> 2) & 1)));
+            }
+            if (first) ++count;
+        }
+    }
+    return count;
+}
+
+bool MeshImpl::estimate_reconstruction_depths(const PointBuffer& points, const PointBuffer* point_normals,
+                                              const PoissonSettings& settings, size_t* out_bytes) {
+    size_t count = points.size();
+    ReconstructionGrid cell;
+    if (count == 0 || !reconstruction_grid(points, settings, cell)) return false;
+    const float* axis[3] = {points.x(), points.y(), points.z()};
+    int resolution = cell.resolution;
+
+    // Sum the indicator of each point (as splatted by create_from_pointcloud,
+    // in the same order) into its voxel at the finest depth; without normals
+    // every point counts as negative
+    EstimatorFootprint footprint;
+    std::unique_ptr<VoxelSums> voxels(new VoxelSums(footprint));
+    for (size_t block = 0; block < count; block += SPLAT_BLOCK) {
+        if (job_cancelled()) return false;
+        size_t block_end = std::min(count, block + SPLAT_BLOCK);
+        for (size_t i = block; i < block_end; ++i) {
+            uint64_t index[3];
+            for (int k = 0; k < 3; ++k) {
+                int v = static_cast<int>((axis[k][i] - cell.min[k]) / cell.voxel[k]);
+                index[k] = static_cast<uint64_t>(std::max(0, std::min(resolution - 1, v)));
+            }
+            float indicator = point_normals
+                ? point_normals->x()[i] + point_normals->y()[i] + point_normals->z()[i] : -1.0f;
+            voxels->add(voxel_key(index[0], index[1], index[2]), indicator);
+        }
+        job_progress(0.5f * block_end / count);
+    }
+
+    // Halving the resolution halves the voxel size exactly, so a point's
+    // voxel one level up is its voxel's parent: fold the table level by level
+    for (int depth = settings.depth; depth >= 1; --depth) {
+        int res = 1 << depth;
+        size_t cells = static_cast<size_t>(res) * res * res;
+        size_t slabs = static_cast<size_t>(res - 1);
+
+        // Indicator and weight grids, the per-slab cell lists and their
+        // offsets, and the mesh arrays (allocated at their final size)
+        out_bytes[depth - 1] = 2 * cells * sizeof(float) +
+                               count_surface_cells(*voxels, res) * BYTES_PER_SURFACE_CELL +
+                               slabs * (sizeof(TrackedVector<uint32_t>) + sizeof(size_t));
+        if (job_cancelled()) return false;
+        job_progress(0.5f + 0.5f * (settings.depth - depth + 1) / settings.depth);
+        if (depth == 1) break;
+
+        std::unique_ptr<VoxelSums> parents(new VoxelSums(footprint));
+        for (size_t slot = 0; slot < voxels->slots(); ++slot) {
+            uint64_t key = voxels->key(slot);
+            if (key == EMPTY_VOXEL) continue;
+            parents->add(voxel_key(voxel_axis(key, 0) >> 1, voxel_axis(key, 1) >> 1, voxel_axis(key, 2) >> 1),
+                         voxels->sum(slot));
+        }
+        voxels = std::move(parents);
+    }
+
+    // The estimate is the peak of estimating and then reconstructing
+    for (int depth = 1; depth <= settings.depth; ++depth) {
+        out_bytes[depth - 1] = std::max(out_bytes[depth - 1], footprint.peak);
+    }
+    return true;
+}
+
+size_t MeshImpl::estimate_reconstruction_bytes(const PointBuffer& points, const PointBuffer* point_normals,
+                                               const PoissonSettings& settings) {
+    size_t bytes[MAX_POISSON_DEPTH];
+    if (!estimate_reconstruction_depths(points, point_normals, settings, bytes)) return 0;
+    return bytes[settings.depth - 1];
+}
+
 void MeshImpl::remove_low_density(float quantile) {
     if (densities.empty() || quantile <= 0 || quantile >= 1) return;
     
     // Find density threshold
-    std::vector<float> sorted_densities = densities;
-    std::sort(sorted_densities.begin(), sorted_densities.end());
+    ScratchScope scratch;
+    size_t n = densities.size();
+    float* sorted_densities = scratch.array<float>(n);
+    std::copy(densities.begin(), densities.end(), sorted_densities);
     
-    int threshold_idx = static_cast<int>(sorted_densities.size() * quantile);
+    size_t threshold_idx = static_cast<size_t>(n * quantile);
+    std::nth_element(sorted_densities, sorted_densities + threshold_idx, sorted_densities + n);
     float threshold = sorted_densities[threshold_idx];
     
     // Filter vertices and rebuild triangles
-    std::vector<float> new_vertices;
-    std::vector<float> new_normals;
-    std::vector<float> new_densities;
-    std::vector<int> vertex_map(vertex_count(), -1);
+    TrackedVector<float> new_vertices = float_buffers.take(vertices.size());
+    TrackedVector<float> new_normals = float_buffers.take(normals.size());
+    TrackedVector<float> new_densities = float_buffers.take(n);
+    int* vertex_map = scratch.array<int>(vertex_count());
+    std::fill(vertex_map, vertex_map + vertex_count(), -1);
     
     int new_idx = 0;
     for (int i = 0; i < vertex_count(); ++i) {
@@ -229,7 +486,7 @@ void MeshImpl::remove_low_density(float quantile) {
     }
     
     // Rebuild triangles
-    std::vector<int> new_triangles;
+    TrackedVector<int> new_triangles = int_buffers.take(triangles.size());
     for (int i = 0; i < triangle_count(); ++i) {
         int v0 = triangles[i*3];
         int v1 = triangles[i*3+1];
@@ -242,14 +499,22 @@ void MeshImpl::remove_low_density(float quantile) {
         }
     }
     
-    vertices = std::move(new_vertices);
-    normals = std::move(new_normals);
-    triangles = std::move(new_triangles);
-    densities = std::move(new_densities);
+    vertices.swap(new_vertices);
+    normals.swap(new_normals);
+    triangles.swap(new_triangles);
+    densities.swap(new_densities);
+    float_buffers.give(std::move(new_vertices));
+    float_buffers.give(std::move(new_normals));
+    float_buffers.give(std::move(new_densities));
+    int_buffers.give(std::move(new_triangles));
+    float_buffers.trim(vertices.size());
+    int_buffers.trim(triangles.size());
+    invalidate_bvh();
 }
 
 void MeshImpl::simplify(float target_ratio) {
     if (target_ratio <= 0 || target_ratio >= 1) return;
+    SMR_STAT_SCOPE(STAT_MESH_SIMPLIFY);
     
     // Simplified decimation: random triangle removal
     // Real implementation would use quadric error metrics
@@ -258,21 +523,58 @@ void MeshImpl::simplify(float target_ratio) {
     if (target_triangles >= triangle_count()) return;
     
     // Randomly select triangles to keep
-    std::vector<int> new_triangles;
-    new_triangles.reserve(target_triangles * 3);
+    TrackedVector<int> new_triangles = int_buffers.take(triangles.size());
     
     float keep_ratio = static_cast<float>(target_triangles) / triangle_count();
     
-    for (int i = 0; i < triangle_count(); ++i) {
-        float r = static_cast<float>(rand()) / RAND_MAX;
-        if (r < keep_ratio) {
-            new_triangles.push_back(triangles[i*3]);
-            new_triangles.push_back(triangles[i*3+1]);
-            new_triangles.push_back(triangles[i*3+2]);
+    // Serial: the random sequence decides which triangles survive.
+    // A cancelled pass leaves the mesh as it was.
+    int n = triangle_count();
+    for (int block = 0; block < n; block += SIMPLIFY_BLOCK) {
+        if (job_cancelled()) {
+            int_buffers.give(std::move(new_triangles));
+            return;
         }
+        int block_end = std::min(n, block + SIMPLIFY_BLOCK);
+        for (int i = block; i < block_end; ++i) {
+            float r = static_cast<float>(rand()) / RAND_MAX;
+            if (r < keep_ratio) {
+                new_triangles.push_back(triangles[i*3]);
+                new_triangles.push_back(triangles[i*3+1]);
+                new_triangles.push_back(triangles[i*3+2]);
+            }
+        }
+        job_progress(static_cast<float>(block_end) / n);
     }
     
-    triangles = std::move(new_triangles);
+    triangles.swap(new_triangles);
+    int_buffers.give(std::move(new_triangles));
+    int_buffers.trim(triangles.size());
+    invalidate_bvh();
+}
+
+std::shared_ptr<const MeshBVH> MeshImpl::get_bvh() const {
+    std::lock_guard<std::mutex> lock(bvh_mutex);
+    if (!bvh) {
+        auto built = std::make_shared<MeshBVH>();
+        built->build(vertices.data(), triangles.data(), triangle_count());
+        bvh = std::move(built);
+    }
+    return bvh;
+}
+
+void MeshImpl::invalidate_bvh() {
+    std::lock_guard<std::mutex> lock(bvh_mutex);
+    bvh.reset();
+}
+
+size_t MeshImpl::memory_bytes() const {
+    size_t bytes = vector_bytes(vertices) + vector_bytes(normals) +
+                   vector_bytes(triangles) + vector_bytes(densities) +
+                   float_buffers.memory_bytes() + int_buffers.memory_bytes();
+    std::lock_guard<std::mutex> lock(bvh_mutex);
+    if (bvh) bytes += bvh->memory_bytes();
+    return bytes;
 }
 
 bool MeshImpl::save_ply(const char* filepath) {
@@ -340,67 +642,54 @@ bool MeshImpl::save_obj(const char* filepath) {
 // C API Implementation
 // =============================================================================
 
-// External access to PointCloudImpl
-extern "C" {
-    // These would need proper linking in a real build
-}
-
 SMR_API MeshHandle smr_mesh_create_poisson(PointCloudHandle pc_handle, 
                                             const PoissonSettings* settings) {
     if (!pc_handle || !settings) return nullptr;
     
-    // Get point cloud data (simplified - would need proper access in real implementation)
-    // For now, create a dummy mesh
     auto* mesh = new MeshImpl();
+    if (mesh->reconstruct(*static_cast<const PointCloudImpl*>(pc_handle), *settings) != SMR_SUCCESS) {
+        delete mesh;
+        return nullptr;
+    }
+    return mesh;
+}
+
+SMR_API MeshHandle smr_mesh_create_from_arrays(const float* vertices, int vertex_count,
+                                                const int* indices, int triangle_count) {
+    if (!vertices || !indices || vertex_count <= 0 || triangle_count <= 0) return nullptr;
     
-    // In real implementation, access pc_handle's points and normals
-    // mesh->create_from_pointcloud(points, normals, count, *settings);
-    
-    // Create a simple test mesh (sphere approximation)
-    int segments = 16;
-    float radius = 1.0f;
-    
-    for (int lat = 0; lat <= segments; ++lat) {
-        float theta = lat * 3.14159f / segments;
-        float sin_theta = std::sin(theta);
-        float cos_theta = std::cos(theta);
-        
-        for (int lon = 0; lon <= segments; ++lon) {
-            float phi = lon * 2.0f * 3.14159f / segments;
-            float sin_phi = std::sin(phi);
-            float cos_phi = std::cos(phi);
-            
-            float x = radius * sin_theta * cos_phi;
-            float y = radius * sin_theta * sin_phi;
-            float z = radius * cos_theta;
-            
-            mesh->vertices.push_back(x);
-            mesh->vertices.push_back(y);
-            mesh->vertices.push_back(z);
-            
-            mesh->normals.push_back(x / radius);
-            mesh->normals.push_back(y / radius);
-            mesh->normals.push_back(z / radius);
-            
-            mesh->densities.push_back(1.0f);
-        }
+    for (int i = 0; i < triangle_count * 3; ++i) {
+        if (indices[i] < 0 || indices[i] >= vertex_count) return nullptr;
     }
     
-    // Generate triangles
-    for (int lat = 0; lat < segments; ++lat) {
-        for (int lon = 0; lon < segments; ++lon) {
-            int curr = lat * (segments + 1) + lon;
-            int next = curr + segments + 1;
-            
-            mesh->triangles.push_back(curr);
-            mesh->triangles.push_back(next);
-            mesh->triangles.push_back(curr + 1);
-            
-            mesh->triangles.push_back(curr + 1);
-            mesh->triangles.push_back(next);
-            mesh->triangles.push_back(next + 1);
+    auto* mesh = new MeshImpl();
+    mesh->vertices.assign(vertices, vertices + vertex_count * 3);
+    mesh->triangles.assign(indices, indices + triangle_count * 3);
+    mesh->densities.assign(vertex_count, 1.0f);
+    
+    // Area-weighted vertex normals (unnormalized face normals summed)
+    mesh->normals.assign(vertex_count * 3, 0.0f);
+    for (int t = 0; t < triangle_count; ++t) {
+        const int* tri = indices + t * 3;
+        const float* a = vertices + tri[0] * 3;
+        const float* b = vertices + tri[1] * 3;
+        const float* c = vertices + tri[2] * 3;
+        float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        float n[3] = {
+            e1[1]*e2[2] - e1[2]*e2[1],
+            e1[2]*e2[0] - e1[0]*e2[2],
+            e1[0]*e2[1] - e1[1]*e2[0]
+        };
+        for (int k = 0; k < 3; ++k) {
+            for (int j = 0; j < 3; ++j) mesh->normals[tri[k] * 3 + j] += n[j];
         }
     }
+    for (int i = 0; i < vertex_count; ++i) {
+        float* n = &mesh->normals[i * 3];
+        float len = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+        if (len > 1e-12f) { n[0] /= len; n[1] /= len; n[2] /= len; }
+    }
     
     return mesh;
 }
@@ -473,3 +762,109 @@ SMR_API SMRErrorCode smr_mesh_save_obj(MeshHandle handle, const char* filepath)
     return static_cast<MeshImpl*>(handle)->save_obj(filepath) ? 
            SMR_SUCCESS : SMR_ERROR_FILE_NOT_FOUND;
 }
+
+SMR_API SMRErrorCode smr_mesh_raycast(MeshHandle handle, const float* origins,
+                                       const float* directions, int count,
+                                       float max_distance, MeshHit* out_hits) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!origins || !directions || !out_hits || count < 0 || !(max_distance > 0)) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+    
+    std::shared_ptr<const MeshBVH> bvh = static_cast<MeshImpl*>(handle)->get_bvh();
+    parallel_for(0, static_cast<size_t>(count), 256, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            bvh->raycast(origins + i * 3, directions + i * 3, max_distance, out_hits[i]);
+        }
+    });
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_mesh_closest_points(MeshHandle handle, const float* points, int count,
+                                              float max_distance, MeshHit* out_hits) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!points || !out_hits || count < 0 || !(max_distance > 0)) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+    
+    std::shared_ptr<const MeshBVH> bvh = static_cast<MeshImpl*>(handle)->get_bvh();
+    parallel_for(0, static_cast<size_t>(count), 256, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            bvh->closest_point(points + i * 3, max_distance, out_hits[i]);
+        }
+    });
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_mesh_sphere_overlap(MeshHandle handle, const float* center, float radius,
+                                              int* out_triangles, int max_triangles,
+                                              int* out_count) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!center || !out_count || !(radius >= 0) || max_triangles < 0 ||
+        (max_triangles > 0 && !out_triangles)) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+    
+    std::vector<int> found;
+    static_cast<MeshImpl*>(handle)->get_bvh()->sphere_overlap(center, radius, found);
+    std::sort(found.begin(), found.end());
+    
+    int n = std::min(max_triangles, static_cast<int>(found.size()));
+    if (n > 0) std::memcpy(out_triangles, found.data(), n * sizeof(int));
+    *out_count = static_cast<int>(found.size());
+    return SMR_SUCCESS;
+}
+
+SMR_API long long smr_mesh_estimate_memory(PointCloudHandle pc_handle,
+                                           const PoissonSettings* settings) {
+    if (!pc_handle || !settings) return -1;
+    const auto* cloud = static_cast<const PointCloudImpl*>(pc_handle);
+    if (cloud->count() == 0 || settings->depth < 1 || settings->depth > MAX_POISSON_DEPTH) return -1;
+
+    const PointBuffer* normals = cloud->has_normals ? &cloud->normals : nullptr;
+    try {
+        return static_cast<long long>(MeshImpl::estimate_reconstruction_bytes(cloud->points, normals, *settings));
+    } catch (const std::bad_alloc&) {
+        set_last_error("Out of memory estimating the reconstruction");
+        return -1;
+    }
+}
+
+SMR_API SMRErrorCode smr_mesh_estimate_memory_depths(PointCloudHandle pc_handle,
+                                                     const PoissonSettings* settings,
+                                                     long long* out_bytes) {
+    if (!pc_handle) return SMR_ERROR_INVALID_HANDLE;
+    const auto* cloud = static_cast<const PointCloudImpl*>(pc_handle);
+    if (!settings || !out_bytes || cloud->count() == 0 ||
+        settings->depth < 1 || settings->depth > MAX_POISSON_DEPTH) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+
+    const PointBuffer* normals = cloud->has_normals ? &cloud->normals : nullptr;
+    size_t bytes[MAX_POISSON_DEPTH];
+    try {
+        if (!MeshImpl::estimate_reconstruction_depths(cloud->points, normals, *settings, bytes)) {
+            return SMR_ERROR_CANCELLED;
+        }
+    } catch (const std::bad_alloc&) {
+        set_last_error("Out of memory estimating the reconstruction");
+        return SMR_ERROR_MEMORY_ALLOCATION;
+    }
+    for (int depth = 1; depth <= settings->depth; ++depth) {
+        out_bytes[depth - 1] = static_cast<long long>(bytes[depth - 1]);
+    }
+    return SMR_SUCCESS;
+}
+
+SMR_API long long smr_mesh_get_memory(MeshHandle handle) {
+    if (!handle) return -1;
+    return static_cast<long long>(static_cast<MeshImpl*>(handle)->memory_bytes());
+}
+
+SMR_API SMRErrorCode smr_mesh_trim_memory(MeshHandle handle) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    auto* mesh = static_cast<MeshImpl*>(handle);
+    mesh->float_buffers.trim();
+    mesh->int_buffers.trim();
+    return SMR_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file mesh_generator.h
+ * @brief Internal Mesh Types (shared between native modules)
+ */
+
+#ifndef SMR_MESH_GENERATOR_H
+#define SMR_MESH_GENERATOR_H
+
+#include "smr_welding_api.h"
+#include "memory_tracker.h"
+#include "point_buffer.h"
+#include "scratch_memory.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+
+/// Deepest reconstruction grid accepted (2^12 cells per axis)
+static const int MAX_POISSON_DEPTH = 12;
+
+// Forward declaration from point_cloud.h
+class PointCloudImpl;
+class MeshBVH;
+
+// =============================================================================
+// Internal Mesh Class
+// =============================================================================
+
+class MeshImpl {
+public:
+    TrackedVector<float> vertices;   // XYZ * vertex_count
+    TrackedVector<float> normals;    // XYZ * vertex_count
+    TrackedVector<int> triangles;    // 3 indices * triangle_count
+    TrackedVector<float> densities;  // Density per vertex (for low-density removal)
+    BufferPool<TrackedVector<float>> float_buffers;  // Arrays replaced by the filters, for reuse
+    BufferPool<TrackedVector<int>> int_buffers;
+
+    int vertex_count() const { return static_cast<int>(vertices.size() / 3); }
+    int triangle_count() const { return static_cast<int>(triangles.size() / 3); }
+
+    void clear() {
+        vertices.clear();
+        normals.clear();
+        triangles.clear();
+        densities.clear();
+        invalidate_bvh();
+    }
+
+    /// Triangle BVH, built on first use and shared with in-flight queries.
+    /// Anything that edits vertices or triangles must call invalidate_bvh().
+    std::shared_ptr<const MeshBVH> get_bvh() const;
+    void invalidate_bvh();
+
+    /// Bytes reserved by the arrays and the BVH (if built)
+    size_t memory_bytes() const;
+
+    // Simplified Poisson reconstruction (Marching Cubes approximation).
+    // Reports job progress and returns false (empty mesh) once the job is cancelled.
+    bool create_from_pointcloud(const PointBuffer& points, const PointBuffer& point_normals,
+                                const PoissonSettings& settings);
+
+    /// Reconstruct a cloud with normals (smr_mesh_create_poisson and its job).
+    /// Sets the last error on failure; out of memory gives SMR_ERROR_MEMORY_ALLOCATION.
+    SMRErrorCode reconstruct(const PointCloudImpl& cloud, const PoissonSettings& settings);
+
+    /// Peak bytes of estimating and then running create_from_pointcloud at every
+    /// depth from 1 to settings.depth (out_bytes[depth - 1]), in one pass over the
+    /// points. point_normals may be NULL for an upper bound. Reports job progress;
+    /// false if the inputs are invalid or the job was cancelled.
+    static bool estimate_reconstruction_depths(const PointBuffer& points, const PointBuffer* point_normals,
+                                               const PoissonSettings& settings, size_t* out_bytes);
+
+    /// The estimate at settings.depth alone (0 if invalid)
+    static size_t estimate_reconstruction_bytes(const PointBuffer& points, const PointBuffer* point_normals,
+                                                const PoissonSettings& settings);
+    
+    void remove_low_density(float quantile);
+    void simplify(float target_ratio);
+    bool save_ply(const char* filepath);
+    bool save_obj(const char* filepath);
+
+private:
+    mutable std::mutex bvh_mutex;
+    mutable std::shared_ptr<const MeshBVH> bvh;
+};
+
+#endif // SMR_MESH_GENERATOR_H
@@ -0,0 +1,95 @@
+/**
+ * @file parallel.h
+ * @brief Internal parallel loop helpers
+ */
+
+#ifndef SMR_PARALLEL_H
+#define SMR_PARALLEL_H
+
+#include "job_control.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Worker count used when a caller passes 0 threads (the shared pool's size)
+inline int parallel_default_threads() {
+    return pool_concurrency();
+}
+
+/**
+ * Run fn(lo, hi) over [begin, end) split into blocks of `grain` items.
+ * Blocks are handed out dynamically so uneven work (e.g. IK retries) balances.
+ * Runs on the shared thread pool with at most num_threads threads (capped
+ * by the pool size). The calling thread participates and returns when every
+ * block has finished. Workers inherit the caller's job and stop taking
+ * blocks once it is cancelled.
+ */
+template <typename Fn>
+void parallel_for(size_t begin, size_t end, size_t grain, Fn&& fn, int num_threads = 0) {
+    if (end <= begin) return;
+    grain = std::max<size_t>(grain, 1);
+
+    size_t num_blocks = (end - begin + grain - 1) / grain;
+    int threads = std::min(num_threads > 0 ? num_threads : parallel_default_threads(),
+                           pool_concurrency());
+    threads = static_cast<int>(std::min<size_t>(threads, num_blocks));
+
+    JobControl* job = job_current();
+    if (threads <= 1) {
+        if (!job) {
+            fn(begin, end);
+            return;
+        }
+        for (size_t lo = begin; lo < end && !job_cancelled(); lo += grain) {
+            fn(lo, std::min(end, lo + grain));
+        }
+        return;
+    }
+
+    std::atomic<size_t> next_block(0);
+    auto worker = [&]() {
+        JobScope scope(job);
+        for (;;) {
+            if (job && job->cancelled()) break;
+            size_t block = next_block.fetch_add(1, std::memory_order_relaxed);
+            if (block >= num_blocks) break;
+            size_t lo = begin + block * grain;
+            size_t hi = std::min(end, lo + grain);
+            fn(lo, hi);
+        }
+    };
+
+    TaskGroup group;
+    for (int t = 1; t < threads; ++t) group.run(worker);
+    worker();
+    group.wait();
+}
+
+/**
+ * Reduce [begin, end) in blocks of `grain` items: map(lo, hi) computes a
+ * block's value and combine(a, b) merges two values. Blocks are combined in
+ * index order, so the result does not depend on the thread count.
+ */
+template <typename T, typename Map, typename Combine>
+T parallel_reduce(size_t begin, size_t end, size_t grain, T identity,
+                  Map&& map, Combine&& combine, int num_threads = 0) {
+    if (end <= begin) return identity;
+    grain = std::max<size_t>(grain, 1);
+
+    size_t num_blocks = (end - begin + grain - 1) / grain;
+    std::vector<T> partial(num_blocks, identity);
+    parallel_for(0, num_blocks, 1, [&](size_t lo, size_t hi) {
+        for (size_t b = lo; b < hi; ++b) {
+            size_t first = begin + b * grain;
+            partial[b] = map(first, std::min(end, first + grain));
+        }
+    }, num_threads);
+
+    T result = identity;
+    for (const T& value : partial) result = combine(result, value);
+    return result;
+}
+
+#endif // SMR_PARALLEL_H
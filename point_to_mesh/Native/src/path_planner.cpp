@@ -4,13 +4,25 @@
  */
 
 #include "smr_welding_api.h"
+#include "robot_kinematics.h"
+#include "trajectory_ik.h"
+#include "global_ik.h"
+#include "tool_orientation.h"
+#include "time_parameterization.h"
+#include "path_smoothing.h"
+#include "path_spline.h"
+#include "weave.h"
+#include "path_set.h"
+#include "mesh_generator.h"
+#include "mesh_bvh.h"
+#include "parallel.h"
+#include "stats.h"
 #include <vector>
 #include <cmath>
 #include <algorithm>
 #include <cstring>
-
-// Forward declaration
-class RobotImpl;
+#include <atomic>
+#include <memory>
 
 // =============================================================================
 // Path Implementation
@@ -34,6 +46,7 @@ public:
     void create_from_points(const float* positions, const float* normals, 
                             int count, const PathParams& p) {
         params = p;
+        spline_valid = false;
         points.clear();
         points.reserve(count);
         
@@ -82,196 +95,131 @@ public:
         }
     }
     
-    void apply_weave(WeaveType type, float amplitude, float frequency) {
-        if (type == WEAVE_NONE || points.empty()) return;
-        
-        float travel_speed = 0.01f; // 10mm/s assumed
+    void apply_weave(const WeaveSettings& settings, const WeaveProfile& profile) {
+        if (settings.type == WEAVE_NONE || points.size() < 2) return;
         
-        for (size_t i = 0; i < points.size(); ++i) {
-            WeldPoint& wp = points[i];
-            float t = wp.arc_length / travel_speed;
-            
-            // Compute lateral direction (perpendicular to tangent and normal)
-            float lateral[3];
-            lateral[0] = wp.tangent[1]*wp.normal[2] - wp.tangent[2]*wp.normal[1];
-            lateral[1] = wp.tangent[2]*wp.normal[0] - wp.tangent[0]*wp.normal[2];
-            lateral[2] = wp.tangent[0]*wp.normal[1] - wp.tangent[1]*wp.normal[0];
-            
-            float offset = 0.0f;
-            
-            switch (type) {
-                case WEAVE_ZIGZAG: {
-                    float phase = std::fmod(t * frequency, 1.0f);
-                    offset = (phase < 0.5f) ? 
-                             amplitude * (4.0f * phase - 1.0f) :
-                             amplitude * (3.0f - 4.0f * phase);
-                    break;
-                }
-                case WEAVE_CIRCULAR: {
-                    offset = amplitude * std::sin(2.0f * M_PI * frequency * t);
-                    // Also add vertical component
-                    float v_offset = amplitude * std::cos(2.0f * M_PI * frequency * t);
-                    wp.position[0] += wp.normal[0] * v_offset * 0.5f;
-                    wp.position[1] += wp.normal[1] * v_offset * 0.5f;
-                    wp.position[2] += wp.normal[2] * v_offset * 0.5f;
-                    break;
-                }
-                case WEAVE_TRIANGLE: {
-                    float phase = std::fmod(t * frequency, 1.0f);
-                    offset = amplitude * (1.0f - 4.0f * std::abs(phase - 0.5f));
-                    break;
-                }
-                case WEAVE_FIGURE8: {
-                    offset = amplitude * std::sin(4.0f * M_PI * frequency * t);
-                    float v_offset = amplitude * 0.5f * std::sin(2.0f * M_PI * frequency * t);
-                    wp.position[0] += wp.normal[0] * v_offset;
-                    wp.position[1] += wp.normal[1] * v_offset;
-                    wp.position[2] += wp.normal[2] * v_offset;
-                    break;
-                }
-                default:
-                    break;
-            }
-            
-            // Apply lateral offset
-            wp.position[0] += lateral[0] * offset;
-            wp.position[1] += lateral[1] * offset;
-            wp.position[2] += lateral[2] * offset;
-        }
+        std::vector<WeldPoint> woven;
+        weave_generate(get_spline(), settings, profile, woven);
+        points = std::move(woven);
+        spline_valid = false;
     }
     
+    /**
+     * Uniform samples of the spline through the path. The spline is only
+     * refitted after the points were changed by something else, so repeated
+     * resampling at different steps does not degrade the path.
+     */
     void resample(float step_size) {
         if (points.size() < 2 || step_size <= 0) return;
         
         std::vector<WeldPoint> new_points;
-        float total_length = points.back().arc_length;
-        int num_points = static_cast<int>(total_length / step_size) + 1;
-        
-        new_points.reserve(num_points);
-        
-        size_t src_idx = 0;
-        for (int i = 0; i < num_points; ++i) {
-            float target_arc = i * step_size;
-            
-            // Find surrounding points
-            while (src_idx < points.size() - 1 && 
-                   points[src_idx + 1].arc_length < target_arc) {
-                ++src_idx;
-            }
-            
-            if (src_idx >= points.size() - 1) {
-                new_points.push_back(points.back());
-                continue;
-            }
-            
-            // Interpolate
-            const WeldPoint& p0 = points[src_idx];
-            const WeldPoint& p1 = points[src_idx + 1];
-            
-            float t = (target_arc - p0.arc_length) / 
-                      (p1.arc_length - p0.arc_length);
-            t = std::max(0.0f, std::min(1.0f, t));
-            
-            WeldPoint wp;
-            for (int j = 0; j < 3; ++j) {
-                wp.position[j] = p0.position[j] + t * (p1.position[j] - p0.position[j]);
-                wp.normal[j] = p0.normal[j] + t * (p1.normal[j] - p0.normal[j]);
-                wp.tangent[j] = p0.tangent[j] + t * (p1.tangent[j] - p0.tangent[j]);
-            }
-            
-            // Normalize normal and tangent
-            float n_len = std::sqrt(wp.normal[0]*wp.normal[0] + 
-                                    wp.normal[1]*wp.normal[1] + 
-                                    wp.normal[2]*wp.normal[2]);
-            float t_len = std::sqrt(wp.tangent[0]*wp.tangent[0] + 
-                                    wp.tangent[1]*wp.tangent[1] + 
-                                    wp.tangent[2]*wp.tangent[2]);
-            
-            if (n_len > 1e-6f) {
-                wp.normal[0] /= n_len;
-                wp.normal[1] /= n_len;
-                wp.normal[2] /= n_len;
-            }
-            if (t_len > 1e-6f) {
-                wp.tangent[0] /= t_len;
-                wp.tangent[1] /= t_len;
-                wp.tangent[2] /= t_len;
-            }
-            
-            wp.arc_length = target_arc;
-            new_points.push_back(wp);
-        }
-        
+        get_spline().sample_uniform(step_size, new_points);
         points = std::move(new_points);
     }
     
-    void smooth(int window_size) {
-        if (points.size() < static_cast<size_t>(window_size) || window_size < 3) return;
+    void resample_adaptive(const AdaptiveResampleSettings& s) {
+        if (points.size() < 2) return;
         
-        std::vector<WeldPoint> smoothed = points;
-        int half = window_size / 2;
+        std::vector<WeldPoint> new_points;
+        get_spline().sample_adaptive(s.chord_tolerance, s.angle_tolerance, s.min_step, s.max_step,
+                                     new_points);
+        points = std::move(new_points);
+    }
+    
+    size_t memory_bytes() const {
+        return vector_bytes(points) + (spline_valid ? spline.memory_bytes() : 0);
+    }
+
+    /// Continuous model of the current points (fitted on first use)
+    const PathSpline& get_spline() {
+        if (!spline_valid) {
+            spline.build(points);
+            spline_valid = true;
+        }
+        return spline;
+    }
+    
+    void smooth(const SmoothingSettings& settings) {
+        smooth_path_points(points, settings);
+        update_tangents_and_arc_length(points);
+        spline_valid = false;
+    }
+    
+    /**
+     * Move each point to the closest surface point within max_distance and
+     * take the vertex normal interpolated there. Returns the number moved.
+     */
+    int project_to_mesh(const MeshImpl& mesh, float max_distance, int num_threads) {
+        SMR_STAT_SCOPE(STAT_PATH_PROJECT);
+        std::shared_ptr<const MeshBVH> bvh = mesh.get_bvh();
+        std::atomic<int> projected(0);
         
-        for (size_t i = half; i < points.size() - half; ++i) {
-            float sum_pos[3] = {0, 0, 0};
-            float sum_norm[3] = {0, 0, 0};
-            
-            for (int j = -half; j <= half; ++j) {
-                const WeldPoint& wp = points[i + j];
+        parallel_for(0, points.size(), 256, [&](size_t lo, size_t hi) {
+            int moved = 0;
+            for (size_t i = lo; i < hi; ++i) {
+                WeldPoint& wp = points[i];
+                MeshHit hit;
+                if (!bvh->closest_point(wp.position, max_distance, hit)) continue;
+                
+                const int* tri = &mesh.triangles[hit.triangle * 3];
+                float bary[3];
+                barycentric(hit.point, &mesh.vertices[tri[0] * 3], &mesh.vertices[tri[1] * 3],
+                            &mesh.vertices[tri[2] * 3], bary);
+                
+                float n[3] = {0, 0, 0};
+                for (int c = 0; c < 3; ++c) {
+                    for (int k = 0; k < 3; ++k) n[k] += bary[c] * mesh.normals[tri[c] * 3 + k];
+                }
+                float len = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+                if (len < 1e-6f) {
+                    std::memcpy(n, hit.normal, sizeof(n));
+                    len = 1.0f;
+                }
+                // Mesh winding is not guaranteed; keep the tool on the caller's side
+                float side = n[0]*wp.normal[0] + n[1]*wp.normal[1] + n[2]*wp.normal[2];
+                float scale = (side < 0.0f ? -1.0f : 1.0f) / len;
+                
                 for (int k = 0; k < 3; ++k) {
-                    sum_pos[k] += wp.position[k];
-                    sum_norm[k] += wp.normal[k];
+                    wp.position[k] = hit.point[k];
+                    wp.normal[k] = n[k] * scale;
                 }
+                ++moved;
             }
-            
-            float count = static_cast<float>(window_size);
-            for (int k = 0; k < 3; ++k) {
-                smoothed[i].position[k] = sum_pos[k] / count;
-                smoothed[i].normal[k] = sum_norm[k] / count;
-            }
-            
-            // Normalize normal
-            float len = std::sqrt(smoothed[i].normal[0]*smoothed[i].normal[0] +
-                                  smoothed[i].normal[1]*smoothed[i].normal[1] +
-                                  smoothed[i].normal[2]*smoothed[i].normal[2]);
-            if (len > 1e-6f) {
-                smoothed[i].normal[0] /= len;
-                smoothed[i].normal[1] /= len;
-                smoothed[i].normal[2] /= len;
-            }
-        }
+            projected += moved;
+        }, num_threads);
         
-        // Recompute tangents
-        for (size_t i = 0; i < smoothed.size(); ++i) {
-            size_t next = std::min(i + 1, smoothed.size() - 1);
-            size_t prev = (i > 0) ? i - 1 : 0;
-            
-            smoothed[i].tangent[0] = smoothed[next].position[0] - smoothed[prev].position[0];
-            smoothed[i].tangent[1] = smoothed[next].position[1] - smoothed[prev].position[1];
-            smoothed[i].tangent[2] = smoothed[next].position[2] - smoothed[prev].position[2];
-            
-            float len = std::sqrt(smoothed[i].tangent[0]*smoothed[i].tangent[0] +
-                                  smoothed[i].tangent[1]*smoothed[i].tangent[1] +
-                                  smoothed[i].tangent[2]*smoothed[i].tangent[2]);
-            if (len > 1e-6f) {
-                smoothed[i].tangent[0] /= len;
-                smoothed[i].tangent[1] /= len;
-                smoothed[i].tangent[2] /= len;
-            }
+        update_tangents_and_arc_length(points);
+        spline_valid = false;
+        return projected.load();
+    }
+    
+private:
+    PathSpline spline;
+    bool spline_valid = false;
+    
+    // Barycentric coordinates of p (assumed on the triangle plane)
+    static void barycentric(const float* p, const float* a, const float* b, const float* c,
+                            float* out) {
+        float e1[3], e2[3], ap[3];
+        for (int k = 0; k < 3; ++k) {
+            e1[k] = b[k] - a[k];
+            e2[k] = c[k] - a[k];
+            ap[k] = p[k] - a[k];
         }
-        
-        points = std::move(smoothed);
-        
-        // Recompute arc lengths
-        float arc = 0.0f;
-        for (size_t i = 0; i < points.size(); ++i) {
-            if (i > 0) {
-                float dx = points[i].position[0] - points[i-1].position[0];
-                float dy = points[i].position[1] - points[i-1].position[1];
-                float dz = points[i].position[2] - points[i-1].position[2];
-                arc += std::sqrt(dx*dx + dy*dy + dz*dz);
-            }
-            points[i].arc_length = arc;
+        float d00 = e1[0]*e1[0] + e1[1]*e1[1] + e1[2]*e1[2];
+        float d01 = e1[0]*e2[0] + e1[1]*e2[1] + e1[2]*e2[2];
+        float d11 = e2[0]*e2[0] + e2[1]*e2[1] + e2[2]*e2[2];
+        float d20 = ap[0]*e1[0] + ap[1]*e1[1] + ap[2]*e1[2];
+        float d21 = ap[0]*e2[0] + ap[1]*e2[1] + ap[2]*e2[2];
+        float det = d00 * d11 - d01 * d01;
+        if (det < 1e-20f) {
+            out[0] = 1.0f;
+            out[1] = out[2] = 0.0f;
+            return;
         }
+        out[1] = (d11 * d20 - d01 * d21) / det;
+        out[2] = (d00 * d21 - d01 * d20) / det;
+        out[0] = 1.0f - out[1] - out[2];
     }
 };
 
@@ -325,11 +273,29 @@ SMR_API void smr_path_destroy(PathHandle handle) {
     delete static_cast<PathImpl*>(handle);
 }
 
+SMR_API SMRErrorCode smr_path_set_add_path(PathSetHandle set_handle, PathHandle path_handle,
+                                            int* out_seam) {
+    if (!set_handle || !path_handle) return SMR_ERROR_INVALID_HANDLE;
+    
+    auto* set = static_cast<PathSetImpl*>(set_handle);
+    const auto* path = static_cast<const PathImpl*>(path_handle);
+    if (path->points.empty()) return SMR_ERROR_INVALID_PARAMETER;
+    
+    set->add_seam(path->points.data(), path->points.size());
+    if (out_seam) *out_seam = set->seam_count() - 1;
+    return SMR_SUCCESS;
+}
+
 SMR_API int smr_path_get_count(PathHandle handle) {
     if (!handle) return -1;
     return static_cast<int>(static_cast<PathImpl*>(handle)->points.size());
 }
 
+SMR_API long long smr_path_get_memory(PathHandle handle) {
+    if (!handle) return -1;
+    return static_cast<long long>(static_cast<PathImpl*>(handle)->memory_bytes());
+}
+
 SMR_API SMRErrorCode smr_path_get_points(PathHandle handle, WeldPoint* out_points) {
     if (!handle) return SMR_ERROR_INVALID_HANDLE;
     if (!out_points) return SMR_ERROR_INVALID_PARAMETER;
@@ -344,7 +310,38 @@ SMR_API SMRErrorCode smr_path_apply_weave(PathHandle handle,
                                            WeaveType weave_type,
                                            float amplitude, float frequency) {
     if (!handle) return SMR_ERROR_INVALID_HANDLE;
-    static_cast<PathImpl*>(handle)->apply_weave(weave_type, amplitude, frequency);
+    if (weave_type == WEAVE_CUSTOM) return SMR_ERROR_INVALID_PARAMETER;
+    
+    WeaveSettings settings;
+    std::memset(&settings, 0, sizeof(settings));
+    settings.type = weave_type;
+    settings.amplitude = amplitude;
+    settings.frequency = frequency;
+    return smr_path_apply_weave_ex(handle, &settings, nullptr, 0);
+}
+
+SMR_API SMRErrorCode smr_path_apply_weave_ex(PathHandle handle,
+                                              const WeaveSettings* settings,
+                                              const float* profile,
+                                              int profile_samples) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    
+    WeaveSettings s = weave_resolve_settings(settings);
+    if (s.type < WEAVE_NONE || s.type > WEAVE_CUSTOM) return SMR_ERROR_INVALID_PARAMETER;
+    
+    WeaveProfile weave_profile;
+    weave_profile.type = s.type;
+    if (s.type == WEAVE_CUSTOM) {
+        if (!profile || profile_samples < 2) return SMR_ERROR_INVALID_PARAMETER;
+        weave_profile.table.assign(profile, profile + static_cast<size_t>(profile_samples) * 2);
+    }
+    
+    auto* path = static_cast<PathImpl*>(handle);
+    if (s.type != WEAVE_NONE && !path->points.empty() &&
+        !(weave_sample_count(path->points.back().arc_length, s) <= WEAVE_MAX_SAMPLES)) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+    path->apply_weave(s, weave_profile);
     return SMR_SUCCESS;
 }
 
@@ -355,78 +352,230 @@ SMR_API SMRErrorCode smr_path_resample(PathHandle handle, float step_size) {
     return SMR_SUCCESS;
 }
 
+SMR_API SMRErrorCode smr_path_resample_adaptive(PathHandle handle,
+                                                 const AdaptiveResampleSettings* settings) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    
+    AdaptiveResampleSettings s = adaptive_resample_resolve_settings(settings);
+    if (s.min_step > s.max_step) return SMR_ERROR_INVALID_PARAMETER;
+    static_cast<PathImpl*>(handle)->resample_adaptive(s);
+    return SMR_SUCCESS;
+}
+
+SMR_API float smr_path_get_length(PathHandle handle) {
+    if (!handle) return -1.0f;
+    return static_cast<float>(static_cast<PathImpl*>(handle)->get_spline().length());
+}
+
+SMR_API SMRErrorCode smr_path_evaluate(PathHandle handle, const float* arc_lengths,
+                                        int count, WeldPoint* out_points) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (count < 0 || (count > 0 && (!arc_lengths || !out_points))) return SMR_ERROR_INVALID_PARAMETER;
+    
+    const PathSpline& spline = static_cast<PathImpl*>(handle)->get_spline();
+    if (spline.empty()) return SMR_ERROR_INVALID_PARAMETER;
+    for (int i = 0; i < count; ++i) {
+        spline.evaluate(arc_lengths[i], out_points[i]);
+    }
+    return SMR_SUCCESS;
+}
+
 SMR_API SMRErrorCode smr_path_smooth(PathHandle handle, int window_size) {
     if (!handle) return SMR_ERROR_INVALID_HANDLE;
     if (window_size < 3) return SMR_ERROR_INVALID_PARAMETER;
-    static_cast<PathImpl*>(handle)->smooth(window_size);
+    
+    SmoothingSettings settings;
+    std::memset(&settings, 0, sizeof(settings));
+    settings.method = SMOOTH_MOVING_AVERAGE;
+    settings.window_size = window_size;
+    settings.corner_angle = static_cast<float>(M_PI);   // Plain moving average: no corner split
+    static_cast<PathImpl*>(handle)->smooth(smoothing_resolve_settings(&settings));
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_smooth_ex(PathHandle handle, const SmoothingSettings* settings) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (settings && settings->window_size != 0 && settings->window_size < 3) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+    static_cast<PathImpl*>(handle)->smooth(smoothing_resolve_settings(settings));
+    return SMR_SUCCESS;
+}
+
+static SurfaceProjectionSettings projection_resolve_settings(const SurfaceProjectionSettings* settings) {
+    SurfaceProjectionSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+    
+    if (s.max_distance <= 0) s.max_distance = 0.02f;
+    if (s.num_threads <= 0) s.num_threads = parallel_default_threads();
+    return s;
+}
+
+SMR_API SMRErrorCode smr_path_project_to_mesh(PathHandle path_handle,
+                                               MeshHandle mesh_handle,
+                                               const SurfaceProjectionSettings* settings,
+                                               int* out_projected) {
+    if (!path_handle || !mesh_handle) return SMR_ERROR_INVALID_HANDLE;
+    
+    auto* path = static_cast<PathImpl*>(path_handle);
+    const auto* mesh = static_cast<const MeshImpl*>(mesh_handle);
+    SurfaceProjectionSettings s = projection_resolve_settings(settings);
+    
+    int projected = path->project_to_mesh(*mesh, s.max_distance, s.num_threads);
+    if (out_projected) *out_projected = projected;
     return SMR_SUCCESS;
 }
 
-// Robot forward declaration for path to joints conversion
-extern "C" SMRErrorCode smr_robot_ik_nearest(RobotHandle handle,
-                                              const double* target_transform,
-                                              const double* reference_angles,
-                                              double* out_angles);
+// Tool targets for every path point (parallel over points)
+static void build_path_targets(const PathImpl& path, float standoff, int num_threads,
+                               std::vector<Matrix4x4>& targets) {
+    targets.resize(path.points.size());
+    parallel_for(0, path.points.size(), 1024, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            build_tool_target(path.points[i], standoff, targets[i]);
+        }
+    }, num_threads);
+}
 
 SMR_API SMRErrorCode smr_path_to_joints(PathHandle path_handle,
                                          RobotHandle robot_handle,
                                          float standoff,
                                          double* out_joints,
                                          bool* out_reachable) {
+    return smr_path_to_joints_ex(path_handle, robot_handle, standoff, nullptr, nullptr,
+                                 out_joints, out_reachable, nullptr);
+}
+
+SMR_API SMRErrorCode smr_path_to_joints_ex(PathHandle path_handle,
+                                            RobotHandle robot_handle,
+                                            float standoff,
+                                            const TrajectoryIKSettings* settings,
+                                            const double* seed_joints,
+                                            double* out_joints,
+                                            bool* out_reachable,
+                                            SMRErrorCode* out_status) {
     if (!path_handle || !robot_handle) return SMR_ERROR_INVALID_HANDLE;
     if (!out_joints || !out_reachable) return SMR_ERROR_INVALID_PARAMETER;
     
     auto* path = static_cast<PathImpl*>(path_handle);
+    auto* robot = static_cast<RobotImpl*>(robot_handle);
+    size_t count = path->points.size();
+    if (count == 0) return SMR_SUCCESS;
     
-    double prev_joints[6] = {0, -M_PI/2, M_PI/2, 0, 0, 0};
+    TrajectoryIKSettings s = trajectory_ik_resolve_settings(settings);
     
-    for (size_t i = 0; i < path->points.size(); ++i) {
-        const WeldPoint& wp = path->points[i];
-        
-        // Build target transform
-        // Position = weld point + standoff along normal
-        double target[16] = {0};
-        
-        // Rotation: Z-axis along negative normal (pointing at surface)
-        // X-axis along tangent
-        float z[3] = {-wp.normal[0], -wp.normal[1], -wp.normal[2]};
-        float x[3] = {wp.tangent[0], wp.tangent[1], wp.tangent[2]};
-        
-        // Y = Z x X
-        float y[3] = {
-            z[1]*x[2] - z[2]*x[1],
-            z[2]*x[0] - z[0]*x[2],
-            z[0]*x[1] - z[1]*x[0]
-        };
-        
-        // Normalize
-        float y_len = std::sqrt(y[0]*y[0] + y[1]*y[1] + y[2]*y[2]);
-        if (y_len > 1e-6f) { y[0] /= y_len; y[1] /= y_len; y[2] /= y_len; }
-        
-        // Rebuild X = Y x Z for orthogonality
-        x[0] = y[1]*z[2] - y[2]*z[1];
-        x[1] = y[2]*z[0] - y[0]*z[2];
-        x[2] = y[0]*z[1] - y[1]*z[0];
-        
-        // Build rotation matrix (column-major for OpenGL style, but we use row-major)
-        target[0] = x[0]; target[1] = y[0]; target[2] = z[0]; target[3] = wp.position[0] - standoff*wp.normal[0];
-        target[4] = x[1]; target[5] = y[1]; target[6] = z[1]; target[7] = wp.position[1] - standoff*wp.normal[1];
-        target[8] = x[2]; target[9] = y[2]; target[10] = z[2]; target[11] = wp.position[2] - standoff*wp.normal[2];
-        target[12] = 0;   target[13] = 0;   target[14] = 0;   target[15] = 1;
-        
-        // Solve IK
-        double joints[6];
-        SMRErrorCode result = smr_robot_ik_nearest(robot_handle, target, prev_joints, joints);
-        
-        if (result == SMR_SUCCESS) {
-            std::memcpy(out_joints + i * 6, joints, 6 * sizeof(double));
-            std::memcpy(prev_joints, joints, 6 * sizeof(double));
-            out_reachable[i] = true;
-        } else {
-            std::memset(out_joints + i * 6, 0, 6 * sizeof(double));
-            out_reachable[i] = false;
+    std::vector<Matrix4x4> targets;
+    build_path_targets(*path, standoff, s.num_threads, targets);
+    
+    std::vector<SMRErrorCode> status(count);
+    solve_trajectory_ik(*robot, targets.data(), count, s, seed_joints,
+                        out_joints, status.data());
+    
+    for (size_t i = 0; i < count; ++i) {
+        out_reachable[i] = (status[i] == SMR_SUCCESS);
+    }
+    if (out_status) {
+        std::memcpy(out_status, status.data(), count * sizeof(SMRErrorCode));
+    }
+    
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_to_joints_global(PathHandle path_handle,
+                                                RobotHandle robot_handle,
+                                                float standoff,
+                                                const GlobalIKSettings* settings,
+                                                double* out_joints,
+                                                bool* out_reachable,
+                                                SMRErrorCode* out_status) {
+    if (!path_handle || !robot_handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!out_joints || !out_reachable) return SMR_ERROR_INVALID_PARAMETER;
+    
+    auto* path = static_cast<PathImpl*>(path_handle);
+    auto* robot = static_cast<RobotImpl*>(robot_handle);
+    size_t count = path->points.size();
+    if (count == 0) return SMR_SUCCESS;
+    
+    GlobalIKSettings s = global_ik_resolve_settings(settings);
+    
+    std::vector<Matrix4x4> targets;
+    build_path_targets(*path, standoff, s.num_threads, targets);
+    
+    std::vector<SMRErrorCode> status(count);
+    solve_global_ik(*robot, targets.data(), count, s, out_joints, status.data());
+    
+    for (size_t i = 0; i < count; ++i) {
+        out_reachable[i] = (status[i] == SMR_SUCCESS);
+    }
+    if (out_status) {
+        std::memcpy(out_status, status.data(), count * sizeof(SMRErrorCode));
+    }
+    
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_to_joints_tool_axis(PathHandle path_handle,
+                                                   RobotHandle robot_handle,
+                                                   float standoff,
+                                                   const ToolAxisSettings* settings,
+                                                   double* out_joints,
+                                                   bool* out_reachable,
+                                                   SMRErrorCode* out_status,
+                                                   float* out_tool_angles) {
+    if (!path_handle || !robot_handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!out_joints || !out_reachable) return SMR_ERROR_INVALID_PARAMETER;
+    
+    auto* path = static_cast<PathImpl*>(path_handle);
+    auto* robot = static_cast<RobotImpl*>(robot_handle);
+    size_t count = path->points.size();
+    if (count == 0) return SMR_SUCCESS;
+    
+    ToolAxisSettings s = tool_axis_resolve_settings(settings);
+    ToolAngles nominal = {0.0f, path->params.travel_angle, path->params.approach_angle};
+    
+    std::vector<SMRErrorCode> status(count);
+    std::vector<ToolAngles> angles(count);
+    solve_tool_axis_ik(*robot, path->points.data(), count, standoff, nominal, s,
+                       out_joints, status.data(), angles.data());
+    
+    for (size_t i = 0; i < count; ++i) {
+        out_reachable[i] = (status[i] == SMR_SUCCESS);
+        if (out_tool_angles) {
+            out_tool_angles[i*3] = angles[i].spin;
+            out_tool_angles[i*3+1] = angles[i].travel;
+            out_tool_angles[i*3+2] = angles[i].work;
         }
     }
+    if (out_status) {
+        std::memcpy(out_status, status.data(), count * sizeof(SMRErrorCode));
+    }
+    
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_time_parameterize(PathHandle path_handle,
+                                                 RobotHandle robot_handle,
+                                                 const double* joints,
+                                                 const TimingSettings* settings,
+                                                 double* out_timestamps,
+                                                 double* out_joint_velocities,
+                                                 double* out_joint_accelerations,
+                                                 float* out_path_speed) {
+    if (!path_handle || !robot_handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!joints || !out_timestamps) return SMR_ERROR_INVALID_PARAMETER;
+    
+    auto* path = static_cast<PathImpl*>(path_handle);
+    auto* robot = static_cast<RobotImpl*>(robot_handle);
+    size_t count = path->points.size();
+    if (count == 0) return SMR_SUCCESS;
+    
+    TimingSettings s = timing_resolve_settings(settings);
+    
+    std::vector<float> arc_lengths(count);
+    for (size_t i = 0; i < count; ++i) arc_lengths[i] = path->points[i].arc_length;
     
+    time_parameterize(*robot, joints, arc_lengths.data(), count, s, out_timestamps,
+                      out_joint_velocities, out_joint_accelerations, out_path_speed);
     return SMR_SUCCESS;
 }
@@ -0,0 +1,456 @@
+/**
+ * @file path_set.cpp
+ * @brief Multi-Seam Path Set Implementation
+ */
+
+#include "path_set.h"
+#include "path_smoothing.h"
+#include "trajectory_ik.h"
+#include "tool_orientation.h"
+#include "parallel.h"
+#include "job_control.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+// =============================================================================
+// Path Set Implementation
+// =============================================================================
+
+void PathSetImpl::add_seam(const float* seam_positions, const float* seam_normals, size_t count) {
+    std::vector<WeldPoint> points(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            points[i].position[k] = seam_positions[i*3 + k];
+            points[i].normal[k] = seam_normals[i*3 + k];
+        }
+    }
+    update_tangents_and_arc_length(points);
+    add_seam(points.data(), count);
+}
+
+void PathSetImpl::add_seam(const WeldPoint* points, size_t count) {
+    size_t base = point_count();
+    positions.resize((base + count) * 3);
+    normals.resize((base + count) * 3);
+    tangents.resize((base + count) * 3);
+    arc_lengths.resize(base + count);
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t j = base + i;
+        for (int k = 0; k < 3; ++k) {
+            positions[j*3 + k] = points[i].position[k];
+            normals[j*3 + k] = points[i].normal[k];
+            tangents[j*3 + k] = points[i].tangent[k];
+        }
+        arc_lengths[j] = points[i].arc_length;
+    }
+
+    offsets.push_back(base + count);
+    splines.emplace_back();
+    spline_valid.push_back(0);
+}
+
+void PathSetImpl::reorder(const int* order, const bool* reversed) {
+    const size_t count = static_cast<size_t>(seam_count());
+    const size_t total = point_count();
+    std::vector<size_t> new_offsets(count + 1, 0);
+    for (size_t i = 0; i < count; ++i) new_offsets[i + 1] = new_offsets[i] + seam_size(order[i]);
+
+    TrackedVector<float> new_positions(total * 3), new_normals(total * 3), new_tangents(total * 3);
+    TrackedVector<float> new_arc_lengths(total);
+    std::vector<PathSpline> new_splines(count);
+    std::vector<char> new_valid(count, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const size_t src = offsets[order[i]];
+        const size_t n = seam_size(order[i]);
+        const bool backwards = reversed && reversed[i];
+        const float seam_length = n > 0 ? arc_lengths[src + n - 1] : 0.0f;
+        for (size_t p = 0; p < n; ++p) {
+            size_t j = src + (backwards ? n - 1 - p : p);
+            size_t d = new_offsets[i] + p;
+            for (int k = 0; k < 3; ++k) {
+                new_positions[d*3 + k] = positions[j*3 + k];
+                new_normals[d*3 + k] = normals[j*3 + k];
+                new_tangents[d*3 + k] = backwards ? -tangents[j*3 + k] : tangents[j*3 + k];
+            }
+            new_arc_lengths[d] = backwards ? seam_length - arc_lengths[j] : arc_lengths[j];
+        }
+        if (!backwards) {
+            new_splines[i] = std::move(splines[order[i]]);
+            new_valid[i] = spline_valid[order[i]];
+        }
+    }
+
+    offsets.swap(new_offsets);
+    positions.swap(new_positions);
+    normals.swap(new_normals);
+    tangents.swap(new_tangents);
+    arc_lengths.swap(new_arc_lengths);
+    splines.swap(new_splines);
+    spline_valid.swap(new_valid);
+}
+
+size_t PathSetImpl::memory_bytes() const {
+    size_t bytes = vector_bytes(offsets) + vector_bytes(positions) + vector_bytes(normals) +
+                   vector_bytes(tangents) + vector_bytes(arc_lengths) +
+                   vector_bytes(splines) + vector_bytes(spline_valid);
+    for (const PathSpline& spline : splines) bytes += spline.memory_bytes();
+    return bytes;
+}
+
+void PathSetImpl::get_points(size_t begin, size_t end, WeldPoint* out) const {
+    for (size_t j = begin; j < end; ++j) {
+        WeldPoint& wp = out[j - begin];
+        for (int k = 0; k < 3; ++k) {
+            wp.position[k] = positions[j*3 + k];
+            wp.normal[k] = normals[j*3 + k];
+            wp.tangent[k] = tangents[j*3 + k];
+        }
+        wp.arc_length = arc_lengths[j];
+    }
+}
+
+int PathSetImpl::worker_count() const {
+    return num_threads > 0 ? num_threads : parallel_default_threads();
+}
+
+const PathSpline& PathSetImpl::get_spline(int seam, const std::vector<WeldPoint>& points) {
+    if (!spline_valid[seam]) {
+        splines[seam].build(points);
+        spline_valid[seam] = 1;
+    }
+    return splines[seam];
+}
+
+template <typename Fn>
+void PathSetImpl::transform_seams(Fn fn) {
+    const size_t count = static_cast<size_t>(seam_count());
+    const int threads = worker_count();
+    std::vector<std::vector<WeldPoint>> results(count);
+    std::vector<char> keep_spline(count, 0);
+
+    parallel_for(0, count, 1, [&](size_t lo, size_t hi) {
+        for (size_t seam = lo; seam < hi; ++seam) {
+            std::vector<WeldPoint>& points = results[seam];
+            points.resize(offsets[seam + 1] - offsets[seam]);
+            get_points(offsets[seam], offsets[seam + 1], points.data());
+            keep_spline[seam] = fn(static_cast<int>(seam), points) ? 1 : 0;
+        }
+    }, threads);
+
+    std::vector<size_t> new_offsets(count + 1, 0);
+    for (size_t seam = 0; seam < count; ++seam) {
+        new_offsets[seam + 1] = new_offsets[seam] + results[seam].size();
+    }
+    const size_t total = new_offsets[count];
+
+    TrackedVector<float> new_positions(total * 3), new_normals(total * 3), new_tangents(total * 3);
+    TrackedVector<float> new_arc_lengths(total);
+
+    parallel_for(0, count, 1, [&](size_t lo, size_t hi) {
+        for (size_t seam = lo; seam < hi; ++seam) {
+            std::vector<WeldPoint>& points = results[seam];
+            size_t base = new_offsets[seam];
+            for (size_t i = 0; i < points.size(); ++i) {
+                size_t j = base + i;
+                for (int k = 0; k < 3; ++k) {
+                    new_positions[j*3 + k] = points[i].position[k];
+                    new_normals[j*3 + k] = points[i].normal[k];
+                    new_tangents[j*3 + k] = points[i].tangent[k];
+                }
+                new_arc_lengths[j] = points[i].arc_length;
+            }
+            std::vector<WeldPoint>().swap(points);
+        }
+    }, threads);
+
+    offsets.swap(new_offsets);
+    positions.swap(new_positions);
+    normals.swap(new_normals);
+    tangents.swap(new_tangents);
+    arc_lengths.swap(new_arc_lengths);
+    for (size_t seam = 0; seam < count; ++seam) {
+        if (!keep_spline[seam]) spline_valid[seam] = 0;
+    }
+}
+
+void PathSetImpl::resample(float step_size) {
+    transform_seams([&](int seam, std::vector<WeldPoint>& points) {
+        if (points.size() < 2) return true;
+
+        std::vector<WeldPoint> sampled;
+        get_spline(seam, points).sample_uniform(step_size, sampled);
+        points.swap(sampled);
+        return true;
+    });
+}
+
+void PathSetImpl::resample_adaptive(const AdaptiveResampleSettings& s) {
+    transform_seams([&](int seam, std::vector<WeldPoint>& points) {
+        if (points.size() < 2) return true;
+
+        std::vector<WeldPoint> sampled;
+        get_spline(seam, points).sample_adaptive(s.chord_tolerance, s.angle_tolerance,
+                                                 s.min_step, s.max_step, sampled);
+        points.swap(sampled);
+        return true;
+    });
+}
+
+void PathSetImpl::smooth(const SmoothingSettings& settings) {
+    transform_seams([&](int, std::vector<WeldPoint>& points) {
+        smooth_path_points(points, settings);
+        update_tangents_and_arc_length(points);
+        return false;
+    });
+}
+
+void PathSetImpl::apply_weave(const WeaveSettings& settings, const WeaveProfile& profile) {
+    if (settings.type == WEAVE_NONE) return;
+
+    transform_seams([&](int seam, std::vector<WeldPoint>& points) {
+        if (points.size() < 2) return true;
+
+        std::vector<WeldPoint> woven;
+        weave_generate(get_spline(seam, points), settings, profile, woven);
+        points.swap(woven);
+        return false;
+    });
+}
+
+size_t PathSetImpl::to_joints(const RobotImpl& robot, float standoff,
+                              const TrajectoryIKSettings& settings, const double* seed,
+                              double* out_joints, SMRErrorCode* out_status) const {
+    const size_t count = static_cast<size_t>(seam_count());
+    const int threads = worker_count();
+
+    // Seams run side by side; workers left over go to each seam's own chunks
+    TrajectoryIKSettings seam_settings = settings;
+    seam_settings.num_threads = std::max(1, threads / static_cast<int>(std::max<size_t>(count, 1)));
+
+    // Seams report into their own control; the set reports points done overall
+    JobControl* job = job_current();
+    std::atomic<size_t> reachable(0);
+    std::atomic<size_t> points_done(0);
+    parallel_for(0, count, 1, [&](size_t lo, size_t hi) {
+        JobControl seam_job;
+        seam_job.parent = job;
+        JobScope scope(job ? &seam_job : nullptr);
+
+        std::vector<WeldPoint> points;
+        std::vector<Matrix4x4> targets;
+        for (size_t seam = lo; seam < hi; ++seam) {
+            size_t base = offsets[seam];
+            size_t n = offsets[seam + 1] - base;
+            if (n == 0) continue;
+
+            points.resize(n);
+            targets.resize(n);
+            get_points(base, base + n, points.data());
+            for (size_t i = 0; i < n; ++i) build_tool_target(points[i], standoff, targets[i]);
+
+            reachable += solve_trajectory_ik(robot, targets.data(), n, seam_settings, seed,
+                                             out_joints + base * 6, out_status + base);
+            if (job) {
+                size_t done = points_done.fetch_add(n) + n;
+                job->progress.store(static_cast<float>(done) / point_count(), std::memory_order_relaxed);
+            }
+        }
+    }, threads);
+
+    return reachable.load();
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+SMR_API PathSetHandle smr_path_set_create(int num_threads) {
+    auto* set = new PathSetImpl();
+    set->num_threads = std::max(num_threads, 0);
+    return set;
+}
+
+SMR_API void smr_path_set_destroy(PathSetHandle handle) {
+    delete static_cast<PathSetImpl*>(handle);
+}
+
+SMR_API SMRErrorCode smr_path_set_add_seam(PathSetHandle handle,
+                                            const float* points,
+                                            const float* normals,
+                                            int count,
+                                            int* out_seam) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!points || !normals || count <= 0) return SMR_ERROR_INVALID_PARAMETER;
+
+    auto* set = static_cast<PathSetImpl*>(handle);
+    set->add_seam(points, normals, static_cast<size_t>(count));
+    if (out_seam) *out_seam = set->seam_count() - 1;
+    return SMR_SUCCESS;
+}
+
+SMR_API int smr_path_set_get_seam_count(PathSetHandle handle) {
+    if (!handle) return -1;
+    return static_cast<PathSetImpl*>(handle)->seam_count();
+}
+
+SMR_API int smr_path_set_get_count(PathSetHandle handle) {
+    if (!handle) return -1;
+    return static_cast<int>(static_cast<PathSetImpl*>(handle)->point_count());
+}
+
+SMR_API long long smr_path_set_get_memory(PathSetHandle handle) {
+    if (!handle) return -1;
+    return static_cast<long long>(static_cast<PathSetImpl*>(handle)->memory_bytes());
+}
+
+SMR_API SMRErrorCode smr_path_set_get_offsets(PathSetHandle handle, int* out_offsets) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!out_offsets) return SMR_ERROR_INVALID_PARAMETER;
+
+    auto* set = static_cast<PathSetImpl*>(handle);
+    for (size_t i = 0; i < set->offsets.size(); ++i) {
+        out_offsets[i] = static_cast<int>(set->offsets[i]);
+    }
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_set_get_points(PathSetHandle handle, WeldPoint* out_points) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!out_points) return SMR_ERROR_INVALID_PARAMETER;
+
+    auto* set = static_cast<PathSetImpl*>(handle);
+    set->get_points(0, set->point_count(), out_points);
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_set_get_seam_points(PathSetHandle handle, int seam,
+                                                   WeldPoint* out_points) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+
+    auto* set = static_cast<PathSetImpl*>(handle);
+    if (seam < 0 || seam >= set->seam_count() || !out_points) return SMR_ERROR_INVALID_PARAMETER;
+    set->get_points(set->offsets[seam], set->offsets[seam + 1], out_points);
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_set_get_arrays(PathSetHandle handle,
+                                              float* out_positions,
+                                              float* out_normals,
+                                              float* out_tangents,
+                                              float* out_arc_lengths) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+
+    auto* set = static_cast<PathSetImpl*>(handle);
+    size_t count = set->point_count();
+    if (out_positions) std::memcpy(out_positions, set->positions.data(), count * 3 * sizeof(float));
+    if (out_normals) std::memcpy(out_normals, set->normals.data(), count * 3 * sizeof(float));
+    if (out_tangents) std::memcpy(out_tangents, set->tangents.data(), count * 3 * sizeof(float));
+    if (out_arc_lengths) std::memcpy(out_arc_lengths, set->arc_lengths.data(), count * sizeof(float));
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_set_reorder(PathSetHandle handle, const int* order,
+                                           const bool* reversed) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!order) return SMR_ERROR_INVALID_PARAMETER;
+
+    auto* set = static_cast<PathSetImpl*>(handle);
+    const int count = set->seam_count();
+    std::vector<char> seen(count, 0);
+    for (int i = 0; i < count; ++i) {
+        if (order[i] < 0 || order[i] >= count || seen[order[i]]) return SMR_ERROR_INVALID_PARAMETER;
+        seen[order[i]] = 1;
+    }
+    set->reorder(order, reversed);
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_set_resample(PathSetHandle handle, float step_size) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (step_size <= 0) return SMR_ERROR_INVALID_PARAMETER;
+    static_cast<PathSetImpl*>(handle)->resample(step_size);
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_set_resample_adaptive(PathSetHandle handle,
+                                                     const AdaptiveResampleSettings* settings) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+
+    AdaptiveResampleSettings s = adaptive_resample_resolve_settings(settings);
+    if (s.min_step > s.max_step) return SMR_ERROR_INVALID_PARAMETER;
+    static_cast<PathSetImpl*>(handle)->resample_adaptive(s);
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_set_smooth(PathSetHandle handle, const SmoothingSettings* settings) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (settings && settings->window_size != 0 && settings->window_size < 3) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+    static_cast<PathSetImpl*>(handle)->smooth(smoothing_resolve_settings(settings));
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_set_apply_weave(PathSetHandle handle,
+                                               const WeaveSettings* settings,
+                                               const float* profile,
+                                               int profile_samples) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+
+    WeaveSettings s = weave_resolve_settings(settings);
+    if (s.type < WEAVE_NONE || s.type > WEAVE_CUSTOM) return SMR_ERROR_INVALID_PARAMETER;
+
+    WeaveProfile weave_profile;
+    weave_profile.type = s.type;
+    if (s.type == WEAVE_CUSTOM) {
+        if (!profile || profile_samples < 2) return SMR_ERROR_INVALID_PARAMETER;
+        weave_profile.table.assign(profile, profile + static_cast<size_t>(profile_samples) * 2);
+    }
+
+    // All seams together, so a rejected weave leaves every seam as it was
+    auto* set = static_cast<PathSetImpl*>(handle);
+    if (s.type != WEAVE_NONE) {
+        double samples = 0.0;
+        for (int seam = 0; seam < set->seam_count(); ++seam) {
+            if (set->seam_size(seam) < 2) continue;
+            samples += weave_sample_count(set->arc_lengths[set->offsets[seam + 1] - 1], s);
+        }
+        if (!(samples <= WEAVE_MAX_SAMPLES)) return SMR_ERROR_INVALID_PARAMETER;
+    }
+    set->apply_weave(s, weave_profile);
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_path_set_to_joints(PathSetHandle set_handle,
+                                             RobotHandle robot_handle,
+                                             float standoff,
+                                             const TrajectoryIKSettings* settings,
+                                             const double* seed_joints,
+                                             double* out_joints,
+                                             bool* out_reachable,
+                                             SMRErrorCode* out_status) {
+    if (!set_handle || !robot_handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!out_joints || !out_reachable) return SMR_ERROR_INVALID_PARAMETER;
+
+    auto* set = static_cast<PathSetImpl*>(set_handle);
+    auto* robot = static_cast<RobotImpl*>(robot_handle);
+    size_t count = set->point_count();
+    if (count == 0) return SMR_SUCCESS;
+
+    TrajectoryIKSettings s = trajectory_ik_resolve_settings(settings);
+
+    std::vector<SMRErrorCode> status(count);
+    set->to_joints(*robot, standoff, s, seed_joints, out_joints, status.data());
+
+    for (size_t i = 0; i < count; ++i) {
+        out_reachable[i] = (status[i] == SMR_SUCCESS);
+    }
+    if (out_status) {
+        std::memcpy(out_status, status.data(), count * sizeof(SMRErrorCode));
+    }
+
+    return SMR_SUCCESS;
+}
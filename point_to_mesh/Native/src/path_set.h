@@ -0,0 +1,86 @@
+/**
+ * @file path_set.h
+ * @brief Internal Path Set Type (many seams, batch operations)
+ */
+
+#ifndef SMR_PATH_SET_H
+#define SMR_PATH_SET_H
+
+#include "smr_welding_api.h"
+#include "memory_tracker.h"
+#include "robot_kinematics.h"
+#include "path_spline.h"
+#include "weave.h"
+#include <vector>
+#include <cstddef>
+
+// =============================================================================
+// Internal Path Set Class
+// =============================================================================
+
+/**
+ * All seams of a part in one structure-of-arrays buffer: seam i owns points
+ * [offsets[i], offsets[i+1]). Batch operations run seam by seam on worker
+ * threads (one seam per task) and repack the results, so a whole part is
+ * resampled, smoothed, woven or solved in one call.
+ *
+ * Each seam keeps its own spline like PathImpl does, so repeated resampling
+ * of a set does not degrade its seams either.
+ */
+class PathSetImpl {
+public:
+    int num_threads = 0;              // Seam-level workers (0 = thread pool size)
+
+    std::vector<size_t> offsets;      // seam_count + 1 entries, offsets[0] = 0
+    TrackedVector<float> positions;     // XYZ * point_count
+    TrackedVector<float> normals;       // XYZ * point_count
+    TrackedVector<float> tangents;      // XYZ * point_count
+    TrackedVector<float> arc_lengths;   // point_count (restarts at 0 on every seam)
+
+    PathSetImpl() : offsets(1, 0) {}
+
+    int seam_count() const { return static_cast<int>(offsets.size() - 1); }
+    size_t point_count() const { return arc_lengths.size(); }
+    size_t seam_size(int seam) const { return offsets[seam + 1] - offsets[seam]; }
+
+    /// Bytes reserved by the point arrays and cached splines
+    size_t memory_bytes() const;
+
+    /// Append a seam from positions and normals (tangents and arc length are derived)
+    void add_seam(const float* seam_positions, const float* seam_normals, size_t count);
+    /// Append a seam as is
+    void add_seam(const WeldPoint* points, size_t count);
+
+    /// Rearrange seams: new seam i is old seam order[i], run backwards if reversed[i]
+    void reorder(const int* order, const bool* reversed);
+
+    /// Copy points [begin, end) of the whole set as weld points
+    void get_points(size_t begin, size_t end, WeldPoint* out) const;
+
+    void resample(float step_size);
+    void resample_adaptive(const AdaptiveResampleSettings& settings);
+    void smooth(const SmoothingSettings& settings);
+    void apply_weave(const WeaveSettings& settings, const WeaveProfile& profile);
+
+    /**
+     * Trajectory IK per seam, every seam starting from `seed` (home if NULL).
+     * Output is laid out like the points (point_count * 6 joints and codes).
+     * Returns the number of reachable points.
+     */
+    size_t to_joints(const RobotImpl& robot, float standoff, const TrajectoryIKSettings& settings,
+                     const double* seed, double* out_joints, SMRErrorCode* out_status) const;
+
+private:
+    std::vector<PathSpline> splines;  // Per seam, fitted on first use
+    std::vector<char> spline_valid;
+
+    int worker_count() const;
+    const PathSpline& get_spline(int seam, const std::vector<WeldPoint>& points);
+
+    /// Run fn(seam, points) on every seam in parallel and repack the results;
+    /// fn returns true if the seam's spline still describes its new points
+    template <typename Fn>
+    void transform_seams(Fn fn);
+};
+
+#endif // SMR_PATH_SET_H
@@ -0,0 +1,490 @@
+/**
+ * @file path_smoothing.cpp
+ * @brief Linear-Time Path Filters Implementation
+ */
+
+#include "path_smoothing.h"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+static const int SG_MAX_ORDER = 5;
+static const int SG_REANCHOR = 1024;     // Recompute sliding moments exactly this often
+static const int PATH_CHANNELS = 6;      // Position XYZ, normal XYZ
+
+SmoothingSettings smoothing_resolve_settings(const SmoothingSettings* settings) {
+    SmoothingSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.method < SMOOTH_MOVING_AVERAGE || s.method > SMOOTH_BSPLINE) s.method = SMOOTH_MOVING_AVERAGE;
+    if (s.window_size <= 0) s.window_size = 9;
+    if (s.polynomial_order <= 0) s.polynomial_order = 2;
+    s.polynomial_order = std::min(s.polynomial_order, SG_MAX_ORDER);
+    if (s.corner_angle <= 0) s.corner_angle = 0.5f;
+    return s;
+}
+
+// Filters run in place over WeldPoint AoS with small ring buffers of original
+// samples: dense paths are several MB, and fresh SoA copies cost more in page
+// faults than the filtering itself.
+
+static inline void load_sample(const WeldPoint& wp, double* value) {
+    for (int k = 0; k < 3; ++k) {
+        value[k] = wp.position[k];
+        value[3 + k] = wp.normal[k];
+    }
+}
+
+// Overwrite a sample with filtered channels, renormalizing the normal
+static void store_sample(WeldPoint& wp, const double* value) {
+    double len = std::sqrt(value[3]*value[3] + value[4]*value[4] + value[5]*value[5]);
+    for (int k = 0; k < 3; ++k) {
+        wp.position[k] = static_cast<float>(value[k]);
+        if (len > 1e-9) wp.normal[k] = static_cast<float>(value[3 + k] / len);
+    }
+}
+
+/// Originals of the most recent `capacity` samples of a stretch being
+/// overwritten front to back
+class SampleHistory {
+public:
+    SampleHistory(const WeldPoint* points, int capacity)
+        : points(points), capacity(capacity), num_saved(0),
+          ring(static_cast<size_t>(capacity) * PATH_CHANNELS) {}
+
+    /// Original channels of sample j, which must be saved already
+    const double* saved(int j) const { return &ring[(j % capacity) * PATH_CHANNELS]; }
+
+    void get(int j, double* value) const {
+        if (j < num_saved) std::memcpy(value, saved(j), sizeof(double) * PATH_CHANNELS);
+        else load_sample(points[j], value);
+    }
+
+    /// Call before overwriting sample j (in order)
+    void save(int j) {
+        load_sample(points[j], &ring[(j % capacity) * PATH_CHANNELS]);
+        num_saved = j + 1;
+    }
+
+private:
+    const WeldPoint* points;
+    int capacity;
+    int num_saved;
+    std::vector<double> ring;
+};
+
+// =============================================================================
+// Savitzky-Golay (order 0 = moving average)
+// =============================================================================
+
+/// Weights on the normalized moments S_k = sum_j (j/h)^k y[i+j], j in [-h, h],
+/// that give the least-squares polynomial value at the window center
+static int sg_center_weights(int h, int order, double* c) {
+    int p = std::min(order, 2 * h);
+    int m = p + 1;
+
+    double pw[2 * SG_MAX_ORDER + 1] = {0};
+    for (int j = -h; j <= h; ++j) {
+        double u = static_cast<double>(j) / h, term = 1.0;
+        for (int e = 0; e <= 2 * p; ++e) {
+            pw[e] += term;
+            term *= u;
+        }
+    }
+
+    // Gram matrix G_ab = sum u^(a+b), solve G c = e0
+    double g[SG_MAX_ORDER + 1][SG_MAX_ORDER + 2];
+    for (int a = 0; a < m; ++a) {
+        for (int b = 0; b < m; ++b) g[a][b] = pw[a + b];
+        g[a][m] = (a == 0) ? 1.0 : 0.0;
+    }
+    for (int col = 0; col < m; ++col) {
+        int pivot = col;
+        for (int r = col + 1; r < m; ++r) {
+            if (std::abs(g[r][col]) > std::abs(g[pivot][col])) pivot = r;
+        }
+        for (int k = 0; k <= m; ++k) std::swap(g[col][k], g[pivot][k]);
+        for (int r = 0; r < m; ++r) {
+            if (r == col) continue;
+            double f = g[r][col] / g[col][col];
+            for (int k = col; k <= m; ++k) g[r][k] -= f * g[col][k];
+        }
+    }
+    for (int a = 0; a < m; ++a) c[a] = g[a][m] / g[a][a];
+    return p;
+}
+
+/// Center weights for every half width 1..h (shrunken windows at stretch ends)
+struct SGKernel {
+    int h;
+    std::vector<int> order;        // Effective order per half width
+    std::vector<double> weights;   // (SG_MAX_ORDER + 1) per half width
+};
+
+static void sg_build_kernel(int h, int order, SGKernel& kernel) {
+    kernel.h = h;
+    kernel.order.assign(h + 1, 0);
+    kernel.weights.assign(static_cast<size_t>(h + 1) * (SG_MAX_ORDER + 1), 0.0);
+    for (int hi = 1; hi <= h; ++hi) {
+        kernel.order[hi] = sg_center_weights(hi, order, &kernel.weights[hi * (SG_MAX_ORDER + 1)]);
+    }
+}
+
+static void sg_moments(const SampleHistory& y, int i, int h, int p,
+                       double moments[][SG_MAX_ORDER + 1]) {
+    for (int c = 0; c < PATH_CHANNELS; ++c) {
+        for (int k = 0; k <= p; ++k) moments[c][k] = 0.0;
+    }
+    for (int j = -h; j <= h; ++j) {
+        double u = static_cast<double>(j) / h;
+        double sample[PATH_CHANNELS];
+        y.get(i + j, sample);
+        for (int c = 0; c < PATH_CHANNELS; ++c) {
+            double term = sample[c];
+            for (int k = 0; k <= p; ++k) {
+                moments[c][k] += term;
+                term *= u;
+            }
+        }
+    }
+}
+
+static void savitzky_golay(WeldPoint* points, int n, const SGKernel& kernel) {
+    const int h = kernel.h;
+    const int p = kernel.order[h];
+    const double* c_main = &kernel.weights[h * (SG_MAX_ORDER + 1)];
+    SampleHistory y(points, 2 * h + 2);
+
+    // Shifting the center by one sample: with T_r the moments of the new
+    // window taken about the old center, S'_m = sum_r C(m,r) (-1/h)^(m-r) T_r
+    double shift[SG_MAX_ORDER + 1][SG_MAX_ORDER + 1] = {{0}};
+    double lead[SG_MAX_ORDER + 1], trail[SG_MAX_ORDER + 1];
+    for (int m = 0; m <= p; ++m) {
+        double binom = 1.0;
+        for (int r = m; r >= 0; --r) {
+            shift[m][r] = binom * std::pow(-1.0 / h, m - r);
+            binom = binom * r / (m - r + 1);
+        }
+        trail[m] = std::pow(-1.0, m);
+        lead[m] = std::pow(static_cast<double>(h + 1) / h, m);
+    }
+
+    double moments[PATH_CHANNELS][SG_MAX_ORDER + 1];
+    bool sliding = false;
+    for (int i = 0; i < n; ++i) {
+        int hi = std::min(h, std::min(i, n - 1 - i));
+        double value[PATH_CHANNELS];
+
+        if (hi == 0) {
+            load_sample(points[i], value);
+        } else if (hi < h) {
+            double local[PATH_CHANNELS][SG_MAX_ORDER + 1];
+            int pi = kernel.order[hi];
+            const double* w = &kernel.weights[hi * (SG_MAX_ORDER + 1)];
+            sg_moments(y, i, hi, pi, local);
+            for (int c = 0; c < PATH_CHANNELS; ++c) {
+                value[c] = 0.0;
+                for (int k = 0; k <= pi; k += 2) value[c] += w[k] * local[c][k];
+            }
+        } else {
+            if (!sliding || (i - h) % SG_REANCHOR == 0) {
+                sg_moments(y, i, h, p, moments);
+                sliding = true;
+            } else {
+                const double* y_out = y.saved(i - 1 - h);
+                double y_in[PATH_CHANNELS];
+                load_sample(points[i + h], y_in);
+                for (int c = 0; c < PATH_CHANNELS; ++c) {
+                    double t[SG_MAX_ORDER + 1];
+                    for (int r = 0; r <= p; ++r) t[r] = moments[c][r] - trail[r] * y_out[c] + lead[r] * y_in[c];
+                    for (int m = 0; m <= p; ++m) {
+                        double v = 0.0;
+                        for (int r = 0; r <= m; ++r) v += shift[m][r] * t[r];
+                        moments[c][m] = v;
+                    }
+                }
+            }
+            for (int c = 0; c < PATH_CHANNELS; ++c) {
+                value[c] = 0.0;
+                for (int k = 0; k <= p; k += 2) value[c] += c_main[k] * moments[c][k];
+            }
+        }
+
+        y.save(i);
+        store_sample(points[i], value);
+    }
+}
+
+// =============================================================================
+// Least-Squares Cubic B-Spline
+// =============================================================================
+
+// Cubic basis values at u on the clamped uniform knot vector with `spans`
+// spans; returns the first of the four affected control points
+static int bspline_basis(double u, int spans, double* basis) {
+    int s = std::min(static_cast<int>(std::floor(u)), spans - 1);
+    s = std::max(s, 0);
+    auto knot = [spans](int i) {
+        return static_cast<double>(std::min(std::max(i - 3, 0), spans));
+    };
+    int span = s + 3;
+
+    double left[4], right[4];
+    basis[0] = 1.0;
+    for (int j = 1; j <= 3; ++j) {
+        left[j] = u - knot(span + 1 - j);
+        right[j] = knot(span + j) - u;
+        double saved = 0.0;
+        for (int r = 0; r < j; ++r) {
+            double denom = right[r + 1] + left[j - r];
+            double temp = denom != 0.0 ? basis[r] / denom : 0.0;
+            basis[r] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        basis[j] = saved;
+    }
+    return s;
+}
+
+static void bspline_fit(WeldPoint* points, int n, int span_samples) {
+    if (n < 4) return;
+    int spans = std::max(1, static_cast<int>(std::lround(static_cast<double>(n - 1) / span_samples)));
+
+    // Chord-length parameter over the positions, recomputed per pass
+    auto chord = [&](int i) {
+        const float* a = points[i - 1].position;
+        const float* b = points[i].position;
+        double dx = b[0] - a[0], dy = b[1] - a[1], dz = b[2] - a[2];
+        return std::sqrt(dx*dx + dy*dy + dz*dz);
+    };
+    double length = 0.0;
+    for (int i = 1; i < n; ++i) length += chord(i);
+    if (length < 1e-12) return;
+    const double scale = spans / length;
+
+    // Control points 0 and last are pinned to the stretch ends; the rest form
+    // a symmetric band system with half bandwidth 3
+    const int num_ctrl = spans + 3;
+    const int m = num_ctrl - 2;
+    std::vector<double> band(static_cast<size_t>(m) * 4, 0.0);
+    std::vector<double> rhs(static_cast<size_t>(m) * PATH_CHANNELS, 0.0);
+    double ends[2][PATH_CHANNELS];
+    load_sample(points[0], ends[0]);
+    load_sample(points[n - 1], ends[1]);
+
+    double arc = 0.0;
+    for (int i = 0; i < n; ++i) {
+        if (i > 0) arc += chord(i);
+        double basis[4];
+        int first = bspline_basis(std::min(arc * scale, static_cast<double>(spans)), spans, basis);
+        double residual[PATH_CHANNELS];
+        load_sample(points[i], residual);
+        for (int q = 0; q < 4; ++q) {
+            int ctrl = first + q;
+            if (ctrl == 0 || ctrl == num_ctrl - 1) {
+                const double* end = ends[ctrl == 0 ? 0 : 1];
+                for (int c = 0; c < PATH_CHANNELS; ++c) residual[c] -= basis[q] * end[c];
+            }
+        }
+        for (int q = 0; q < 4; ++q) {
+            int row = first + q - 1;
+            if (row < 0 || row >= m) continue;
+            for (int c = 0; c < PATH_CHANNELS; ++c) rhs[row * PATH_CHANNELS + c] += basis[q] * residual[c];
+            for (int q2 = q; q2 < 4; ++q2) {
+                int col = first + q2 - 1;
+                if (col >= m) break;
+                band[row * 4 + (col - row)] += basis[q] * basis[q2];
+            }
+        }
+    }
+
+    // Banded Cholesky: band[j*4 + d] becomes L(j + d, j)
+    for (int j = 0; j < m; ++j) band[j * 4] += 1e-9;
+    for (int j = 0; j < m; ++j) {
+        double diag = band[j * 4];
+        for (int k = std::max(0, j - 3); k < j; ++k) {
+            double l = band[k * 4 + (j - k)];
+            diag -= l * l;
+        }
+        diag = std::sqrt(std::max(diag, 1e-12));
+        band[j * 4] = diag;
+        for (int i = j + 1; i <= std::min(m - 1, j + 3); ++i) {
+            double v = band[j * 4 + (i - j)];
+            for (int k = std::max(0, i - 3); k < j; ++k) {
+                v -= band[k * 4 + (i - k)] * band[k * 4 + (j - k)];
+            }
+            band[j * 4 + (i - j)] = v / diag;
+        }
+    }
+    for (int c = 0; c < PATH_CHANNELS; ++c) {
+        for (int j = 0; j < m; ++j) {
+            double v = rhs[j * PATH_CHANNELS + c];
+            for (int k = std::max(0, j - 3); k < j; ++k) v -= band[k * 4 + (j - k)] * rhs[k * PATH_CHANNELS + c];
+            rhs[j * PATH_CHANNELS + c] = v / band[j * 4];
+        }
+        for (int j = m - 1; j >= 0; --j) {
+            double v = rhs[j * PATH_CHANNELS + c];
+            for (int i = j + 1; i <= std::min(m - 1, j + 3); ++i) v -= band[j * 4 + (i - j)] * rhs[i * PATH_CHANNELS + c];
+            rhs[j * PATH_CHANNELS + c] = v / band[j * 4];
+        }
+    }
+
+    // Evaluate in place; the chord parameter needs the previous original
+    float prev[3] = {points[0].position[0], points[0].position[1], points[0].position[2]};
+    arc = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const float* cur = points[i].position;
+        double dx = cur[0] - prev[0], dy = cur[1] - prev[1], dz = cur[2] - prev[2];
+        arc += std::sqrt(dx*dx + dy*dy + dz*dz);
+        std::memcpy(prev, cur, sizeof(prev));
+
+        double basis[4];
+        int first = bspline_basis(std::min(arc * scale, static_cast<double>(spans)), spans, basis);
+        double value[PATH_CHANNELS];
+        for (int c = 0; c < PATH_CHANNELS; ++c) {
+            double v = 0.0;
+            for (int q = 0; q < 4; ++q) {
+                int ctrl = first + q;
+                double p = (ctrl == 0) ? ends[0][c]
+                         : (ctrl == num_ctrl - 1) ? ends[1][c]
+                         : rhs[(ctrl - 1) * PATH_CHANNELS + c];
+                v += basis[q] * p;
+            }
+            value[c] = v;
+        }
+        store_sample(points[i], value);
+    }
+}
+
+// =============================================================================
+// Corner Splitting
+// =============================================================================
+
+// Sharpest sample of each cluster of turns above the threshold (clusters are
+// at least a window apart). Turns are measured +-h samples away on moving
+// averages of the positions, so sample noise denser than the seam does not
+// read as a corner while real corners keep (nearly) their full turn.
+static std::vector<int> find_corners(const std::vector<WeldPoint>& points, int h, float corner_angle) {
+    std::vector<int> corners;
+    const int n = static_cast<int>(points.size());
+    if (corner_angle >= static_cast<float>(M_PI) || h < 1 || n < 2 * h + 1) return corners;
+
+    const double cos_threshold = std::cos(static_cast<double>(corner_angle));
+    std::vector<double> corner_cos;
+
+    // Means over [i-h, i+h] (clipped), streamed into a ring of the last 2h+1
+    const int cap = 2 * h + 1;
+    std::vector<double> means(static_cast<size_t>(cap) * 3);
+    double sum[3] = {0, 0, 0};
+    int count = 0;
+    for (int j = 0; j <= std::min(h, n - 1); ++j) {
+        for (int k = 0; k < 3; ++k) sum[k] += points[j].position[k];
+        ++count;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (i > 0) {
+            if (i + h < n) {
+                for (int k = 0; k < 3; ++k) sum[k] += points[i + h].position[k];
+                ++count;
+            }
+            if (i - h - 1 >= 0) {
+                for (int k = 0; k < 3; ++k) sum[k] -= points[i - h - 1].position[k];
+                --count;
+            }
+        }
+        for (int k = 0; k < 3; ++k) means[(i % cap) * 3 + k] = sum[k] / count;
+        if (i < 2 * h) continue;
+
+        // Turn at center i - h between the means h samples to either side
+        const double* prev = &means[((i - 2 * h) % cap) * 3];
+        const double* cur = &means[((i - h) % cap) * 3];
+        const double* next = &means[(i % cap) * 3];
+        double a[3], b[3];
+        for (int k = 0; k < 3; ++k) {
+            a[k] = cur[k] - prev[k];
+            b[k] = next[k] - cur[k];
+        }
+        double la = std::sqrt(a[0]*a[0] + a[1]*a[1] + a[2]*a[2]);
+        double lb = std::sqrt(b[0]*b[0] + b[1]*b[1] + b[2]*b[2]);
+        if (la < 1e-12 || lb < 1e-12) continue;
+        double cos_turn = (a[0]*b[0] + a[1]*b[1] + a[2]*b[2]) / (la * lb);
+        if (cos_turn >= cos_threshold) continue;
+
+        int center = i - h;
+        if (!corners.empty() && center - corners.back() <= 2 * h) {
+            // Same corner seen from a neighbouring sample: keep the sharpest
+            if (cos_turn < corner_cos.back()) {
+                corners.back() = center;
+                corner_cos.back() = cos_turn;
+            }
+        } else {
+            corners.push_back(center);
+            corner_cos.push_back(cos_turn);
+        }
+    }
+    return corners;
+}
+
+// =============================================================================
+// Entry Point
+// =============================================================================
+
+void smooth_path_points(std::vector<WeldPoint>& points, const SmoothingSettings& s) {
+    const int n = static_cast<int>(points.size());
+    const int h = s.window_size / 2;
+    if (n < 3 || h < 1) return;
+
+    std::vector<int> bounds;
+    bounds.push_back(0);
+    for (int corner : find_corners(points, h, s.corner_angle)) bounds.push_back(corner);
+    bounds.push_back(n - 1);
+
+    SGKernel kernel;
+    if (s.method != SMOOTH_BSPLINE) {
+        int order = (s.method == SMOOTH_SAVITZKY_GOLAY) ? s.polynomial_order : 0;
+        sg_build_kernel(h, order, kernel);
+    }
+
+    // Stretches share their corner samples, which every filter keeps fixed
+    for (size_t b = 0; b + 1 < bounds.size(); ++b) {
+        WeldPoint* first = &points[bounds[b]];
+        int len = bounds[b + 1] - bounds[b] + 1;
+        if (s.method == SMOOTH_BSPLINE) {
+            bspline_fit(first, len, std::max(2, h));
+        } else {
+            savitzky_golay(first, len, kernel);
+        }
+    }
+}
+
+void update_tangents_and_arc_length(std::vector<WeldPoint>& points) {
+    float arc = 0.0f;
+    for (size_t i = 0; i < points.size(); ++i) {
+        size_t next = std::min(i + 1, points.size() - 1);
+        size_t prev = (i > 0) ? i - 1 : 0;
+        
+        WeldPoint& wp = points[i];
+        wp.tangent[0] = points[next].position[0] - points[prev].position[0];
+        wp.tangent[1] = points[next].position[1] - points[prev].position[1];
+        wp.tangent[2] = points[next].position[2] - points[prev].position[2];
+        
+        float len = std::sqrt(wp.tangent[0]*wp.tangent[0] +
+                              wp.tangent[1]*wp.tangent[1] +
+                              wp.tangent[2]*wp.tangent[2]);
+        if (len > 1e-6f) {
+            wp.tangent[0] /= len;
+            wp.tangent[1] /= len;
+            wp.tangent[2] /= len;
+        }
+        
+        if (i > 0) {
+            float dx = wp.position[0] - points[i-1].position[0];
+            float dy = wp.position[1] - points[i-1].position[1];
+            float dz = wp.position[2] - points[i-1].position[2];
+            arc += std::sqrt(dx*dx + dy*dy + dz*dz);
+        }
+        wp.arc_length = arc;
+    }
+}
@@ -0,0 +1,33 @@
+/**
+ * @file path_smoothing.h
+ * @brief Linear-time path filters (moving average, Savitzky-Golay, B-spline)
+ */
+
+#ifndef SMR_PATH_SMOOTHING_H
+#define SMR_PATH_SMOOTHING_H
+
+#include "smr_welding_api.h"
+#include <vector>
+
+/// Fill zero/unset fields of `settings` with defaults
+SmoothingSettings smoothing_resolve_settings(const SmoothingSettings* settings);
+
+/**
+ * Filter positions and normals in place. The path is first split at corners
+ * (turns above corner_angle measured half a window to either side, one per
+ * run of sharp samples); each stretch is filtered on its own with its end
+ * points held fixed. Normals are renormalized; tangents and arc lengths are
+ * left for the caller to recompute.
+ *
+ * - Moving average and Savitzky-Golay share one O(n) kernel: sliding
+ *   polynomial moments updated per step (order 0 is the moving average).
+ *   The window shrinks symmetrically near stretch ends.
+ * - B-spline is a least-squares clamped cubic fit over arc length with knots
+ *   half a window apart, solved as a banded system.
+ */
+void smooth_path_points(std::vector<WeldPoint>& points, const SmoothingSettings& settings);
+
+/// Central-difference tangents and cumulative arc length from positions
+void update_tangents_and_arc_length(std::vector<WeldPoint>& points);
+
+#endif // SMR_PATH_SMOOTHING_H
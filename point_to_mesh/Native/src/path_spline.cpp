@@ -0,0 +1,439 @@
+/**
+ * @file path_spline.cpp
+ * @brief Continuous Weld Path Model Implementation
+ */
+
+#include "path_spline.h"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+static const double SPLINE_MIN_SPACING = 1e-7;   // Closer source points are merged (m)
+static const int SPLINE_NEWTON_STEPS = 1;        // Refinements after the Hermite guess
+
+AdaptiveResampleSettings adaptive_resample_resolve_settings(const AdaptiveResampleSettings* settings) {
+    AdaptiveResampleSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+    
+    if (s.chord_tolerance <= 0) s.chord_tolerance = 0.0001f;
+    if (s.angle_tolerance <= 0) s.angle_tolerance = 0.1f;
+    if (s.min_step <= 0) s.min_step = 0.0005f;
+    if (s.max_step <= 0) s.max_step = 0.02f;
+    return s;
+}
+
+static inline double dot3(const double* a, const double* b) {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+static inline void cross3(const double* a, const double* b, double* out) {
+    out[0] = a[1]*b[2] - a[2]*b[1];
+    out[1] = a[2]*b[0] - a[0]*b[2];
+    out[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+static inline bool normalize3(double* v) {
+    double len = std::sqrt(dot3(v, v));
+    if (len < 1e-12) return false;
+    v[0] /= len;
+    v[1] /= len;
+    v[2] /= len;
+    return true;
+}
+
+// Normalize `v`, falling back to direction `fallback` when it vanishes
+static void normalize_or(double* v, const double* fallback) {
+    if (normalize3(v)) return;
+    std::copy(fallback, fallback + 3, v);
+    normalize3(v);
+}
+
+// Component of `v` perpendicular to unit `axis`, normalized (out may alias v).
+// Fails when v is (nearly) parallel to the axis.
+static bool orthonormalize(const double* v, const double* axis, double* out) {
+    double d = dot3(v, axis);
+    double v_len = std::sqrt(dot3(v, v));
+    for (int k = 0; k < 3; ++k) out[k] = v[k] - d * axis[k];
+    double len = std::sqrt(dot3(out, out));
+    if (len < 1e-3 * v_len || len < 1e-12) return false;
+    for (int k = 0; k < 3; ++k) out[k] /= len;
+    return true;
+}
+
+// Any unit vector perpendicular to unit `axis`
+static void any_perpendicular(const double* axis, double* out) {
+    double ref[3] = {0, 0, 0};
+    ref[std::fabs(axis[0]) < 0.9 ? 0 : 1] = 1.0;
+    orthonormalize(ref, axis, out);
+}
+
+/// Double reflection (Wang et al. 2008): carry frame normal r0 at (x0, t0)
+/// to (x1, t1) with minimal rotation about the tangent
+static void double_reflect(const double* x0, const double* t0, const double* r0,
+                           const double* x1, const double* t1, double* r1) {
+    double v1[3], rl[3], tl[3], v2[3];
+    for (int k = 0; k < 3; ++k) v1[k] = x1[k] - x0[k];
+    double c1 = dot3(v1, v1);
+    if (c1 < 1e-24) {
+        std::copy(r0, r0 + 3, rl);
+        std::copy(t0, t0 + 3, tl);
+    } else {
+        double fr = 2.0 * dot3(v1, r0) / c1, ft = 2.0 * dot3(v1, t0) / c1;
+        for (int k = 0; k < 3; ++k) {
+            rl[k] = r0[k] - fr * v1[k];
+            tl[k] = t0[k] - ft * v1[k];
+        }
+    }
+    for (int k = 0; k < 3; ++k) v2[k] = t1[k] - tl[k];
+    double c2 = dot3(v2, v2);
+    double f = c2 < 1e-24 ? 0.0 : 2.0 * dot3(v2, rl) / c2;
+    for (int k = 0; k < 3; ++k) r1[k] = rl[k] - f * v2[k];
+}
+
+// =============================================================================
+// Construction
+// =============================================================================
+
+// Position and derivative of a segment at u
+static void segment_point(const float* p0, const float* c1, const float* c2, const float* c3,
+                          double u, double* pos, double* deriv) {
+    for (int k = 0; k < 3; ++k) {
+        pos[k] = p0[k] + u * (c1[k] + u * (c2[k] + u * c3[k]));
+        deriv[k] = c1[k] + u * (2.0 * c2[k] + u * 3.0 * c3[k]);
+    }
+}
+
+// Unit tangent at u = 0 (the chord if the derivative vanishes)
+static void segment_start_tangent(const float* c1, const float* c2, const float* c3, double* t0) {
+    double chord[3];
+    for (int k = 0; k < 3; ++k) {
+        t0[k] = c1[k];
+        chord[k] = static_cast<double>(c1[k]) + c2[k] + c3[k];
+    }
+    normalize_or(t0, chord);
+}
+
+double PathSpline::segment_arc(int seg, double u0, double u1) const {
+    // 3-point Gauss-Legendre on |p'(u)|
+    static const double nodes[3] = {-0.7745966692414834, 0.0, 0.7745966692414834};
+    static const double weights[3] = {5.0 / 9.0, 8.0 / 9.0, 5.0 / 9.0};
+    const Segment& sg = segments[seg];
+    double half = 0.5 * (u1 - u0), mid = 0.5 * (u0 + u1);
+    double sum = 0.0;
+    for (int g = 0; g < 3; ++g) {
+        double pos[3], deriv[3];
+        segment_point(sg.p0, sg.c1, sg.c2, sg.c3, mid + half * nodes[g], pos, deriv);
+        sum += weights[g] * std::sqrt(dot3(deriv, deriv));
+    }
+    return sum * half;
+}
+
+void PathSpline::build(const std::vector<WeldPoint>& points) {
+    segments.clear();
+    arc.clear();
+    arc_slope.clear();
+    has_points = !points.empty();
+    if (!has_points) return;
+    first = points[0];
+    first.arc_length = 0.0f;
+    arc.push_back(0.0);
+
+    std::vector<const WeldPoint*> knots;
+    knots.reserve(points.size());
+    for (const WeldPoint& wp : points) {
+        if (!knots.empty()) {
+            const float* last = knots.back()->position;
+            double dx = wp.position[0] - last[0], dy = wp.position[1] - last[1], dz = wp.position[2] - last[2];
+            if (dx*dx + dy*dy + dz*dz < SPLINE_MIN_SPACING * SPLINE_MIN_SPACING) continue;
+        }
+        knots.push_back(&wp);
+    }
+    const int n = static_cast<int>(knots.size());
+    if (n == 1) return;
+
+    // Hermite form of each centripetal Catmull-Rom segment. Phantom end
+    // points extrapolate the last three knots quadratically (linearly for two
+    // knots), so end tangents follow the path's curvature instead of the chord.
+    segments.resize(n - 1);
+    for (int i = 0; i + 1 < n; ++i) {
+        double P[4][3];
+        for (int k = 0; k < 3; ++k) {
+            P[1][k] = knots[i]->position[k];
+            P[2][k] = knots[i + 1]->position[k];
+            if (i > 0) {
+                P[0][k] = knots[i - 1]->position[k];
+            } else {
+                P[0][k] = (n > 2) ? 3.0 * (P[1][k] - P[2][k]) + knots[2]->position[k]
+                                  : 2.0 * P[1][k] - P[2][k];
+            }
+            if (i + 2 < n) {
+                P[3][k] = knots[i + 2]->position[k];
+            } else {
+                P[3][k] = (n > 2) ? 3.0 * (P[2][k] - P[1][k]) + knots[n - 3]->position[k]
+                                  : 2.0 * P[2][k] - P[1][k];
+            }
+        }
+        // Centripetal knot spacing: sqrt of the chord length
+        double d[3];
+        for (int j = 0; j < 3; ++j) {
+            double dx = P[j + 1][0] - P[j][0], dy = P[j + 1][1] - P[j][1], dz = P[j + 1][2] - P[j][2];
+            d[j] = std::max(std::sqrt(std::sqrt(dx*dx + dy*dy + dz*dz)), 1e-12);
+        }
+
+        Segment& sg = segments[i];
+        for (int k = 0; k < 3; ++k) {
+            double chord = P[2][k] - P[1][k];
+            double m1 = ((P[1][k] - P[0][k]) / d[0] - (P[2][k] - P[0][k]) / (d[0] + d[1]) + chord / d[1]) * d[1];
+            double m2 = (chord / d[1] - (P[3][k] - P[1][k]) / (d[1] + d[2]) + (P[3][k] - P[2][k]) / d[2]) * d[1];
+            sg.p0[k] = knots[i]->position[k];
+            sg.c1[k] = static_cast<float>(m1);
+            sg.c2[k] = static_cast<float>(3.0 * chord - 2.0 * m1 - m2);
+            sg.c3[k] = static_cast<float>(-2.0 * chord + m1 + m2);
+        }
+    }
+
+    // Arc-length table, with du/ds at both ends of every interval for the
+    // Hermite inverse in evaluate_in
+    const size_t intervals = static_cast<size_t>(n - 1) * SPLINE_ARC_SUBDIVISIONS;
+    arc.reserve(intervals + 1);
+    arc_slope.resize(intervals * 2);
+    double total = 0.0;
+    for (int i = 0; i + 1 < n; ++i) {
+        double slope[SPLINE_ARC_SUBDIVISIONS + 1];
+        for (int q = 0; q <= SPLINE_ARC_SUBDIVISIONS; ++q) {
+            double pos[3], deriv[3];
+            const Segment& sg = segments[i];
+            segment_point(sg.p0, sg.c1, sg.c2, sg.c3, static_cast<double>(q) / SPLINE_ARC_SUBDIVISIONS, pos, deriv);
+            double speed = std::sqrt(dot3(deriv, deriv));
+            slope[q] = speed > 1e-12 ? 1.0 / speed : 0.0;
+        }
+        for (int q = 0; q < SPLINE_ARC_SUBDIVISIONS; ++q) {
+            size_t k = static_cast<size_t>(i) * SPLINE_ARC_SUBDIVISIONS + q;
+            if (k > 0) arc.push_back(total);
+            arc_slope[k * 2] = static_cast<float>(slope[q]);
+            arc_slope[k * 2 + 1] = static_cast<float>(slope[q + 1]);
+            total += segment_arc(i, static_cast<double>(q) / SPLINE_ARC_SUBDIVISIONS,
+                                 static_cast<double>(q + 1) / SPLINE_ARC_SUBDIVISIONS);
+        }
+    }
+    arc.push_back(total);
+
+    // Frames: knot normals projected off the tangent, joined by rotation
+    // minimizing transport plus a per-segment twist
+    double normal[3];
+    for (int i = 0; i + 1 < n; ++i) {
+        Segment& sg = segments[i];
+        double x0[3], t0[3], x1[3], t1[3], unused[3];
+        segment_point(sg.p0, sg.c1, sg.c2, sg.c3, 0.0, x0, unused);
+        segment_point(sg.p0, sg.c1, sg.c2, sg.c3, 1.0, x1, t1);
+        segment_start_tangent(sg.c1, sg.c2, sg.c3, t0);
+        normalize_or(t1, t0);
+
+        if (i == 0) {
+            double source[3] = {knots[0]->normal[0], knots[0]->normal[1], knots[0]->normal[2]};
+            if (!orthonormalize(source, t0, normal)) any_perpendicular(t0, normal);
+        }
+        for (int k = 0; k < 3; ++k) sg.normal[k] = static_cast<float>(normal[k]);
+
+        double carried[3], target[3];
+        double_reflect(x0, t0, normal, x1, t1, carried);
+        orthonormalize(carried, t1, carried);
+        double source[3] = {knots[i + 1]->normal[0], knots[i + 1]->normal[1], knots[i + 1]->normal[2]};
+        if (orthonormalize(source, t1, target)) {
+            double c[3];
+            cross3(carried, target, c);
+            sg.twist = static_cast<float>(std::atan2(dot3(c, t1), dot3(carried, target)));
+            std::copy(target, target + 3, normal);
+        } else {
+            // Normal along the tangent: keep the transported frame
+            sg.twist = 0.0f;
+            std::copy(carried, carried + 3, normal);
+        }
+    }
+}
+
+// =============================================================================
+// Evaluation
+// =============================================================================
+
+void PathSpline::evaluate_segment(int seg, double u, double s, WeldPoint& out) const {
+    const Segment& sg = segments[seg];
+    // Start frame in the same arithmetic as the sample, so u = 0 reproduces it exactly
+    double x0[3], t0[3], pos[3], tangent[3];
+    segment_point(sg.p0, sg.c1, sg.c2, sg.c3, 0.0, x0, t0);
+    segment_point(sg.p0, sg.c1, sg.c2, sg.c3, u, pos, tangent);
+    segment_start_tangent(sg.c1, sg.c2, sg.c3, t0);
+    normalize_or(tangent, t0);
+
+    double n0[3] = {sg.normal[0], sg.normal[1], sg.normal[2]};
+    double r[3], binormal[3], normal[3];
+    double_reflect(x0, t0, n0, pos, tangent, r);
+    if (!orthonormalize(r, tangent, r)) any_perpendicular(tangent, r);
+
+    double seg_start = arc[seg * SPLINE_ARC_SUBDIVISIONS];
+    double seg_length = arc[(seg + 1) * SPLINE_ARC_SUBDIVISIONS] - seg_start;
+    double angle = seg_length > 0.0 ? sg.twist * (s - seg_start) / seg_length : 0.0;
+    double ca = std::cos(angle), sa = std::sin(angle);
+    cross3(tangent, r, binormal);
+    for (int k = 0; k < 3; ++k) normal[k] = r[k] * ca + binormal[k] * sa;
+
+    for (int k = 0; k < 3; ++k) {
+        out.position[k] = static_cast<float>(pos[k]);
+        out.normal[k] = static_cast<float>(normal[k]);
+        out.tangent[k] = static_cast<float>(tangent[k]);
+    }
+    out.arc_length = static_cast<float>(s);
+}
+
+int PathSpline::locate(double s, int hint) const {
+    const int last = static_cast<int>(arc.size()) - 2;
+    if (hint >= 0 && hint <= last && arc[hint] <= s) {
+        // Sweeps move a few entries at a time: walk instead of searching
+        while (hint < last && arc[hint + 1] <= s) ++hint;
+        return hint;
+    }
+    int k = static_cast<int>(std::upper_bound(arc.begin(), arc.end() - 1, s) - arc.begin()) - 1;
+    return std::max(0, std::min(k, last));
+}
+
+void PathSpline::evaluate_in(int k, double s, WeldPoint& out) const {
+    // Cubic Hermite guess for u(s) from the interval's end slopes, then
+    // Newton on the arc-length integral
+    int seg = k / SPLINE_ARC_SUBDIVISIONS;
+    const double du = 1.0 / SPLINE_ARC_SUBDIVISIONS;
+    double u_lo = (k % SPLINE_ARC_SUBDIVISIONS) * du;
+    double u_hi = u_lo + du;
+    double span = arc[k + 1] - arc[k];
+    double target = s - arc[k];
+    double u = u_lo;
+    if (span > 0.0) {
+        double t = target / span, t2 = t * t, t3 = t2 * t;
+        u = u_lo + du * (3.0 * t2 - 2.0 * t3)
+          + span * (arc_slope[k * 2] * (t3 - 2.0 * t2 + t) + arc_slope[k * 2 + 1] * (t3 - t2));
+        u = std::max(u_lo, std::min(u, u_hi));
+    }
+
+    const Segment& sg = segments[seg];
+    for (int iter = 0; iter < SPLINE_NEWTON_STEPS; ++iter) {
+        double pos[3], deriv[3];
+        segment_point(sg.p0, sg.c1, sg.c2, sg.c3, u, pos, deriv);
+        double speed = std::sqrt(dot3(deriv, deriv));
+        if (speed < 1e-12) break;
+        u -= (segment_arc(seg, u_lo, u) - target) / speed;
+        u = std::max(u_lo, std::min(u, u_hi));
+    }
+    evaluate_segment(seg, u, s, out);
+}
+
+void PathSpline::evaluate(double s, WeldPoint& out) const {
+    if (segments.empty()) {
+        if (has_points) out = first;
+        return;
+    }
+    s = std::max(0.0, std::min(s, length()));
+    evaluate_in(locate(s, -1), s, out);
+}
+
+void PathSpline::sample_uniform(double step, std::vector<WeldPoint>& out) const {
+    out.clear();
+    if (!has_points || step <= 0.0) return;
+    double total = length();
+    // Tolerance keeps the end sample when the length is a whole number of steps
+    size_t count = static_cast<size_t>(total / step + 1e-6) + 1;
+    out.resize(count);
+    if (segments.empty()) {
+        out[0] = first;
+        return;
+    }
+    int k = 0;
+    for (size_t i = 0; i < count; ++i) {
+        double s = std::min(static_cast<double>(i) * step, total);
+        k = locate(s, k);
+        evaluate_in(k, s, out[i]);
+    }
+}
+
+// Angle between two unit float vectors
+static double unit_angle(const float* a, const float* b) {
+    double d = static_cast<double>(a[0])*b[0] + static_cast<double>(a[1])*b[1] + static_cast<double>(a[2])*b[2];
+    return std::acos(std::max(-1.0, std::min(1.0, d)));
+}
+
+// Distance from p to segment a-b
+static double point_segment_distance(const float* p, const float* a, const float* b) {
+    double ab[3], ap[3];
+    for (int k = 0; k < 3; ++k) {
+        ab[k] = static_cast<double>(b[k]) - a[k];
+        ap[k] = static_cast<double>(p[k]) - a[k];
+    }
+    double len2 = dot3(ab, ab);
+    double t = len2 > 0.0 ? std::max(0.0, std::min(1.0, dot3(ap, ab) / len2)) : 0.0;
+    for (int k = 0; k < 3; ++k) ap[k] -= t * ab[k];
+    return std::sqrt(dot3(ap, ap));
+}
+
+void PathSpline::sample_adaptive(double chord_tolerance, double angle_tolerance,
+                                 double min_step, double max_step, std::vector<WeldPoint>& out) const {
+    out.clear();
+    if (!has_points) return;
+    if (segments.empty()) {
+        out.push_back(first);
+        return;
+    }
+    const double total = length();
+    const int probes = 3;   // Quarter points of a trial step
+
+    WeldPoint current;
+    int k = 0;
+    evaluate_in(k, 0.0, current);
+    out.push_back(current);
+
+    double s = 0.0;
+    double step = max_step;
+    while (s < total) {
+        step = std::max(min_step, std::min(step, max_step));
+        for (;;) {
+            // Finish at the end rather than leave a sliver under half a minimum
+            // step; re-tested after each rejection, with the shrunk step
+            bool last = total - s < step + 0.5 * min_step;
+            double h = last ? total - s : step;
+            WeldPoint end, probe[probes];
+            evaluate_in(locate(s + h, k), s + h, end);
+            double chord_error = 0.0;
+            double tangent_turn = 0.0, normal_turn = 0.0;
+            const WeldPoint* prev = &current;
+            for (int q = 0; q <= probes; ++q) {
+                const WeldPoint* next = &end;
+                if (q < probes) {
+                    double sq = s + h * (q + 1) / (probes + 1);
+                    evaluate_in(locate(sq, k), sq, probe[q]);
+                    chord_error = std::max(chord_error,
+                                           point_segment_distance(probe[q].position, current.position, end.position));
+                    next = &probe[q];
+                }
+                tangent_turn += unit_angle(prev->tangent, next->tangent);
+                normal_turn += unit_angle(prev->normal, next->normal);
+                prev = next;
+            }
+            double turn = std::max(tangent_turn, normal_turn);
+
+            // Chord error grows with h^2, turn with h
+            double factor = 2.0;
+            if (chord_error > 0.0) factor = std::min(factor, 0.9 * std::sqrt(chord_tolerance / chord_error));
+            if (turn > 0.0) factor = std::min(factor, 0.9 * angle_tolerance / turn);
+
+            // At the step floor the last step can be up to 1.5 * min_step long
+            bool accept = (chord_error <= chord_tolerance && turn <= angle_tolerance) || step <= min_step;
+            if (accept) {
+                s = last ? total : s + h;
+                k = locate(s, k);
+                current = end;
+                out.push_back(current);
+                step = h * std::max(1.0, factor);
+                break;
+            }
+            step = std::max(min_step, h * std::max(0.25, factor));
+        }
+    }
+}
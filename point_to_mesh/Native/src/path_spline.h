@@ -0,0 +1,85 @@
+/**
+ * @file path_spline.h
+ * @brief Continuous weld path model (centripetal Catmull-Rom with arc-length table)
+ */
+
+#ifndef SMR_PATH_SPLINE_H
+#define SMR_PATH_SPLINE_H
+
+#include "smr_welding_api.h"
+#include "memory_tracker.h"
+#include <vector>
+
+static const int SPLINE_ARC_SUBDIVISIONS = 4;   // Arc-length table entries per segment
+
+/// Fill zero/unset fields of `settings` with defaults
+AdaptiveResampleSettings adaptive_resample_resolve_settings(const AdaptiveResampleSettings* settings);
+
+/**
+ * Centripetal Catmull-Rom spline through the positions of a weld path.
+ * Centripetal knots keep the curve free of cusps and overshoot on unevenly
+ * spaced samples, and it passes through every source point.
+ *
+ * Normals come from rotation-minimizing frames (double reflection) pinned to
+ * the source normals at the knots: the twist needed to meet the next knot's
+ * normal is spread evenly over the segment's arc length.
+ *
+ * Arc length is tabulated per quarter segment (Gauss-Legendre). A lookup is
+ * a table search (a forward walk when sweeping), a cubic Hermite guess and
+ * one Newton step; sampling never goes back to the source points, so
+ * repeated resampling does not degrade the path.
+ */
+class PathSpline {
+public:
+    /// Fit through `points` (consecutive duplicates are skipped)
+    void build(const std::vector<WeldPoint>& points);
+
+    bool empty() const { return !has_points; }
+
+    size_t memory_bytes() const { return vector_bytes(segments) + vector_bytes(arc); }
+
+    /// Total arc length (m)
+    double length() const { return arc.empty() ? 0.0 : arc.back(); }
+
+    /// Weld point at arc length s (clamped to the path); arc_length = s
+    void evaluate(double s, WeldPoint& out) const;
+
+    /// Samples every `step` from the start; the last one is at or before the end
+    void sample_uniform(double step, std::vector<WeldPoint>& out) const;
+
+    /**
+     * Samples with steps in [min_step, max_step] (the last step may be
+     * shorter, or up to half a minimum step longer so that no sliver is
+     * left before the end) chosen so that the polyline stays within chord_tolerance of
+     * the curve and tangent and normal turn at most angle_tolerance per step.
+     * Steps are checked at their quarter points, so wiggles shorter than a
+     * quarter step can slip through. Both path ends are always sampled.
+     */
+    void sample_adaptive(double chord_tolerance, double angle_tolerance,
+                         double min_step, double max_step, std::vector<WeldPoint>& out) const;
+
+private:
+    /// p(u) = p0 + c1 u + c2 u^2 + c3 u^3, u in [0, 1]
+    struct Segment {
+        float p0[3];
+        float c1[3];
+        float c2[3];
+        float c3[3];
+        float normal[3];    // Frame normal at u = 0
+        float twist;        // Rotation about the tangent accumulated over the segment (rad)
+    };
+
+    bool has_points = false;
+    WeldPoint first;                  // Whole path when it has a single point
+    std::vector<Segment> segments;
+    std::vector<double> arc;          // Arc length at u = q / SUBDIVISIONS, plus the total
+    std::vector<float> arc_slope;     // du/ds at the start and end of each table interval
+
+    /// Table interval holding s; walks forward from `hint` when it is usable
+    int locate(double s, int hint) const;
+    void evaluate_in(int k, double s, WeldPoint& out) const;
+    void evaluate_segment(int seg, double u, double s, WeldPoint& out) const;
+    double segment_arc(int seg, double u0, double u1) const;
+};
+
+#endif // SMR_PATH_SPLINE_H
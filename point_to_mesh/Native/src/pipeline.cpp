@@ -0,0 +1,389 @@
+/**
+ * @file pipeline.cpp
+ * @brief Scan-to-Trajectory Pipeline Implementation
+ */
+
+#include "point_cloud.h"
+#include "mesh_generator.h"
+#include "job_control.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock PipelineClock;
+
+static const int PIPELINE_BLOCKS = 3;   // Blocks in flight between reader and filter
+
+static PipelineSettings pipeline_resolve_settings(const PipelineSettings* settings) {
+    PipelineSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.voxel_size == 0) s.voxel_size = 0.002f;
+    if (s.outlier_neighbors == 0) s.outlier_neighbors = 20;
+    if (s.outlier_std_ratio <= 0) s.outlier_std_ratio = 2.0f;
+    if (s.normal_knn <= 0) s.normal_knn = 30;
+    if (s.poisson.depth <= 0) s.poisson.depth = 8;
+    if (s.poisson.scale <= 0) s.poisson.scale = 1.1f;
+    if (s.poisson.density_threshold == 0) s.poisson.density_threshold = 0.01f;
+    if (s.path.step_size <= 0) s.path.step_size = 0.005f;
+    if (s.path.standoff_distance <= 0) s.path.standoff_distance = 0.015f;
+    if (s.path.weave_amplitude <= 0) s.path.weave_amplitude = 0.002f;
+    if (s.path.weave_frequency <= 0) s.path.weave_frequency = 2.0f;
+    if (s.smooth_window == 0) s.smooth_window = 5;
+    if (s.block_points <= 0) s.block_points = 65536;
+    return s;
+}
+
+static bool has_extension(const std::string& path, const char* ext) {
+    size_t n = std::strlen(ext);
+    if (path.size() < n) return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (std::tolower(static_cast<unsigned char>(path[path.size() - n + i])) != ext[i]) return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// Internal Pipeline Class
+// =============================================================================
+
+/// Points handed from the reader thread to the filter
+struct PointBlock {
+    PointBuffer xyz;
+    PointBuffer normals;
+};
+
+/**
+ * Owns every intermediate of the flow. Vectors are cleared rather than
+ * released between runs, so a pipeline that processes scan after scan stops
+ * allocating once it has seen its largest scan.
+ */
+class PipelineImpl {
+public:
+    PipelineSettings settings;
+
+    PointCloudImpl cloud;
+    MeshImpl mesh;
+    PathHandle path = nullptr;
+
+    TrackedVector<double> joints;            // joint_count * 6
+    std::unique_ptr<bool[]> reachable;       // joint_count
+    size_t reachable_capacity = 0;
+    int joint_count = 0;
+
+    double stage_ms[SMR_STAGE_COUNT];
+
+    explicit PipelineImpl(const PipelineSettings& s) : settings(s) {
+        std::fill(stage_ms, stage_ms + SMR_STAGE_COUNT, 0.0);
+    }
+    ~PipelineImpl() { smr_path_destroy(path); }
+
+    SMRErrorCode run(const char* filepath, RobotHandle robot);
+
+    size_t memory_bytes() const;
+
+private:
+    VoxelGrid grid;
+    PointBlock blocks[PIPELINE_BLOCKS];
+
+    SMRErrorCode load(const char* filepath);
+    SMRErrorCode build_mesh();
+    SMRErrorCode build_path();
+    SMRErrorCode solve_joints(RobotHandle robot);
+};
+
+/**
+ * Read and downsample in one pass: a reader thread parses blocks into a
+ * small ring of reused buffers while this thread bins the previous block
+ * into the voxel grid. Blocks arrive in file order, so the result equals
+ * downsampling the fully loaded cloud.
+ */
+SMRErrorCode PipelineImpl::load(const char* filepath) {
+    PointFileFormat format;
+    std::string name(filepath);
+    if (has_extension(name, ".ply")) {
+        format = POINT_FILE_PLY;
+    } else if (has_extension(name, ".pcd")) {
+        format = POINT_FILE_PCD;
+    } else {
+        set_last_error("Unsupported point cloud format");
+        return SMR_ERROR_FILE_FORMAT;
+    }
+
+    PointFileReader reader;
+    if (!reader.open(filepath, format)) return SMR_ERROR_FILE_NOT_FOUND;
+
+    const bool with_normals = reader.has_normals;
+    const bool downsample = settings.voxel_size > 0;
+    cloud.clear();
+    if (downsample) {
+        grid.reset(settings.voxel_size);
+    } else {
+        cloud.points.reserve(reader.count);
+        if (with_normals) cloud.normals.reserve(reader.count);
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<PointBlock*> free_blocks;
+    std::deque<PointBlock*> filled;
+    bool reader_done = false;
+    bool stop = false;
+    for (auto& block : blocks) free_blocks.push_back(&block);
+
+    std::thread reader_thread([&]() {
+        for (;;) {
+            PointBlock* block;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return stop || !free_blocks.empty(); });
+                if (stop) break;
+                block = free_blocks.front();
+                free_blocks.pop_front();
+            }
+
+            block->xyz.clear();
+            block->normals.clear();
+            int n = reader.read(settings.block_points, block->xyz,
+                                with_normals ? &block->normals : nullptr, nullptr);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (n == 0) {
+                free_blocks.push_back(block);
+                break;
+            }
+            filled.push_back(block);
+            changed.notify_all();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        reader_done = true;
+        changed.notify_all();
+    });
+
+    JobControl* job = job_current();
+    size_t points_done = 0;
+    bool cancelled = false;
+    for (;;) {
+        PointBlock* block;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return reader_done || !filled.empty(); });
+            if (filled.empty()) break;
+            block = filled.front();
+            filled.pop_front();
+        }
+
+        size_t n = block->xyz.size();
+        if (downsample) {
+            grid.add(block->xyz, with_normals ? &block->normals : nullptr);
+        } else {
+            cloud.points.append(block->xyz);
+            if (with_normals) cloud.normals.append(block->normals);
+        }
+
+        points_done += n;
+        if (job) {
+            float fraction = static_cast<float>(points_done) / reader.count;
+            job->progress.store((SMR_STAGE_LOAD + fraction) / SMR_STAGE_COUNT, std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        free_blocks.push_back(block);
+        if (job_cancelled()) {
+            cancelled = true;
+            stop = true;
+        }
+        changed.notify_all();
+        if (cancelled) break;
+    }
+    reader_thread.join();
+    if (cancelled) return SMR_ERROR_CANCELLED;
+
+    if (downsample) grid.extract(cloud.points, with_normals ? &cloud.normals : nullptr);
+    cloud.has_normals = with_normals && !cloud.normals.empty();
+
+    if (cloud.count() == 0) {
+        set_last_error("Point cloud file has no points");
+        return SMR_ERROR_FILE_FORMAT;
+    }
+    return SMR_SUCCESS;
+}
+
+SMRErrorCode PipelineImpl::build_mesh() {
+    SMRErrorCode result = mesh.reconstruct(cloud, settings.poisson);
+    if (result != SMR_SUCCESS) return result;
+    if (settings.poisson.density_threshold > 0) mesh.remove_low_density(settings.poisson.density_threshold);
+    if (settings.simplify_ratio > 0) mesh.simplify(settings.simplify_ratio);
+    return SMR_SUCCESS;
+}
+
+SMRErrorCode PipelineImpl::build_path() {
+    smr_path_destroy(path);
+    path = smr_path_create_from_edge(&mesh, &settings.path);
+    if (!path) {
+        set_last_error("Path generation failed");
+        return SMR_ERROR_COMPUTATION_FAILED;
+    }
+
+    SMRErrorCode result = SMR_SUCCESS;
+    const PathParams& p = settings.path;
+    if (p.weave_type != WEAVE_NONE) {
+        result = smr_path_apply_weave(path, p.weave_type, p.weave_amplitude, p.weave_frequency);
+        if (result != SMR_SUCCESS) set_last_error("Weave rejected (type, or too many samples for weave_frequency)");
+    }
+    if (result == SMR_SUCCESS) result = smr_path_resample(path, p.step_size);
+    if (result == SMR_SUCCESS && settings.smooth_window > 0) result = smr_path_smooth(path, settings.smooth_window);
+    return result;
+}
+
+SMRErrorCode PipelineImpl::solve_joints(RobotHandle robot) {
+    int count = smr_path_get_count(path);
+    if (count <= 0) return SMR_SUCCESS;
+
+    joints.resize(static_cast<size_t>(count) * 6);
+    if (reachable_capacity < static_cast<size_t>(count)) {
+        reachable.reset(new bool[count]);
+        reachable_capacity = count;
+    }
+
+    SMRErrorCode result = smr_path_to_joints_ex(path, robot, settings.path.standoff_distance,
+                                                &settings.ik, nullptr, joints.data(),
+                                                reachable.get(), nullptr);
+    if (result == SMR_SUCCESS) joint_count = count;
+    return result;
+}
+
+size_t PipelineImpl::memory_bytes() const {
+    size_t bytes = cloud.memory_bytes() + mesh.memory_bytes() + grid.memory_bytes() +
+                   vector_bytes(joints) + reachable_capacity * sizeof(bool);
+    if (path) bytes += static_cast<size_t>(smr_path_get_memory(path));
+    for (const PointBlock& block : blocks) bytes += block.xyz.memory_bytes() + block.normals.memory_bytes();
+    return bytes;
+}
+
+SMRErrorCode PipelineImpl::run(const char* filepath, RobotHandle robot) {
+    std::fill(stage_ms, stage_ms + SMR_STAGE_COUNT, 0.0);
+    joint_count = 0;
+
+    // Stages report into their own control; the pipeline reports stages done
+    JobControl* job = job_current();
+    JobControl stage_job;
+    stage_job.parent = job;
+
+    SMRErrorCode result = SMR_SUCCESS;
+    for (int stage = 0; stage < SMR_STAGE_COUNT && result == SMR_SUCCESS; ++stage) {
+        if (job_cancelled()) return SMR_ERROR_CANCELLED;
+        if (stage == SMR_STAGE_TRAJECTORY && !robot) break;
+
+        PipelineClock::time_point start = PipelineClock::now();
+        {
+            JobScope scope(job && stage != SMR_STAGE_LOAD ? &stage_job : job);
+            switch (stage) {
+            case SMR_STAGE_LOAD:
+                result = load(filepath);
+                break;
+            case SMR_STAGE_OUTLIERS:
+                if (settings.outlier_neighbors > 0) {
+                    cloud.remove_outliers(settings.outlier_neighbors, settings.outlier_std_ratio);
+                }
+                break;
+            case SMR_STAGE_NORMALS:
+                cloud.estimate_normals_knn(settings.normal_knn);
+                if (!cloud.has_normals) {
+                    set_last_error("Too few points for normal estimation");
+                    result = SMR_ERROR_COMPUTATION_FAILED;
+                    break;
+                }
+                cloud.orient_normals(settings.view_point[0], settings.view_point[1], settings.view_point[2]);
+                break;
+            case SMR_STAGE_MESH:
+                result = build_mesh();
+                break;
+            case SMR_STAGE_PATH:
+                result = build_path();
+                break;
+            case SMR_STAGE_TRAJECTORY:
+                result = solve_joints(robot);
+                break;
+            }
+        }
+        stage_ms[stage] = std::chrono::duration<double, std::milli>(PipelineClock::now() - start).count();
+        if (job) job->progress.store(static_cast<float>(stage + 1) / SMR_STAGE_COUNT, std::memory_order_relaxed);
+    }
+
+    if (job_cancelled()) return SMR_ERROR_CANCELLED;
+    return result;
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+SMR_API PipelineHandle smr_pipeline_create(const PipelineSettings* settings) {
+    return new PipelineImpl(pipeline_resolve_settings(settings));
+}
+
+SMR_API void smr_pipeline_destroy(PipelineHandle handle) {
+    delete static_cast<PipelineImpl*>(handle);
+}
+
+SMR_API SMRErrorCode smr_pipeline_run(PipelineHandle handle, const char* filepath,
+                                      RobotHandle robot_handle) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!filepath) return SMR_ERROR_INVALID_PARAMETER;
+    return static_cast<PipelineImpl*>(handle)->run(filepath, robot_handle);
+}
+
+SMR_API PointCloudHandle smr_pipeline_get_pointcloud(PipelineHandle handle) {
+    if (!handle) return nullptr;
+    return &static_cast<PipelineImpl*>(handle)->cloud;
+}
+
+SMR_API MeshHandle smr_pipeline_get_mesh(PipelineHandle handle) {
+    if (!handle) return nullptr;
+    return &static_cast<PipelineImpl*>(handle)->mesh;
+}
+
+SMR_API PathHandle smr_pipeline_get_path(PipelineHandle handle) {
+    if (!handle) return nullptr;
+    return static_cast<PipelineImpl*>(handle)->path;
+}
+
+SMR_API int smr_pipeline_get_joint_count(PipelineHandle handle) {
+    if (!handle) return -1;
+    return static_cast<PipelineImpl*>(handle)->joint_count;
+}
+
+SMR_API long long smr_pipeline_get_memory(PipelineHandle handle) {
+    if (!handle) return -1;
+    return static_cast<long long>(static_cast<PipelineImpl*>(handle)->memory_bytes());
+}
+
+SMR_API SMRErrorCode smr_pipeline_get_joints(PipelineHandle handle, double* out_joints,
+                                             bool* out_reachable) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!out_joints) return SMR_ERROR_INVALID_PARAMETER;
+
+    auto* pipeline = static_cast<PipelineImpl*>(handle);
+    size_t count = static_cast<size_t>(pipeline->joint_count);
+    if (count == 0) return SMR_SUCCESS;
+    std::memcpy(out_joints, pipeline->joints.data(), count * 6 * sizeof(double));
+    if (out_reachable) std::memcpy(out_reachable, pipeline->reachable.get(), count * sizeof(bool));
+    return SMR_SUCCESS;
+}
+
+SMR_API SMRErrorCode smr_pipeline_get_stage_times(PipelineHandle handle, double* out_ms) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!out_ms) return SMR_ERROR_INVALID_PARAMETER;
+    std::memcpy(out_ms, static_cast<PipelineImpl*>(handle)->stage_ms, sizeof(double) * SMR_STAGE_COUNT);
+    return SMR_SUCCESS;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file point_buffer.h
+ * @brief Structure-of-arrays storage for points, normals and colors
+ */
+
+#ifndef SMR_POINT_BUFFER_H
+#define SMR_POINT_BUFFER_H
+
+#include "memory_tracker.h"
+#include <cstddef>
+#include <vector>
+
+/// Alignment of PointBuffer arrays (a cache line; covers AVX-512 loads)
+static const size_t POINT_ALIGNMENT = 64;
+
+typedef std::vector<float, AlignedTrackedAllocator<float, POINT_ALIGNMENT>> AlignedFloats;
+
+/**
+ * Three aligned arrays x[], y[], z[], so distance and covariance kernels
+ * read whole SIMD lanes. The interleaved x0 y0 z0 x1 ... layout of the C API
+ * (and Unity's Vector3[]) is only produced on export, by copy_interleaved().
+ */
+class PointBuffer {
+public:
+    size_t size() const { return xs.size(); }
+    size_t capacity() const { return xs.capacity(); }
+    bool empty() const { return xs.empty(); }
+
+    const float* x() const { return xs.data(); }
+    const float* y() const { return ys.data(); }
+    const float* z() const { return zs.data(); }
+    float* x() { return xs.data(); }
+    float* y() { return ys.data(); }
+    float* z() { return zs.data(); }
+
+    void reserve(size_t n) {
+        xs.reserve(n);
+        ys.reserve(n);
+        zs.reserve(n);
+    }
+
+    void resize(size_t n) {
+        xs.resize(n);
+        ys.resize(n);
+        zs.resize(n);
+    }
+
+    void clear() {
+        xs.clear();
+        ys.clear();
+        zs.clear();
+    }
+
+    void push_back(float px, float py, float pz) {
+        xs.push_back(px);
+        ys.push_back(py);
+        zs.push_back(pz);
+    }
+
+    /// Append n interleaved XYZ triples
+    void append_interleaved(const float* xyz, size_t n) {
+        size_t start = size();
+        resize(start + n);
+        for (size_t i = 0; i < n; ++i) {
+            xs[start + i] = xyz[i * 3];
+            ys[start + i] = xyz[i * 3 + 1];
+            zs[start + i] = xyz[i * 3 + 2];
+        }
+    }
+
+    void assign_interleaved(const float* xyz, size_t n) {
+        clear();
+        append_interleaved(xyz, n);
+    }
+
+    void append(const PointBuffer& other) {
+        xs.insert(xs.end(), other.xs.begin(), other.xs.end());
+        ys.insert(ys.end(), other.ys.begin(), other.ys.end());
+        zs.insert(zs.end(), other.zs.begin(), other.zs.end());
+    }
+
+    /// Write the points as interleaved XYZ triples (3 * size() floats)
+    void copy_interleaved(float* out) const {
+        size_t n = size();
+        for (size_t i = 0; i < n; ++i) {
+            out[i * 3] = xs[i];
+            out[i * 3 + 1] = ys[i];
+            out[i * 3 + 2] = zs[i];
+        }
+    }
+
+    void swap(PointBuffer& other) noexcept {
+        xs.swap(other.xs);
+        ys.swap(other.ys);
+        zs.swap(other.zs);
+    }
+
+    size_t memory_bytes() const {
+        return vector_bytes(xs) + vector_bytes(ys) + vector_bytes(zs);
+    }
+
+private:
+    AlignedFloats xs;
+    AlignedFloats ys;
+    AlignedFloats zs;
+};
+
+/// Bytes reserved by a pooled buffer (see BufferPool)
+inline size_t buffer_bytes(const PointBuffer& buffer) {
+    return buffer.memory_bytes();
+}
+
+#endif // SMR_POINT_BUFFER_H
@@ -3,242 +3,325 @@
  * @brief Point Cloud Processing Implementation
  */
 
-#include "smr_welding_api.h"
-#include <vector>
-#include <string>
+#include "point_cloud.h"
+#include "job_control.h"
+#include "parallel.h"
+#include "point_kernels.h"
+#include "stats.h"
 #include <cmath>
 #include <algorithm>
-#include <fstream>
-#include <sstream>
+#include <atomic>
+#include <cstdlib>
 #include <cstring>
+#include <numeric>
+#include <sstream>
 
 // Thread-local error message
 static thread_local char g_last_error[512] = {0};
 
-static void set_error(const char* msg) {
+void set_last_error(const char* msg) {
     strncpy(g_last_error, msg, sizeof(g_last_error) - 1);
     g_last_error[sizeof(g_last_error) - 1] = '\0';
 }
 
 // =============================================================================
-// Internal Point Cloud Class
+// Streaming File Reader
 // =============================================================================
 
-class PointCloudImpl {
-public:
-    std::vector<float> points;   // XYZ * count
-    std::vector<float> normals;  // XYZ * count
-    std::vector<float> colors;   // RGB * count
-    bool has_normals = false;
-    bool has_colors = false;
-
-    int count() const { return static_cast<int>(points.size() / 3); }
-
-    void clear() {
-        points.clear();
-        normals.clear();
-        colors.clear();
-        has_normals = false;
-        has_colors = false;
-    }
-
-    bool load_ply(const char* filepath);
-    bool load_pcd(const char* filepath);
-    void estimate_normals_knn(int k);
-    void estimate_normals_radius(float radius);
-    void orient_normals(float cx, float cy, float cz);
-    void downsample_voxel(float voxel_size);
-    void remove_outliers(int nb_neighbors, float std_ratio);
-};
+bool PointFileReader::open(const char* filepath, PointFileFormat format) {
+    const bool ply = (format == POINT_FILE_PLY);
+    count = 0;
+    has_normals = false;
+    has_colors = false;
+    consumed = 0;
 
-// Simple PLY loader (ASCII format)
-bool PointCloudImpl::load_ply(const char* filepath) {
-    std::ifstream file(filepath);
+    file.close();
+    file.clear();
+    file.open(filepath);
     if (!file.is_open()) {
-        set_error("Cannot open PLY file");
+        set_last_error(ply ? "Cannot open PLY file" : "Cannot open PCD file");
         return false;
     }
 
-    std::string line;
-    int vertex_count = 0;
-    bool in_header = true;
-    bool has_nx = false, has_red = false;
-
     // Parse header
+    bool in_header = true;
     while (in_header && std::getline(file, line)) {
         std::istringstream iss(line);
         std::string token;
         iss >> token;
 
-        if (token == "element") {
-            std::string type;
-            iss >> type;
-            if (type == "vertex") {
-                iss >> vertex_count;
+        if (ply) {
+            if (token == "element") {
+                std::string type;
+                iss >> type;
+                if (type == "vertex") {
+                    iss >> count;
+                }
+            } else if (token == "property") {
+                std::string dtype, name;
+                iss >> dtype >> name;
+                if (name == "nx") has_normals = true;
+                if (name == "red") has_colors = true;
+            } else if (token == "end_header") {
+                in_header = false;
+            }
+        } else {
+            if (token == "POINTS") {
+                iss >> count;
+            } else if (token == "DATA") {
+                in_header = false;
             }
-        } else if (token == "property") {
-            std::string dtype, name;
-            iss >> dtype >> name;
-            if (name == "nx") has_nx = true;
-            if (name == "red") has_red = true;
-        } else if (token == "end_header") {
-            in_header = false;
         }
     }
 
-    if (vertex_count <= 0) {
-        set_error("Invalid vertex count in PLY");
+    if (count <= 0) {
+        set_last_error(ply ? "Invalid vertex count in PLY" : "Invalid point count in PCD");
         return false;
     }
+    return true;
+}
 
-    // Read vertices
-    clear();
-    points.reserve(vertex_count * 3);
-    if (has_nx) normals.reserve(vertex_count * 3);
-    if (has_red) colors.reserve(vertex_count * 3);
+// Parse three floats starting at s (advanced past them)
+static void parse_triple(const char*& s, float v[3]) {
+    char* end;
+    for (int c = 0; c < 3; ++c) {
+        v[c] = std::strtof(s, &end);
+        s = end;
+    }
+}
 
-    for (int i = 0; i < vertex_count && std::getline(file, line); ++i) {
-        std::istringstream iss(line);
-        float x, y, z;
-        iss >> x >> y >> z;
-        points.push_back(x);
-        points.push_back(y);
-        points.push_back(z);
-
-        if (has_nx) {
-            float nx, ny, nz;
-            iss >> nx >> ny >> nz;
-            normals.push_back(nx);
-            normals.push_back(ny);
-            normals.push_back(nz);
+int PointFileReader::read(int max_points, PointBuffer& xyz,
+                          PointBuffer* out_normals, PointBuffer* out_colors) {
+    int n = 0;
+    float v[3];
+    while (n < max_points && consumed < count && std::getline(file, line)) {
+        const char* s = line.c_str();
+        parse_triple(s, v);
+        xyz.push_back(v[0], v[1], v[2]);
+        if (has_normals) {
+            parse_triple(s, v);
+            if (out_normals) out_normals->push_back(v[0], v[1], v[2]);
         }
-
-        if (has_red) {
-            float r, g, b;
-            iss >> r >> g >> b;
-            colors.push_back(r / 255.0f);
-            colors.push_back(g / 255.0f);
-            colors.push_back(b / 255.0f);
+        if (has_colors) {
+            parse_triple(s, v);
+            if (out_colors) out_colors->push_back(v[0] / 255.0f, v[1] / 255.0f, v[2] / 255.0f);
         }
+        ++n;
+        ++consumed;
     }
+    return n;
+}
 
-    has_normals = has_nx && !normals.empty();
-    has_colors = has_red && !colors.empty();
-    return true;
+// =============================================================================
+// Voxel Grid
+// =============================================================================
+
+// Points whose voxel keys are computed per voxel_keys() call
+static const size_t VOXEL_KEY_BATCH = 1024;
+
+void VoxelGrid::reset(float size) {
+    voxel_size = size;
+    index.reset();  // Drop the nodes before the arena takes their storage back
+    arena.reset();
+    index.emplace(0, KeyHash(), std::equal_to<Key>(), Index::allocator_type(&arena));
+    keys.clear();
+    sums.clear();
+    normal_sums.clear();
+    counts.clear();
 }
 
-// Simple PCD loader (ASCII format)
-bool PointCloudImpl::load_pcd(const char* filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        set_error("Cannot open PCD file");
-        return false;
+size_t VoxelGrid::memory_bytes() const {
+    return arena.memory_bytes() + vector_bytes(keys) + vector_bytes(sums) + vector_bytes(normal_sums) + vector_bytes(counts);
+}
+
+void VoxelGrid::add(const PointBuffer& xyz, const PointBuffer* point_normals) {
+    const float* px = xyz.x();
+    const float* py = xyz.y();
+    const float* pz = xyz.z();
+
+    // Voxel coordinates for a batch at a time, then the hash lookups
+    ScratchScope scratch;
+    const size_t batch = std::min(xyz.size(), VOXEL_KEY_BATCH);
+    int* kx = scratch.array<int>(batch);
+    int* ky = scratch.array<int>(batch);
+    int* kz = scratch.array<int>(batch);
+    for (size_t i = 0; i < xyz.size(); ++i) {
+        size_t slot = i % VOXEL_KEY_BATCH;
+        if (slot == 0) {
+            voxel_keys(px + i, py + i, pz + i, std::min(batch, xyz.size() - i), voxel_size, kx, ky, kz);
+        }
+        const float p[3] = {px[i], py[i], pz[i]};
+        Key key;
+        key.x = kx[slot];
+        key.y = ky[slot];
+        key.z = kz[slot];
+
+        auto inserted = index->emplace(key, counts.size());
+        size_t cell = inserted.first->second;
+        if (inserted.second) {
+            keys.push_back(key);
+            sums.insert(sums.end(), 3, 0.0f);
+            if (point_normals) normal_sums.insert(normal_sums.end(), 3, 0.0f);
+            counts.push_back(0);
+        }
+
+        for (int c = 0; c < 3; ++c) sums[cell * 3 + c] += p[c];
+        if (point_normals) {
+            normal_sums[cell * 3] += point_normals->x()[i];
+            normal_sums[cell * 3 + 1] += point_normals->y()[i];
+            normal_sums[cell * 3 + 2] += point_normals->z()[i];
+        }
+        ++counts[cell];
     }
+}
 
-    std::string line;
-    int point_count = 0;
-    bool in_header = true;
+void VoxelGrid::extract(PointBuffer& out_points, PointBuffer* out_normals) const {
+    ScratchScope scratch;
+    size_t cells = counts.size();
+    size_t* order = scratch.array<size_t>(cells);
+    std::iota(order, order + cells, size_t(0));
+    std::sort(order, order + cells, [this](size_t a, size_t b) {
+        const Key& ka = keys[a];
+        const Key& kb = keys[b];
+        if (ka.x != kb.x) return ka.x < kb.x;
+        if (ka.y != kb.y) return ka.y < kb.y;
+        return ka.z < kb.z;
+    });
+
+    const bool with_normals = out_normals && normal_sums.size() == sums.size();
+    out_points.clear();
+    out_points.reserve(cells);
+    if (with_normals) {
+        out_normals->clear();
+        out_normals->reserve(cells);
+    }
 
-    // Parse header
-    while (in_header && std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string token;
-        iss >> token;
+    for (size_t i = 0; i < cells; ++i) {
+        size_t cell = order[i];
+        float count = static_cast<float>(counts[cell]);
+        out_points.push_back(sums[cell * 3] / count, sums[cell * 3 + 1] / count, sums[cell * 3 + 2] / count);
 
-        if (token == "POINTS") {
-            iss >> point_count;
-        } else if (token == "DATA") {
-            in_header = false;
+        if (with_normals) {
+            float nx = normal_sums[cell * 3], ny = normal_sums[cell * 3 + 1], nz = normal_sums[cell * 3 + 2];
+            float len = std::sqrt(nx*nx + ny*ny + nz*nz);
+            if (len > 1e-6f) {
+                out_normals->push_back(nx / len, ny / len, nz / len);
+            } else {
+                out_normals->push_back(0, 0, 1);
+            }
         }
     }
+}
 
-    if (point_count <= 0) {
-        set_error("Invalid point count in PCD");
-        return false;
-    }
+// =============================================================================
+// Point Cloud
+// =============================================================================
 
-    clear();
-    points.reserve(point_count * 3);
+bool PointCloudImpl::load(const char* filepath, PointFileFormat format) {
+    SMR_STAT_SCOPE(STAT_POINTCLOUD_LOAD);
+    PointFileReader reader;
+    if (!reader.open(filepath, format)) return false;
 
-    for (int i = 0; i < point_count && std::getline(file, line); ++i) {
-        std::istringstream iss(line);
-        float x, y, z;
-        iss >> x >> y >> z;
-        points.push_back(x);
-        points.push_back(y);
-        points.push_back(z);
+    clear();
+    points.reserve(reader.count);
+    if (reader.has_normals) normals.reserve(reader.count);
+    if (reader.has_colors) colors.reserve(reader.count);
+
+    while (reader.read(4096, points, &normals, &colors) > 0) {
+        if (job_cancelled()) {
+            clear();
+            set_last_error("Cancelled");
+            return false;
+        }
+        job_progress(static_cast<float>(reader.points_read()) / reader.count);
     }
 
+    has_normals = reader.has_normals && !normals.empty();
+    has_colors = reader.has_colors && !colors.empty();
     return true;
 }
 
+// Candidate of a brute-force neighbor search (kept in thread scratch)
+struct Neighbor {
+    float distance;
+    int index;
+};
+
+static bool nearer(const Neighbor& a, const Neighbor& b) {
+    return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+}
+
 // KNN-based normal estimation (simplified)
 void PointCloudImpl::estimate_normals_knn(int k) {
     int n = count();
     if (n < k) return;
 
-    normals.resize(n * 3);
+    normals.resize(n);
+    std::atomic<int> done(0);
+    const float* xs = points.x();
+    const float* ys = points.y();
+    const float* zs = points.z();
     
     // For each point, find k nearest neighbors and compute normal via PCA
-    for (int i = 0; i < n; ++i) {
-        float px = points[i*3], py = points[i*3+1], pz = points[i*3+2];
-        
-        // Find k nearest neighbors (brute force for simplicity)
-        std::vector<std::pair<float, int>> distances;
-        for (int j = 0; j < n; ++j) {
-            if (i == j) continue;
-            float dx = points[j*3] - px;
-            float dy = points[j*3+1] - py;
-            float dz = points[j*3+2] - pz;
-            float d = dx*dx + dy*dy + dz*dz;
-            distances.push_back({d, j});
-        }
-        std::partial_sort(distances.begin(), distances.begin() + k, 
-                          distances.end());
-
-        // Compute centroid of neighbors
-        float cx = 0, cy = 0, cz = 0;
-        for (int j = 0; j < k; ++j) {
-            int idx = distances[j].second;
-            cx += points[idx*3];
-            cy += points[idx*3+1];
-            cz += points[idx*3+2];
-        }
-        cx /= k; cy /= k; cz /= k;
-
-        // Compute covariance matrix
-        float cov[9] = {0};
-        for (int j = 0; j < k; ++j) {
-            int idx = distances[j].second;
-            float dx = points[idx*3] - cx;
-            float dy = points[idx*3+1] - cy;
-            float dz = points[idx*3+2] - cz;
-            cov[0] += dx*dx; cov[1] += dx*dy; cov[2] += dx*dz;
-            cov[3] += dy*dx; cov[4] += dy*dy; cov[5] += dy*dz;
-            cov[6] += dz*dx; cov[7] += dz*dy; cov[8] += dz*dz;
-        }
+    parallel_for(0, static_cast<size_t>(n), 64, [&](size_t lo, size_t hi) {
+        ScratchScope scratch;
+        float* d2 = scratch.array<float>(n);
+        Neighbor* candidates = scratch.array<Neighbor>(n);
+        float* gx = scratch.array<float>(k);
+        float* gy = scratch.array<float>(k);
+        float* gz = scratch.array<float>(k);
+        for (int i = static_cast<int>(lo); i < static_cast<int>(hi); ++i) {
+            // Find k nearest neighbors (brute force for simplicity)
+            {
+                SMR_STAT_SCOPE(STAT_NORMALS_SEARCH);
+                squared_distances(xs, ys, zs, n, xs[i], ys[i], zs[i], d2);
+                int m = 0;
+                for (int j = 0; j < n; ++j) {
+                    if (j != i) candidates[m++] = Neighbor{d2[j], j};
+                }
+                std::partial_sort(candidates, candidates + k, candidates + m, nearer);
+            }
+            SMR_STAT_SCOPE(STAT_NORMALS_PCA);
+
+            // Centroid and covariance of the neighbors
+            for (int j = 0; j < k; ++j) {
+                int idx = candidates[j].index;
+                gx[j] = xs[idx];
+                gy[j] = ys[idx];
+                gz[j] = zs[idx];
+            }
+            float centroid[3], cov[6];
+            covariance(gx, gy, gz, k, centroid, cov);
 
-        // Simplified: use cross product of two eigenvectors approximation
-        // Normal = smallest eigenvector (simplified: use column with smallest variance)
-        float var0 = cov[0], var1 = cov[4], var2 = cov[8];
-        int min_idx = (var0 < var1 && var0 < var2) ? 0 : (var1 < var2 ? 1 : 2);
+            // Simplified: use cross product of two eigenvectors approximation
+            // Normal = smallest eigenvector (simplified: use column with smallest variance)
+            float var0 = cov[0], var1 = cov[3], var2 = cov[5];
+            int min_idx = (var0 < var1 && var0 < var2) ? 0 : (var1 < var2 ? 1 : 2);
         
-        float nx = (min_idx == 0) ? 1.0f : 0.0f;
-        float ny = (min_idx == 1) ? 1.0f : 0.0f;
-        float nz = (min_idx == 2) ? 1.0f : 0.0f;
-
-        // More accurate: power iteration for smallest eigenvector
-        // (simplified version for demo)
-        float len = std::sqrt(nx*nx + ny*ny + nz*nz);
-        if (len > 1e-6f) {
-            normals[i*3] = nx / len;
-            normals[i*3+1] = ny / len;
-            normals[i*3+2] = nz / len;
-        } else {
-            normals[i*3] = 0;
-            normals[i*3+1] = 0;
-            normals[i*3+2] = 1;
+            float nx = (min_idx == 0) ? 1.0f : 0.0f;
+            float ny = (min_idx == 1) ? 1.0f : 0.0f;
+            float nz = (min_idx == 2) ? 1.0f : 0.0f;
+
+            // More accurate: power iteration for smallest eigenvector
+            // (simplified version for demo)
+            float len = std::sqrt(nx*nx + ny*ny + nz*nz);
+            if (len > 1e-6f) {
+                normals.x()[i] = nx / len;
+                normals.y()[i] = ny / len;
+                normals.z()[i] = nz / len;
+            } else {
+                normals.x()[i] = 0;
+                normals.y()[i] = 0;
+                normals.z()[i] = 1;
+            }
         }
+        job_progress(static_cast<float>(done += static_cast<int>(hi - lo)) / n);
+    });
+
+    if (job_cancelled()) {
+        normals.clear();
+        has_normals = false;
+        return;
     }
     has_normals = true;
 }
@@ -252,147 +335,265 @@ void PointCloudImpl::orient_normals(float cx, float cy, float cz) {
     if (!has_normals) return;
     
     int n = count();
+    float* nxs = normals.x();
+    float* nys = normals.y();
+    float* nzs = normals.z();
     for (int i = 0; i < n; ++i) {
-        float px = points[i*3], py = points[i*3+1], pz = points[i*3+2];
-        float nx = normals[i*3], ny = normals[i*3+1], nz = normals[i*3+2];
-        
         // Vector from point to camera
-        float vx = cx - px, vy = cy - py, vz = cz - pz;
+        float vx = cx - points.x()[i], vy = cy - points.y()[i], vz = cz - points.z()[i];
         
         // Flip normal if pointing away from camera
-        float dot = nx*vx + ny*vy + nz*vz;
+        float dot = nxs[i]*vx + nys[i]*vy + nzs[i]*vz;
         if (dot < 0) {
-            normals[i*3] = -nx;
-            normals[i*3+1] = -ny;
-            normals[i*3+2] = -nz;
+            nxs[i] = -nxs[i];
+            nys[i] = -nys[i];
+            nzs[i] = -nzs[i];
         }
     }
 }
 
 void PointCloudImpl::downsample_voxel(float voxel_size) {
     if (voxel_size <= 0) return;
-    
-    // Simple voxel grid downsampling
-    struct VoxelKey {
-        int x, y, z;
-        bool operator<(const VoxelKey& other) const {
-            if (x != other.x) return x < other.x;
-            if (y != other.y) return y < other.y;
-            return z < other.z;
-        }
-    };
+    SMR_STAT_SCOPE(STAT_DOWNSAMPLE);
 
-    std::map<VoxelKey, std::vector<int>> voxels;
-    int n = count();
-    
-    for (int i = 0; i < n; ++i) {
-        VoxelKey key;
-        key.x = static_cast<int>(std::floor(points[i*3] / voxel_size));
-        key.y = static_cast<int>(std::floor(points[i*3+1] / voxel_size));
-        key.z = static_cast<int>(std::floor(points[i*3+2] / voxel_size));
-        voxels[key].push_back(i);
-    }
+    VoxelGrid grid;
+    grid.reset(voxel_size);
+    grid.add(points, has_normals ? &normals : nullptr);
 
-    std::vector<float> new_points;
-    std::vector<float> new_normals;
-    
-    for (auto& pair : voxels) {
-        float px = 0, py = 0, pz = 0;
-        float nx = 0, ny = 0, nz = 0;
-        int count = static_cast<int>(pair.second.size());
-        
-        for (int idx : pair.second) {
-            px += points[idx*3];
-            py += points[idx*3+1];
-            pz += points[idx*3+2];
-            if (has_normals) {
-                nx += normals[idx*3];
-                ny += normals[idx*3+1];
-                nz += normals[idx*3+2];
-            }
-        }
-        
-        new_points.push_back(px / count);
-        new_points.push_back(py / count);
-        new_points.push_back(pz / count);
-        
-        if (has_normals) {
-            float len = std::sqrt(nx*nx + ny*ny + nz*nz);
-            if (len > 1e-6f) {
-                new_normals.push_back(nx / len);
-                new_normals.push_back(ny / len);
-                new_normals.push_back(nz / len);
-            } else {
-                new_normals.push_back(0);
-                new_normals.push_back(0);
-                new_normals.push_back(1);
-            }
-        }
-    }
+    PointBuffer new_points = buffers.take(grid.size());
+    PointBuffer new_normals = has_normals ? buffers.take(grid.size()) : PointBuffer();
+    grid.extract(new_points, has_normals ? &new_normals : nullptr);
 
-    points = std::move(new_points);
-    if (has_normals) normals = std::move(new_normals);
+    points.swap(new_points);
+    buffers.give(std::move(new_points));
+    if (has_normals) {
+        normals.swap(new_normals);
+        buffers.give(std::move(new_normals));
+    }
+    buffers.trim(points.size());
 }
 
 void PointCloudImpl::remove_outliers(int nb_neighbors, float std_ratio) {
     int n = count();
     if (n <= nb_neighbors) return;
 
-    std::vector<float> mean_distances(n);
+    ScratchScope scratch;
+    float* mean_distances = scratch.array<float>(n);
+    std::atomic<int> done(0);
+    const float* xs = points.x();
+    const float* ys = points.y();
+    const float* zs = points.z();
     
     // Compute mean distance to neighbors for each point
-    for (int i = 0; i < n; ++i) {
-        float px = points[i*3], py = points[i*3+1], pz = points[i*3+2];
-        std::vector<float> distances;
+    parallel_for(0, static_cast<size_t>(n), 64, [&](size_t lo, size_t hi) {
+        ScratchScope chunk_scratch;
+        float* dist = chunk_scratch.array<float>(n);
+        for (int i = static_cast<int>(lo); i < static_cast<int>(hi); ++i) {
+            SMR_STAT_SCOPE(STAT_OUTLIER_SEARCH);
+            distances(xs, ys, zs, n, xs[i], ys[i], zs[i], dist);
+            dist[i] = INFINITY;  // Not its own neighbor
+            std::partial_sort(dist, dist + nb_neighbors, dist + n);
         
-        for (int j = 0; j < n; ++j) {
-            if (i == j) continue;
-            float dx = points[j*3] - px;
-            float dy = points[j*3+1] - py;
-            float dz = points[j*3+2] - pz;
-            distances.push_back(std::sqrt(dx*dx + dy*dy + dz*dz));
+            float sum = 0;
+            for (int k = 0; k < nb_neighbors; ++k) sum += dist[k];
+            mean_distances[i] = sum / nb_neighbors;
         }
-        std::partial_sort(distances.begin(), 
-                          distances.begin() + nb_neighbors, 
-                          distances.end());
-        
-        float sum = 0;
-        for (int k = 0; k < nb_neighbors; ++k) sum += distances[k];
-        mean_distances[i] = sum / nb_neighbors;
-    }
+        job_progress(static_cast<float>(done += static_cast<int>(hi - lo)) / n);
+    });
+    if (job_cancelled()) return;
 
     // Compute global statistics
-    float global_mean = 0, global_std = 0;
-    for (float d : mean_distances) global_mean += d;
-    global_mean /= n;
-    
-    for (float d : mean_distances) {
-        float diff = d - global_mean;
-        global_std += diff * diff;
-    }
-    global_std = std::sqrt(global_std / n);
+    auto add = [](double a, double b) { return a + b; };
+    double sum = parallel_reduce(0, static_cast<size_t>(n), 4096, 0.0, [&](size_t lo, size_t hi) {
+        double s = 0;
+        for (size_t i = lo; i < hi; ++i) s += mean_distances[i];
+        return s;
+    }, add);
+    float global_mean = static_cast<float>(sum / n);
+
+    double squares = parallel_reduce(0, static_cast<size_t>(n), 4096, 0.0, [&](size_t lo, size_t hi) {
+        double s = 0;
+        for (size_t i = lo; i < hi; ++i) {
+            double diff = mean_distances[i] - global_mean;
+            s += diff * diff;
+        }
+        return s;
+    }, add);
+    float global_std = static_cast<float>(std::sqrt(squares / n));
 
     float threshold = global_mean + std_ratio * global_std;
 
     // Filter points
-    std::vector<float> new_points;
-    std::vector<float> new_normals;
+    PointBuffer new_points = buffers.take(points.size());
+    PointBuffer new_normals = has_normals ? buffers.take(normals.size()) : PointBuffer();
     
     for (int i = 0; i < n; ++i) {
         if (mean_distances[i] <= threshold) {
-            new_points.push_back(points[i*3]);
-            new_points.push_back(points[i*3+1]);
-            new_points.push_back(points[i*3+2]);
-            if (has_normals) {
-                new_normals.push_back(normals[i*3]);
-                new_normals.push_back(normals[i*3+1]);
-                new_normals.push_back(normals[i*3+2]);
+            new_points.push_back(xs[i], ys[i], zs[i]);
+            if (has_normals) new_normals.push_back(normals.x()[i], normals.y()[i], normals.z()[i]);
+        }
+    }
+
+    points.swap(new_points);
+    buffers.give(std::move(new_points));
+    if (has_normals) {
+        normals.swap(new_normals);
+        buffers.give(std::move(new_normals));
+    }
+    buffers.trim(points.size());
+}
+
+// =============================================================================
+// Spatial Sort
+// =============================================================================
+
+// Bits per axis of a Morton code (3 * 21 = 63)
+static const int MORTON_BITS = 21;
+
+// Items per radix sort block (one digit histogram each) and per gather task
+static const size_t RADIX_BLOCK = 1u << 16;
+
+// Key bits per radix pass (63-bit codes take 6 passes)
+static const int RADIX_BITS = 11;
+static const size_t RADIX_DIGITS = size_t(1) << RADIX_BITS;
+
+// Move bit i of the low 21 bits of v to bit 3i
+static uint64_t spread_bits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffull;
+    v = (v | v << 16) & 0x1f0000ff0000ffull;
+    v = (v | v << 8) & 0x100f00f00f00f00full;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+    v = (v | v << 2) & 0x1249249249249249ull;
+    return v;
+}
+
+/**
+ * Stable LSD radix sort of (key, value) pairs on the low `key_bits` bits of
+ * the keys, RADIX_BITS per pass. A pass counts digits per block in parallel,
+ * turns the counts into per-block output offsets (digit-major, so equal
+ * digits keep their order) and scatters the blocks in parallel. Passes on a
+ * digit every key shares are skipped. tmp_keys / tmp_values are work space
+ * of n entries; the result is left in keys / values.
+ */
+static void radix_sort_pairs(uint64_t* keys, uint32_t* values, size_t n, int key_bits,
+                             uint64_t* tmp_keys, uint32_t* tmp_values) {
+    ScratchScope scratch;
+    const size_t blocks = (n + RADIX_BLOCK - 1) / RADIX_BLOCK;
+    size_t* offsets = scratch.array<size_t>(blocks * RADIX_DIGITS);
+
+    uint64_t* src_keys = keys;
+    uint32_t* src_values = values;
+    uint64_t* dst_keys = tmp_keys;
+    uint32_t* dst_values = tmp_values;
+    const uint64_t mask = RADIX_DIGITS - 1;
+    for (int shift = 0; shift < key_bits; shift += RADIX_BITS) {
+        const uint64_t* in_keys = src_keys;
+        const uint32_t* in_values = src_values;
+        uint64_t* out_keys = dst_keys;
+        uint32_t* out_values = dst_values;
+        parallel_for(0, blocks, 1, [=](size_t lo, size_t hi) {
+            for (size_t b = lo; b < hi; ++b) {
+                size_t* count = offsets + b * RADIX_DIGITS;
+                std::fill(count, count + RADIX_DIGITS, size_t(0));
+                size_t end = std::min(n, (b + 1) * RADIX_BLOCK);
+                for (size_t i = b * RADIX_BLOCK; i < end; ++i) ++count[(in_keys[i] >> shift) & mask];
+            }
+        });
+
+        size_t total = 0;
+        bool shared_digit = false;
+        for (size_t d = 0; d < RADIX_DIGITS; ++d) {
+            size_t digit_start = total;
+            for (size_t b = 0; b < blocks; ++b) {
+                size_t count = offsets[b * RADIX_DIGITS + d];
+                offsets[b * RADIX_DIGITS + d] = total;
+                total += count;
             }
+            if (total - digit_start == n) shared_digit = true;
         }
+        if (shared_digit) continue;
+
+        parallel_for(0, blocks, 1, [=](size_t lo, size_t hi) {
+            for (size_t b = lo; b < hi; ++b) {
+                size_t* next = offsets + b * RADIX_DIGITS;
+                size_t end = std::min(n, (b + 1) * RADIX_BLOCK);
+                for (size_t i = b * RADIX_BLOCK; i < end; ++i) {
+                    size_t slot = next[(in_keys[i] >> shift) & mask]++;
+                    out_keys[slot] = in_keys[i];
+                    out_values[slot] = in_values[i];
+                }
+            }
+        });
+        std::swap(src_keys, dst_keys);
+        std::swap(src_values, dst_values);
     }
 
-    points = std::move(new_points);
-    if (has_normals) normals = std::move(new_normals);
+    if (src_keys != keys) {
+        std::copy(src_keys, src_keys + n, keys);
+        std::copy(src_values, src_values + n, values);
+    }
+}
+
+// buffer[i] = old buffer[order[i]], built in a pooled buffer
+static void permute(PointBuffer& buffer, const uint32_t* order, BufferPool<PointBuffer>& pool) {
+    size_t n = buffer.size();
+    PointBuffer sorted = pool.take(n);
+    sorted.resize(n);
+    const float* src[3] = {buffer.x(), buffer.y(), buffer.z()};
+    float* dst[3] = {sorted.x(), sorted.y(), sorted.z()};
+    parallel_for(0, n, RADIX_BLOCK, [&](size_t lo, size_t hi) {
+        for (int k = 0; k < 3; ++k) {
+            for (size_t i = lo; i < hi; ++i) dst[k][i] = src[k][order[i]];
+        }
+    });
+    buffer.swap(sorted);
+    pool.give(std::move(sorted));
+}
+
+void PointCloudImpl::sort_spatial(int* permutation) {
+    size_t n = points.size();
+    if (n == 0) return;
+    SMR_STAT_SCOPE(STAT_SPATIAL_SORT);
+
+    // Quantize onto a 2^21 grid over the bounding box, with one scale for
+    // all axes so the curve's cells are cubes
+    const float* axis[3] = {points.x(), points.y(), points.z()};
+    float lo[3];
+    float extent = 0;
+    for (int k = 0; k < 3; ++k) {
+        const auto range = std::minmax_element(axis[k], axis[k] + n);
+        lo[k] = *range.first;
+        extent = std::max(extent, *range.second - *range.first);
+    }
+    const float max_cell = static_cast<float>((1u << MORTON_BITS) - 1);
+    const float scale = extent > 0 ? max_cell / extent : 0.0f;
+
+    ScratchScope scratch;
+    uint64_t* codes = scratch.array<uint64_t>(n);
+    uint32_t* order = scratch.array<uint32_t>(n);
+    parallel_for(0, n, RADIX_BLOCK, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uint64_t code = 0;
+            for (int k = 0; k < 3; ++k) {
+                float q = (axis[k][i] - lo[k]) * scale;
+                q = q >= 0 ? std::min(q, max_cell) : 0.0f;  // Also maps NaN to 0
+                code |= spread_bits(static_cast<uint64_t>(q)) << k;
+            }
+            codes[i] = code;
+            order[i] = static_cast<uint32_t>(i);
+        }
+    });
+    radix_sort_pairs(codes, order, n, 3 * MORTON_BITS,
+                     scratch.array<uint64_t>(n), scratch.array<uint32_t>(n));
+
+    permute(points, order, buffers);
+    if (has_normals && normals.size() == n) permute(normals, order, buffers);
+    if (has_colors && colors.size() == n) permute(colors, order, buffers);
+
+    if (permutation) {
+        for (size_t i = 0; i < n; ++i) permutation[i] = static_cast<int>(order[i]);
+    }
 }
 
 // =============================================================================
@@ -430,7 +631,7 @@ SMR_API SMRErrorCode smr_pointcloud_set_points(PointCloudHandle handle,
     
     auto* pc = static_cast<PointCloudImpl*>(handle);
     pc->clear();
-    pc->points.assign(points, points + count * 3);
+    pc->points.assign_interleaved(points, count);
     return SMR_SUCCESS;
 }
 
@@ -439,12 +640,23 @@ SMR_API int smr_pointcloud_get_count(PointCloudHandle handle) {
     return static_cast<PointCloudImpl*>(handle)->count();
 }
 
+SMR_API long long smr_pointcloud_get_memory(PointCloudHandle handle) {
+    if (!handle) return -1;
+    return static_cast<long long>(static_cast<PointCloudImpl*>(handle)->memory_bytes());
+}
+
+SMR_API SMRErrorCode smr_pointcloud_trim_memory(PointCloudHandle handle) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    static_cast<PointCloudImpl*>(handle)->buffers.trim();
+    return SMR_SUCCESS;
+}
+
 SMR_API SMRErrorCode smr_pointcloud_get_points(PointCloudHandle handle, float* out_points) {
     if (!handle) return SMR_ERROR_INVALID_HANDLE;
     if (!out_points) return SMR_ERROR_INVALID_PARAMETER;
     
     auto* pc = static_cast<PointCloudImpl*>(handle);
-    std::memcpy(out_points, pc->points.data(), pc->points.size() * sizeof(float));
+    pc->points.copy_interleaved(out_points);
     return SMR_SUCCESS;
 }
 
@@ -460,7 +672,7 @@ SMR_API SMRErrorCode smr_pointcloud_get_normals(PointCloudHandle handle, float*
     auto* pc = static_cast<PointCloudImpl*>(handle);
     if (!pc->has_normals) return SMR_ERROR_COMPUTATION_FAILED;
     
-    std::memcpy(out_normals, pc->normals.data(), pc->normals.size() * sizeof(float));
+    pc->normals.copy_interleaved(out_normals);
     return SMR_SUCCESS;
 }
 
@@ -504,6 +716,13 @@ SMR_API SMRErrorCode smr_pointcloud_remove_outliers(PointCloudHandle handle,
     return SMR_SUCCESS;
 }
 
+SMR_API SMRErrorCode smr_pointcloud_sort_spatial(PointCloudHandle handle, int* out_permutation) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+
+    static_cast<PointCloudImpl*>(handle)->sort_spatial(out_permutation);
+    return SMR_SUCCESS;
+}
+
 SMR_API const char* smr_get_last_error(void) {
     return g_last_error;
 }
@@ -512,5 +731,6 @@ SMR_API const char* smr_get_version(void) {
     return "1.0.0";
 }
 
-// Include map for voxel downsampling
-#include <map>
+SMR_API const char* smr_get_simd_level(void) {
+    return simd_level_name(point_kernels_level());
+}
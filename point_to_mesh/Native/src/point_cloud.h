@@ -0,0 +1,163 @@
+/**
+ * @file point_cloud.h
+ * @brief Internal Point Cloud Types (shared between native modules)
+ */
+
+#ifndef SMR_POINT_CLOUD_H
+#define SMR_POINT_CLOUD_H
+
+#include "smr_welding_api.h"
+#include "memory_tracker.h"
+#include "point_buffer.h"
+#include "scratch_memory.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Set the calling thread's message for smr_get_last_error
+void set_last_error(const char* msg);
+
+// =============================================================================
+// Streaming File Reader
+// =============================================================================
+
+enum PointFileFormat {
+    POINT_FILE_PLY,
+    POINT_FILE_PCD
+};
+
+/**
+ * ASCII PLY/PCD reader that hands out points in blocks, so a consumer can
+ * filter one block while the next is parsed.
+ */
+class PointFileReader {
+public:
+    int count = 0;              // Points announced by the header
+    bool has_normals = false;   // PLY nx ny nz after xyz
+    bool has_colors = false;    // PLY red green blue after the normals
+
+    /// Open a file and parse its header (false with the last error set if unusable)
+    bool open(const char* filepath, PointFileFormat format);
+
+    /**
+     * Append up to max_points points to xyz (and to normals / colors when
+     * present and not NULL; colors are scaled to [0, 1]).
+     * @return Points read (0 at the end of the data)
+     */
+    int read(int max_points, PointBuffer& xyz, PointBuffer* normals, PointBuffer* colors);
+
+    int points_read() const { return consumed; }
+
+private:
+    std::ifstream file;
+    std::string line;
+    int consumed = 0;
+};
+
+// =============================================================================
+// Voxel Grid
+// =============================================================================
+
+/**
+ * Incremental voxel-grid filter: points (and normals) are summed per voxel
+ * as they arrive, so a cloud can be downsampled block by block while it is
+ * still being read.
+ */
+class VoxelGrid {
+public:
+    VoxelGrid() { reset(0); }
+
+    /// Start an empty grid (keeps allocated storage)
+    void reset(float voxel_size);
+
+    /// Add points (normals may be NULL, but must be given always or never)
+    void add(const PointBuffer& xyz, const PointBuffer* point_normals);
+
+    size_t size() const { return counts.size(); }
+
+    /// Bytes reserved by the voxel arrays and the hash index (approximate)
+    size_t memory_bytes() const;
+
+    /**
+     * Voxel centroids in (x, y, z) voxel order, and the renormalized mean
+     * normals if normals were added and `out_normals` is not NULL.
+     */
+    void extract(PointBuffer& out_points, PointBuffer* out_normals) const;
+
+private:
+    struct Key {
+        int x, y, z;
+        bool operator==(const Key& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const {
+            uint64_t h = static_cast<uint32_t>(k.x) * 73856093ull ^
+                         static_cast<uint32_t>(k.y) * 19349663ull ^
+                         static_cast<uint32_t>(k.z) * 83492791ull;
+            return static_cast<size_t>(h);
+        }
+    };
+
+    typedef std::unordered_map<Key, size_t, KeyHash, std::equal_to<Key>,
+                               ArenaAllocator<std::pair<const Key, size_t>>> Index;
+
+    float voxel_size = 0;
+    MonotonicArena arena;           // Hash nodes and buckets, freed by reset()
+    std::optional<Index> index;     // Rebuilt on reset(), after the arena
+    TrackedVector<Key> keys;
+    TrackedVector<float> sums;          // XYZ per voxel
+    TrackedVector<float> normal_sums;   // XYZ per voxel
+    TrackedVector<int> counts;
+};
+
+// =============================================================================
+// Internal Point Cloud Class
+// =============================================================================
+
+class PointCloudImpl {
+public:
+    PointBuffer points;   // count points
+    PointBuffer normals;  // count normals
+    PointBuffer colors;   // count RGB triples (x = red)
+    bool has_normals = false;
+    bool has_colors = false;
+    BufferPool<PointBuffer> buffers;  // Arrays replaced by the filters, for reuse
+
+    int count() const { return static_cast<int>(points.size()); }
+
+    size_t memory_bytes() const {
+        return points.memory_bytes() + normals.memory_bytes() + colors.memory_bytes() +
+               buffers.memory_bytes();
+    }
+
+    void clear() {
+        points.clear();
+        normals.clear();
+        colors.clear();
+        has_normals = false;
+        has_colors = false;
+    }
+
+    bool load(const char* filepath, PointFileFormat format);
+    bool load_ply(const char* filepath) { return load(filepath, POINT_FILE_PLY); }
+    bool load_pcd(const char* filepath) { return load(filepath, POINT_FILE_PCD); }
+    void estimate_normals_knn(int k);
+    void estimate_normals_radius(float radius);
+    void orient_normals(float cx, float cy, float cz);
+    void downsample_voxel(float voxel_size);
+    void remove_outliers(int nb_neighbors, float std_ratio);
+
+    /**
+     * Reorder the points (with their normals and colors) along a Morton
+     * (Z-order) curve over their bounding box, so points near in space are
+     * near in memory. If `permutation` is not NULL it receives count()
+     * entries: the original index of the point now at each position.
+     */
+    void sort_spatial(int* permutation);
+};
+
+#endif // SMR_POINT_CLOUD_H
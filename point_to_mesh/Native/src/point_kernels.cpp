@@ -0,0 +1,526 @@
+/**
+ * @file point_kernels.cpp
+ * @brief Distance, Covariance, Voxel Key and Cube Case Kernels
+ *
+ * Every kernel exists as a scalar body plus AVX2 (8 lanes), AVX-512
+ * (16 lanes) and NEON (4 lanes) bodies that finish their remainder with the
+ * scalar one. The x86 bodies carry a target attribute instead of the whole
+ * library being built with -mavx2, so the rest of the binary stays generic
+ * and a table picked once at run time routes the calls. Loads are
+ * unaligned, so callers may pass any sub-range of a PointBuffer or a
+ * scratch array. FMA is not used, so the vector paths round each product
+ * like the scalar one (sums are only reordered).
+ */
+
+#include "point_kernels.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define SMR_KERNELS_X86 1
+#if defined(__GNUC__) || defined(__clang__)
+#define SMR_TARGET_AVX2 __attribute__((target("avx2")))
+#define SMR_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+// MSVC emits any intrinsic regardless of /arch
+#define SMR_TARGET_AVX2
+#define SMR_TARGET_AVX512
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SMR_KERNELS_NEON 1
+#endif
+
+// =============================================================================
+// Scalar
+// =============================================================================
+
+static void scalar_squared_distances(const float* x, const float* y, const float* z, size_t n,
+                                     float px, float py, float pz, float* out) {
+    for (size_t j = 0; j < n; ++j) {
+        float dx = x[j] - px;
+        float dy = y[j] - py;
+        float dz = z[j] - pz;
+        out[j] = dx*dx + dy*dy + dz*dz;
+    }
+}
+
+static void scalar_distances(const float* x, const float* y, const float* z, size_t n,
+                             float px, float py, float pz, float* out) {
+    scalar_squared_distances(x, y, z, n, px, py, pz, out);
+    for (size_t j = 0; j < n; ++j) out[j] = std::sqrt(out[j]);
+}
+
+// Covariance tails: add points j..n-1 to the coordinate sums s[3] and to the
+// scatter sums acc[6] about c[3]
+static void add_sums(const float* x, const float* y, const float* z, size_t j, size_t n, float s[3]) {
+    for (; j < n; ++j) {
+        s[0] += x[j];
+        s[1] += y[j];
+        s[2] += z[j];
+    }
+}
+
+static void add_scatter(const float* x, const float* y, const float* z, size_t j, size_t n,
+                        const float c[3], float acc[6]) {
+    for (; j < n; ++j) {
+        float dx = x[j] - c[0], dy = y[j] - c[1], dz = z[j] - c[2];
+        acc[0] += dx*dx; acc[1] += dx*dy; acc[2] += dx*dz;
+        acc[3] += dy*dy; acc[4] += dy*dz; acc[5] += dz*dz;
+    }
+}
+
+static void finish_centroid(const float s[3], size_t n, float centroid[3]) {
+    for (int c = 0; c < 3; ++c) centroid[c] = s[c] / n;
+}
+
+static void scalar_covariance(const float* x, const float* y, const float* z, size_t n,
+                              float centroid[3], float cov[6]) {
+    float s[3] = {0, 0, 0};
+    add_sums(x, y, z, 0, n, s);
+    finish_centroid(s, n, centroid);
+    for (int c = 0; c < 6; ++c) cov[c] = 0;
+    add_scatter(x, y, z, 0, n, centroid, cov);
+}
+
+static void scalar_voxel_keys(const float* x, const float* y, const float* z, size_t n,
+                              float voxel_size, int* kx, int* ky, int* kz) {
+    for (size_t j = 0; j < n; ++j) {
+        kx[j] = static_cast<int>(std::floor(x[j] / voxel_size));
+        ky[j] = static_cast<int>(std::floor(y[j] / voxel_size));
+        kz[j] = static_cast<int>(std::floor(z[j] / voxel_size));
+    }
+}
+
+static void scalar_cube_indices(const float* r00, const float* r01, const float* r10, const float* r11,
+                                size_t n, float iso, uint8_t* out) {
+    for (size_t j = 0; j < n; ++j) {
+        int index = 0;
+        if (r00[j] < iso) index |= 1;
+        if (r00[j + 1] < iso) index |= 2;
+        if (r01[j + 1] < iso) index |= 4;
+        if (r01[j] < iso) index |= 8;
+        if (r10[j] < iso) index |= 16;
+        if (r10[j + 1] < iso) index |= 32;
+        if (r11[j + 1] < iso) index |= 64;
+        if (r11[j] < iso) index |= 128;
+        out[j] = static_cast<uint8_t>(index);
+    }
+}
+
+// =============================================================================
+// AVX2
+// =============================================================================
+
+#if defined(SMR_KERNELS_X86)
+SMR_TARGET_AVX2 static inline float hsum_avx2(__m256 v) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+SMR_TARGET_AVX2 static void avx2_squared_distances(const float* x, const float* y, const float* z, size_t n,
+                                                   float px, float py, float pz, float* out) {
+    const __m256 vx = _mm256_set1_ps(px), vy = _mm256_set1_ps(py), vz = _mm256_set1_ps(pz);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + j), vx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + j), vy);
+        __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + j), vz);
+        __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                 _mm256_mul_ps(dz, dz));
+        _mm256_storeu_ps(out + j, d);
+    }
+    scalar_squared_distances(x + j, y + j, z + j, n - j, px, py, pz, out + j);
+}
+
+SMR_TARGET_AVX2 static void avx2_distances(const float* x, const float* y, const float* z, size_t n,
+                                           float px, float py, float pz, float* out) {
+    avx2_squared_distances(x, y, z, n, px, py, pz, out);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) _mm256_storeu_ps(out + j, _mm256_sqrt_ps(_mm256_loadu_ps(out + j)));
+    for (; j < n; ++j) out[j] = std::sqrt(out[j]);
+}
+
+SMR_TARGET_AVX2 static void avx2_covariance(const float* x, const float* y, const float* z, size_t n,
+                                            float centroid[3], float cov[6]) {
+    size_t j = 0;
+    __m256 ax = _mm256_setzero_ps(), ay = _mm256_setzero_ps(), az = _mm256_setzero_ps();
+    for (; j + 8 <= n; j += 8) {
+        ax = _mm256_add_ps(ax, _mm256_loadu_ps(x + j));
+        ay = _mm256_add_ps(ay, _mm256_loadu_ps(y + j));
+        az = _mm256_add_ps(az, _mm256_loadu_ps(z + j));
+    }
+    float s[3] = {hsum_avx2(ax), hsum_avx2(ay), hsum_avx2(az)};
+    add_sums(x, y, z, j, n, s);
+    finish_centroid(s, n, centroid);
+
+    const __m256 vx = _mm256_set1_ps(centroid[0]), vy = _mm256_set1_ps(centroid[1]),
+                 vz = _mm256_set1_ps(centroid[2]);
+    __m256 sxx = _mm256_setzero_ps(), sxy = _mm256_setzero_ps(), sxz = _mm256_setzero_ps();
+    __m256 syy = _mm256_setzero_ps(), syz = _mm256_setzero_ps(), szz = _mm256_setzero_ps();
+    for (j = 0; j + 8 <= n; j += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + j), vx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + j), vy);
+        __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + j), vz);
+        sxx = _mm256_add_ps(sxx, _mm256_mul_ps(dx, dx));
+        sxy = _mm256_add_ps(sxy, _mm256_mul_ps(dx, dy));
+        sxz = _mm256_add_ps(sxz, _mm256_mul_ps(dx, dz));
+        syy = _mm256_add_ps(syy, _mm256_mul_ps(dy, dy));
+        syz = _mm256_add_ps(syz, _mm256_mul_ps(dy, dz));
+        szz = _mm256_add_ps(szz, _mm256_mul_ps(dz, dz));
+    }
+    cov[0] = hsum_avx2(sxx); cov[1] = hsum_avx2(sxy); cov[2] = hsum_avx2(sxz);
+    cov[3] = hsum_avx2(syy); cov[4] = hsum_avx2(syz); cov[5] = hsum_avx2(szz);
+    add_scatter(x, y, z, j, n, centroid, cov);
+}
+
+SMR_TARGET_AVX2 static void avx2_voxel_keys(const float* x, const float* y, const float* z, size_t n,
+                                            float voxel_size, int* kx, int* ky, int* kz) {
+    const __m256 size = _mm256_set1_ps(voxel_size);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256 fx = _mm256_floor_ps(_mm256_div_ps(_mm256_loadu_ps(x + j), size));
+        __m256 fy = _mm256_floor_ps(_mm256_div_ps(_mm256_loadu_ps(y + j), size));
+        __m256 fz = _mm256_floor_ps(_mm256_div_ps(_mm256_loadu_ps(z + j), size));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(kx + j), _mm256_cvttps_epi32(fx));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ky + j), _mm256_cvttps_epi32(fy));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(kz + j), _mm256_cvttps_epi32(fz));
+    }
+    scalar_voxel_keys(x + j, y + j, z + j, n - j, voxel_size, kx + j, ky + j, kz + j);
+}
+
+// Lanes of `index` where v < iso gain `bit`
+SMR_TARGET_AVX2 static inline __m256i cube_bit_avx2(__m256i index, const float* v, __m256 iso, int bit) {
+    __m256i below = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(v), iso, _CMP_LT_OQ));
+    return _mm256_or_si256(index, _mm256_and_si256(below, _mm256_set1_epi32(bit)));
+}
+
+SMR_TARGET_AVX2 static void avx2_cube_indices(const float* r00, const float* r01, const float* r10,
+                                              const float* r11, size_t n, float iso, uint8_t* out) {
+    const __m256 viso = _mm256_set1_ps(iso);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256i index = _mm256_setzero_si256();
+        index = cube_bit_avx2(index, r00 + j, viso, 1);
+        index = cube_bit_avx2(index, r00 + j + 1, viso, 2);
+        index = cube_bit_avx2(index, r01 + j + 1, viso, 4);
+        index = cube_bit_avx2(index, r01 + j, viso, 8);
+        index = cube_bit_avx2(index, r10 + j, viso, 16);
+        index = cube_bit_avx2(index, r10 + j + 1, viso, 32);
+        index = cube_bit_avx2(index, r11 + j + 1, viso, 64);
+        index = cube_bit_avx2(index, r11 + j, viso, 128);
+
+        // Narrow to bytes; the packs work per 128-bit half, so the low four
+        // bytes of each half are lanes 0-3 and 4-7
+        __m256i bytes = _mm256_packus_epi16(_mm256_packus_epi32(index, index), _mm256_setzero_si256());
+        uint32_t lo = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_castsi256_si128(bytes)));
+        uint32_t hi = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_extracti128_si256(bytes, 1)));
+        std::memcpy(out + j, &lo, 4);
+        std::memcpy(out + j + 4, &hi, 4);
+    }
+    scalar_cube_indices(r00 + j, r01 + j, r10 + j, r11 + j, n - j, iso, out + j);
+}
+
+// =============================================================================
+// AVX-512
+// =============================================================================
+
+// GCC 12 headers trip their own -Wuninitialized on _mm512_undefined_*()
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+SMR_TARGET_AVX512 static void avx512_squared_distances(const float* x, const float* y, const float* z, size_t n,
+                                                       float px, float py, float pz, float* out) {
+    const __m512 vx = _mm512_set1_ps(px), vy = _mm512_set1_ps(py), vz = _mm512_set1_ps(pz);
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m512 dx = _mm512_sub_ps(_mm512_loadu_ps(x + j), vx);
+        __m512 dy = _mm512_sub_ps(_mm512_loadu_ps(y + j), vy);
+        __m512 dz = _mm512_sub_ps(_mm512_loadu_ps(z + j), vz);
+        __m512 d = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)),
+                                 _mm512_mul_ps(dz, dz));
+        _mm512_storeu_ps(out + j, d);
+    }
+    scalar_squared_distances(x + j, y + j, z + j, n - j, px, py, pz, out + j);
+}
+
+SMR_TARGET_AVX512 static void avx512_distances(const float* x, const float* y, const float* z, size_t n,
+                                               float px, float py, float pz, float* out) {
+    avx512_squared_distances(x, y, z, n, px, py, pz, out);
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) _mm512_storeu_ps(out + j, _mm512_sqrt_ps(_mm512_loadu_ps(out + j)));
+    for (; j < n; ++j) out[j] = std::sqrt(out[j]);
+}
+
+SMR_TARGET_AVX512 static void avx512_covariance(const float* x, const float* y, const float* z, size_t n,
+                                                float centroid[3], float cov[6]) {
+    size_t j = 0;
+    __m512 ax = _mm512_setzero_ps(), ay = _mm512_setzero_ps(), az = _mm512_setzero_ps();
+    for (; j + 16 <= n; j += 16) {
+        ax = _mm512_add_ps(ax, _mm512_loadu_ps(x + j));
+        ay = _mm512_add_ps(ay, _mm512_loadu_ps(y + j));
+        az = _mm512_add_ps(az, _mm512_loadu_ps(z + j));
+    }
+    float s[3] = {_mm512_reduce_add_ps(ax), _mm512_reduce_add_ps(ay), _mm512_reduce_add_ps(az)};
+    add_sums(x, y, z, j, n, s);
+    finish_centroid(s, n, centroid);
+
+    const __m512 vx = _mm512_set1_ps(centroid[0]), vy = _mm512_set1_ps(centroid[1]),
+                 vz = _mm512_set1_ps(centroid[2]);
+    __m512 sxx = _mm512_setzero_ps(), sxy = _mm512_setzero_ps(), sxz = _mm512_setzero_ps();
+    __m512 syy = _mm512_setzero_ps(), syz = _mm512_setzero_ps(), szz = _mm512_setzero_ps();
+    for (j = 0; j + 16 <= n; j += 16) {
+        __m512 dx = _mm512_sub_ps(_mm512_loadu_ps(x + j), vx);
+        __m512 dy = _mm512_sub_ps(_mm512_loadu_ps(y + j), vy);
+        __m512 dz = _mm512_sub_ps(_mm512_loadu_ps(z + j), vz);
+        sxx = _mm512_add_ps(sxx, _mm512_mul_ps(dx, dx));
+        sxy = _mm512_add_ps(sxy, _mm512_mul_ps(dx, dy));
+        sxz = _mm512_add_ps(sxz, _mm512_mul_ps(dx, dz));
+        syy = _mm512_add_ps(syy, _mm512_mul_ps(dy, dy));
+        syz = _mm512_add_ps(syz, _mm512_mul_ps(dy, dz));
+        szz = _mm512_add_ps(szz, _mm512_mul_ps(dz, dz));
+    }
+    cov[0] = _mm512_reduce_add_ps(sxx); cov[1] = _mm512_reduce_add_ps(sxy); cov[2] = _mm512_reduce_add_ps(sxz);
+    cov[3] = _mm512_reduce_add_ps(syy); cov[4] = _mm512_reduce_add_ps(syz); cov[5] = _mm512_reduce_add_ps(szz);
+    add_scatter(x, y, z, j, n, centroid, cov);
+}
+
+SMR_TARGET_AVX512 static void avx512_voxel_keys(const float* x, const float* y, const float* z, size_t n,
+                                                float voxel_size, int* kx, int* ky, int* kz) {
+    const __m512 size = _mm512_set1_ps(voxel_size);
+    const int down = _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC;
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m512 fx = _mm512_roundscale_ps(_mm512_div_ps(_mm512_loadu_ps(x + j), size), down);
+        __m512 fy = _mm512_roundscale_ps(_mm512_div_ps(_mm512_loadu_ps(y + j), size), down);
+        __m512 fz = _mm512_roundscale_ps(_mm512_div_ps(_mm512_loadu_ps(z + j), size), down);
+        _mm512_storeu_si512(kx + j, _mm512_cvttps_epi32(fx));
+        _mm512_storeu_si512(ky + j, _mm512_cvttps_epi32(fy));
+        _mm512_storeu_si512(kz + j, _mm512_cvttps_epi32(fz));
+    }
+    scalar_voxel_keys(x + j, y + j, z + j, n - j, voxel_size, kx + j, ky + j, kz + j);
+}
+
+SMR_TARGET_AVX512 static inline __m512i cube_bit_avx512(__m512i index, const float* v, __m512 iso, int bit) {
+    __mmask16 below = _mm512_cmp_ps_mask(_mm512_loadu_ps(v), iso, _CMP_LT_OQ);
+    return _mm512_mask_or_epi32(index, below, index, _mm512_set1_epi32(bit));
+}
+
+SMR_TARGET_AVX512 static void avx512_cube_indices(const float* r00, const float* r01, const float* r10,
+                                                  const float* r11, size_t n, float iso, uint8_t* out) {
+    const __m512 viso = _mm512_set1_ps(iso);
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m512i index = _mm512_setzero_si512();
+        index = cube_bit_avx512(index, r00 + j, viso, 1);
+        index = cube_bit_avx512(index, r00 + j + 1, viso, 2);
+        index = cube_bit_avx512(index, r01 + j + 1, viso, 4);
+        index = cube_bit_avx512(index, r01 + j, viso, 8);
+        index = cube_bit_avx512(index, r10 + j, viso, 16);
+        index = cube_bit_avx512(index, r10 + j + 1, viso, 32);
+        index = cube_bit_avx512(index, r11 + j + 1, viso, 64);
+        index = cube_bit_avx512(index, r11 + j, viso, 128);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j), _mm512_cvtepi32_epi8(index));
+    }
+    scalar_cube_indices(r00 + j, r01 + j, r10 + j, r11 + j, n - j, iso, out + j);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif // SMR_KERNELS_X86
+
+// =============================================================================
+// NEON
+// =============================================================================
+
+#if defined(SMR_KERNELS_NEON)
+static void neon_squared_distances(const float* x, const float* y, const float* z, size_t n,
+                                   float px, float py, float pz, float* out) {
+    const float32x4_t vx = vdupq_n_f32(px), vy = vdupq_n_f32(py), vz = vdupq_n_f32(pz);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        float32x4_t dx = vsubq_f32(vld1q_f32(x + j), vx);
+        float32x4_t dy = vsubq_f32(vld1q_f32(y + j), vy);
+        float32x4_t dz = vsubq_f32(vld1q_f32(z + j), vz);
+        float32x4_t d = vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(dz, dz));
+        vst1q_f32(out + j, d);
+    }
+    scalar_squared_distances(x + j, y + j, z + j, n - j, px, py, pz, out + j);
+}
+
+static void neon_distances(const float* x, const float* y, const float* z, size_t n,
+                           float px, float py, float pz, float* out) {
+    neon_squared_distances(x, y, z, n, px, py, pz, out);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) vst1q_f32(out + j, vsqrtq_f32(vld1q_f32(out + j)));
+    for (; j < n; ++j) out[j] = std::sqrt(out[j]);
+}
+
+static void neon_covariance(const float* x, const float* y, const float* z, size_t n,
+                            float centroid[3], float cov[6]) {
+    size_t j = 0;
+    float32x4_t ax = vdupq_n_f32(0), ay = vdupq_n_f32(0), az = vdupq_n_f32(0);
+    for (; j + 4 <= n; j += 4) {
+        ax = vaddq_f32(ax, vld1q_f32(x + j));
+        ay = vaddq_f32(ay, vld1q_f32(y + j));
+        az = vaddq_f32(az, vld1q_f32(z + j));
+    }
+    float s[3] = {vaddvq_f32(ax), vaddvq_f32(ay), vaddvq_f32(az)};
+    add_sums(x, y, z, j, n, s);
+    finish_centroid(s, n, centroid);
+
+    const float32x4_t vx = vdupq_n_f32(centroid[0]), vy = vdupq_n_f32(centroid[1]),
+                      vz = vdupq_n_f32(centroid[2]);
+    float32x4_t sxx = vdupq_n_f32(0), sxy = vdupq_n_f32(0), sxz = vdupq_n_f32(0);
+    float32x4_t syy = vdupq_n_f32(0), syz = vdupq_n_f32(0), szz = vdupq_n_f32(0);
+    for (j = 0; j + 4 <= n; j += 4) {
+        float32x4_t dx = vsubq_f32(vld1q_f32(x + j), vx);
+        float32x4_t dy = vsubq_f32(vld1q_f32(y + j), vy);
+        float32x4_t dz = vsubq_f32(vld1q_f32(z + j), vz);
+        sxx = vaddq_f32(sxx, vmulq_f32(dx, dx));
+        sxy = vaddq_f32(sxy, vmulq_f32(dx, dy));
+        sxz = vaddq_f32(sxz, vmulq_f32(dx, dz));
+        syy = vaddq_f32(syy, vmulq_f32(dy, dy));
+        syz = vaddq_f32(syz, vmulq_f32(dy, dz));
+        szz = vaddq_f32(szz, vmulq_f32(dz, dz));
+    }
+    cov[0] = vaddvq_f32(sxx); cov[1] = vaddvq_f32(sxy); cov[2] = vaddvq_f32(sxz);
+    cov[3] = vaddvq_f32(syy); cov[4] = vaddvq_f32(syz); cov[5] = vaddvq_f32(szz);
+    add_scatter(x, y, z, j, n, centroid, cov);
+}
+
+static void neon_voxel_keys(const float* x, const float* y, const float* z, size_t n,
+                            float voxel_size, int* kx, int* ky, int* kz) {
+    const float32x4_t size = vdupq_n_f32(voxel_size);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        vst1q_s32(kx + j, vcvtq_s32_f32(vrndmq_f32(vdivq_f32(vld1q_f32(x + j), size))));
+        vst1q_s32(ky + j, vcvtq_s32_f32(vrndmq_f32(vdivq_f32(vld1q_f32(y + j), size))));
+        vst1q_s32(kz + j, vcvtq_s32_f32(vrndmq_f32(vdivq_f32(vld1q_f32(z + j), size))));
+    }
+    scalar_voxel_keys(x + j, y + j, z + j, n - j, voxel_size, kx + j, ky + j, kz + j);
+}
+
+static inline uint32x4_t cube_bit_neon(uint32x4_t index, const float* v, float32x4_t iso, uint32_t bit) {
+    return vorrq_u32(index, vandq_u32(vcltq_f32(vld1q_f32(v), iso), vdupq_n_u32(bit)));
+}
+
+static void neon_cube_indices(const float* r00, const float* r01, const float* r10, const float* r11,
+                              size_t n, float iso, uint8_t* out) {
+    const float32x4_t viso = vdupq_n_f32(iso);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        uint32x4_t index = vdupq_n_u32(0);
+        index = cube_bit_neon(index, r00 + j, viso, 1);
+        index = cube_bit_neon(index, r00 + j + 1, viso, 2);
+        index = cube_bit_neon(index, r01 + j + 1, viso, 4);
+        index = cube_bit_neon(index, r01 + j, viso, 8);
+        index = cube_bit_neon(index, r10 + j, viso, 16);
+        index = cube_bit_neon(index, r10 + j + 1, viso, 32);
+        index = cube_bit_neon(index, r11 + j + 1, viso, 64);
+        index = cube_bit_neon(index, r11 + j, viso, 128);
+        uint16x4_t half = vmovn_u32(index);
+        uint8x8_t bytes = vmovn_u16(vcombine_u16(half, half));
+        uint32_t four = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+        std::memcpy(out + j, &four, 4);
+    }
+    scalar_cube_indices(r00 + j, r01 + j, r10 + j, r11 + j, n - j, iso, out + j);
+}
+#endif // SMR_KERNELS_NEON
+
+// =============================================================================
+// Dispatch
+// =============================================================================
+
+struct KernelTable {
+    SimdLevel level;
+    void (*squared_distances)(const float*, const float*, const float*, size_t,
+                              float, float, float, float*);
+    void (*distances)(const float*, const float*, const float*, size_t,
+                      float, float, float, float*);
+    void (*covariance)(const float*, const float*, const float*, size_t, float*, float*);
+    void (*voxel_keys)(const float*, const float*, const float*, size_t, float, int*, int*, int*);
+    void (*cube_indices)(const float*, const float*, const float*, const float*,
+                         size_t, float, uint8_t*);
+};
+
+static const KernelTable SCALAR_KERNELS = {
+    SIMD_SCALAR, scalar_squared_distances, scalar_distances, scalar_covariance,
+    scalar_voxel_keys, scalar_cube_indices
+};
+
+#if defined(SMR_KERNELS_X86)
+static const KernelTable AVX2_KERNELS = {
+    SIMD_AVX2, avx2_squared_distances, avx2_distances, avx2_covariance,
+    avx2_voxel_keys, avx2_cube_indices
+};
+
+static const KernelTable AVX512_KERNELS = {
+    SIMD_AVX512, avx512_squared_distances, avx512_distances, avx512_covariance,
+    avx512_voxel_keys, avx512_cube_indices
+};
+#endif
+
+#if defined(SMR_KERNELS_NEON)
+static const KernelTable NEON_KERNELS = {
+    SIMD_NEON, neon_squared_distances, neon_distances, neon_covariance,
+    neon_voxel_keys, neon_cube_indices
+};
+#endif
+
+static const KernelTable& select_kernels(SimdLevel level) {
+#if defined(SMR_KERNELS_X86)
+    if (level == SIMD_AVX512) return AVX512_KERNELS;
+    if (level == SIMD_AVX2) return AVX2_KERNELS;
+#elif defined(SMR_KERNELS_NEON)
+    if (level == SIMD_NEON) return NEON_KERNELS;
+#endif
+    (void)level;
+    return SCALAR_KERNELS;
+}
+
+static const KernelTable& kernels() {
+    static const KernelTable& table = select_kernels(cpu_simd_level());
+    return table;
+}
+
+void squared_distances(const float* x, const float* y, const float* z, size_t n,
+                       float px, float py, float pz, float* out) {
+    kernels().squared_distances(x, y, z, n, px, py, pz, out);
+}
+
+void distances(const float* x, const float* y, const float* z, size_t n,
+               float px, float py, float pz, float* out) {
+    kernels().distances(x, y, z, n, px, py, pz, out);
+}
+
+void covariance(const float* x, const float* y, const float* z, size_t n,
+                float centroid[3], float cov[6]) {
+    if (n == 0) {
+        for (int c = 0; c < 3; ++c) centroid[c] = 0;
+        for (int c = 0; c < 6; ++c) cov[c] = 0;
+        return;
+    }
+    kernels().covariance(x, y, z, n, centroid, cov);
+}
+
+void voxel_keys(const float* x, const float* y, const float* z, size_t n,
+                float voxel_size, int* kx, int* ky, int* kz) {
+    kernels().voxel_keys(x, y, z, n, voxel_size, kx, ky, kz);
+}
+
+void cube_indices(const float* r00, const float* r01, const float* r10, const float* r11,
+                  size_t n, float iso, uint8_t* out) {
+    kernels().cube_indices(r00, r01, r10, r11, n, iso, out);
+}
+
+SimdLevel point_kernels_level() {
+    return kernels().level;
+}
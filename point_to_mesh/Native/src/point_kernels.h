@@ -0,0 +1,48 @@
+/**
+ * @file point_kernels.h
+ * @brief SIMD kernels over structure-of-arrays points and grids
+ *
+ * Each kernel has a scalar, AVX2, AVX-512 and NEON body; the first call
+ * picks the widest one the CPU supports (see cpu_features.h), so one binary
+ * built with generic flags runs the vector code where it exists.
+ */
+
+#ifndef SMR_POINT_KERNELS_H
+#define SMR_POINT_KERNELS_H
+
+#include "cpu_features.h"
+#include <cstddef>
+#include <cstdint>
+
+/// out[j] = squared distance from (px, py, pz) to point j, for j < n
+void squared_distances(const float* x, const float* y, const float* z, size_t n,
+                       float px, float py, float pz, float* out);
+
+/// out[j] = distance from (px, py, pz) to point j, for j < n
+void distances(const float* x, const float* y, const float* z, size_t n,
+               float px, float py, float pz, float* out);
+
+/**
+ * Centroid of n points and their scatter about it (unnormalized
+ * covariance) as xx, xy, xz, yy, yz, zz.
+ */
+void covariance(const float* x, const float* y, const float* z, size_t n,
+                float centroid[3], float cov[6]);
+
+/// Voxel coordinates floor(p / voxel_size) of n points, per axis
+void voxel_keys(const float* x, const float* y, const float* z, size_t n,
+                float voxel_size, int* kx, int* ky, int* kz);
+
+/**
+ * Marching cubes case (bit k set when corner k is below `iso`) of the n
+ * cells x = 0..n-1 between four grid rows: `r00` at (y, z), `r01` at
+ * (y + 1, z), `r10` at (y, z + 1) and `r11` at (y + 1, z + 1). Each row
+ * must hold n + 1 samples.
+ */
+void cube_indices(const float* r00, const float* r01, const float* r10, const float* r11,
+                  size_t n, float iso, uint8_t* out);
+
+/// Instruction set the kernels dispatched to
+SimdLevel point_kernels_level();
+
+#endif // SMR_POINT_KERNELS_H
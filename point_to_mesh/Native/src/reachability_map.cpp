@@ -0,0 +1,406 @@
+/**
+ * @file reachability_map.cpp
+ * @brief Workspace Reachability Map Implementation
+ */
+
+#include "reachability_map.h"
+#include "parallel.h"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+
+static const char REACH_MAGIC[4] = {'S', 'M', 'R', 'M'};
+static const uint32_t REACH_VERSION = 1;
+static const int MAX_ORIENTATION_SAMPLES = 255;  // Counts are stored in one byte
+static const int32_t MAX_MAP_DIM = 1 << 16;      // Per axis (built or loaded); keeps the voxel count within 48 bits
+
+// Iteration cap for cold starts. Most candidates the row warm start misses are
+// unreachable, and a reachable one converges from some multi-start guess well
+// within this, so the cap mostly bounds the cost of rejecting the rest.
+static const int SEARCH_ITERATIONS = 40;
+
+// =============================================================================
+// Map Storage and Lookup
+// =============================================================================
+
+ReachabilityMap::ReachabilityMap()
+    : voxel_size(0), orientation_samples(0), manip_scale(0) {
+    dims[0] = dims[1] = dims[2] = 0;
+    origin[0] = origin[1] = origin[2] = 0;
+}
+
+bool ReachabilityMap::lookup(const float* position, float& out_ratio,
+                             float& out_manipulability) const {
+    out_ratio = 0.0f;
+    out_manipulability = 0.0f;
+    if (reach.empty()) return false;
+
+    int idx[3];
+    for (int k = 0; k < 3; ++k) {
+        float f = (position[k] - origin[k]) / voxel_size;
+        if (!(f >= 0.0f) || f >= static_cast<float>(dims[k])) return false;
+        idx[k] = static_cast<int>(f);
+    }
+
+    size_t v = (static_cast<size_t>(idx[2]) * dims[1] + idx[1]) * dims[0] + idx[0];
+    out_ratio = static_cast<float>(reach[v]) / orientation_samples;
+    out_manipulability = manip_scale * manip[v] / 255.0f;
+    return true;
+}
+
+bool ReachabilityMap::save(const char* filepath, const RobotImpl& robot) const {
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    int32_t header[4] = {dims[0], dims[1], dims[2], orientation_samples};
+    file.write(REACH_MAGIC, sizeof(REACH_MAGIC));
+    file.write(reinterpret_cast<const char*>(&REACH_VERSION), sizeof(REACH_VERSION));
+    file.write(reinterpret_cast<const char*>(robot.dh), sizeof(robot.dh));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(origin), sizeof(origin));
+    file.write(reinterpret_cast<const char*>(&voxel_size), sizeof(voxel_size));
+    file.write(reinterpret_cast<const char*>(&manip_scale), sizeof(manip_scale));
+    file.write(reinterpret_cast<const char*>(reach.data()), reach.size());
+    file.write(reinterpret_cast<const char*>(manip.data()), manip.size());
+    return file.good();
+}
+
+SMRErrorCode ReachabilityMap::load(const char* filepath, const RobotImpl& robot) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) return SMR_ERROR_FILE_NOT_FOUND;
+
+    char magic[4];
+    uint32_t version = 0;
+    DHParams dh[6];
+    int32_t header[4];
+    float file_origin[3], file_voxel, file_scale;
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(dh), sizeof(dh));
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(file_origin), sizeof(file_origin));
+    file.read(reinterpret_cast<char*>(&file_voxel), sizeof(file_voxel));
+    file.read(reinterpret_cast<char*>(&file_scale), sizeof(file_scale));
+    if (!file || std::memcmp(magic, REACH_MAGIC, sizeof(magic)) != 0 ||
+        version != REACH_VERSION) {
+        return SMR_ERROR_FILE_FORMAT;
+    }
+    if (header[0] <= 0 || header[1] <= 0 || header[2] <= 0 ||
+        header[0] > MAX_MAP_DIM || header[1] > MAX_MAP_DIM || header[2] > MAX_MAP_DIM ||
+        header[3] <= 0 || header[3] > MAX_ORIENTATION_SAMPLES || !(file_voxel > 0)) {
+        return SMR_ERROR_FILE_FORMAT;
+    }
+
+    // Both voxel arrays must be present before anything is allocated for them
+    uint64_t n = static_cast<uint64_t>(header[0]) * header[1] * header[2];
+    std::streampos data_start = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streampos data_end = file.tellg();
+    file.seekg(data_start);
+    if (!file || data_end < data_start ||
+        static_cast<uint64_t>(data_end - data_start) / 2 < n) {
+        return SMR_ERROR_FILE_FORMAT;
+    }
+
+    // A map is only meaningful for the kinematics it was built with
+    for (int i = 0; i < 6; ++i) {
+        if (std::abs(dh[i].a - robot.dh[i].a) > 1e-9 ||
+            std::abs(dh[i].alpha - robot.dh[i].alpha) > 1e-9 ||
+            std::abs(dh[i].d - robot.dh[i].d) > 1e-9 ||
+            std::abs(dh[i].theta_offset - robot.dh[i].theta_offset) > 1e-9) {
+            return SMR_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    TrackedVector<uint8_t> file_reach(static_cast<size_t>(n)), file_manip(static_cast<size_t>(n));
+    file.read(reinterpret_cast<char*>(file_reach.data()), static_cast<std::streamsize>(n));
+    file.read(reinterpret_cast<char*>(file_manip.data()), static_cast<std::streamsize>(n));
+    if (!file) return SMR_ERROR_FILE_FORMAT;
+
+    for (int k = 0; k < 3; ++k) {
+        dims[k] = header[k];
+        origin[k] = file_origin[k];
+    }
+    orientation_samples = header[3];
+    voxel_size = file_voxel;
+    manip_scale = file_scale;
+    reach = std::move(file_reach);
+    manip = std::move(file_manip);
+    return SMR_SUCCESS;
+}
+
+// =============================================================================
+// Map Generation
+// =============================================================================
+
+// Distance from the shoulder (frame 1 axis at height d1) that the origin of
+// frame `last` cannot exceed: the summed offsets between consecutive origins
+static double shoulder_reach(const RobotImpl& robot, int last = 6) {
+    double r = std::abs(robot.dh[0].a);
+    for (int i = 1; i < last; ++i) {
+        r += std::sqrt(robot.dh[i].a * robot.dh[i].a + robot.dh[i].d * robot.dh[i].d);
+    }
+    return r;
+}
+
+ReachabilitySettings reachability_resolve_settings(const ReachabilitySettings* settings,
+                                                   const RobotImpl& robot) {
+    ReachabilitySettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.voxel_size <= 0) s.voxel_size = 0.05f;
+    if (s.orientation_samples <= 0) s.orientation_samples = 26;
+    s.orientation_samples = std::min(s.orientation_samples, MAX_ORIENTATION_SAMPLES);
+    if (s.num_threads <= 0) s.num_threads = parallel_default_threads();
+
+    bool has_bounds = false;
+    for (int k = 0; k < 3; ++k) has_bounds = has_bounds || s.bounds_max[k] > s.bounds_min[k];
+    if (!has_bounds) {
+        float r = static_cast<float>(shoulder_reach(robot));
+        float z0 = static_cast<float>(robot.dh[0].d);
+        s.bounds_min[0] = -r; s.bounds_min[1] = -r; s.bounds_min[2] = z0 - r;
+        s.bounds_max[0] = r;  s.bounds_max[1] = r;  s.bounds_max[2] = z0 + r;
+    }
+    return s;
+}
+
+// Tool Z directions spread evenly over the sphere (Fibonacci lattice), each
+// completed to a rotation; spin about the tool axis is left to the last joint
+static void sample_tool_rotations(int count, std::vector<Matrix4x4>& out) {
+    out.resize(count);
+    const double golden = M_PI * (3.0 - std::sqrt(5.0));
+    for (int i = 0; i < count; ++i) {
+        double z_coord = 1.0 - 2.0 * (i + 0.5) / count;
+        double radius = std::sqrt(std::max(0.0, 1.0 - z_coord * z_coord));
+        double phi = golden * i;
+        double z[3] = {radius * std::cos(phi), radius * std::sin(phi), z_coord};
+
+        // X = normalize(helper x Z), Y = Z x X
+        double helper[3] = {0.0, 0.0, 0.0};
+        helper[std::abs(z[0]) < 0.9 ? 0 : 1] = 1.0;
+        double x[3] = {
+            helper[1]*z[2] - helper[2]*z[1],
+            helper[2]*z[0] - helper[0]*z[2],
+            helper[0]*z[1] - helper[1]*z[0]
+        };
+        double x_len = std::sqrt(x[0]*x[0] + x[1]*x[1] + x[2]*x[2]);
+        x[0] /= x_len; x[1] /= x_len; x[2] /= x_len;
+        double y[3] = {
+            z[1]*x[2] - z[2]*x[1],
+            z[2]*x[0] - z[0]*x[2],
+            z[0]*x[1] - z[1]*x[0]
+        };
+
+        double* m = out[i].m;
+        for (int r = 0; r < 3; ++r) {
+            m[r*4+0] = x[r];
+            m[r*4+1] = y[r];
+            m[r*4+2] = z[r];
+        }
+    }
+}
+
+bool reachability_grid_dims(const ReachabilitySettings& s, int* out_dims) {
+    for (int k = 0; k < 3; ++k) {
+        if (!(s.bounds_max[k] >= s.bounds_min[k])) return false;
+        // Checked as a float first: the cast is undefined past INT_MAX
+        float cells = std::ceil(std::max(s.bounds_max[k] - s.bounds_min[k], s.voxel_size) / s.voxel_size);
+        if (!(cells <= static_cast<float>(MAX_MAP_DIM))) return false;
+        out_dims[k] = std::max(1, static_cast<int>(cells));
+    }
+    return true;
+}
+
+void build_reachability_map(const RobotImpl& robot,
+                            const ReachabilitySettings& s,
+                            ReachabilityMap& out) {
+    const float voxel = s.voxel_size;
+    reachability_grid_dims(s, out.dims);
+    for (int k = 0; k < 3; ++k) out.origin[k] = s.bounds_min[k];
+    out.voxel_size = voxel;
+    out.orientation_samples = s.orientation_samples;
+
+    const int nx = out.dims[0];
+    const int num_dirs = s.orientation_samples;
+    const size_t n = out.voxel_count();
+    out.reach.assign(n, 0);
+    out.manip.assign(n, 0);
+    std::vector<float> best_manip(n, 0.0f);
+
+    std::vector<Matrix4x4> rotations;
+    sample_tool_rotations(num_dirs, rotations);
+
+    const double shoulder_z = robot.dh[0].d;
+    const double reach_limit = shoulder_reach(robot) + 0.5 * std::sqrt(3.0) * voxel;
+
+    // The last link is rigid in the flange frame: frame 5's origin sits at
+    // p - R * (a6, d6 sin(alpha6), d6 cos(alpha6)). Directions whose wrist
+    // center is out of the arm's reach are rejected without running IK.
+    const DHParams& last = robot.dh[5];
+    const double wrist_offset[3] = {last.a, last.d * std::sin(last.alpha), last.d * std::cos(last.alpha)};
+    const double wrist_limit = shoulder_reach(robot, 5) + 1e-6;
+    std::vector<double> wrist_shift(num_dirs * 3);
+    for (int d = 0; d < num_dirs; ++d) {
+        const double* m = rotations[d].m;
+        for (int r = 0; r < 3; ++r) {
+            wrist_shift[d * 3 + r] = m[r*4+0] * wrist_offset[0] + m[r*4+1] * wrist_offset[1] +
+                                     m[r*4+2] * wrist_offset[2];
+        }
+    }
+
+    // One task per X row, so warm starts follow the row
+    size_t num_rows = static_cast<size_t>(out.dims[1]) * out.dims[2];
+    parallel_for(0, num_rows, 1, [&](size_t lo, size_t hi) {
+        std::vector<double> prev_q(num_dirs * 6);
+        std::vector<char> prev_ok(num_dirs);
+
+        for (size_t row = lo; row < hi; ++row) {
+            int iy = static_cast<int>(row % out.dims[1]);
+            int iz = static_cast<int>(row / out.dims[1]);
+            std::fill(prev_ok.begin(), prev_ok.end(), 0);
+
+            for (int ix = 0; ix < nx; ++ix) {
+                double c[3] = {
+                    out.origin[0] + (ix + 0.5) * voxel,
+                    out.origin[1] + (iy + 0.5) * voxel,
+                    out.origin[2] + (iz + 0.5) * voxel
+                };
+                size_t v = row * nx + ix;
+
+                double dz = c[2] - shoulder_z;
+                if (c[0]*c[0] + c[1]*c[1] + dz*dz > reach_limit * reach_limit) {
+                    std::fill(prev_ok.begin(), prev_ok.end(), 0);
+                    continue;
+                }
+
+                int reachable = 0;
+                double best = 0.0;
+                const double* voxel_seed = nullptr;  // Last solution found in this voxel
+
+                for (int d = 0; d < num_dirs; ++d) {
+                    double wx = c[0] - wrist_shift[d * 3];
+                    double wy = c[1] - wrist_shift[d * 3 + 1];
+                    double wz = c[2] - wrist_shift[d * 3 + 2] - shoulder_z;
+                    if (wx*wx + wy*wy + wz*wz > wrist_limit * wrist_limit) {
+                        prev_ok[d] = 0;
+                        continue;
+                    }
+
+                    Matrix4x4 target = rotations[d];
+                    target.m[3] = c[0];
+                    target.m[7] = c[1];
+                    target.m[11] = c[2];
+
+                    double* q = &prev_q[d * 6];
+                    double sol[6];
+                    bool ok = false;
+                    if (prev_ok[d]) {
+                        ok = robot.inverse_kinematics_numerical(target, q, sol);
+                    }
+                    if (!ok && voxel_seed) {
+                        ok = robot.inverse_kinematics_numerical(target, voxel_seed, sol,
+                                                                SEARCH_ITERATIONS);
+                    }
+                    if (!ok) {
+                        double candidates[8 * 6];
+                        ok = robot.inverse_kinematics_all(target, candidates, SEARCH_ITERATIONS) > 0;
+                        if (ok) std::memcpy(sol, candidates, sizeof(sol));
+                    }
+
+                    prev_ok[d] = ok ? 1 : 0;
+                    if (!ok) continue;
+
+                    std::memcpy(q, sol, sizeof(sol));
+                    voxel_seed = q;
+                    ++reachable;
+                    best = std::max(best, robot.compute_manipulability(sol));
+                }
+
+                out.reach[v] = static_cast<uint8_t>(reachable);
+                best_manip[v] = static_cast<float>(best);
+            }
+        }
+    }, s.num_threads);
+
+    // Quantize manipulability against the map-wide maximum
+    float scale = 0.0f;
+    for (size_t v = 0; v < n; ++v) scale = std::max(scale, best_manip[v]);
+    out.manip_scale = scale;
+    if (scale > 0.0f) {
+        for (size_t v = 0; v < n; ++v) {
+            out.manip[v] = static_cast<uint8_t>(std::lround(255.0f * best_manip[v] / scale));
+        }
+    }
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+SMR_API SMRErrorCode smr_robot_build_reachability(RobotHandle handle,
+                                                   const ReachabilitySettings* settings) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+
+    auto* robot = static_cast<RobotImpl*>(handle);
+    ReachabilitySettings s = reachability_resolve_settings(settings, *robot);
+    int dims[3];
+    if (!reachability_grid_dims(s, dims)) return SMR_ERROR_INVALID_PARAMETER;
+
+    try {
+        auto map = std::make_shared<ReachabilityMap>();
+        build_reachability_map(*robot, s, *map);
+        robot->reachability = map;
+        return SMR_SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return SMR_ERROR_MEMORY_ALLOCATION;
+    }
+}
+
+SMR_API SMRErrorCode smr_robot_save_reachability(RobotHandle handle, const char* filepath) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!filepath) return SMR_ERROR_INVALID_PARAMETER;
+
+    auto* robot = static_cast<RobotImpl*>(handle);
+    if (!robot->reachability) return SMR_ERROR_COMPUTATION_FAILED;
+    return robot->reachability->save(filepath, *robot) ? SMR_SUCCESS : SMR_ERROR_FILE_NOT_FOUND;
+}
+
+SMR_API SMRErrorCode smr_robot_load_reachability(RobotHandle handle, const char* filepath) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!filepath) return SMR_ERROR_INVALID_PARAMETER;
+
+    auto* robot = static_cast<RobotImpl*>(handle);
+    try {
+        auto map = std::make_shared<ReachabilityMap>();
+        SMRErrorCode result = map->load(filepath, *robot);
+        if (result == SMR_SUCCESS) robot->reachability = map;
+        return result;
+    } catch (const std::bad_alloc&) {
+        return SMR_ERROR_MEMORY_ALLOCATION;
+    }
+}
+
+SMR_API SMRErrorCode smr_robot_query_reachability(RobotHandle handle,
+                                                   const float* positions,
+                                                   int count,
+                                                   float* out_reach_ratio,
+                                                   float* out_manipulability) {
+    if (!handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!positions || !out_reach_ratio || count < 0) return SMR_ERROR_INVALID_PARAMETER;
+
+    auto* robot = static_cast<RobotImpl*>(handle);
+    std::shared_ptr<const ReachabilityMap> map = robot->reachability;
+    if (!map) return SMR_ERROR_COMPUTATION_FAILED;
+
+    for (int i = 0; i < count; ++i) {
+        float manip;
+        map->lookup(positions + i * 3, out_reach_ratio[i], manip);
+        if (out_manipulability) out_manipulability[i] = manip;
+    }
+    return SMR_SUCCESS;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file reachability_map.h
+ * @brief Voxelized workspace reachability map for placement checks
+ */
+
+#ifndef SMR_REACHABILITY_MAP_H
+#define SMR_REACHABILITY_MAP_H
+
+#include "smr_welding_api.h"
+#include "memory_tracker.h"
+#include "robot_kinematics.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Regular voxel grid over target (flange) positions in the robot base frame.
+ * Each voxel stores how many of the sampled tool directions are reachable at
+ * its center and the best manipulability among them, both as one byte.
+ */
+class ReachabilityMap {
+public:
+    int dims[3];
+    float origin[3];             // Min corner of voxel (0,0,0)
+    float voxel_size;
+    int orientation_samples;     // Tool directions tried per voxel
+    float manip_scale;           // Manipulability of quantized value 255
+
+    TrackedVector<uint8_t> reach;  // Reachable direction count per voxel
+    TrackedVector<uint8_t> manip;  // Best manipulability, quantized to manip_scale
+
+    ReachabilityMap();
+
+    size_t voxel_count() const {
+        return static_cast<size_t>(dims[0]) * dims[1] * dims[2];
+    }
+
+    size_t memory_bytes() const { return vector_bytes(reach) + vector_bytes(manip); }
+
+    /**
+     * O(1) lookup. Positions outside the grid are unreachable.
+     * @param out_ratio Fraction of sampled tool directions reachable (0-1)
+     * @param out_manipulability Best manipulability at the voxel
+     * @return false if the position is outside the grid
+     */
+    bool lookup(const float* position, float& out_ratio, float& out_manipulability) const;
+
+    // Binary I/O; the robot's DH parameters are stored to reject foreign maps
+    bool save(const char* filepath, const RobotImpl& robot) const;
+    SMRErrorCode load(const char* filepath, const RobotImpl& robot);
+};
+
+/// Fill zero/unset fields of `settings` with defaults (bounds from the robot's reach)
+ReachabilitySettings reachability_resolve_settings(const ReachabilitySettings* settings,
+                                                   const RobotImpl& robot);
+
+/**
+ * Grid size for resolved settings. False if the bounds are inverted or an
+ * axis would exceed 65536 voxels (tiny voxel_size or huge bounds).
+ */
+bool reachability_grid_dims(const ReachabilitySettings& settings, int* out_dims);
+
+/**
+ * Build the map (settings must pass reachability_grid_dims). Voxel rows along
+ * X are solved in parallel; along a row each tool direction is warm-started
+ * from the previous voxel's solution, falling back to multi-start IK, so
+ * reachable regions cost a few iterations per voxel. The IK is the numerical
+ * solver: the kinematics layer has no closed-form solution for arbitrary DH
+ * chains, and warm starts along a row give most of the batching benefit.
+ * Voxels farther from the shoulder than the summed link lengths are skipped.
+ */
+void build_reachability_map(const RobotImpl& robot,
+                            const ReachabilitySettings& settings,
+                            ReachabilityMap& out);
+
+#endif // SMR_REACHABILITY_MAP_H
@@ -4,6 +4,9 @@
  */
 
 #include "smr_welding_api.h"
+#include "robot_kinematics.h"
+#include "reachability_map.h"
+#include "stats.h"
 #include <vector>
 #include <cmath>
 #include <algorithm>
@@ -93,228 +96,367 @@ static const JointLimits DOOSAN_M1013_LIMITS[6] = {
 // Matrix Operations
 // =============================================================================
 
-class Matrix4x4 {
-public:
-    double m[16]; // Row-major order
+void Matrix4x4::set_dh(double a, double alpha, double d, double theta) {
+    double ct = std::cos(theta);
+    double st = std::sin(theta);
+    double ca = std::cos(alpha);
+    double sa = std::sin(alpha);
     
-    Matrix4x4() { identity(); }
-    
-    void identity() {
-        std::memset(m, 0, sizeof(m));
-        m[0] = m[5] = m[10] = m[15] = 1.0;
+    m[0] = ct;       m[1] = -st*ca;   m[2] = st*sa;    m[3] = a*ct;
+    m[4] = st;       m[5] = ct*ca;    m[6] = -ct*sa;   m[7] = a*st;
+    m[8] = 0;        m[9] = sa;       m[10] = ca;      m[11] = d;
+    m[12] = 0;       m[13] = 0;       m[14] = 0;       m[15] = 1;
+}
+
+Matrix4x4 Matrix4x4::operator*(const Matrix4x4& other) const {
+    Matrix4x4 result;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result.m[i*4+j] = 0;
+            for (int k = 0; k < 4; ++k) {
+                result.m[i*4+j] += m[i*4+k] * other.m[k*4+j];
+            }
+        }
     }
-    
-    void set_dh(double a, double alpha, double d, double theta) {
-        double ct = std::cos(theta);
-        double st = std::sin(theta);
-        double ca = std::cos(alpha);
-        double sa = std::sin(alpha);
-        
-        m[0] = ct;       m[1] = -st*ca;   m[2] = st*sa;    m[3] = a*ct;
-        m[4] = st;       m[5] = ct*ca;    m[6] = -ct*sa;   m[7] = a*st;
-        m[8] = 0;        m[9] = sa;       m[10] = ca;      m[11] = d;
-        m[12] = 0;       m[13] = 0;       m[14] = 0;       m[15] = 1;
+    return result;
+}
+
+// out = a * b for affine transforms (bottom row 0 0 0 1); skips the constant row
+static void affine_multiply(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& out) {
+    for (int i = 0; i < 3; ++i) {
+        const double* r = a.m + i * 4;
+        for (int j = 0; j < 4; ++j) {
+            out.m[i*4+j] = r[0] * b.m[j] + r[1] * b.m[4+j] + r[2] * b.m[8+j];
+        }
+        out.m[i*4+3] += r[3];
     }
-    
-    Matrix4x4 operator*(const Matrix4x4& other) const {
-        Matrix4x4 result;
-        for (int i = 0; i < 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                result.m[i*4+j] = 0;
-                for (int k = 0; k < 4; ++k) {
-                    result.m[i*4+j] += m[i*4+k] * other.m[k*4+j];
-                }
-            }
+    out.m[12] = 0; out.m[13] = 0; out.m[14] = 0; out.m[15] = 1;
+}
+
+// In-place Cholesky factorization of a symmetric positive definite 6x6 matrix.
+// The lower triangle of A receives L. Returns false if A is not positive definite.
+static bool cholesky6(double* A) {
+    for (int j = 0; j < 6; ++j) {
+        double diag = A[j*6+j];
+        for (int k = 0; k < j; ++k) diag -= A[j*6+k] * A[j*6+k];
+        if (diag <= 0.0) return false;
+        diag = std::sqrt(diag);
+        A[j*6+j] = diag;
+        
+        for (int i = j + 1; i < 6; ++i) {
+            double sum = A[i*6+j];
+            for (int k = 0; k < j; ++k) sum -= A[i*6+k] * A[j*6+k];
+            A[i*6+j] = sum / diag;
         }
-        return result;
     }
-    
-    void get_position(double& x, double& y, double& z) const {
-        x = m[3]; y = m[7]; z = m[11];
+    return true;
+}
+
+// Solve L L^T x = b in place using the factor produced by cholesky6
+static void cholesky6_solve(const double* L, double* b) {
+    for (int i = 0; i < 6; ++i) {
+        double sum = b[i];
+        for (int k = 0; k < i; ++k) sum -= L[i*6+k] * b[k];
+        b[i] = sum / L[i*6+i];
+    }
+    for (int i = 5; i >= 0; --i) {
+        double sum = b[i];
+        for (int k = i + 1; k < 6; ++k) sum -= L[k*6+i] * b[k];
+        b[i] = sum / L[i*6+i];
     }
+}
+
+// J * J^T (+ damping on the diagonal)
+static void jacobian_outer(const double* J, double damping_sq, double* JJT) {
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            double sum = 0;
+            for (int k = 0; k < 6; ++k) sum += J[i*6+k] * J[j*6+k];
+            JJT[i*6+j] = sum;
+            JJT[j*6+i] = sum;
+        }
+        JJT[i*6+i] += damping_sq;
+    }
+}
+
+// Geometric Jacobian from the frame chain T[0..6]
+static void jacobian_from_frames(const Matrix4x4* T, double* J) {
+    double pe[3]; // End-effector position
+    T[6].get_position(pe[0], pe[1], pe[2]);
     
-    void get_rotation_axis(int col, double& x, double& y, double& z) const {
-        x = m[col]; y = m[4+col]; z = m[8+col];
+    for (int i = 0; i < 6; ++i) {
+        double pi[3]; // Joint i position
+        T[i].get_position(pi[0], pi[1], pi[2]);
+        
+        double zi[3]; // Joint i z-axis
+        T[i].get_rotation_axis(2, zi[0], zi[1], zi[2]);
+        
+        // Linear velocity component: z_i x (p_e - p_i)
+        double dp[3] = {pe[0]-pi[0], pe[1]-pi[1], pe[2]-pi[2]};
+        J[0*6+i] = zi[1]*dp[2] - zi[2]*dp[1];
+        J[1*6+i] = zi[2]*dp[0] - zi[0]*dp[2];
+        J[2*6+i] = zi[0]*dp[1] - zi[1]*dp[0];
+        
+        // Angular velocity component: z_i
+        J[3*6+i] = zi[0];
+        J[4*6+i] = zi[1];
+        J[5*6+i] = zi[2];
     }
-};
+}
 
 // =============================================================================
 // Robot Implementation
 // =============================================================================
 
-class RobotImpl {
-public:
-    DHParams dh[6];
-    JointLimits limits[6];
-    RobotType type;
+RobotImpl::RobotImpl(RobotType t) : type(t) {
+    const DHParams* preset_dh = nullptr;
+    const JointLimits* preset_limits = nullptr;
     
-    RobotImpl(RobotType t) : type(t) {
-        const DHParams* preset_dh = nullptr;
-        const JointLimits* preset_limits = nullptr;
-        
-        switch (t) {
-            case ROBOT_UR5:
-                preset_dh = UR5_DH;
-                preset_limits = UR5_LIMITS;
-                break;
-            case ROBOT_UR10:
-                preset_dh = UR10_DH;
-                preset_limits = UR10_LIMITS;
-                break;
-            case ROBOT_KUKA_KR6_R700:
-                preset_dh = KUKA_KR6_DH;
-                preset_limits = KUKA_KR6_LIMITS;
-                break;
-            case ROBOT_DOOSAN_M1013:
-                preset_dh = DOOSAN_M1013_DH;
-                preset_limits = DOOSAN_M1013_LIMITS;
-                break;
-            default:
-                // Use UR5 as default
-                preset_dh = UR5_DH;
-                preset_limits = UR5_LIMITS;
-                break;
-        }
-        
-        std::memcpy(dh, preset_dh, sizeof(dh));
-        std::memcpy(limits, preset_limits, sizeof(limits));
+    switch (t) {
+        case ROBOT_UR5:
+            preset_dh = UR5_DH;
+            preset_limits = UR5_LIMITS;
+            break;
+        case ROBOT_UR10:
+            preset_dh = UR10_DH;
+            preset_limits = UR10_LIMITS;
+            break;
+        case ROBOT_KUKA_KR6_R700:
+            preset_dh = KUKA_KR6_DH;
+            preset_limits = KUKA_KR6_LIMITS;
+            break;
+        case ROBOT_DOOSAN_M1013:
+            preset_dh = DOOSAN_M1013_DH;
+            preset_limits = DOOSAN_M1013_LIMITS;
+            break;
+        default:
+            // Use UR5 as default
+            preset_dh = UR5_DH;
+            preset_limits = UR5_LIMITS;
+            break;
     }
     
-    RobotImpl(const DHParams* custom_dh, const JointLimits* custom_limits) 
-        : type(ROBOT_CUSTOM) {
-        std::memcpy(dh, custom_dh, sizeof(dh));
-        std::memcpy(limits, custom_limits, sizeof(limits));
+    std::memcpy(dh, preset_dh, sizeof(dh));
+    std::memcpy(limits, preset_limits, sizeof(limits));
+}
+
+RobotImpl::RobotImpl(const DHParams* custom_dh, const JointLimits* custom_limits) 
+    : type(ROBOT_CUSTOM) {
+    std::memcpy(dh, custom_dh, sizeof(dh));
+    std::memcpy(limits, custom_limits, sizeof(limits));
+}
+
+void RobotImpl::forward_kinematics(const double* joints, Matrix4x4& result) const {
+    result.identity();
+    
+    for (int i = 0; i < 6; ++i) {
+        Matrix4x4 Ti;
+        double theta = joints[i] + dh[i].theta_offset;
+        Ti.set_dh(dh[i].a, dh[i].alpha, dh[i].d, theta);
+        result = result * Ti;
     }
+}
+
+void RobotImpl::forward_kinematics_chain(const double* joints, Matrix4x4* frames) const {
+    frames[0].identity();
     
-    void forward_kinematics(const double* joints, Matrix4x4& result) const {
-        result.identity();
-        
-        for (int i = 0; i < 6; ++i) {
-            Matrix4x4 Ti;
-            double theta = joints[i] + dh[i].theta_offset;
-            Ti.set_dh(dh[i].a, dh[i].alpha, dh[i].d, theta);
-            result = result * Ti;
-        }
+    for (int i = 0; i < 6; ++i) {
+        Matrix4x4 Ti;
+        double theta = joints[i] + dh[i].theta_offset;
+        Ti.set_dh(dh[i].a, dh[i].alpha, dh[i].d, theta);
+        affine_multiply(frames[i], Ti, frames[i+1]);
     }
+}
+
+bool RobotImpl::inverse_kinematics_numerical(const Matrix4x4& target, 
+                                             const double* initial_guess,
+                                             double* solution,
+                                             int max_iterations,
+                                             double tolerance) const {
+    SMR_STAT_SCOPE(STAT_IK_SOLVE);
+    const double damping_sq = 1e-4;   // lambda^2 for damped least squares
+    const double max_step = 0.5;      // Max joint update per iteration (rad)
+    
+    std::memcpy(solution, initial_guess, 6 * sizeof(double));
     
-    // Numerical IK using Jacobian pseudo-inverse
-    bool inverse_kinematics_numerical(const Matrix4x4& target, 
-                                       const double* initial_guess,
-                                       double* solution,
-                                       int max_iterations = 100,
-                                       double tolerance = 1e-6) const {
-        std::memcpy(solution, initial_guess, 6 * sizeof(double));
+    for (int iter = 0; iter < max_iterations; ++iter) {
+        Matrix4x4 T[7];
+        forward_kinematics_chain(solution, T);
+        const Matrix4x4& current = T[6];
         
-        for (int iter = 0; iter < max_iterations; ++iter) {
-            Matrix4x4 current;
-            forward_kinematics(solution, current);
-            
-            // Compute position error
-            double dx = target.m[3] - current.m[3];
-            double dy = target.m[7] - current.m[7];
-            double dz = target.m[11] - current.m[11];
-            
-            // Compute orientation error (simplified: using rotation matrix difference)
-            double ex = target.m[0] - current.m[0] + target.m[5] - current.m[5];
-            double ey = target.m[1] - current.m[1] + target.m[6] - current.m[6];
-            double ez = target.m[2] - current.m[2] + target.m[9] - current.m[9];
-            
-            double error[6] = {dx, dy, dz, ex*0.1, ey*0.1, ez*0.1};
-            
-            // Check convergence
-            double error_norm = 0;
-            for (int i = 0; i < 6; ++i) error_norm += error[i] * error[i];
-            if (error_norm < tolerance * tolerance) return true;
-            
-            // Compute Jacobian
-            double J[36];
-            compute_jacobian(solution, J);
-            
-            // Pseudo-inverse update (simplified)
-            double damping = 0.01;
-            for (int i = 0; i < 6; ++i) {
-                double delta = 0;
-                for (int j = 0; j < 6; ++j) {
-                    delta += J[j*6+i] * error[j];
-                }
-                solution[i] += delta * damping;
-                
-                // Clamp to joint limits
-                solution[i] = std::max(limits[i].min_angle, 
-                              std::min(limits[i].max_angle, solution[i]));
-            }
+        // Position error
+        double error[6];
+        error[0] = target.m[3] - current.m[3];
+        error[1] = target.m[7] - current.m[7];
+        error[2] = target.m[11] - current.m[11];
+        
+        // Orientation error: 0.5 * sum(current_axis x target_axis)
+        error[3] = error[4] = error[5] = 0.0;
+        for (int c = 0; c < 3; ++c) {
+            double ax = current.m[c], ay = current.m[4+c], az = current.m[8+c];
+            double bx = target.m[c], by = target.m[4+c], bz = target.m[8+c];
+            error[3] += 0.5 * (ay*bz - az*by);
+            error[4] += 0.5 * (az*bx - ax*bz);
+            error[5] += 0.5 * (ax*by - ay*bx);
         }
         
-        return false;
-    }
-    
-    void compute_jacobian(const double* joints, double* J) const {
-        // Compute geometric Jacobian
-        Matrix4x4 T[7];
-        T[0].identity();
+        // Check convergence
+        double error_norm = 0;
+        for (int i = 0; i < 6; ++i) error_norm += error[i] * error[i];
+        if (error_norm < tolerance * tolerance) {
+            SMR_STAT_ADD(STAT_IK_ITERATIONS, iter + 1);
+            return true;
+        }
         
-        for (int i = 0; i < 6; ++i) {
-            Matrix4x4 Ti;
-            double theta = joints[i] + dh[i].theta_offset;
-            Ti.set_dh(dh[i].a, dh[i].alpha, dh[i].d, theta);
-            T[i+1] = T[i] * Ti;
+        // dq = J^T (J J^T + lambda^2 I)^-1 e
+        double J[36];
+        jacobian_from_frames(T, J);
+        
+        double A[36];
+        jacobian_outer(J, damping_sq, A);
+        if (!cholesky6(A)) {
+            SMR_STAT_ADD(STAT_IK_ITERATIONS, iter + 1);
+            SMR_STAT_ADD(STAT_IK_FAILURES, 1);
+            return false;
         }
+        cholesky6_solve(A, error);
         
-        double pe[3]; // End-effector position
-        T[6].get_position(pe[0], pe[1], pe[2]);
+        double dq[6];
+        double step = 0;
+        for (int i = 0; i < 6; ++i) {
+            dq[i] = 0;
+            for (int j = 0; j < 6; ++j) dq[i] += J[j*6+i] * error[j];
+            step = std::max(step, std::abs(dq[i]));
+        }
+        double scale = (step > max_step) ? max_step / step : 1.0;
         
         for (int i = 0; i < 6; ++i) {
-            double pi[3]; // Joint i position
-            T[i].get_position(pi[0], pi[1], pi[2]);
-            
-            double zi[3]; // Joint i z-axis
-            T[i].get_rotation_axis(2, zi[0], zi[1], zi[2]);
-            
-            // Linear velocity component: z_i x (p_e - p_i)
-            double dp[3] = {pe[0]-pi[0], pe[1]-pi[1], pe[2]-pi[2]};
-            J[0*6+i] = zi[1]*dp[2] - zi[2]*dp[1];
-            J[1*6+i] = zi[2]*dp[0] - zi[0]*dp[2];
-            J[2*6+i] = zi[0]*dp[1] - zi[1]*dp[0];
+            solution[i] += dq[i] * scale;
             
-            // Angular velocity component: z_i
-            J[3*6+i] = zi[0];
-            J[4*6+i] = zi[1];
-            J[5*6+i] = zi[2];
+            // Clamp to joint limits
+            solution[i] = std::max(limits[i].min_angle, 
+                          std::min(limits[i].max_angle, solution[i]));
         }
     }
     
-    double compute_manipulability(const double* joints) const {
-        double J[36];
-        compute_jacobian(joints, J);
-        
-        // Compute J * J^T
-        double JJT[36];
-        for (int i = 0; i < 6; ++i) {
-            for (int j = 0; j < 6; ++j) {
-                JJT[i*6+j] = 0;
+    SMR_STAT_ADD(STAT_IK_ITERATIONS, max_iterations);
+    SMR_STAT_ADD(STAT_IK_FAILURES, 1);
+    return false;
+}
+
+// Initial guesses for multi-start IK (cover shoulder/elbow/wrist branches)
+static const double IK_INITIAL_GUESSES[8][6] = {
+    {0, -M_PI/2, M_PI/2, 0, 0, 0},
+    {0, -M_PI/4, M_PI/4, 0, 0, 0},
+    {M_PI/2, -M_PI/2, M_PI/2, 0, 0, 0},
+    {-M_PI/2, -M_PI/2, M_PI/2, 0, 0, 0},
+    {0, -M_PI/2, M_PI/2, M_PI, 0, 0},
+    {0, -3*M_PI/4, 3*M_PI/4, 0, 0, 0},
+    {M_PI, -M_PI/2, M_PI/2, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0}
+};
+
+int RobotImpl::inverse_kinematics_all(const Matrix4x4& target, double* out_solutions,
+                                      int max_iterations) const {
+    int count = 0;
+    for (int i = 0; i < 8 && count < 8; ++i) {
+        double solution[6];
+        if (inverse_kinematics_numerical(target, IK_INITIAL_GUESSES[i], solution, max_iterations)) {
+            // Check if solution is unique
+            bool duplicate = false;
+            for (int j = 0; j < count; ++j) {
+                double diff = 0;
                 for (int k = 0; k < 6; ++k) {
-                    JJT[i*6+j] += J[i*6+k] * J[j*6+k];
+                    double d = out_solutions[j*6+k] - solution[k];
+                    diff += d * d;
+                }
+                if (diff < 0.01) {
+                    duplicate = true;
+                    break;
                 }
             }
+            
+            if (!duplicate) {
+                std::memcpy(out_solutions + count * 6, solution, 6 * sizeof(double));
+                count++;
+            }
         }
-        
-        // Compute determinant (simplified: trace as approximation for small values)
-        // Real implementation would compute full determinant
-        double trace = 0;
-        for (int i = 0; i < 6; ++i) trace += JJT[i*6+i];
-        
-        return std::sqrt(std::max(0.0, trace / 6.0));
     }
+    return count;
+}
+
+bool RobotImpl::inverse_kinematics_nearest(const Matrix4x4& target,
+                                           const double* reference,
+                                           double* solution) const {
+    if (inverse_kinematics_numerical(target, reference, solution)) return true;
     
-    bool check_joint_limits(const double* joints) const {
-        for (int i = 0; i < 6; ++i) {
-            if (joints[i] < limits[i].min_angle || joints[i] > limits[i].max_angle) {
-                return false;
-            }
+    // Warm start failed: fall back to multi-start and keep the closest branch
+    double candidates[8 * 6];
+    int count = inverse_kinematics_all(target, candidates);
+    if (count == 0) return false;
+    
+    int best = 0;
+    double best_dist = 1e300;
+    for (int s = 0; s < count; ++s) {
+        double dist = 0;
+        for (int k = 0; k < 6; ++k) {
+            double d = candidates[s*6+k] - reference[k];
+            dist += d * d;
+        }
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = s;
         }
-        return true;
     }
-};
+    std::memcpy(solution, candidates + best * 6, 6 * sizeof(double));
+    return true;
+}
+
+SMRErrorCode RobotImpl::classify_ik_failure(const double* solution) const {
+    const double limit_eps = 1e-9;
+    const double singular_threshold = 1e-4;
+    
+    for (int i = 0; i < 6; ++i) {
+        if (solution[i] <= limits[i].min_angle + limit_eps ||
+            solution[i] >= limits[i].max_angle - limit_eps) {
+            return SMR_ERROR_JOINT_LIMITS;
+        }
+    }
+    if (compute_manipulability(solution) < singular_threshold) {
+        return SMR_ERROR_SINGULARITY;
+    }
+    return SMR_ERROR_NO_SOLUTION;
+}
+
+void RobotImpl::compute_jacobian(const double* joints, double* J) const {
+    // Compute geometric Jacobian
+    Matrix4x4 T[7];
+    forward_kinematics_chain(joints, T);
+    jacobian_from_frames(T, J);
+}
+
+double RobotImpl::compute_manipulability(const double* joints) const {
+    double J[36];
+    compute_jacobian(joints, J);
+    
+    // det(J * J^T) = prod(L_ii)^2 from its Cholesky factor
+    double JJT[36];
+    jacobian_outer(J, 0.0, JJT);
+    if (!cholesky6(JJT)) return 0.0;
+    
+    double root_det = 1.0;
+    for (int i = 0; i < 6; ++i) root_det *= JJT[i*6+i];
+    return root_det;
+}
+
+bool RobotImpl::check_joint_limits(const double* joints) const {
+    for (int i = 0; i < 6; ++i) {
+        if (joints[i] < limits[i].min_angle || joints[i] > limits[i].max_angle) {
+            return false;
+        }
+    }
+    return true;
+}
 
 // =============================================================================
 // C API Implementation
@@ -334,6 +476,15 @@ SMR_API void smr_robot_destroy(RobotHandle handle) {
     delete static_cast<RobotImpl*>(handle);
 }
 
+SMR_API long long smr_robot_get_memory(RobotHandle handle) {
+    if (!handle) return -1;
+    const auto* robot = static_cast<RobotImpl*>(handle);
+    std::shared_ptr<const ReachabilityMap> map = robot->reachability;
+    size_t bytes = vector_bytes(robot->collision_capsules);
+    if (map) bytes += map->memory_bytes();
+    return static_cast<long long>(bytes);
+}
+
 SMR_API SMRErrorCode smr_robot_forward_kinematics(RobotHandle handle,
                                                    const double* joint_angles,
                                                    double* out_transform) {
@@ -359,42 +510,7 @@ SMR_API SMRErrorCode smr_robot_inverse_kinematics(RobotHandle handle,
     Matrix4x4 target;
     std::memcpy(target.m, target_transform, 16 * sizeof(double));
     
-    // Try multiple initial guesses
-    double initial_guesses[8][6] = {
-        {0, -M_PI/2, M_PI/2, 0, 0, 0},
-        {0, -M_PI/4, M_PI/4, 0, 0, 0},
-        {M_PI/2, -M_PI/2, M_PI/2, 0, 0, 0},
-        {-M_PI/2, -M_PI/2, M_PI/2, 0, 0, 0},
-        {0, -M_PI/2, M_PI/2, M_PI, 0, 0},
-        {0, -3*M_PI/4, 3*M_PI/4, 0, 0, 0},
-        {M_PI, -M_PI/2, M_PI/2, 0, 0, 0},
-        {0, 0, 0, 0, 0, 0}
-    };
-    
-    *out_count = 0;
-    for (int i = 0; i < 8 && *out_count < 8; ++i) {
-        double solution[6];
-        if (robot->inverse_kinematics_numerical(target, initial_guesses[i], solution)) {
-            // Check if solution is unique
-            bool duplicate = false;
-            for (int j = 0; j < *out_count; ++j) {
-                double diff = 0;
-                for (int k = 0; k < 6; ++k) {
-                    double d = out_solutions[j*6+k] - solution[k];
-                    diff += d * d;
-                }
-                if (diff < 0.01) {
-                    duplicate = true;
-                    break;
-                }
-            }
-            
-            if (!duplicate) {
-                std::memcpy(out_solutions + (*out_count) * 6, solution, 6 * sizeof(double));
-                (*out_count)++;
-            }
-        }
-    }
+    *out_count = robot->inverse_kinematics_all(target, out_solutions);
     
     return (*out_count > 0) ? SMR_SUCCESS : SMR_ERROR_NO_SOLUTION;
 }
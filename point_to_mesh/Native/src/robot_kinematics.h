@@ -0,0 +1,92 @@
+/**
+ * @file robot_kinematics.h
+ * @brief Internal Robot Kinematics Types (shared between native modules)
+ */
+
+#ifndef SMR_ROBOT_KINEMATICS_H
+#define SMR_ROBOT_KINEMATICS_H
+
+#include "smr_welding_api.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+class ReachabilityMap;
+
+// =============================================================================
+// Matrix Operations
+// =============================================================================
+
+class Matrix4x4 {
+public:
+    double m[16]; // Row-major order
+
+    Matrix4x4() { identity(); }
+
+    void identity() {
+        std::memset(m, 0, sizeof(m));
+        m[0] = m[5] = m[10] = m[15] = 1.0;
+    }
+
+    void set_dh(double a, double alpha, double d, double theta);
+
+    Matrix4x4 operator*(const Matrix4x4& other) const;
+
+    void get_position(double& x, double& y, double& z) const {
+        x = m[3]; y = m[7]; z = m[11];
+    }
+
+    void get_rotation_axis(int col, double& x, double& y, double& z) const {
+        x = m[col]; y = m[4+col]; z = m[8+col];
+    }
+};
+
+// =============================================================================
+// Robot Implementation
+// =============================================================================
+
+class RobotImpl {
+public:
+    DHParams dh[6];
+    JointLimits limits[6];
+    RobotType type;
+
+    // Precomputed workspace map (null until built or loaded)
+    std::shared_ptr<const ReachabilityMap> reachability;
+
+    // User-defined collision capsules (empty = generated from DH links)
+    std::vector<LinkCapsule> collision_capsules;
+
+    explicit RobotImpl(RobotType t);
+    RobotImpl(const DHParams* custom_dh, const JointLimits* custom_limits);
+
+    void forward_kinematics(const double* joints, Matrix4x4& result) const;
+
+    // Frames T[0] (base) .. T[6] (flange) for the given joint angles
+    void forward_kinematics_chain(const double* joints, Matrix4x4* frames) const;
+
+    // Numerical IK using damped least squares on the geometric Jacobian
+    bool inverse_kinematics_numerical(const Matrix4x4& target,
+                                       const double* initial_guess,
+                                       double* solution,
+                                       int max_iterations = 100,
+                                       double tolerance = 1e-6) const;
+
+    // Multi-start IK; writes up to 8 distinct solutions (8 * 6 doubles)
+    int inverse_kinematics_all(const Matrix4x4& target, double* out_solutions,
+                               int max_iterations = 100) const;
+
+    // Warm-started IK, falling back to the multi-start branch nearest `reference`
+    bool inverse_kinematics_nearest(const Matrix4x4& target,
+                                    const double* reference,
+                                    double* solution) const;
+
+    // Reason a numerical IK run ended at `solution` without converging
+    SMRErrorCode classify_ik_failure(const double* solution) const;
+
+    void compute_jacobian(const double* joints, double* J) const;
+    double compute_manipulability(const double* joints) const;
+    bool check_joint_limits(const double* joints) const;
+};
+
+#endif // SMR_ROBOT_KINEMATICS_H
@@ -0,0 +1,96 @@
+/**
+ * @file scratch_memory.cpp
+ * @brief Monotonic Arena and Per-Thread Scratch
+ */
+
+#include "scratch_memory.h"
+#include "stats.h"
+#include <cstdlib>
+#include <new>
+
+// Smallest block an arena asks the system for
+static const size_t ARENA_MIN_BLOCK = 64u << 10;
+
+// =============================================================================
+// Monotonic Arena
+// =============================================================================
+
+void* MonotonicArena::allocate(size_t bytes, size_t align) {
+    if (bytes == 0) bytes = 1;
+    for (;;) {
+        if (current < blocks.size()) {
+            size_t start = (offset + align - 1) & ~(align - 1);
+            if (start + bytes <= blocks[current].size) {
+                offset = start + bytes;
+                return blocks[current].data + start;
+            }
+            // Blocks past the current one are free: move on, dropping one
+            // that is too small for this request
+            ++current;
+            offset = 0;
+            if (current < blocks.size() && blocks[current].size < bytes) free_block(current);
+            continue;
+        }
+        // Grow geometrically (the new block at least doubles the arena)
+        add_block(std::max(std::max(ARENA_MIN_BLOCK, bytes), std::max(next_block, capacity)));
+        next_block = 0;
+    }
+}
+
+void MonotonicArena::reset(size_t keep_bytes) {
+    current = 0;
+    offset = 0;
+    if (capacity > keep_bytes) {
+        release();
+    } else if (blocks.size() > 1) {
+        size_t total = capacity;
+        release();
+        next_block = total;
+    }
+}
+
+void MonotonicArena::release() {
+    while (!blocks.empty()) free_block(blocks.size() - 1);
+    current = 0;
+    offset = 0;
+    next_block = 0;
+}
+
+void MonotonicArena::add_block(size_t size) {
+    char* data = static_cast<char*>(std::malloc(size));
+    if (!data) throw std::bad_alloc();
+    memory_charge(size);
+    SMR_STAT_ADD(STAT_SCRATCH_BLOCKS, 1);
+    blocks.push_back(Block{data, size});
+    capacity += size;
+}
+
+void MonotonicArena::free_block(size_t i) {
+    memory_release(blocks[i].size);
+    std::free(blocks[i].data);
+    capacity -= blocks[i].size;
+    blocks.erase(blocks.begin() + i);
+}
+
+// =============================================================================
+// Thread Scratch
+// =============================================================================
+
+static thread_local int g_scratch_depth = 0;
+
+MonotonicArena& thread_scratch() {
+    static thread_local MonotonicArena arena;
+    return arena;
+}
+
+ScratchScope::ScratchScope() : arena(thread_scratch()), start(arena.mark()) {
+    ++g_scratch_depth;
+}
+
+ScratchScope::~ScratchScope() {
+    if (--g_scratch_depth == 0) {
+        arena.reset(SCRATCH_RETAIN_BYTES);
+    } else {
+        arena.rewind(start);
+    }
+}
@@ -0,0 +1,247 @@
+/**
+ * @file scratch_memory.h
+ * @brief Arena, per-thread scratch and per-handle buffer reuse for hot loops
+ */
+
+#ifndef SMR_SCRATCH_MEMORY_H
+#define SMR_SCRATCH_MEMORY_H
+
+#include "memory_tracker.h"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =============================================================================
+// Monotonic Arena
+// =============================================================================
+
+/**
+ * Bump allocator over a list of blocks. Nothing is freed individually:
+ * rewind() and reset() hand the space back in one step. Blocks are counted
+ * by the smr_memory_* API.
+ */
+class MonotonicArena {
+public:
+    /// Position to rewind to
+    struct Mark {
+        size_t block;
+        size_t offset;
+    };
+
+    MonotonicArena() = default;
+    ~MonotonicArena() { release(); }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    /// `bytes` of storage aligned to `align` (at most alignof(max_align_t))
+    void* allocate(size_t bytes, size_t align);
+
+    /// Uninitialized array of n trivially destructible elements
+    template <class T>
+    T* allocate_array(size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena arrays are never destroyed");
+        return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    Mark mark() const { return Mark{current, offset}; }
+
+    /// Free everything allocated since `m` (the blocks are kept)
+    void rewind(Mark m) {
+        current = m.block;
+        offset = m.offset;
+    }
+
+    /// Free everything; merges the blocks into one of their total size, or
+    /// drops them if that would exceed `keep_bytes`
+    void reset(size_t keep_bytes = static_cast<size_t>(-1));
+
+    /// Return all blocks to the system
+    void release();
+
+    /// Bytes held in blocks
+    size_t memory_bytes() const { return capacity; }
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0;     // Block in use (== blocks.size() before the first allocation)
+    size_t offset = 0;      // Bytes used in blocks[current]
+    size_t capacity = 0;    // Sum of block sizes
+    size_t next_block = 0;  // Size of the next block after a merge
+
+    void add_block(size_t size);
+    void free_block(size_t i);
+};
+
+/**
+ * Allocator for node-based containers that live and die with an arena:
+ * deallocate() is a no-op and the arena's reset() frees the nodes.
+ */
+template <class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(MonotonicArena* arena) noexcept : arena(arena) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    MonotonicArena* arena;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.arena == b.arena;
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.arena != b.arena;
+}
+
+// =============================================================================
+// Thread Scratch
+// =============================================================================
+
+/// Calling thread's scratch arena; only use it inside a ScratchScope
+MonotonicArena& thread_scratch();
+
+/**
+ * Borrows the calling thread's scratch arena and frees what was taken from
+ * it when the scope ends. Scopes nest, including across nested parallel
+ * loops (a pool thread that waits runs other tasks to completion). When the
+ * outermost scope ends the arena keeps one block of up to
+ * SCRATCH_RETAIN_BYTES for the next call.
+ */
+class ScratchScope {
+public:
+    ScratchScope();
+    ~ScratchScope();
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    /// Uninitialized array of n trivially destructible elements
+    template <class T>
+    T* array(size_t n) { return arena.allocate_array<T>(n); }
+
+private:
+    MonotonicArena& arena;
+    MonotonicArena::Mark start;
+};
+
+/// Scratch bytes a thread keeps between calls
+static const size_t SCRATCH_RETAIN_BYTES = 64u << 20;
+
+// =============================================================================
+// Buffer Pool
+// =============================================================================
+
+/// Bytes reserved by a pooled vector (see BufferPool)
+template <class T, class A>
+size_t buffer_bytes(const std::vector<T, A>& buffer) {
+    return vector_bytes(buffer);
+}
+
+/**
+ * Spare buffers of one handle, so filters that build a new array and swap
+ * it in reuse the array they replaced last time instead of going back to
+ * the heap:
+ *
+ *     PointBuffer kept = pool.take(points.size());
+ *     ...fill kept...
+ *     points.swap(kept);
+ *     pool.give(std::move(kept));
+ *
+ * It keeps at most one spare per power-of-two size class. A filter that
+ * shrinks the handle calls trim() with the new size afterwards: no later
+ * take() needs more, so the larger arrays it replaced go back to the heap
+ * instead of doubling the handle's footprint.
+ *
+ * Buffer is a vector or a PointBuffer (anything with capacity(), reserve(),
+ * clear(), swap() and a buffer_bytes() overload). Not thread-safe; like the
+ * rest of a handle it is used by one call at a time.
+ */
+template <class Buffer>
+class BufferPool {
+public:
+    /// An empty buffer with room for at least `capacity` elements
+    Buffer take(size_t capacity) {
+        // Smallest spare that fits, else the largest one (grown once)
+        size_t best = spares.size();
+        for (size_t i = 0; i < spares.size(); ++i) {
+            if (best == spares.size() ||
+                better_fit(spares[i].capacity(), spares[best].capacity(), capacity)) {
+                best = i;
+            }
+        }
+
+        Buffer buffer;
+        if (best < spares.size()) {
+            buffer.swap(spares[best]);
+            spares.erase(spares.begin() + best);
+        }
+        buffer.reserve(capacity);
+        return buffer;
+    }
+
+    /// Keep a buffer for a later take() (its contents are discarded), unless
+    /// a spare of its size class is at least as large
+    void give(Buffer&& buffer) {
+        if (buffer.capacity() == 0) return;
+        buffer.clear();
+        for (auto& spare : spares) {
+            if (size_class(spare.capacity()) != size_class(buffer.capacity())) continue;
+            if (spare.capacity() < buffer.capacity()) spare.swap(buffer);
+            return;
+        }
+        spares.push_back(std::move(buffer));
+    }
+
+    /// Release the spares with room for more than max_capacity elements
+    /// (all of them by default)
+    void trim(size_t max_capacity = 0) {
+        spares.erase(std::remove_if(spares.begin(), spares.end(),
+                                    [max_capacity](const Buffer& spare) {
+                                        return spare.capacity() > max_capacity;
+                                    }),
+                     spares.end());
+    }
+
+    /// Bytes held by the spares
+    size_t memory_bytes() const {
+        size_t bytes = 0;
+        for (const auto& s : spares) bytes += buffer_bytes(s);
+        return bytes;
+    }
+
+private:
+    std::vector<Buffer> spares;
+
+    static int size_class(size_t capacity) {
+        int bits = 0;
+        for (; capacity > 1; capacity >>= 1) ++bits;
+        return bits;
+    }
+
+    static bool better_fit(size_t a, size_t b, size_t need) {
+        if ((a >= need) != (b >= need)) return a >= need;
+        return a >= need ? a < b : a > b;
+    }
+};
+
+#endif // SMR_SCRATCH_MEMORY_H
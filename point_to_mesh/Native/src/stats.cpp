@@ -0,0 +1,234 @@
+/**
+ * @file stats.cpp
+ * @brief Stage Timers, Counters and Chrome Trace Output
+ */
+
+#include "smr_welding_api.h"
+#include "point_cloud.h"
+#include "stats.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+std::atomic<int> g_stats_mode{SMR_STATS_OFF};
+
+// Trace timestamps count from library load
+static const int64_t g_stats_epoch_ns = stats_now_ns();
+
+static const char* const STAT_NAMES[STAT_COUNT] = {
+    "pointcloud.load",
+    "pointcloud.normals.search",
+    "pointcloud.normals.pca",
+    "pointcloud.outliers.search",
+    "pointcloud.downsample",
+    "pointcloud.spatial_sort",
+    "mesh.splat",
+    "mesh.extract",
+    "mesh.simplify",
+    "path.project",
+    "ik.trajectory",
+    "ik.solve",
+    "ik.iterations",
+    "ik.failures",
+    "ik.chunk_repairs",
+    "pool.tasks",
+    "pool.steals",
+    "scratch.blocks"
+};
+
+// Scopes shorter than this are counted but not traced, so per-point timers
+// do not flood the trace
+static const int64_t TRACE_MIN_NS = 20000;
+static const size_t TRACE_MAX_EVENTS = 1 << 20;
+
+// =============================================================================
+// Per-Thread Accumulators
+// =============================================================================
+
+struct StatSlot {
+    // Written only by the owning thread; atomics let other threads sum them
+    std::atomic<int64_t> count{0};
+    std::atomic<int64_t> total_ns{0};
+    std::atomic<int64_t> max_ns{0};
+
+    void add(int64_t n, int64_t ns) {
+        count.store(count.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        if (ns > 0) {
+            total_ns.store(total_ns.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+            if (ns > max_ns.load(std::memory_order_relaxed)) max_ns.store(ns, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct TraceEvent {
+    int id;
+    int thread;
+    int64_t start_ns;
+    int64_t duration_ns;
+};
+
+struct ThreadStats {
+    StatSlot slots[STAT_COUNT];
+    int thread = 0;
+};
+
+/**
+ * Every thread that records gets its own slots, so timers in parallel loops
+ * never contend. The registry sums live threads on demand and folds a
+ * thread's slots into `retired` when it exits.
+ */
+class StatsRegistry {
+public:
+    std::mutex mutex;
+    std::vector<ThreadStats*> threads;
+    int64_t retired_count[STAT_COUNT] = {};
+    int64_t retired_ns[STAT_COUNT] = {};
+    int64_t retired_max[STAT_COUNT] = {};
+    int next_thread = 1;
+
+    std::mutex trace_mutex;
+    std::vector<TraceEvent> trace;
+    size_t trace_dropped = 0;
+
+    void attach(ThreadStats* stats) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats->thread = next_thread++;
+        threads.push_back(stats);
+    }
+
+    void detach(ThreadStats* stats) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < STAT_COUNT; ++i) {
+            const StatSlot& slot = stats->slots[i];
+            retired_count[i] += slot.count.load(std::memory_order_relaxed);
+            retired_ns[i] += slot.total_ns.load(std::memory_order_relaxed);
+            retired_max[i] = std::max(retired_max[i], slot.max_ns.load(std::memory_order_relaxed));
+        }
+        threads.erase(std::find(threads.begin(), threads.end(), stats));
+    }
+};
+
+static StatsRegistry& stats_registry() {
+    // Never destroyed: threads may still detach during static destruction
+    static StatsRegistry* registry = new StatsRegistry();
+    return *registry;
+}
+
+class ThreadStatsHandle {
+public:
+    ThreadStatsHandle() { stats_registry().attach(&stats); }
+    ~ThreadStatsHandle() { stats_registry().detach(&stats); }
+    ThreadStats stats;
+};
+
+static ThreadStats& thread_stats() {
+    static thread_local ThreadStatsHandle handle;
+    return handle.stats;
+}
+
+void stats_record(StatId id, int64_t start_ns, int64_t duration_ns) {
+    ThreadStats& stats = thread_stats();
+    stats.slots[id].add(1, duration_ns);
+
+    if (g_stats_mode.load(std::memory_order_relaxed) == SMR_STATS_TRACE &&
+        duration_ns >= TRACE_MIN_NS) {
+        StatsRegistry& registry = stats_registry();
+        std::lock_guard<std::mutex> lock(registry.trace_mutex);
+        if (registry.trace.size() < TRACE_MAX_EVENTS) {
+            registry.trace.push_back(TraceEvent{id, stats.thread, start_ns, duration_ns});
+        } else {
+            ++registry.trace_dropped;
+        }
+    }
+}
+
+void stats_add(StatId id, int64_t n) {
+    thread_stats().slots[id].add(n, 0);
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+SMR_API SMRErrorCode smr_stats_set_mode(SMRStatsMode mode) {
+    if (mode < SMR_STATS_OFF || mode > SMR_STATS_TRACE) return SMR_ERROR_INVALID_PARAMETER;
+#ifndef SMR_HAS_STATS
+    if (mode != SMR_STATS_OFF) return SMR_ERROR_NOT_IMPLEMENTED;
+#endif
+    g_stats_mode.store(mode);
+    return SMR_SUCCESS;
+}
+
+SMR_API int smr_stats_get(StageStat* out_stats, int capacity) {
+    if (!out_stats || capacity <= 0) return STAT_COUNT;
+
+    StatsRegistry& registry = stats_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    int n = std::min(capacity, static_cast<int>(STAT_COUNT));
+    for (int i = 0; i < n; ++i) {
+        int64_t count = registry.retired_count[i];
+        int64_t total = registry.retired_ns[i];
+        int64_t longest = registry.retired_max[i];
+        for (const ThreadStats* stats : registry.threads) {
+            const StatSlot& slot = stats->slots[i];
+            count += slot.count.load(std::memory_order_relaxed);
+            total += slot.total_ns.load(std::memory_order_relaxed);
+            longest = std::max(longest, slot.max_ns.load(std::memory_order_relaxed));
+        }
+        out_stats[i].name = STAT_NAMES[i];
+        out_stats[i].count = count;
+        out_stats[i].total_ms = total * 1e-6;
+        out_stats[i].max_ms = longest * 1e-6;
+    }
+    return STAT_COUNT;
+}
+
+SMR_API void smr_stats_reset(void) {
+    StatsRegistry& registry = stats_registry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (int i = 0; i < STAT_COUNT; ++i) {
+            registry.retired_count[i] = registry.retired_ns[i] = registry.retired_max[i] = 0;
+            for (ThreadStats* stats : registry.threads) {
+                StatSlot& slot = stats->slots[i];
+                slot.count.store(0, std::memory_order_relaxed);
+                slot.total_ns.store(0, std::memory_order_relaxed);
+                slot.max_ns.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(registry.trace_mutex);
+    registry.trace.clear();
+    registry.trace_dropped = 0;
+}
+
+SMR_API SMRErrorCode smr_stats_write_trace(const char* filepath) {
+    if (!filepath) return SMR_ERROR_INVALID_PARAMETER;
+
+    FILE* file = std::fopen(filepath, "w");
+    if (!file) {
+        set_last_error("Cannot open trace file for writing");
+        return SMR_ERROR_FILE_NOT_FOUND;
+    }
+
+    StatsRegistry& registry = stats_registry();
+    std::lock_guard<std::mutex> lock(registry.trace_mutex);
+
+    // Chrome trace event format: complete ("X") events, microseconds
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < registry.trace.size(); ++i) {
+        const TraceEvent& e = registry.trace[i];
+        std::fprintf(file, "{\"name\":\"%s\",\"cat\":\"smr\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                           "\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                     STAT_NAMES[e.id], e.thread,
+                     (e.start_ns - g_stats_epoch_ns) * 1e-3, e.duration_ns * 1e-3,
+                     i + 1 < registry.trace.size() ? "," : "");
+    }
+    std::fprintf(file, "],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":%zu}}\n",
+                 registry.trace_dropped);
+
+    bool ok = std::fclose(file) == 0;
+    if (!ok) set_last_error("Failed to write trace file");
+    return ok ? SMR_SUCCESS : SMR_ERROR_FILE_NOT_FOUND;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file stats.h
+ * @brief Internal stage timers and counters (smr_stats_* API)
+ */
+
+#ifndef SMR_STATS_H
+#define SMR_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/// Timers (T) and counters (C) reported by smr_stats_get, in output order
+enum StatId {
+    STAT_POINTCLOUD_LOAD,          // T  File parsing
+    STAT_NORMALS_SEARCH,           // T  Neighbor search, per point
+    STAT_NORMALS_PCA,              // T  Covariance and normal, per point
+    STAT_OUTLIER_SEARCH,           // T  Neighbor search of outlier removal, per point
+    STAT_DOWNSAMPLE,               // T  Voxel-grid downsampling
+    STAT_SPATIAL_SORT,             // T  Morton-order reordering
+    STAT_MESH_SPLAT,               // T  Splatting points onto the grid
+    STAT_MESH_EXTRACT,             // T  Surface extraction
+    STAT_MESH_SIMPLIFY,            // T  Decimation
+    STAT_PATH_PROJECT,             // T  Projecting path points onto a mesh
+    STAT_TRAJECTORY_IK,            // T  Whole-path IK
+    STAT_IK_SOLVE,                 // T  Single damped least squares solve
+    STAT_IK_ITERATIONS,            // C  Damped least squares iterations
+    STAT_IK_FAILURES,              // C  Solves that did not converge
+    STAT_IK_CHUNK_REPAIRS,         // C  Trajectory chunks re-solved serially
+    STAT_POOL_TASKS,               // C  Thread pool tasks run
+    STAT_POOL_STEALS,              // C  Tasks taken from another thread's queue
+    STAT_SCRATCH_BLOCKS,           // C  Blocks arenas took from the heap
+    STAT_COUNT
+};
+
+/// 0 = off, else an SMRStatsMode
+extern std::atomic<int> g_stats_mode;
+
+inline bool stats_enabled() {
+    return g_stats_mode.load(std::memory_order_relaxed) != 0;
+}
+
+inline int64_t stats_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Add one timed call (and a trace event when tracing)
+void stats_record(StatId id, int64_t start_ns, int64_t duration_ns);
+
+/// Add n to a counter
+void stats_add(StatId id, int64_t n);
+
+/// Times its scope when stats are enabled; a relaxed load otherwise
+class StatTimer {
+public:
+    explicit StatTimer(StatId id) : id(id), start(stats_enabled() ? stats_now_ns() : -1) {}
+    ~StatTimer() {
+        if (start >= 0) stats_record(id, start, stats_now_ns() - start);
+    }
+
+    StatTimer(const StatTimer&) = delete;
+    StatTimer& operator=(const StatTimer&) = delete;
+
+private:
+    StatId id;
+    int64_t start;
+};
+
+// Compiled out entirely with -DSMR_ENABLE_STATS=OFF
+#ifdef SMR_HAS_STATS
+#define SMR_STAT_CONCAT2(a, b) a##b
+#define SMR_STAT_CONCAT(a, b) SMR_STAT_CONCAT2(a, b)
+#define SMR_STAT_SCOPE(id) StatTimer SMR_STAT_CONCAT(stat_timer_, __LINE__)(id)
+#define SMR_STAT_ADD(id, n) do { if (stats_enabled()) stats_add(id, n); } while (0)
+#else
+#define SMR_STAT_SCOPE(id) do {} while (0)
+#define SMR_STAT_ADD(id, n) do {} while (0)
+#endif
+
+#endif // SMR_STATS_H
@@ -0,0 +1,347 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Work-Stealing Thread Pool Implementation
+ */
+
+#include "smr_welding_api.h"
+#include "stats.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(SMR_PLATFORM_WINDOWS)
+#include <windows.h>
+#elif defined(SMR_PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+static const int MAX_POOL_THREADS = 256;
+
+static int hardware_threads() {
+    unsigned int hw = std::thread::hardware_concurrency();
+    return hw > 0 ? static_cast<int>(hw) : 1;
+}
+
+// =============================================================================
+// Thread Affinity
+// =============================================================================
+
+// Restrict a thread to one CPU (cpu < 0 = any CPU of the process)
+static bool pin_thread(std::thread& thread, int cpu) {
+#if defined(SMR_PLATFORM_WINDOWS)
+    DWORD_PTR mask;
+    if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) return false;
+    if (cpu >= 0) {
+        mask = static_cast<DWORD_PTR>(1) << cpu;
+    } else {
+        DWORD_PTR system_mask;
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &mask, &system_mask)) return false;
+    }
+    return SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), mask) != 0;
+#elif defined(SMR_PLATFORM_LINUX)
+    if (cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpu >= 0) {
+        CPU_SET(cpu, &set);
+    } else {
+        for (int i = 0; i < CPU_SETSIZE; ++i) CPU_SET(i, &set);
+    }
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)thread;
+    (void)cpu;
+    return false;
+#endif
+}
+
+static bool affinity_supported() {
+#if defined(SMR_PLATFORM_WINDOWS) || defined(SMR_PLATFORM_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// =============================================================================
+// Thread Pool
+// =============================================================================
+
+struct PoolTask {
+    TaskGroup* group;
+    Task fn;
+};
+
+struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<PoolTask> tasks;
+};
+
+// Queue of the calling thread: 0 (shared) outside the pool, i for worker i
+static thread_local int worker_index = 0;
+
+/**
+ * Worker i (1 .. concurrency - 1) serves queues[i]; queues[0] takes tasks
+ * submitted by threads outside the pool, whose callers help run their own
+ * group's tasks while they wait. Workers are started on first use and kept:
+ * lowering the concurrency parks the surplus, so a resize never races
+ * running tasks. shutdown() joins them; the next submission restarts them.
+ */
+class ThreadPool {
+public:
+    ThreadPool() : concurrency(hardware_threads()) {
+        queues[0].reset(new WorkerQueue);
+    }
+
+    // Stop and join the workers (no task may be queued or running)
+    void shutdown() {
+        std::lock_guard<std::mutex> config(config_mutex);
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) thread.join();
+        threads.clear();
+        started.store(1, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = false;
+    }
+
+    int get_concurrency() const { return concurrency.load(std::memory_order_relaxed); }
+
+    void set_concurrency(int threads_wanted) {
+        std::lock_guard<std::mutex> config(config_mutex);
+        concurrency.store(std::min(std::max(threads_wanted, 1), MAX_POOL_THREADS));
+        notify();
+    }
+
+    bool set_affinity(const int* cpus, int count) {
+        if (!affinity_supported()) return false;
+        std::lock_guard<std::mutex> config(config_mutex);
+        affinity.assign(cpus, cpus + count);
+        bool ok = true;
+        for (size_t i = 0; i < threads.size(); ++i) {
+            ok = pin_thread(threads[i], cpu_for(static_cast<int>(i) + 1)) && ok;
+        }
+        return ok;
+    }
+
+    void submit(TaskGroup* group, Task fn) {
+        if (started.load(std::memory_order_acquire) < get_concurrency()) start_workers();
+
+        group->pending.fetch_add(1, std::memory_order_relaxed);
+        WorkerQueue& queue = *queues[worker_index];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(PoolTask{group, std::move(fn)});
+        }
+        queued.fetch_add(1);
+        notify();
+    }
+
+    /**
+     * Run queued tasks until every task of the group has finished. Pool
+     * threads run any task. Threads outside the pool (the application's,
+     * job threads) only run their own group's, so a short call never picks
+     * up a chunk of an unrelated long job; once none of those is left in
+     * the shared queue they block until the workers finish the rest.
+     */
+    void help(TaskGroup* group) {
+        int self = worker_index;
+        while (group->pending.load(std::memory_order_acquire) > 0) {
+            if (self > 0 ? run_one(self) : run_own(group)) continue;
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [&] {
+                return group->pending.load(std::memory_order_acquire) == 0 ||
+                       (self > 0 && queued.load() > 0);
+            });
+        }
+    }
+
+private:
+    std::unique_ptr<WorkerQueue> queues[MAX_POOL_THREADS];
+    std::atomic<int> started{1};        // Queues in use (workers + the shared one)
+    std::atomic<int> concurrency;       // Workers below this index take tasks
+    std::atomic<int> queued{0};         // Tasks waiting in any queue
+
+    std::mutex config_mutex;            // Worker start, affinity
+    std::vector<std::thread> threads;   // threads[i - 1] is worker i
+    std::vector<int> affinity;
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;       // Idle workers and waiting groups
+    bool stopping = false;
+
+    void notify() {
+        { std::lock_guard<std::mutex> lock(sleep_mutex); }
+        wake.notify_all();
+    }
+
+    int cpu_for(int worker) const {
+        if (affinity.empty()) return -1;
+        return affinity[(worker - 1) % affinity.size()];
+    }
+
+    void start_workers() {
+        std::lock_guard<std::mutex> config(config_mutex);
+        for (int i = started.load(); i < get_concurrency(); ++i) {
+            queues[i].reset(new WorkerQueue);
+            threads.emplace_back(&ThreadPool::worker, this, i);
+            if (!affinity.empty()) pin_thread(threads.back(), cpu_for(i));
+            started.store(i + 1, std::memory_order_release);
+        }
+    }
+
+    // Pop the newest own task, else steal the oldest task of another queue
+    bool run_one(int self) {
+        PoolTask task;
+        if (!pop(self, task)) {
+            int count = started.load(std::memory_order_acquire);
+            bool found = false;
+            for (int k = 1; k < count && !found; ++k) {
+                found = steal((self + k) % count, task);
+            }
+            if (!found) return false;
+            SMR_STAT_ADD(STAT_POOL_STEALS, 1);
+        }
+        execute(task);
+        return true;
+    }
+
+    // Pop the newest task of `group` from the shared queue
+    bool run_own(TaskGroup* group) {
+        PoolTask task;
+        {
+            WorkerQueue& queue = *queues[0];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto it = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(),
+                                   [group](const PoolTask& t) { return t.group == group; });
+            if (it == queue.tasks.rend()) return false;
+            task = std::move(*it);
+            queue.tasks.erase(std::next(it).base());
+        }
+        execute(task);
+        return true;
+    }
+
+    void execute(PoolTask& task) {
+        queued.fetch_sub(1);
+        SMR_STAT_ADD(STAT_POOL_TASKS, 1);
+
+        TaskGroup* group = task.group;
+        try {
+            task.fn();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(group->error_mutex);
+            if (!group->error) group->error = std::current_exception();
+        }
+        task.fn = nullptr;
+        if (group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) notify();
+    }
+
+    bool pop(int index, PoolTask& task) {
+        WorkerQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(int index, PoolTask& task) {
+        WorkerQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    void worker(int index) {
+        worker_index = index;
+        for (;;) {
+            if (index < get_concurrency() && run_one(index)) continue;
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [&] {
+                return stopping || (index < get_concurrency() && queued.load() > 0);
+            });
+            if (stopping) return;
+        }
+    }
+};
+
+// Never destroyed: a static destructor would join the workers while a DLL
+// unloads, under the Windows loader lock. smr_shutdown joins them instead.
+static ThreadPool& thread_pool() {
+    static ThreadPool* pool = new ThreadPool;
+    return *pool;
+}
+
+// =============================================================================
+// Task Group
+// =============================================================================
+
+void TaskGroup::run(Task task) {
+    thread_pool().submit(this, std::move(task));
+}
+
+void TaskGroup::join() {
+    if (pending.load(std::memory_order_acquire) > 0) thread_pool().help(this);
+}
+
+void TaskGroup::wait() {
+    join();
+    std::exception_ptr first;
+    {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        std::swap(first, error);
+    }
+    if (first) std::rethrow_exception(first);
+}
+
+int pool_concurrency() {
+    return thread_pool().get_concurrency();
+}
+
+void pool_set_concurrency(int threads) {
+    thread_pool().set_concurrency(threads > 0 ? threads : hardware_threads());
+}
+
+bool pool_set_affinity(const int* cpus, int count) {
+    return thread_pool().set_affinity(cpus, count);
+}
+
+void pool_shutdown() {
+    thread_pool().shutdown();
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+SMR_API SMRErrorCode smr_set_thread_count(int num_threads) {
+    if (num_threads < 0) return SMR_ERROR_INVALID_PARAMETER;
+    pool_set_concurrency(num_threads);
+    return SMR_SUCCESS;
+}
+
+SMR_API int smr_get_thread_count(void) {
+    return pool_concurrency();
+}
+
+SMR_API SMRErrorCode smr_set_thread_affinity(const int* cpus, int count) {
+    if (count < 0 || (count > 0 && !cpus)) return SMR_ERROR_INVALID_PARAMETER;
+    for (int i = 0; i < count; ++i) {
+        if (cpus[i] < 0) return SMR_ERROR_INVALID_PARAMETER;
+    }
+    if (!affinity_supported()) return SMR_ERROR_NOT_IMPLEMENTED;
+    return pool_set_affinity(cpus, count) ? SMR_SUCCESS : SMR_ERROR_INVALID_PARAMETER;
+}
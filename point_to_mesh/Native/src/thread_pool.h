@@ -0,0 +1,62 @@
+/**
+ * @file thread_pool.h
+ * @brief Internal work-stealing thread pool shared by all parallel stages
+ */
+
+#ifndef SMR_THREAD_POOL_H
+#define SMR_THREAD_POOL_H
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+typedef std::function<void()> Task;
+
+/// Threads parallel loops may use, counting the calling thread (>= 1)
+int pool_concurrency();
+
+/// Resize the pool (0 = hardware concurrency); extra workers are parked
+void pool_set_concurrency(int threads);
+
+/**
+ * Pin worker i to cpus[i % count] (count 0 = no pinning).
+ * @return false if thread affinity is not supported on this platform
+ */
+bool pool_set_affinity(const int* cpus, int count);
+
+/// Join the worker threads (nothing may be running); later work restarts them
+void pool_shutdown();
+
+/**
+ * Set of tasks run on the pool. Each pool thread has its own deque: it
+ * pushes and pops its newest tasks, and idle threads steal the oldest ones
+ * from the others. Threads outside the pool share one submission deque.
+ * wait() runs queued tasks while it waits (a thread outside the pool only
+ * those of its own group), so nested groups (a seam batch whose seams run
+ * parallel IK) cannot deadlock and need no extra threads.
+ */
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    ~TaskGroup() { join(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(Task task);
+
+    /// Wait for every task; rethrows the first exception a task threw
+    void wait();
+
+private:
+    friend class ThreadPool;
+
+    std::atomic<int> pending{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    void join();
+};
+
+#endif // SMR_THREAD_POOL_H
@@ -0,0 +1,203 @@
+/**
+ * @file time_parameterization.cpp
+ * @brief Time-Optimal Path Parameterization Implementation
+ */
+
+#include "time_parameterization.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+static const double DERIV_EPS = 1e-9;   // |dq/ds| below this puts no bound on sddot
+static const double U_UNBOUNDED = 1e30;
+
+// Minimum arc-length baseline for finite differences. IK solutions carry noise
+// at the solver tolerance; differentiating it over sub-millimetre steps would
+// swamp d2q/ds2 and throttle the whole trajectory.
+static const double DERIV_BASELINE = 1e-3;
+
+TimingSettings timing_resolve_settings(const TimingSettings* settings) {
+    TimingSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.travel_speed <= 0) s.travel_speed = 0.01f;
+    if (s.velocity_scale <= 0) s.velocity_scale = 1.0;
+    if (s.accel_scale <= 0) s.accel_scale = 1.0;
+    return s;
+}
+
+// Per-sample path derivatives and the resulting constraint coefficients.
+// Joint acceleration is q' * u + q'' * x with u = sddot and x = sdot^2.
+struct PathSample {
+    double s;
+    double dq[6];       // dq/ds
+    double ddq[6];      // d2q/ds2
+    double x_max;       // Velocity, travel speed and zero-q' acceleration bounds on x
+};
+
+// Bounds on u at sample p for a given x: max_j(lo_j), min_j(hi_j)
+static void control_bounds(const PathSample& p, const double* accel, double x,
+                           double& u_min, double& u_max) {
+    u_min = -U_UNBOUNDED;
+    u_max = U_UNBOUNDED;
+    for (int j = 0; j < 6; ++j) {
+        double d = p.dq[j];
+        if (std::abs(d) <= DERIV_EPS) continue;
+        double slope = -p.ddq[j] / d;
+        double half = accel[j] / std::abs(d);
+        u_min = std::max(u_min, -half + slope * x);
+        u_max = std::min(u_max, half + slope * x);
+    }
+}
+
+double time_parameterize(const RobotImpl& robot,
+                         const double* joints,
+                         const float* arc_lengths,
+                         size_t count,
+                         const TimingSettings& settings,
+                         double* out_timestamps,
+                         double* out_velocities,
+                         double* out_accelerations,
+                         float* out_speed) {
+    if (count == 0) return 0.0;
+
+    double vel[6], accel[6];
+    for (int j = 0; j < 6; ++j) {
+        vel[j] = settings.velocity_scale * robot.limits[j].max_velocity;
+        accel[j] = settings.accel_scale * robot.limits[j].max_accel;
+    }
+
+    // Step 1: Grid of samples with strictly increasing arc length
+    std::vector<size_t> grid;
+    std::vector<size_t> grid_of(count);
+    grid.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (grid.empty() || arc_lengths[i] > arc_lengths[grid.back()] + 1e-9f) {
+            grid.push_back(i);
+        }
+        grid_of[i] = grid.size() - 1;
+    }
+    size_t m = grid.size();
+
+    std::vector<PathSample> samples(m);
+    double v_travel_sq = static_cast<double>(settings.travel_speed) * settings.travel_speed;
+
+    size_t lo = 0, hi = 0;
+    for (size_t k = 0; k < m; ++k) {
+        PathSample& p = samples[k];
+        p.s = arc_lengths[grid[k]];
+
+        // Neighbours at least DERIV_BASELINE away on each side (two pointers)
+        while (lo + 1 < k && p.s - arc_lengths[grid[lo + 1]] >= DERIV_BASELINE) ++lo;
+        hi = std::max(hi, std::min(k + 1, m - 1));
+        while (hi + 1 < m && arc_lengths[grid[hi]] - p.s < DERIV_BASELINE) ++hi;
+
+        const double* q = joints + grid[k] * 6;
+        const double* ql = joints + grid[lo] * 6;
+        const double* qh = joints + grid[hi] * 6;
+        double sl = arc_lengths[grid[lo]], sh = arc_lengths[grid[hi]];
+        double span = sh - sl;
+
+        p.x_max = v_travel_sq;
+        for (int j = 0; j < 6; ++j) {
+            p.dq[j] = (span > 0) ? (qh[j] - ql[j]) / span : 0.0;
+            p.ddq[j] = 0.0;
+            if (lo < k && hi > k) {
+                double d0 = (q[j] - ql[j]) / (p.s - sl);
+                double d1 = (qh[j] - q[j]) / (sh - p.s);
+                p.ddq[j] = 2.0 * (d1 - d0) / span;
+            }
+
+            double adq = std::abs(p.dq[j]);
+            if (adq > DERIV_EPS) {
+                double v = vel[j] / adq;
+                p.x_max = std::min(p.x_max, v * v);
+            } else if (std::abs(p.ddq[j]) > DERIV_EPS) {
+                p.x_max = std::min(p.x_max, accel[j] / std::abs(p.ddq[j]));
+            }
+        }
+    }
+
+    // Step 2: Backward pass - largest x at each sample that can still
+    // decelerate into the next sample's controllable set
+    std::vector<double> x_upper(m);
+    x_upper[m - 1] = 0.0;
+    for (size_t k = m - 1; k-- > 0;) {
+        const PathSample& p = samples[k];
+        double delta = samples[k + 1].s - p.s;
+        double bound = p.x_max;
+
+        // x + 2*delta*(lo_j + slope_j*x) <= x_upper[k+1] for every joint
+        for (int j = 0; j < 6; ++j) {
+            double d = p.dq[j];
+            if (std::abs(d) <= DERIV_EPS) continue;
+            double lo = -accel[j] / std::abs(d);
+            double coeff = 1.0 + 2.0 * delta * (-p.ddq[j] / d);
+            if (coeff > 0) {
+                bound = std::min(bound, (x_upper[k + 1] - 2.0 * delta * lo) / coeff);
+            }
+        }
+
+        // Lower and upper control bounds of different joints must overlap
+        for (int a = 0; a < 6; ++a) {
+            if (std::abs(p.dq[a]) <= DERIV_EPS) continue;
+            double slope_a = -p.ddq[a] / p.dq[a];
+            double lo_a = -accel[a] / std::abs(p.dq[a]);
+            for (int b = 0; b < 6; ++b) {
+                if (b == a || std::abs(p.dq[b]) <= DERIV_EPS) continue;
+                double slope_b = -p.ddq[b] / p.dq[b];
+                double hi_b = accel[b] / std::abs(p.dq[b]);
+                if (slope_a > slope_b) {
+                    bound = std::min(bound, (hi_b - lo_a) / (slope_a - slope_b));
+                }
+            }
+        }
+        x_upper[k] = std::max(0.0, bound);
+    }
+
+    // Step 3: Forward pass - greedy maximal acceleration inside the sets
+    std::vector<double> x(m, 0.0), u(m, 0.0);
+    for (size_t k = 0; k + 1 < m; ++k) {
+        double delta = samples[k + 1].s - samples[k].s;
+        double u_min, u_max;
+        control_bounds(samples[k], accel, x[k], u_min, u_max);
+
+        double uk = std::min(u_max, (x_upper[k + 1] - x[k]) / (2.0 * delta));
+        uk = std::max(uk, u_min);
+        x[k + 1] = std::max(0.0, x[k] + 2.0 * delta * uk);
+        if (x[k + 1] > x_upper[k + 1]) x[k + 1] = x_upper[k + 1];
+        u[k] = (x[k + 1] - x[k]) / (2.0 * delta);
+    }
+    if (m > 1) {
+        // Hold the final deceleration, within the end sample's own bounds
+        double u_min, u_max;
+        control_bounds(samples[m - 1], accel, x[m - 1], u_min, u_max);
+        u[m - 1] = std::min(std::max(u[m - 2], u_min), u_max);
+    }
+
+    // Step 4: Integrate time (sdot linear in t per segment under constant sddot)
+    std::vector<double> t(m, 0.0);
+    for (size_t k = 0; k + 1 < m; ++k) {
+        double delta = samples[k + 1].s - samples[k].s;
+        double speed_sum = std::sqrt(x[k]) + std::sqrt(x[k + 1]);
+        t[k + 1] = t[k] + 2.0 * delta / std::max(speed_sum, 1e-9);
+    }
+
+    // Step 5: Expand to the input samples
+    for (size_t i = 0; i < count; ++i) {
+        size_t k = grid_of[i];
+        const PathSample& p = samples[k];
+        double sdot = std::sqrt(x[k]);
+
+        out_timestamps[i] = t[k];
+        if (out_speed) out_speed[i] = static_cast<float>(sdot);
+        for (int j = 0; j < 6; ++j) {
+            if (out_velocities) out_velocities[i * 6 + j] = p.dq[j] * sdot;
+            if (out_accelerations) out_accelerations[i * 6 + j] = p.dq[j] * u[k] + p.ddq[j] * x[k];
+        }
+    }
+
+    return t[m - 1];
+}
@@ -0,0 +1,43 @@
+/**
+ * @file time_parameterization.h
+ * @brief Time-optimal path parameterization under joint velocity/acceleration limits
+ */
+
+#ifndef SMR_TIME_PARAMETERIZATION_H
+#define SMR_TIME_PARAMETERIZATION_H
+
+#include "smr_welding_api.h"
+#include "robot_kinematics.h"
+#include <cstddef>
+
+/// Fill zero/unset fields of `settings` with defaults
+TimingSettings timing_resolve_settings(const TimingSettings* settings);
+
+/**
+ * Parameterize q(s) by time, where s is the seam arc length of each sample.
+ *
+ * Works on x = sdot^2 over the sample grid: a backward pass computes the largest
+ * x at each sample from which the robot can still stop at the end, then a forward
+ * pass accelerates as hard as the joint acceleration bounds allow without leaving
+ * that set. Both passes are O(count). Starts and ends at rest.
+ *
+ * Path derivatives are taken over at least 1 mm of arc length so IK noise at
+ * densely sampled seams does not dominate d2q/ds2. Samples with zero arc length
+ * increment share the previous sample's timing.
+ *
+ * @param out_velocities count * 6 joint velocities (may be NULL)
+ * @param out_accelerations count * 6 joint accelerations (may be NULL)
+ * @param out_speed count path speeds ds/dt (may be NULL)
+ * @return Total duration (s)
+ */
+double time_parameterize(const RobotImpl& robot,
+                         const double* joints,
+                         const float* arc_lengths,
+                         size_t count,
+                         const TimingSettings& settings,
+                         double* out_timestamps,
+                         double* out_velocities,
+                         double* out_accelerations,
+                         float* out_speed);
+
+#endif // SMR_TIME_PARAMETERIZATION_H
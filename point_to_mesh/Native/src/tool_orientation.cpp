@@ -0,0 +1,244 @@
+/**
+ * @file tool_orientation.cpp
+ * @brief Tool Frame Construction and Tool-Axis Redundancy Implementation
+ */
+
+#include "tool_orientation.h"
+#include "trajectory_ik.h"
+#include "parallel.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+// =============================================================================
+// Tool Frames
+// =============================================================================
+
+void build_tool_target(const WeldPoint& wp, float standoff, Matrix4x4& out) {
+    ToolAngles zero = {0.0f, 0.0f, 0.0f};
+    build_tool_target(wp, standoff, zero, out);
+}
+
+void build_tool_target(const WeldPoint& wp, float standoff,
+                       const ToolAngles& angles, Matrix4x4& out) {
+    double* target = out.m;
+
+    // Rotation: Z-axis along negative normal (pointing at surface)
+    // X-axis along tangent
+    double z[3] = {-wp.normal[0], -wp.normal[1], -wp.normal[2]};
+    double x[3] = {wp.tangent[0], wp.tangent[1], wp.tangent[2]};
+
+    // Y = Z x X
+    double y[3] = {
+        z[1]*x[2] - z[2]*x[1],
+        z[2]*x[0] - z[0]*x[2],
+        z[0]*x[1] - z[1]*x[0]
+    };
+
+    // Normalize
+    double y_len = std::sqrt(y[0]*y[0] + y[1]*y[1] + y[2]*y[2]);
+    if (y_len > 1e-6) { y[0] /= y_len; y[1] /= y_len; y[2] /= y_len; }
+
+    // Rebuild X = Y x Z for orthogonality
+    x[0] = y[1]*z[2] - y[2]*z[1];
+    x[1] = y[2]*z[0] - y[0]*z[2];
+    x[2] = y[0]*z[1] - y[1]*z[0];
+
+    // Local rotation L = Rx(work) * Ry(travel) * Rz(spin)
+    double cw = std::cos(angles.work),   sw = std::sin(angles.work);
+    double ct = std::cos(angles.travel), st = std::sin(angles.travel);
+    double cs = std::cos(angles.spin),   ss = std::sin(angles.spin);
+    double L[9] = {
+        ct*cs,                -ct*ss,                st,
+        sw*st*cs + cw*ss,     -sw*st*ss + cw*cs,     -sw*ct,
+        -cw*st*cs + sw*ss,    cw*st*ss + sw*cs,      cw*ct
+    };
+
+    // Columns of base * L (row-major output)
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            target[r*4+c] = x[r] * L[0*3+c] + y[r] * L[1*3+c] + z[r] * L[2*3+c];
+        }
+    }
+
+    // TCP offset along the (tilted) tool axis
+    for (int r = 0; r < 3; ++r) {
+        target[r*4+3] = wp.position[r] + standoff * target[r*4+2];
+    }
+    target[12] = 0; target[13] = 0; target[14] = 0; target[15] = 1;
+}
+
+// =============================================================================
+// Tool-Axis Redundancy
+// =============================================================================
+
+// Candidates are warm-started from a neighbouring solution, so a reachable one
+// converges quickly; a low cap keeps unreachable candidates cheap to reject
+static const int SEARCH_ITERATIONS = 30;
+
+ToolAxisSettings tool_axis_resolve_settings(const ToolAxisSettings* settings) {
+    ToolAxisSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.spin_samples <= 0) s.spin_samples = 12;
+    if (s.spin_range <= 0) s.spin_range = static_cast<float>(M_PI);
+    if (s.travel_tolerance < 0) s.travel_tolerance = 0;
+    if (s.work_tolerance < 0) s.work_tolerance = 0;
+    if (s.angle_samples <= 0) s.angle_samples = 3;
+    if (s.min_manipulability <= 0) s.min_manipulability = 0.01;
+    if (s.blend_window <= 0) s.blend_window = 16;
+    if (s.num_threads <= 0) s.num_threads = parallel_default_threads();
+    return s;
+}
+
+// Samples of [-range, range]; a full turn drops the duplicate endpoint
+static std::vector<float> sample_band(float range, int samples, bool periodic) {
+    std::vector<float> values;
+    if (range <= 0 || samples <= 1) {
+        values.push_back(0.0f);
+        return values;
+    }
+    int divisions = periodic ? samples : samples - 1;
+    for (int k = 0; k < samples; ++k) {
+        values.push_back(-range + 2.0f * range * k / divisions);
+    }
+    return values;
+}
+
+static void build_targets(const WeldPoint* points, size_t count, float standoff,
+                          const ToolAngles* angles, int num_threads,
+                          std::vector<Matrix4x4>& targets) {
+    targets.resize(count);
+    parallel_for(0, count, 1024, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            build_tool_target(points[i], standoff, angles[i], targets[i]);
+        }
+    }, num_threads);
+}
+
+size_t solve_tool_axis_ik(const RobotImpl& robot,
+                          const WeldPoint* points,
+                          size_t count,
+                          float standoff,
+                          const ToolAngles& nominal,
+                          const ToolAxisSettings& s,
+                          double* out_joints,
+                          SMRErrorCode* out_status,
+                          ToolAngles* out_angles) {
+    if (count == 0) return 0;
+
+    TrajectoryIKSettings ik = trajectory_ik_resolve_settings(nullptr);
+    ik.num_threads = s.num_threads;
+
+    // Step 1: Nominal orientation
+    std::vector<ToolAngles> angles(count, nominal);
+    std::vector<Matrix4x4> targets;
+    build_targets(points, count, standoff, angles.data(), s.num_threads, targets);
+    solve_trajectory_ik(robot, targets.data(), count, ik, nullptr, out_joints, out_status);
+
+    // Step 2: Search the redundancy at unreachable / poorly conditioned points
+    // When the last joint is a pure rotation about the tool axis (a6 = alpha6 = 0,
+    // true for all presets), spin only shifts q6 and never changes reachability or
+    // manipulability of joints 1-5, so sampling it would just repeat the same solve.
+    bool spin_is_last_joint = std::abs(robot.dh[5].a) < 1e-12 && std::abs(robot.dh[5].alpha) < 1e-12;
+    std::vector<float> spins = spin_is_last_joint ? std::vector<float>(1, 0.0f) :
+                               sample_band(s.spin_range, s.spin_samples,
+                                           s.spin_range >= static_cast<float>(M_PI) - 1e-4f);
+    std::vector<float> travels = sample_band(s.travel_tolerance, s.angle_samples, false);
+    std::vector<float> works = sample_band(s.work_tolerance, s.angle_samples, false);
+
+    std::vector<ToolAngles> delta(count, ToolAngles{0.0f, 0.0f, 0.0f});
+    std::vector<char> searched(count, 0);
+
+    parallel_for(0, count, 64, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            const double* seed = out_joints + i * 6;
+            double best_score = -1e300;
+            if (out_status[i] == SMR_SUCCESS) {
+                best_score = robot.compute_manipulability(seed);
+                if (best_score >= s.min_manipulability) continue;
+            }
+            searched[i] = 1;
+
+            for (float spin : spins) {
+                for (float dt : travels) {
+                    for (float dw : works) {
+                        if (spin == 0.0f && dt == 0.0f && dw == 0.0f) continue;
+
+                        ToolAngles a = {nominal.spin + spin, nominal.travel + dt, nominal.work + dw};
+                        Matrix4x4 target;
+                        build_tool_target(points[i], standoff, a, target);
+
+                        // Spin mostly maps onto the last joint: pre-rotate the guess
+                        double guess[6], q[6];
+                        std::memcpy(guess, seed, sizeof(guess));
+                        guess[5] += spin;
+                        if (!robot.inverse_kinematics_numerical(target, guess, q,
+                                                                SEARCH_ITERATIONS)) continue;
+
+                        double deviation = spin * spin + dt * dt + dw * dw;
+                        double score = robot.compute_manipulability(q) - 1e-3 * deviation;
+                        if (score > best_score) {
+                            best_score = score;
+                            delta[i] = ToolAngles{spin, dt, dw};
+                        }
+                    }
+                }
+            }
+        }
+    }, s.num_threads);
+
+    bool any = false;
+    for (size_t i = 0; i < count && !any; ++i) {
+        any = searched[i] && (delta[i].spin != 0.0f || delta[i].travel != 0.0f || delta[i].work != 0.0f);
+    }
+
+    if (any) {
+        // Step 3: Ramp each re-orientation in/out over blend_window points
+        // from the nearest searched point, so the torch turns gradually
+        const long window = s.blend_window;
+        std::vector<long> prev_searched(count), next_searched(count);
+        long last = -1;
+        for (size_t i = 0; i < count; ++i) {
+            if (searched[i]) last = static_cast<long>(i);
+            prev_searched[i] = last;
+        }
+        last = -1;
+        for (size_t i = count; i > 0; --i) {
+            if (searched[i - 1]) last = static_cast<long>(i - 1);
+            next_searched[i - 1] = last;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            ToolAngles d = delta[i];
+            if (!searched[i]) {
+                long p = prev_searched[i], n = next_searched[i];
+                long dp = (p >= 0) ? static_cast<long>(i) - p : window + 1;
+                long dn = (n >= 0) ? n - static_cast<long>(i) : window + 1;
+                long src = (dp <= dn) ? p : n;
+                long dist = std::min(dp, dn);
+                d = ToolAngles{0.0f, 0.0f, 0.0f};
+                if (src >= 0 && dist <= window) {
+                    float w = 1.0f - static_cast<float>(dist) / (window + 1);
+                    d = ToolAngles{delta[src].spin * w, delta[src].travel * w, delta[src].work * w};
+                }
+            }
+            angles[i] = ToolAngles{nominal.spin + d.spin, nominal.travel + d.travel, nominal.work + d.work};
+        }
+
+        // Step 4: Re-solve the whole trajectory with the final orientations
+        double seed[6];
+        std::memcpy(seed, out_joints, sizeof(seed));
+        build_targets(points, count, standoff, angles.data(), s.num_threads, targets);
+        solve_trajectory_ik(robot, targets.data(), count, ik, seed, out_joints, out_status);
+    }
+
+    size_t reachable = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (out_status[i] == SMR_SUCCESS) ++reachable;
+        if (out_angles) out_angles[i] = angles[i];
+    }
+    return reachable;
+}
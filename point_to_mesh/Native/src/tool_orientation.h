@@ -0,0 +1,49 @@
+/**
+ * @file tool_orientation.h
+ * @brief Tool frames for weld points and tool-axis redundancy resolution
+ */
+
+#ifndef SMR_TOOL_ORIENTATION_H
+#define SMR_TOOL_ORIENTATION_H
+
+#include "smr_welding_api.h"
+#include "robot_kinematics.h"
+#include <cstddef>
+
+/// Tool orientation relative to the weld frame (rad)
+struct ToolAngles {
+    float spin;     // About the tool Z-axis
+    float travel;   // About the lateral axis (push/drag)
+    float work;     // About the travel direction
+};
+
+/**
+ * Build the tool target for a weld point.
+ * Base frame: X along tangent, Z along -normal; the angles rotate it as
+ * Rx(work) * Ry(travel) * Rz(spin). The TCP sits `standoff` along tool Z.
+ */
+void build_tool_target(const WeldPoint& wp, float standoff, Matrix4x4& out);
+void build_tool_target(const WeldPoint& wp, float standoff,
+                       const ToolAngles& angles, Matrix4x4& out);
+
+/// Fill zero/unset fields of `settings` with defaults
+ToolAxisSettings tool_axis_resolve_settings(const ToolAxisSettings* settings);
+
+/**
+ * Solve path IK with the nominal angles, then re-orient unreachable or poorly
+ * conditioned points within the tolerance bands and re-solve.
+ *
+ * @param out_angles count tool angles actually used
+ * @return Number of reachable points
+ */
+size_t solve_tool_axis_ik(const RobotImpl& robot,
+                          const WeldPoint* points,
+                          size_t count,
+                          float standoff,
+                          const ToolAngles& nominal,
+                          const ToolAxisSettings& settings,
+                          double* out_joints,
+                          SMRErrorCode* out_status,
+                          ToolAngles* out_angles);
+
+#endif // SMR_TOOL_ORIENTATION_H
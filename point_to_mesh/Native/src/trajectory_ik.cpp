@@ -0,0 +1,170 @@
+/**
+ * @file trajectory_ik.cpp
+ * @brief Parallel Trajectory IK Implementation
+ */
+
+#include "trajectory_ik.h"
+#include "parallel.h"
+#include "stats.h"
+#include <atomic>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+static const double HOME_JOINTS[6] = {0, -M_PI/2, M_PI/2, 0, 0, 0};
+
+TrajectoryIKSettings trajectory_ik_resolve_settings(const TrajectoryIKSettings* settings) {
+    TrajectoryIKSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.num_threads <= 0) s.num_threads = parallel_default_threads();
+    if (s.max_iterations <= 0) s.max_iterations = 100;
+    if (s.tolerance <= 0) s.tolerance = 1e-6;
+    if (s.max_joint_step <= 0) s.max_joint_step = 0.5;
+    return s;
+}
+
+static double max_joint_delta(const double* a, const double* b) {
+    double d = 0;
+    for (int k = 0; k < 6; ++k) d = std::max(d, std::abs(a[k] - b[k]));
+    return d;
+}
+
+// Sequential warm-started solve over n targets. Returns reachable count.
+static size_t solve_span(const RobotImpl& robot, const Matrix4x4* targets,
+                         size_t n, const double* seed,
+                         const TrajectoryIKSettings& s,
+                         double* out_joints, SMRErrorCode* out_status) {
+    double prev[6];
+    std::memcpy(prev, seed, sizeof(prev));
+    size_t reachable = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        double* q = out_joints + i * 6;
+        if (robot.inverse_kinematics_numerical(targets[i], prev, q,
+                                               s.max_iterations, s.tolerance)) {
+            out_status[i] = SMR_SUCCESS;
+            std::memcpy(prev, q, sizeof(prev));
+            ++reachable;
+        } else {
+            out_status[i] = robot.classify_ik_failure(q);
+        }
+    }
+    return reachable;
+}
+
+size_t solve_trajectory_ik(const RobotImpl& robot,
+                           const Matrix4x4* targets,
+                           size_t count,
+                           const TrajectoryIKSettings& s,
+                           const double* seed,
+                           double* out_joints,
+                           SMRErrorCode* out_status) {
+    if (count == 0) return 0;
+    if (!seed) seed = HOME_JOINTS;
+    SMR_STAT_SCOPE(STAT_TRAJECTORY_IK);
+
+    size_t chunk = static_cast<size_t>(std::max(0, s.chunk_size));
+    if (chunk == 0) {
+        chunk = count / (static_cast<size_t>(s.num_threads) * 4);
+        chunk = std::max<size_t>(32, std::min<size_t>(1024, chunk));
+    }
+    size_t num_chunks = (count + chunk - 1) / chunk;
+
+    // Step 1: Coarse continuation over chunk start points gives
+    // branch-consistent seeds without solving the whole path serially.
+    // The seeds come from the numerical nearest-solution IK: the kinematics
+    // layer has no closed-form solver for arbitrary DH parameters.
+    std::vector<double> chunk_seeds(num_chunks * 6);
+    double ref[6];
+    std::memcpy(ref, seed, sizeof(ref));
+
+    for (size_t c = 0; c < num_chunks; ++c) {
+        double q[6];
+        if (robot.inverse_kinematics_nearest(targets[c * chunk], ref, q)) {
+            std::memcpy(ref, q, sizeof(ref));
+        }
+        std::memcpy(chunk_seeds.data() + c * 6, ref, sizeof(ref));
+    }
+
+    // Step 2: Solve chunks in parallel, warm-starting point to point. Chunks
+    // a cancelled job never reaches stay marked as cancelled.
+    std::fill(out_status, out_status + count, SMR_ERROR_CANCELLED);
+    std::vector<size_t> chunk_reachable(num_chunks, 0);
+    std::atomic<size_t> chunks_done(0);
+    parallel_for(0, num_chunks, 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c) {
+            size_t begin = c * chunk;
+            size_t end = std::min(count, begin + chunk);
+            chunk_reachable[c] = solve_span(robot, targets + begin, end - begin,
+                                            chunk_seeds.data() + c * 6, s,
+                                            out_joints + begin * 6, out_status + begin);
+            job_progress(static_cast<float>(chunks_done.fetch_add(1) + 1) / num_chunks);
+        }
+    }, s.num_threads);
+    if (job_cancelled()) return fill_unreachable_joints(count, out_status, seed, out_joints);
+
+    // Step 3: Repair continuity at chunk boundaries (in order, since a repaired
+    // chunk changes the configuration its successor must connect to)
+    std::vector<double> retry_joints(chunk * 6);
+    std::vector<SMRErrorCode> retry_status(chunk);
+    long last_valid = -1;
+
+    for (size_t c = 0; c < num_chunks; ++c) {
+        size_t begin = c * chunk;
+        size_t end = std::min(count, begin + chunk);
+
+        if (last_valid >= 0) {
+            size_t first_valid = begin;
+            while (first_valid < end && out_status[first_valid] != SMR_SUCCESS) ++first_valid;
+
+            const double* tail = out_joints + last_valid * 6;
+            bool broken = (first_valid == end) ||
+                          max_joint_delta(tail, out_joints + first_valid * 6) > s.max_joint_step;
+
+            if (broken) {
+                // Re-solve the chunk as a serial solver would, from the previous tail
+                SMR_STAT_ADD(STAT_IK_CHUNK_REPAIRS, 1);
+                size_t n = end - begin;
+                size_t reachable = solve_span(robot, targets + begin, n, tail, s,
+                                              retry_joints.data(), retry_status.data());
+                if (reachable >= chunk_reachable[c]) {
+                    std::memcpy(out_joints + begin * 6, retry_joints.data(), n * 6 * sizeof(double));
+                    std::memcpy(out_status + begin, retry_status.data(), n * sizeof(SMRErrorCode));
+                    chunk_reachable[c] = reachable;
+                }
+            }
+        }
+
+        for (size_t i = end; i > begin; --i) {
+            if (out_status[i - 1] == SMR_SUCCESS) {
+                last_valid = static_cast<long>(i - 1);
+                break;
+            }
+        }
+    }
+
+    // Step 4: Failed points hold the nearest valid configuration
+    return fill_unreachable_joints(count, out_status, seed, out_joints);
+}
+
+size_t fill_unreachable_joints(size_t count, const SMRErrorCode* status,
+                               const double* fallback, double* joints) {
+    size_t first_ok = 0;
+    while (first_ok < count && status[first_ok] != SMR_SUCCESS) ++first_ok;
+    if (!fallback) fallback = HOME_JOINTS;
+    const double* hold = (first_ok < count) ? joints + first_ok * 6 : fallback;
+
+    size_t reachable = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (status[i] == SMR_SUCCESS) {
+            hold = joints + i * 6;
+            ++reachable;
+        } else {
+            std::memmove(joints + i * 6, hold, 6 * sizeof(double));
+        }
+    }
+    return reachable;
+}
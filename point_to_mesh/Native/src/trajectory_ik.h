@@ -0,0 +1,47 @@
+/**
+ * @file trajectory_ik.h
+ * @brief Parallel, warm-started IK over a sequence of tool targets
+ */
+
+#ifndef SMR_TRAJECTORY_IK_H
+#define SMR_TRAJECTORY_IK_H
+
+#include "smr_welding_api.h"
+#include "robot_kinematics.h"
+#include <cstddef>
+
+/// Fill zero/unset fields of `settings` with defaults
+TrajectoryIKSettings trajectory_ik_resolve_settings(const TrajectoryIKSettings* settings);
+
+/**
+ * Solve IK for `count` targets.
+ *
+ * The path is split into chunks solved on worker threads. Chunk starts are
+ * seeded by a coarse sequential continuation pass over the chunk start points
+ * (numerical nearest-solution IK), then each chunk warm-starts point to point.
+ * Chunk boundaries whose joint jump exceeds max_joint_step are re-solved from
+ * the previous chunk's end. If the job is cancelled, points of chunks not yet
+ * solved get SMR_ERROR_CANCELLED and boundaries are not repaired.
+ *
+ * @param seed Initial configuration for the first point (6 doubles, may be NULL)
+ * @param out_joints count * 6 doubles; failed points hold the nearest valid solution
+ * @param out_status count codes (SMR_SUCCESS or failure reason)
+ * @return Number of reachable points
+ */
+size_t solve_trajectory_ik(const RobotImpl& robot,
+                           const Matrix4x4* targets,
+                           size_t count,
+                           const TrajectoryIKSettings& settings,
+                           const double* seed,
+                           double* out_joints,
+                           SMRErrorCode* out_status);
+
+/**
+ * Overwrite joints of failed points (status != SMR_SUCCESS) with the nearest
+ * preceding valid configuration (the first valid one for leading failures,
+ * `fallback` or the home pose if none). Returns the number of valid points.
+ */
+size_t fill_unreachable_joints(size_t count, const SMRErrorCode* status,
+                               const double* fallback, double* joints);
+
+#endif // SMR_TRAJECTORY_IK_H
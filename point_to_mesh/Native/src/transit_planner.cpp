@@ -0,0 +1,309 @@
+/**
+ * @file transit_planner.cpp
+ * @brief Joint-Space Transit Planner Implementation
+ */
+
+#include "transit_planner.h"
+#include "mesh_generator.h"
+#include "parallel.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+
+typedef std::chrono::steady_clock TransitClock;
+
+TransitSettings transit_resolve_settings(const TransitSettings* settings) {
+    TransitSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.step_size <= 0) s.step_size = 0.3;
+    if (s.max_iterations <= 0) s.max_iterations = 20000;
+    if (s.time_limit <= 0) s.time_limit = 1.0f;
+    if (s.shortcut_iterations <= 0) s.shortcut_iterations = 100;
+    if (s.seed == 0) s.seed = 1;
+    if (s.num_threads <= 0) s.num_threads = parallel_default_threads();
+    return s;
+}
+
+// =============================================================================
+// RRT-Connect
+// =============================================================================
+
+struct TreeNode {
+    double q[6];
+    int parent;     // -1 at the root
+};
+
+enum ExtendResult { EXTEND_TRAPPED, EXTEND_ADVANCED, EXTEND_REACHED };
+
+struct TransitContext {
+    const CollisionChecker& checker;
+    double max_joint_step;
+    double step_size;
+};
+
+static double joint_distance(const double* a, const double* b) {
+    double d2 = 0;
+    for (int j = 0; j < 6; ++j) d2 += (a[j] - b[j]) * (a[j] - b[j]);
+    return std::sqrt(d2);
+}
+
+static int nearest_node(const std::vector<TreeNode>& tree, const double* q) {
+    int best = 0;
+    double best_d2 = 1e300;
+    for (size_t i = 0; i < tree.size(); ++i) {
+        double d2 = 0;
+        for (int j = 0; j < 6; ++j) d2 += (tree[i].q[j] - q[j]) * (tree[i].q[j] - q[j]);
+        if (d2 < best_d2) {
+            best_d2 = d2;
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+// One step of at most step_size from tree node `from` towards q
+static ExtendResult extend_from(const TransitContext& ctx, std::vector<TreeNode>& tree, int from,
+                                const double* q) {
+    TreeNode node;
+    node.parent = from;
+    const double* base = tree[from].q;
+    double d = joint_distance(base, q);
+
+    ExtendResult result;
+    if (d <= ctx.step_size) {
+        std::memcpy(node.q, q, sizeof(node.q));
+        result = EXTEND_REACHED;
+    } else {
+        double t = ctx.step_size / d;
+        for (int j = 0; j < 6; ++j) node.q[j] = base[j] + t * (q[j] - base[j]);
+        result = EXTEND_ADVANCED;
+    }
+
+    if (ctx.checker.collides(node.q) ||
+        motion_collides(ctx.checker, base, node.q, ctx.max_joint_step)) {
+        return EXTEND_TRAPPED;
+    }
+    tree.push_back(node);
+    return result;
+}
+
+// Greedy connect: keep stepping from the newest node until q is reached or blocked
+static ExtendResult connect_tree(const TransitContext& ctx, std::vector<TreeNode>& tree,
+                                 const double* q) {
+    ExtendResult result = extend_from(ctx, tree, nearest_node(tree, q), q);
+    while (result == EXTEND_ADVANCED) {
+        result = extend_from(ctx, tree, static_cast<int>(tree.size()) - 1, q);
+    }
+    return result;
+}
+
+// Root-to-node configurations of a tree branch
+static void trace_branch(const std::vector<TreeNode>& tree, int node, std::vector<double>& out) {
+    out.clear();
+    for (; node >= 0; node = tree[node].parent) {
+        out.insert(out.end(), tree[node].q, tree[node].q + 6);
+    }
+    // Collected node-to-root; flip whole configurations
+    size_t n = out.size() / 6;
+    for (size_t i = 0; i < n / 2; ++i) {
+        std::swap_ranges(out.begin() + i * 6, out.begin() + i * 6 + 6, out.begin() + (n - 1 - i) * 6);
+    }
+}
+
+static bool rrt_connect(const TransitContext& ctx, const RobotImpl& robot,
+                        const double* start, const double* goal, int max_iterations,
+                        unsigned int seed, TransitClock::time_point deadline,
+                        const std::atomic<bool>& stop, std::vector<double>& path) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<TreeNode> trees[2];
+    TreeNode root;
+    root.parent = -1;
+    std::memcpy(root.q, start, sizeof(root.q));
+    trees[0].push_back(root);
+    std::memcpy(root.q, goal, sizeof(root.q));
+    trees[1].push_back(root);
+
+    for (int iter = 0; iter < max_iterations; ++iter) {
+        if ((iter & 15) == 0 && (stop.load(std::memory_order_relaxed) || TransitClock::now() > deadline)) {
+            return false;
+        }
+
+        double q[6];
+        for (int j = 0; j < 6; ++j) {
+            const JointLimits& lim = robot.limits[j];
+            q[j] = lim.min_angle + unit(rng) * (lim.max_angle - lim.min_angle);
+        }
+
+        // Trees swap roles every iteration
+        std::vector<TreeNode>& grow = trees[iter & 1];
+        std::vector<TreeNode>& other = trees[1 - (iter & 1)];
+        if (extend_from(ctx, grow, nearest_node(grow, q), q) == EXTEND_TRAPPED) continue;
+
+        double q_new[6];
+        std::memcpy(q_new, grow.back().q, sizeof(q_new));
+        if (connect_tree(ctx, other, q_new) != EXTEND_REACHED) continue;
+
+        // Both trees now end in q_new
+        std::vector<double> to_goal;
+        trace_branch(trees[0], static_cast<int>(trees[0].size()) - 1, path);
+        trace_branch(trees[1], static_cast<int>(trees[1].size()) - 1, to_goal);
+        for (size_t i = to_goal.size() / 6 - 1; i-- > 0;) {
+            path.insert(path.end(), to_goal.begin() + i * 6, to_goal.begin() + i * 6 + 6);
+        }
+        return true;
+    }
+    return false;
+}
+
+// =============================================================================
+// Shortcutting
+// =============================================================================
+
+static void shortcut_path(const TransitContext& ctx, int iterations, unsigned int seed,
+                          std::vector<double>& path) {
+    std::mt19937 rng(seed);
+
+    // Random shortcuts between non-adjacent waypoints
+    for (int iter = 0; iter < iterations; ++iter) {
+        int n = static_cast<int>(path.size() / 6);
+        if (n < 3) return;
+        int i = std::uniform_int_distribution<int>(0, n - 3)(rng);
+        int j = std::uniform_int_distribution<int>(i + 2, n - 1)(rng);
+        if (motion_collides(ctx.checker, &path[i * 6], &path[j * 6], ctx.max_joint_step)) continue;
+        path.erase(path.begin() + (i + 1) * 6, path.begin() + j * 6);
+    }
+
+    // Greedy pass: from each kept waypoint jump to the farthest one in sight
+    int n = static_cast<int>(path.size() / 6);
+    std::vector<double> result(path.begin(), path.begin() + 6);
+    for (int i = 0; i < n - 1;) {
+        int j = n - 1;
+        while (j > i + 1 && motion_collides(ctx.checker, &path[i * 6], &path[j * 6], ctx.max_joint_step)) {
+            --j;
+        }
+        result.insert(result.end(), path.begin() + j * 6, path.begin() + j * 6 + 6);
+        i = j;
+    }
+    path.swap(result);
+}
+
+bool plan_transit(const RobotImpl& robot, const CollisionChecker& checker,
+                  const double* start, const double* goal, double max_joint_step,
+                  const TransitSettings& s, std::vector<double>& out) {
+    TransitContext ctx = {checker, max_joint_step, s.step_size};
+
+    out.assign(start, start + 6);
+    if (!motion_collides(checker, start, goal, max_joint_step)) {
+        out.insert(out.end(), goal, goal + 6);
+        return true;
+    }
+
+    const TransitClock::time_point deadline = TransitClock::now() +
+        std::chrono::duration_cast<TransitClock::duration>(std::chrono::duration<double>(s.time_limit));
+
+    std::atomic<bool> found(false);
+    std::mutex result_mutex;
+    parallel_for(0, static_cast<size_t>(s.num_threads), 1, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            std::vector<double> path;
+            if (!rrt_connect(ctx, robot, start, goal, s.max_iterations,
+                             s.seed + static_cast<unsigned int>(i), deadline, found, path)) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(result_mutex);
+            if (!found.load()) {
+                out.swap(path);
+                found.store(true);
+            }
+        }
+    }, s.num_threads);
+
+    if (!found.load()) return false;
+    shortcut_path(ctx, s.shortcut_iterations, s.seed, out);
+    return true;
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+// Mesh checks plus the caller's test
+class CallbackCollisionChecker : public CollisionChecker {
+public:
+    CallbackCollisionChecker(const CollisionChecker& base, SMRCollisionCallback callback,
+                             void* user_data)
+        : base(base), callback(callback), user_data(user_data) {}
+
+    bool collides(const double* joints) const override {
+        return base.collides(joints) || (callback && callback(joints, user_data));
+    }
+
+private:
+    const CollisionChecker& base;
+    SMRCollisionCallback callback;
+    void* user_data;
+};
+
+SMR_API SMRErrorCode smr_robot_plan_transit(RobotHandle robot_handle,
+                                             const MeshHandle* obstacles,
+                                             int obstacle_count,
+                                             const double* start_joints,
+                                             const double* goal_joints,
+                                             const CollisionSettings* collision_settings,
+                                             const TransitSettings* settings,
+                                             SMRCollisionCallback callback,
+                                             void* user_data,
+                                             double* out_joints,
+                                             int max_points,
+                                             int* out_count) {
+    if (!robot_handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!start_joints || !goal_joints || !out_count || max_points < 0 || (max_points > 0 && !out_joints) ||
+        obstacle_count < 0 || (obstacle_count > 0 && !obstacles)) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+    for (int o = 0; o < obstacle_count; ++o) {
+        if (!obstacles[o]) return SMR_ERROR_INVALID_HANDLE;
+    }
+    *out_count = 0;
+
+    const auto* robot = static_cast<const RobotImpl*>(robot_handle);
+    CollisionSettings cs = collision_resolve_settings(collision_settings);
+    TransitSettings s = transit_resolve_settings(settings);
+
+    CollisionModel model;
+    collision_build_model(*robot, cs, model);
+
+    std::vector<std::shared_ptr<const MeshBVH>> bvhs(obstacle_count);
+    std::vector<const MeshBVH*> bvh_ptrs(obstacle_count);
+    for (int o = 0; o < obstacle_count; ++o) {
+        bvhs[o] = static_cast<const MeshImpl*>(obstacles[o])->get_bvh();
+        bvh_ptrs[o] = bvhs[o].get();
+    }
+
+    MeshCollisionChecker mesh_checker(*robot, model, bvh_ptrs.data(), obstacle_count,
+                                      !cs.ignore_self_collision);
+    CallbackCollisionChecker checker(mesh_checker, callback, user_data);
+    if (checker.collides(start_joints) || checker.collides(goal_joints)) {
+        return SMR_ERROR_INVALID_PARAMETER;
+    }
+
+    std::vector<double> path;
+    if (!plan_transit(*robot, checker, start_joints, goal_joints, cs.max_joint_step, s, path)) {
+        return SMR_ERROR_NO_SOLUTION;
+    }
+
+    int count = static_cast<int>(path.size() / 6);
+    *out_count = count;
+    if (count > max_points) return SMR_ERROR_INVALID_PARAMETER;
+    std::memcpy(out_joints, path.data(), path.size() * sizeof(double));
+    return SMR_SUCCESS;
+}
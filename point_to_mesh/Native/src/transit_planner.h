@@ -0,0 +1,33 @@
+/**
+ * @file transit_planner.h
+ * @brief Collision-free joint-space moves (RRT-Connect with shortcutting)
+ */
+
+#ifndef SMR_TRANSIT_PLANNER_H
+#define SMR_TRANSIT_PLANNER_H
+
+#include "smr_welding_api.h"
+#include "robot_kinematics.h"
+#include "collision.h"
+#include <vector>
+
+/// Fill zero/unset fields of `settings` with defaults
+TransitSettings transit_resolve_settings(const TransitSettings* settings);
+
+/**
+ * Plan a move from `start` to `goal` that `checker` accepts everywhere
+ * (motions checked at max_joint_step).
+ *
+ * The direct move is tried first. Otherwise num_threads RRT-Connect planners
+ * (seeds seed .. seed + num_threads - 1) race; the first path found stops the
+ * others. It is then shortened by random shortcuts and a greedy pass that
+ * links each waypoint to the farthest waypoint it reaches directly.
+ *
+ * @param out Waypoints from start to goal (6 doubles each)
+ * @return true if a path was found within the iteration and time budgets
+ */
+bool plan_transit(const RobotImpl& robot, const CollisionChecker& checker,
+                  const double* start, const double* goal, double max_joint_step,
+                  const TransitSettings& settings, std::vector<double>& out);
+
+#endif // SMR_TRANSIT_PLANNER_H
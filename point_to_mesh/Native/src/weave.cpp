@@ -0,0 +1,158 @@
+/**
+ * @file weave.cpp
+ * @brief Weave Pattern Generation Implementation
+ */
+
+#include "weave.h"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+static const int WEAVE_BLOCK = 256;   // Points per evaluation batch
+
+WeaveSettings weave_resolve_settings(const WeaveSettings* settings) {
+    WeaveSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.amplitude <= 0) s.amplitude = 0.002f;
+    if (s.frequency <= 0) s.frequency = 2.0f;
+    if (s.travel_speed <= 0) s.travel_speed = 0.01f;
+    if (s.samples_per_cycle <= 0) s.samples_per_cycle = 16;
+    s.samples_per_cycle = std::max(s.samples_per_cycle, 4);
+    return s;
+}
+
+// Seam length covered by one sample
+static double weave_step(const WeaveSettings& s) {
+    // One weave cycle covers travel_speed / frequency of seam
+    const double wavelength = static_cast<double>(s.travel_speed) / s.frequency;
+    return wavelength / s.samples_per_cycle;
+}
+
+double weave_sample_count(double length, const WeaveSettings& settings) {
+    // sample_uniform's samples plus the end point it may miss
+    return length / weave_step(settings) + 2.0;
+}
+
+// =============================================================================
+// Lane-Wise Pattern Evaluation
+// =============================================================================
+
+// Lane helpers use no branches and no select-style comparisons (abs,
+// min/max and converts only): under the default FP trapping model the
+// compiler will not turn a select into a blend, and a branch blocks
+// vectorization. min/max lower to vector min/max instructions.
+
+// Phase wrapped into [0, 1) for phases above -1024 cycles; truncation
+// compiles to vector converts instead of a libm floor call
+static inline float wrap_cycle(float x) {
+    return x - (static_cast<float>(static_cast<int>(x + 1024.0f)) - 1024.0f);
+}
+
+// sin(2*pi*x): wrap to [-0.5, 0.5), fold to [-0.25, 0.25] by symmetry
+// about +-0.25, odd Taylor polynomial (error below 1e-7 on that range)
+static inline float sin_cycle(float x) {
+    float y = wrap_cycle(x + 0.5f) - 0.5f;
+    float folded = std::max(std::min(y, 0.5f - y), -0.5f - y);
+    float z = 6.28318530718f * folded;
+    float z2 = z * z;
+    float p = -1.0f / 39916800.0f;
+    p = p * z2 + 1.0f / 362880.0f;
+    p = p * z2 - 1.0f / 5040.0f;
+    p = p * z2 + 1.0f / 120.0f;
+    p = p * z2 - 1.0f / 6.0f;
+    p = p * z2 + 1.0f;
+    return z * p;
+}
+
+// Triangle wave: -1 at phase 0, +1 at phase 0.5
+static inline float triangle_cycle(float x) {
+    return 1.0f - 4.0f * std::fabs(wrap_cycle(x) - 0.5f);
+}
+
+void weave_evaluate(const WeaveProfile& profile, const float* phase, size_t count,
+                    float* lateral, float* vertical) {
+    switch (profile.type) {
+        case WEAVE_ZIGZAG:
+        case WEAVE_TRIANGLE:
+            // Same wave: linear ramps between -1 (phase 0) and +1 (phase 0.5)
+            for (size_t i = 0; i < count; ++i) {
+                lateral[i] = triangle_cycle(phase[i]);
+                vertical[i] = 0.0f;
+            }
+            break;
+        case WEAVE_CIRCULAR:
+            for (size_t i = 0; i < count; ++i) {
+                lateral[i] = sin_cycle(phase[i]);
+                vertical[i] = 0.5f * sin_cycle(phase[i] + 0.25f);
+            }
+            break;
+        case WEAVE_FIGURE8:
+            for (size_t i = 0; i < count; ++i) {
+                lateral[i] = sin_cycle(2.0f * phase[i]);
+                vertical[i] = 0.5f * sin_cycle(phase[i]);
+            }
+            break;
+        case WEAVE_CUSTOM: {
+            const int samples = profile.samples();
+            const float* table = profile.table.data();
+            for (size_t i = 0; i < count; ++i) {
+                float x = wrap_cycle(phase[i]) * samples;
+                int i0 = std::min(static_cast<int>(x), samples - 1);
+                int i1 = (i0 + 1) % samples;
+                float f = x - i0;
+                lateral[i] = table[i0 * 2] + f * (table[i1 * 2] - table[i0 * 2]);
+                vertical[i] = table[i0 * 2 + 1] + f * (table[i1 * 2 + 1] - table[i0 * 2 + 1]);
+            }
+            break;
+        }
+        default:
+            std::fill(lateral, lateral + count, 0.0f);
+            std::fill(vertical, vertical + count, 0.0f);
+            break;
+    }
+}
+
+// =============================================================================
+// Generation
+// =============================================================================
+
+void weave_generate(const PathSpline& spline, const WeaveSettings& s,
+                    const WeaveProfile& profile, std::vector<WeldPoint>& out) {
+    out.clear();
+    if (spline.empty()) return;
+
+    const double wavelength = static_cast<double>(s.travel_speed) / s.frequency;
+    const double step = weave_step(s);
+    spline.sample_uniform(step, out);
+    const double total = spline.length();
+    if (out.back().arc_length < total - 1e-3 * step) {
+        WeldPoint end;
+        spline.evaluate(total, end);
+        out.push_back(end);
+    }
+
+    float phase[WEAVE_BLOCK], lateral[WEAVE_BLOCK], vertical[WEAVE_BLOCK];
+    for (size_t base = 0; base < out.size(); base += WEAVE_BLOCK) {
+        size_t count = std::min(out.size() - base, static_cast<size_t>(WEAVE_BLOCK));
+        for (size_t i = 0; i < count; ++i) {
+            // Fractional cycles in double: float phase drifts on long seams
+            double cycles = out[base + i].arc_length / wavelength;
+            phase[i] = static_cast<float>(cycles - std::floor(cycles));
+        }
+        weave_evaluate(profile, phase, count, lateral, vertical);
+
+        for (size_t i = 0; i < count; ++i) {
+            WeldPoint& wp = out[base + i];
+            float across[3] = {
+                wp.tangent[1]*wp.normal[2] - wp.tangent[2]*wp.normal[1],
+                wp.tangent[2]*wp.normal[0] - wp.tangent[0]*wp.normal[2],
+                wp.tangent[0]*wp.normal[1] - wp.tangent[1]*wp.normal[0]
+            };
+            float a = s.amplitude * lateral[i];
+            float v = s.amplitude * vertical[i];
+            for (int k = 0; k < 3; ++k) wp.position[k] += across[k] * a + wp.normal[k] * v;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file weave.h
+ * @brief Weave pattern generation along a continuous weld path
+ */
+
+#ifndef SMR_WEAVE_H
+#define SMR_WEAVE_H
+
+#include "smr_welding_api.h"
+#include "path_spline.h"
+#include <vector>
+#include <cstddef>
+
+/**
+ * One period of a weave as offsets in units of the amplitude: lateral
+ * (across the seam, tangent x normal) and vertical (along the normal).
+ * Built-in types are closed-form; WEAVE_CUSTOM interpolates `table`
+ * linearly and periodically (lateral, vertical pairs at phase k / samples),
+ * so dwell plateaus and sharp turns are reproduced exactly.
+ */
+struct WeaveProfile {
+    WeaveType type = WEAVE_NONE;
+    std::vector<float> table;
+
+    int samples() const { return static_cast<int>(table.size() / 2); }
+};
+
+/// Most samples one weave call may emit over all its seams (40 bytes each)
+static const size_t WEAVE_MAX_SAMPLES = size_t(1) << 22;
+
+/// Fill zero/unset fields of `settings` with defaults
+WeaveSettings weave_resolve_settings(const WeaveSettings* settings);
+
+/**
+ * Samples weave_generate emits for a seam of `length` (m) with resolved
+ * settings. Computed in double so that extreme settings give a huge or
+ * non-finite count, not an overflow; compare with !(count <= max).
+ */
+double weave_sample_count(double length, const WeaveSettings& settings);
+
+/**
+ * Offsets for `count` phases (in cycles, any range). Lane loops without
+ * libm calls or branches, so the built-in patterns vectorize.
+ */
+void weave_evaluate(const WeaveProfile& profile, const float* phase, size_t count,
+                    float* lateral, float* vertical);
+
+/**
+ * Sample the path every travel_speed / (frequency * samples_per_cycle) and
+ * displace each sample by the profile at phase = frequency * arc / speed.
+ * Normals, tangents and arc lengths are those of the seam, so the torch
+ * orientation and timing still follow the seam, not the weave.
+ */
+void weave_generate(const PathSpline& spline, const WeaveSettings& settings,
+                    const WeaveProfile& profile, std::vector<WeldPoint>& out);
+
+#endif // SMR_WEAVE_H
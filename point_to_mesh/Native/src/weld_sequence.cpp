@@ -0,0 +1,433 @@
+/**
+ * @file weld_sequence.cpp
+ * @brief Weld Sequence Optimization Implementation
+ */
+
+#include "weld_sequence.h"
+#include "tool_orientation.h"
+#include "parallel.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <random>
+
+static const double HOME_JOINTS[6] = {0, -M_PI/2, M_PI/2, 0, 0, 0};
+
+static const int SEQUENCE_TRACK_POINTS = 8;              // IK samples per seam to follow its branch
+static const int SEQUENCE_HEAT_SAMPLES = 16;             // Points per seam for seam-to-seam distance
+static const int SEQUENCE_MAX_CHAIN = 3;                 // Longest chain an Or-opt move relocates
+static const int SEQUENCE_MIN_KICKS = 100;               // Perturbations without gain before giving up
+static const double SEQUENCE_UNREACHABLE_COST = 1000.0;  // Per unreachable seam end (s)
+static const double SEQUENCE_EPS = 1e-9;                 // Minimum gain for a move to count
+
+typedef std::chrono::steady_clock SequenceClock;
+
+SequenceSettings sequence_resolve_settings(const SequenceSettings* settings) {
+    SequenceSettings s;
+    std::memset(&s, 0, sizeof(s));
+    if (settings) s = *settings;
+
+    if (s.time_limit <= 0) s.time_limit = 0.1f;
+    if (s.min_heat_distance < 0) s.min_heat_distance = 0.0f;
+    if (s.heat_penalty <= 0) s.heat_penalty = 10.0f;
+    if (s.num_threads <= 0) s.num_threads = parallel_default_threads();
+    return s;
+}
+
+// =============================================================================
+// Transition Costs
+// =============================================================================
+
+// Duration of a synchronous point-to-point move: the slowest joint's
+// trapezoidal (triangular when short) velocity profile
+static double move_time(const RobotImpl& robot, const double* from, const double* to) {
+    double t = 0;
+    for (int k = 0; k < 6; ++k) {
+        double d = std::abs(to[k] - from[k]);
+        double v = robot.limits[k].max_velocity;
+        double a = robot.limits[k].max_accel;
+        double tk;
+        if (v <= 0) tk = d;
+        else if (a <= 0) tk = d / v;
+        else if (d * a > v * v) tk = d / v + v / a;
+        else tk = 2.0 * std::sqrt(d / a);
+        t = std::max(t, tk);
+    }
+    return t;
+}
+
+// Configurations at both ends of a seam run in one direction
+struct SeamEnds {
+    double entry[6];
+    double exit[6];
+    int unreachable;    // Ends (0-2) without an IK solution
+};
+
+// Entry IK nearest `start`, then warm-started along a few samples of the
+// seam so the exit lies on the branch the weld actually follows
+static void track_seam(const PathSetImpl& set, int seam, bool backwards, const RobotImpl& robot,
+                       float standoff, const double* start, SeamEnds& out) {
+    const size_t base = set.offsets[seam];
+    const size_t n = set.seam_size(seam);
+    const int samples = static_cast<int>(std::min<size_t>(n, SEQUENCE_TRACK_POINTS));
+
+    double prev[6];
+    std::memcpy(prev, start, sizeof(prev));
+    std::memcpy(out.entry, start, sizeof(prev));
+    out.unreachable = 0;
+
+    bool ok = true;
+    for (int k = 0; k < samples; ++k) {
+        size_t p = samples > 1 ? (n - 1) * k / (samples - 1) : 0;
+        size_t index = base + (backwards ? n - 1 - p : p);
+
+        WeldPoint wp;
+        set.get_points(index, index + 1, &wp);
+        if (backwards) {
+            for (int c = 0; c < 3; ++c) wp.tangent[c] = -wp.tangent[c];
+        }
+        Matrix4x4 target;
+        build_tool_target(wp, standoff, target);
+
+        double q[6];
+        ok = robot.inverse_kinematics_nearest(target, prev, q);
+        if (ok) std::memcpy(prev, q, sizeof(prev));
+        if (k == 0) {
+            std::memcpy(out.entry, prev, sizeof(prev));
+            if (!ok) ++out.unreachable;
+        }
+    }
+    std::memcpy(out.exit, prev, sizeof(prev));
+    if (!ok && samples > 1) ++out.unreachable;
+}
+
+// Seam pairs closer than min_distance anywhere (on evenly spaced samples)
+static void find_close_seams(const PathSetImpl& set, float min_distance, int num_threads,
+                             std::vector<char>& close) {
+    const int seams = set.seam_count();
+    std::vector<float> samples(static_cast<size_t>(seams) * SEQUENCE_HEAT_SAMPLES * 3);
+    std::vector<int> sample_count(seams);
+
+    for (int s = 0; s < seams; ++s) {
+        size_t n = set.seam_size(s);
+        int count = static_cast<int>(std::min<size_t>(n, SEQUENCE_HEAT_SAMPLES));
+        for (int k = 0; k < count; ++k) {
+            size_t p = set.offsets[s] + (count > 1 ? (n - 1) * k / (count - 1) : 0);
+            std::memcpy(&samples[(static_cast<size_t>(s) * SEQUENCE_HEAT_SAMPLES + k) * 3],
+                        &set.positions[p * 3], 3 * sizeof(float));
+        }
+        sample_count[s] = count;
+    }
+
+    const float limit2 = min_distance * min_distance;
+    close.assign(static_cast<size_t>(seams) * seams, 0);
+    parallel_for(0, seams, 8, [&](size_t lo, size_t hi) {
+        for (size_t a = lo; a < hi; ++a) {
+            const float* pa = &samples[a * SEQUENCE_HEAT_SAMPLES * 3];
+            for (int b = 0; b < seams; ++b) {
+                if (static_cast<int>(a) == b) continue;
+                const float* pb = &samples[static_cast<size_t>(b) * SEQUENCE_HEAT_SAMPLES * 3];
+                bool hit = false;
+                for (int i = 0; i < sample_count[a] && !hit; ++i) {
+                    for (int j = 0; j < sample_count[b]; ++j) {
+                        float dx = pa[i*3] - pb[j*3];
+                        float dy = pa[i*3+1] - pb[j*3+1];
+                        float dz = pa[i*3+2] - pb[j*3+2];
+                        if (dx*dx + dy*dy + dz*dz < limit2) {
+                            hit = true;
+                            break;
+                        }
+                    }
+                }
+                close[a * seams + b] = hit ? 1 : 0;
+            }
+        }
+    }, num_threads);
+}
+
+// =============================================================================
+// Tour Search
+// =============================================================================
+
+/**
+ * Node 2s runs seam s forward, 2s + 1 backwards; the depot (start
+ * configuration) closes the tour at both ends.
+ */
+struct SequenceProblem {
+    int seams = 0;
+    int depot = 0;                // 2 * seams
+    bool fixed_direction = false;
+    std::vector<float> cost;      // (depot + 1)^2, row = from, column = to
+
+    double c(int a, int b) const { return cost[static_cast<size_t>(a) * (depot + 1) + b]; }
+
+    // Same seam run the other way (itself when directions are fixed)
+    int flip(int node) const { return fixed_direction ? node : node ^ 1; }
+};
+
+static double tour_cost(const SequenceProblem& P, const std::vector<int>& tour) {
+    double total = 0;
+    int prev = P.depot;
+    for (int node : tour) {
+        total += P.c(prev, node);
+        prev = node;
+    }
+    return total + P.c(prev, P.depot);
+}
+
+static void nearest_neighbor_tour(const SequenceProblem& P, std::vector<int>& tour) {
+    std::vector<char> used(P.seams, 0);
+    tour.clear();
+    int current = P.depot;
+    for (int step = 0; step < P.seams; ++step) {
+        int best = -1;
+        double best_cost = 0;
+        for (int s = 0; s < P.seams; ++s) {
+            if (used[s]) continue;
+            for (int dir = 0; dir < (P.fixed_direction ? 1 : 2); ++dir) {
+                double cost = P.c(current, 2 * s + dir);
+                if (best < 0 || cost < best_cost) {
+                    best = 2 * s + dir;
+                    best_cost = cost;
+                }
+            }
+        }
+        used[best / 2] = 1;
+        tour.push_back(best);
+        current = best;
+    }
+}
+
+// First-improvement descent over seam flips, 2-opt and Or-opt moves
+static void local_search(const SequenceProblem& P, std::vector<int>& tour,
+                         SequenceClock::time_point deadline) {
+    const int m = static_cast<int>(tour.size());
+    auto node_at = [&](int i) { return (i < 0 || i >= m) ? P.depot : tour[i]; };
+
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        if (SequenceClock::now() > deadline) return;
+
+        // Weld one seam the other way
+        if (!P.fixed_direction) {
+            for (int i = 0; i < m; ++i) {
+                int a = node_at(i - 1), x = tour[i], b = node_at(i + 1), y = x ^ 1;
+                if (P.c(a, y) + P.c(y, b) - P.c(a, x) - P.c(x, b) < -SEQUENCE_EPS) {
+                    tour[i] = y;
+                    improved = true;
+                }
+            }
+        }
+
+        // 2-opt: run tour[i..j] backwards; the inner costs of the reversed
+        // stretch are accumulated while j grows
+        for (int i = 0; i < m; ++i) {
+            if ((i & 63) == 0 && SequenceClock::now() > deadline) return;
+            int a = node_at(i - 1);
+            double forward = 0, backward = 0;
+            for (int j = i + 1; j < m; ++j) {
+                forward += P.c(tour[j - 1], tour[j]);
+                backward += P.c(P.flip(tour[j]), P.flip(tour[j - 1]));
+                int b = node_at(j + 1);
+                double delta = P.c(a, P.flip(tour[j])) + P.c(P.flip(tour[i]), b) + backward
+                             - P.c(a, tour[i]) - P.c(tour[j], b) - forward;
+                if (delta < -SEQUENCE_EPS) {
+                    std::reverse(tour.begin() + i, tour.begin() + j + 1);
+                    for (int k = i; k <= j; ++k) tour[k] = P.flip(tour[k]);
+                    improved = true;
+                    break;
+                }
+            }
+        }
+
+        // Or-opt: move a chain of up to SEQUENCE_MAX_CHAIN seams elsewhere,
+        // either way round
+        for (int len = 1; len <= SEQUENCE_MAX_CHAIN && len < m; ++len) {
+            for (int i = 0; i + len <= m; ++i) {
+                if ((i & 63) == 0 && SequenceClock::now() > deadline) return;
+                int first = tour[i], last = tour[i + len - 1];
+                int a = node_at(i - 1), b = node_at(i + len);
+                double removal = P.c(a, first) + P.c(last, b) - P.c(a, b);
+                if (removal <= SEQUENCE_EPS) continue;
+
+                double forward = 0, backward = 0;
+                for (int k = i; k < i + len - 1; ++k) {
+                    forward += P.c(tour[k], tour[k + 1]);
+                    backward += P.c(P.flip(tour[k + 1]), P.flip(tour[k]));
+                }
+                const bool try_reversed = !P.fixed_direction || len > 1;
+
+                int best_edge = -1;
+                bool best_reversed = false;
+                double best_delta = -SEQUENCE_EPS;
+                for (int k = 0; k <= m; ++k) {
+                    if (k >= i && k <= i + len) continue;
+                    int p = node_at(k - 1), q = node_at(k);
+                    double delta = P.c(p, first) + P.c(last, q) - P.c(p, q) - removal;
+                    if (delta < best_delta) {
+                        best_delta = delta;
+                        best_edge = k;
+                        best_reversed = false;
+                    }
+                    if (try_reversed) {
+                        delta = P.c(p, P.flip(last)) + P.c(P.flip(first), q) - P.c(p, q)
+                              + backward - forward - removal;
+                        if (delta < best_delta) {
+                            best_delta = delta;
+                            best_edge = k;
+                            best_reversed = true;
+                        }
+                    }
+                }
+                if (best_edge < 0) continue;
+
+                std::vector<int> chain(tour.begin() + i, tour.begin() + i + len);
+                if (best_reversed) {
+                    std::reverse(chain.begin(), chain.end());
+                    for (int& node : chain) node = P.flip(node);
+                }
+                tour.erase(tour.begin() + i, tour.begin() + i + len);
+                int at = best_edge > i ? best_edge - len : best_edge;
+                tour.insert(tour.begin() + at, chain.begin(), chain.end());
+                improved = true;
+            }
+        }
+    }
+}
+
+// Double bridge (A B C D -> A C B D) plus one random seam flip
+static void perturb_tour(const SequenceProblem& P, std::vector<int>& tour, std::mt19937& rng) {
+    const int m = static_cast<int>(tour.size());
+    int cut[3];
+    std::uniform_int_distribution<int> pick(1, m - 1);
+    do {
+        for (int& c : cut) c = pick(rng);
+        std::sort(cut, cut + 3);
+    } while (cut[0] == cut[1] || cut[1] == cut[2]);
+
+    std::vector<int> next;
+    next.reserve(m);
+    next.insert(next.end(), tour.begin(), tour.begin() + cut[0]);
+    next.insert(next.end(), tour.begin() + cut[1], tour.begin() + cut[2]);
+    next.insert(next.end(), tour.begin() + cut[0], tour.begin() + cut[1]);
+    next.insert(next.end(), tour.begin() + cut[2], tour.end());
+    tour.swap(next);
+
+    int i = std::uniform_int_distribution<int>(0, m - 1)(rng);
+    tour[i] = P.flip(tour[i]);
+}
+
+// =============================================================================
+// Optimization
+// =============================================================================
+
+double optimize_weld_sequence(const PathSetImpl& set, const RobotImpl& robot, float standoff,
+                              const SequenceSettings& settings, const double* start,
+                              int* out_order, bool* out_reversed) {
+    const int seams = set.seam_count();
+    if (seams == 0) return 0.0;
+    if (!start) start = HOME_JOINTS;
+
+    SequenceProblem P;
+    P.seams = seams;
+    P.depot = 2 * seams;
+    P.fixed_direction = settings.fixed_direction;
+
+    std::vector<SeamEnds> ends(2 * seams);
+    parallel_for(0, ends.size(), 1, [&](size_t lo, size_t hi) {
+        for (size_t node = lo; node < hi; ++node) {
+            if (P.fixed_direction && (node & 1)) continue;
+            track_seam(set, static_cast<int>(node / 2), (node & 1) != 0, robot, standoff, start,
+                       ends[node]);
+        }
+    }, settings.num_threads);
+
+    std::vector<char> close;
+    const bool heat = settings.min_heat_distance > 0;
+    if (heat) find_close_seams(set, settings.min_heat_distance, settings.num_threads, close);
+
+    const size_t width = static_cast<size_t>(P.depot) + 1;
+    P.cost.assign(width * width, 0.0f);
+    parallel_for(0, width, 16, [&](size_t lo, size_t hi) {
+        for (size_t a = lo; a < hi; ++a) {
+            const bool from_depot = static_cast<int>(a) == P.depot;
+            if (P.fixed_direction && !from_depot && (a & 1)) continue;
+            const double* from = from_depot ? start : ends[a].exit;
+            float* row = &P.cost[a * width];
+            for (int b = 0; b < P.depot; ++b) {
+                if (P.fixed_direction && (b & 1)) continue;
+                if (static_cast<int>(a / 2) == b / 2 && !from_depot) continue;
+                double cost = move_time(robot, from, ends[b].entry)
+                            + SEQUENCE_UNREACHABLE_COST * ends[b].unreachable;
+                if (heat && !from_depot && close[(a / 2) * seams + b / 2]) {
+                    cost += settings.heat_penalty;
+                }
+                row[b] = static_cast<float>(cost);
+            }
+            if (settings.return_home && !from_depot) {
+                row[P.depot] = static_cast<float>(move_time(robot, from, start));
+            }
+        }
+    }, settings.num_threads);
+
+    const SequenceClock::time_point deadline = SequenceClock::now() +
+        std::chrono::duration_cast<SequenceClock::duration>(
+            std::chrono::duration<double>(settings.time_limit));
+
+    std::vector<int> best;
+    nearest_neighbor_tour(P, best);
+    local_search(P, best, deadline);
+    double best_cost = tour_cost(P, best);
+
+    // Iterated local search from the best tour so far
+    if (seams >= 4) {
+        std::mt19937 rng(0x5eed);
+        const int max_stall = std::max(SEQUENCE_MIN_KICKS, 2 * seams);
+        std::vector<int> tour;
+        for (int stall = 0; stall < max_stall && SequenceClock::now() < deadline; ++stall) {
+            tour = best;
+            perturb_tour(P, tour, rng);
+            local_search(P, tour, deadline);
+            double cost = tour_cost(P, tour);
+            if (cost < best_cost - SEQUENCE_EPS) {
+                best.swap(tour);
+                best_cost = cost;
+                stall = -1;
+            }
+        }
+    }
+
+    for (int i = 0; i < seams; ++i) {
+        out_order[i] = best[i] / 2;
+        out_reversed[i] = (best[i] & 1) != 0;
+    }
+    return best_cost;
+}
+
+// =============================================================================
+// C API Implementation
+// =============================================================================
+
+SMR_API SMRErrorCode smr_path_set_optimize_sequence(PathSetHandle set_handle,
+                                                     RobotHandle robot_handle,
+                                                     float standoff,
+                                                     const SequenceSettings* settings,
+                                                     const double* start_joints,
+                                                     int* out_order,
+                                                     bool* out_reversed,
+                                                     double* out_cost) {
+    if (!set_handle || !robot_handle) return SMR_ERROR_INVALID_HANDLE;
+    if (!out_order || !out_reversed) return SMR_ERROR_INVALID_PARAMETER;
+
+    const auto* set = static_cast<const PathSetImpl*>(set_handle);
+    const auto* robot = static_cast<const RobotImpl*>(robot_handle);
+    SequenceSettings s = sequence_resolve_settings(settings);
+
+    double cost = optimize_weld_sequence(*set, *robot, standoff, s, start_joints,
+                                         out_order, out_reversed);
+    if (out_cost) *out_cost = cost;
+    return SMR_SUCCESS;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file weld_sequence.h
+ * @brief Seam order and direction optimization (robot-aware TSP)
+ */
+
+#ifndef SMR_WELD_SEQUENCE_H
+#define SMR_WELD_SEQUENCE_H
+
+#include "smr_welding_api.h"
+#include "robot_kinematics.h"
+#include "path_set.h"
+
+/// Fill zero/unset fields of `settings` with defaults
+SequenceSettings sequence_resolve_settings(const SequenceSettings* settings);
+
+/**
+ * Order the seams of `set` to minimize the time spent moving between them.
+ *
+ * Each seam has two nodes (forward, reversed) with an entry and an exit
+ * configuration. Transitions cost the duration of a synchronous trapezoidal
+ * joint move; the start configuration is a depot at both ends of the tour.
+ * The tour is built nearest-neighbor first, polished by local search (seam
+ * flips, Or-opt chain moves, 2-opt reversals; all O(1) or amortized O(1) per
+ * candidate) and then perturbed (double bridge) and re-polished from the best
+ * tour until the time budget or the kick budget runs out.
+ *
+ * @param start Start configuration (6 doubles, home pose if NULL)
+ * @param out_order seam_count seam indices in welding order
+ * @param out_reversed seam_count flags in welding order
+ * @return Total cost of the tour (s, including penalties)
+ */
+double optimize_weld_sequence(const PathSetImpl& set, const RobotImpl& robot, float standoff,
+                              const SequenceSettings& settings, const double* start,
+                              int* out_order, bool* out_reversed);
+
+#endif // SMR_WELD_SEQUENCE_H
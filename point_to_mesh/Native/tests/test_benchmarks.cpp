@@ -0,0 +1,70 @@
+/**
+ * @file test_benchmarks.cpp
+ * @brief Benchmark dataset tests (built with SMR_BUILD_BENCHMARKS)
+ */
+
+#include "test_common.h"
+#include "bench_datasets.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+SMR_TEST(benchmark_clouds_are_reproducible) {
+    for (int shape = 0; shape < SHAPE_COUNT; ++shape) {
+        const std::vector<float> first = bench_cloud(shape, 20000).points;
+        bench_cloud((shape + 1) % SHAPE_COUNT, 1000);   // Replace the cached cloud
+        const BenchCloud& cloud = bench_cloud(shape, 20000);
+        CHECK(cloud.count() == 20000 && cloud.normals.size() == cloud.points.size());
+        CHECK(cloud.points == first);
+        for (size_t i = 0; i < cloud.count(); ++i) {
+            const float* n = &cloud.normals[i * 3];
+            CHECK(std::fabs(n[0] * n[0] + n[1] * n[1] + n[2] * n[2] - 1.0f) < 1e-5f);
+        }
+    }
+
+    // T-joint: about 1% of the points lie off the plate and the web
+    const BenchCloud& tjoint = bench_cloud(SHAPE_TJOINT, 20000);
+    int strays = 0;
+    for (size_t i = 0; i < tjoint.count(); ++i) {
+        const float* p = &tjoint.points[i * 3];
+        strays += std::fabs(p[2]) > 0.004f && std::fabs(std::fabs(p[0]) - 0.005f) > 0.004f;
+    }
+    CHECK(strays > 100 && strays < 200);
+}
+
+SMR_TEST(benchmark_ply_loads_back) {
+    const BenchCloud& cloud = bench_cloud(SHAPE_CYLINDER, 5000);
+    std::string path = bench_write_ply(cloud, "smr_test_bench.ply");
+    CHECK(!path.empty());
+
+    PointCloudHandle loaded = smr_pointcloud_create();
+    CHECK(smr_pointcloud_load_ply(loaded, path.c_str()) == SMR_SUCCESS);
+    std::remove(path.c_str());
+    CHECK(smr_pointcloud_get_count(loaded) == static_cast<int>(cloud.count()));
+    CHECK(smr_pointcloud_has_normals(loaded));
+
+    std::vector<float> points(cloud.points.size()), normals(cloud.normals.size());
+    smr_pointcloud_get_points(loaded, points.data());
+    smr_pointcloud_get_normals(loaded, normals.data());
+    for (size_t i = 0; i < points.size(); ++i) {
+        CHECK(std::fabs(points[i] - cloud.points[i]) < 1e-6f);
+        CHECK(std::fabs(normals[i] - cloud.normals[i]) < 1e-4f);
+    }
+    smr_pointcloud_destroy(loaded);
+}
+
+SMR_TEST(benchmark_seam_is_reachable) {
+    const int count = 200;
+    std::vector<float> points, normals;
+    bench_seam(count, points, normals);
+    PathParams params = {};
+    PathHandle path = smr_path_create_from_points(points.data(), normals.data(), count, &params);
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    std::vector<double> joints(count * 6);
+    std::vector<char> reachable(count);
+    CHECK(smr_path_to_joints_ex(path, robot, 0.015f, nullptr, nullptr, joints.data(),
+                                reinterpret_cast<bool*>(reachable.data()), nullptr) == SMR_SUCCESS);
+    for (char r : reachable) CHECK(r);
+    smr_robot_destroy(robot);
+    smr_path_destroy(path);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_collision.cpp
+ * @brief Collision checking and transit planning tests
+ */
+
+#include "test_common.h"
+#include <vector>
+
+// Square plate in the plane at height z, clear of the robot base
+static MeshHandle plate_mesh(float z) {
+    const float vertices[12] = {0.25f, -0.2f, z, 0.65f, -0.2f, z,
+                                0.65f, 0.2f, z, 0.25f, 0.2f, z};
+    const int indices[6] = {0, 1, 2, 0, 2, 3};
+    return smr_mesh_create_from_arrays(vertices, 4, indices, 2);
+}
+
+// Straight seam on the plate along x at y, normals +Z
+static PathHandle plate_seam(float y, int count) {
+    std::vector<float> points, normals;
+    for (int i = 0; i < count; ++i) {
+        const float p[3] = {0.35f + 0.2f * i / (count - 1), y, 0.0f};
+        const float n[3] = {0.0f, 0.0f, 1.0f};
+        points.insert(points.end(), p, p + 3);
+        normals.insert(normals.end(), n, n + 3);
+    }
+    PathParams params = {};
+    return smr_path_create_from_points(points.data(), normals.data(), count, &params);
+}
+
+// Joint trajectory of a seam 15 mm above the plate, or empty if any sample is unreachable
+static std::vector<double> seam_joints(RobotHandle robot, PathHandle path) {
+    int count = smr_path_get_count(path);
+    std::vector<double> joints(static_cast<size_t>(count) * 6);
+    bool reachable[64];
+    if (count > 64 || smr_path_to_joints(path, robot, 0.015f, joints.data(), reachable) != SMR_SUCCESS) {
+        return std::vector<double>();
+    }
+    for (int i = 0; i < count; ++i) {
+        if (!reachable[i]) return std::vector<double>();
+    }
+    return joints;
+}
+
+SMR_TEST(collision_reachable_seam_over_part_is_clear) {
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    MeshHandle plate = plate_mesh(0.0f);
+    PathHandle path = plate_seam(0.0f, 50);
+    CHECK(robot && plate && path);
+
+    std::vector<double> joints = seam_joints(robot, path);
+    CHECK(joints.size() == 50 * 6);
+
+    bool flags[50];
+    int first = 0;
+    CHECK(smr_robot_check_collisions(robot, &plate, 1, joints.data(), 50, nullptr,
+                                     flags, &first) == SMR_SUCCESS);
+    CHECK(first == -1);
+
+    // The same motion through a plate 10 cm up cuts the wrist
+    MeshHandle raised = plate_mesh(0.1f);
+    CHECK(raised != nullptr);
+    CHECK(smr_robot_check_collisions(robot, &raised, 1, joints.data(), 50, nullptr,
+                                     flags, &first) == SMR_SUCCESS);
+    smr_mesh_destroy(raised);
+    CHECK(first == 0);
+
+    smr_path_destroy(path);
+    smr_mesh_destroy(plate);
+    smr_robot_destroy(robot);
+}
+
+SMR_TEST(transit_between_seam_endpoints_is_collision_free) {
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    PathHandle first_seam = plate_seam(-0.12f, 10);
+    PathHandle second_seam = plate_seam(0.12f, 10);
+    CHECK(robot && first_seam && second_seam);
+    std::vector<double> a = seam_joints(robot, first_seam);
+    std::vector<double> b = seam_joints(robot, second_seam);
+    CHECK(a.size() == 60 && b.size() == 60);
+
+    // Plate under both seams plus a 10 cm wall between them (off centre, so
+    // the wrist, which sits on the -y side of the torch, clears it at both)
+    const float vertices[24] = {0.25f, -0.2f, 0.0f, 0.65f, -0.2f, 0.0f,
+                                0.65f, 0.2f, 0.0f, 0.25f, 0.2f, 0.0f,
+                                0.3f, -0.05f, 0.0f, 0.6f, -0.05f, 0.0f,
+                                0.6f, -0.05f, 0.1f, 0.3f, -0.05f, 0.1f};
+    const int indices[12] = {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7};
+    MeshHandle cell = smr_mesh_create_from_arrays(vertices, 8, indices, 4);
+    CHECK(cell != nullptr);
+
+    // End of the first seam to the start of the second; the direct move hits the wall
+    std::vector<double> direct(a.end() - 6, a.end());
+    direct.insert(direct.end(), b.begin(), b.begin() + 6);
+    int hit = 0;
+    CHECK(smr_robot_check_collisions(robot, &cell, 1, direct.data(), 2, nullptr,
+                                     nullptr, &hit) == SMR_SUCCESS);
+    CHECK(hit == 1);
+
+    std::vector<double> waypoints(64 * 6);
+    int count = 0;
+    CHECK(smr_robot_plan_transit(robot, &cell, 1, &a[9 * 6], &b[0], nullptr, nullptr,
+                                 nullptr, nullptr, waypoints.data(), 64, &count) == SMR_SUCCESS);
+    CHECK(count >= 2);
+    for (int j = 0; j < 6; ++j) {
+        CHECK(waypoints[j] == a[9 * 6 + j]);
+        CHECK(waypoints[(count - 1) * 6 + j] == b[j]);
+    }
+
+    // Every waypoint and every segment between them
+    CHECK(smr_robot_check_collisions(robot, &cell, 1, waypoints.data(), count, nullptr,
+                                     nullptr, &hit) == SMR_SUCCESS);
+    CHECK(hit == -1);
+
+    smr_mesh_destroy(cell);
+    smr_path_destroy(second_seam);
+    smr_path_destroy(first_seam);
+    smr_robot_destroy(robot);
+}
@@ -0,0 +1,38 @@
+/**
+ * @file test_common.h
+ * @brief Minimal test registry and assertions for smr_tests
+ */
+
+#ifndef SMR_TEST_COMMON_H
+#define SMR_TEST_COMMON_H
+
+#include "smr_welding_api.h"
+#include <cstdio>
+
+typedef void (*TestFunction)();
+
+/// Adds a test to the list test_main.cpp runs
+struct TestRegistrar {
+    TestRegistrar(const char* name, TestFunction fn);
+};
+
+/// Path this test binary was started with (to rerun it in a child process)
+const char* test_executable();
+
+/// Marks the running test as failed
+void test_fail(const char* file, int line, const char* expression);
+
+#define SMR_TEST(name) \
+    static void name(); \
+    static TestRegistrar name##_registrar(#name, name); \
+    static void name()
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            test_fail(__FILE__, __LINE__, #cond); \
+            return; \
+        } \
+    } while (0)
+
+#endif // SMR_TEST_COMMON_H
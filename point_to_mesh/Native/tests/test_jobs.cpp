@@ -0,0 +1,81 @@
+/**
+ * @file test_jobs.cpp
+ * @brief Asynchronous job API tests
+ */
+
+#include "test_common.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+struct CallbackRecord {
+    std::atomic<int> calls{0};
+    std::atomic<int> state{-1};
+    std::atomic<bool> waited{false};
+};
+
+// Waits on and destroys its own job, as a fire-and-forget caller would
+static void destroy_in_callback(JobHandle job, SMRJobState state, void* user_data) {
+    auto* record = static_cast<CallbackRecord*>(user_data);
+    record->waited.store(smr_job_wait(job, -1) == state);
+    smr_job_destroy(job);
+    record->state.store(state);
+    record->calls.fetch_add(1);
+}
+
+SMR_TEST(job_destroy_from_callback_does_not_deadlock) {
+    // 20 x 20 x 20 grid at 1 cm; 5 cm voxels keep one point in 125
+    std::vector<float> points;
+    for (int z = 0; z < 20; ++z)
+        for (int y = 0; y < 20; ++y)
+            for (int x = 0; x < 20; ++x) {
+                points.push_back(x * 0.01f);
+                points.push_back(y * 0.01f);
+                points.push_back(z * 0.01f);
+            }
+    PointCloudHandle cloud = smr_pointcloud_create();
+    CHECK(cloud != nullptr);
+    CHECK(smr_pointcloud_set_points(cloud, points.data(), 8000) == SMR_SUCCESS);
+
+    CallbackRecord record;
+    JobHandle job = smr_job_pointcloud_downsample_voxel(cloud, 0.05f, destroy_in_callback, &record);
+    CHECK(job != nullptr);
+    for (int i = 0; i < 1000 && record.calls.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    CHECK(record.calls.load() == 1);
+    CHECK(record.state.load() == SMR_JOB_COMPLETED);
+    CHECK(record.waited.load());
+    CHECK(smr_pointcloud_get_count(cloud) == 64);
+
+    smr_pointcloud_destroy(cloud);
+}
+
+SMR_TEST(shutdown_joins_threads_and_library_restarts) {
+    std::vector<float> points;
+    for (int i = 0; i < 4000; ++i) {
+        points.push_back((i % 20) * 0.01f);
+        points.push_back((i / 20 % 20) * 0.01f);
+        points.push_back((i / 400) * 0.01f);
+    }
+    PointCloudHandle cloud = smr_pointcloud_create();
+    CHECK(cloud != nullptr);
+    CHECK(smr_pointcloud_set_points(cloud, points.data(), 4000) == SMR_SUCCESS);
+
+    JobHandle job = smr_job_pointcloud_estimate_normals_knn(cloud, 10, nullptr, nullptr);
+    CHECK(job != nullptr);
+    smr_shutdown();
+    // Finished or cancelled, never left pending
+    CHECK(smr_job_get_state(job) >= SMR_JOB_COMPLETED);
+    smr_job_destroy(job);
+
+    // Threads come back on demand
+    job = smr_job_pointcloud_estimate_normals_knn(cloud, 10, nullptr, nullptr);
+    CHECK(job != nullptr);
+    CHECK(smr_job_wait(job, -1) == SMR_JOB_COMPLETED);
+    smr_job_destroy(job);
+    CHECK(smr_pointcloud_has_normals(cloud));
+
+    smr_pointcloud_destroy(cloud);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file test_main.cpp
+ * @brief Runs the registered tests; exit code is the number of failures
+ *
+ * smr_tests [name] runs only the test called `name`.
+ */
+
+#include "test_common.h"
+#include <cstring>
+#include <vector>
+
+struct TestCase {
+    const char* name;
+    TestFunction fn;
+};
+
+static std::vector<TestCase>& registry() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+static bool current_failed = false;
+static const char* executable = "smr_tests";
+
+TestRegistrar::TestRegistrar(const char* name, TestFunction fn) {
+    registry().push_back({name, fn});
+}
+
+const char* test_executable() {
+    return executable;
+}
+
+void test_fail(const char* file, int line, const char* expression) {
+    std::printf("  %s:%d: CHECK(%s) failed\n", file, line, expression);
+    current_failed = true;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 0) executable = argv[0];
+    const char* only = argc > 1 ? argv[1] : nullptr;
+
+    int failures = 0, run = 0;
+    for (const TestCase& test : registry()) {
+        if (only && std::strcmp(test.name, only) != 0) continue;
+        ++run;
+        current_failed = false;
+        test.fn();
+        std::printf("[%s] %s\n", current_failed ? "FAIL" : " OK ", test.name);
+        failures += current_failed ? 1 : 0;
+    }
+    std::printf("%d/%d tests passed\n", run - failures, run);
+    return run > 0 ? failures : 1;
+}
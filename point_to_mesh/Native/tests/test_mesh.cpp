@@ -0,0 +1,181 @@
+/**
+ * @file test_mesh.cpp
+ * @brief Mesh and BVH query tests
+ */
+
+#include "test_common.h"
+#include <cmath>
+#include <vector>
+
+// Small triangles in the x = const plane at geometrically spaced x. SAH splits
+// peel a few triangles off per level here, which used to build a tree deeper
+// than the traversal stack.
+static MeshHandle skewed_mesh(int triangle_count) {
+    std::vector<float> vertices;
+    std::vector<int> indices;
+    for (int i = 0; i < triangle_count; ++i) {
+        float x = static_cast<float>(std::pow(1.01, i) * 1e-3);
+        const float corners[9] = {x, 0.0f, 0.0f, x, 1e-4f, 0.0f, x, 0.0f, 1e-4f};
+        vertices.insert(vertices.end(), corners, corners + 9);
+        for (int c = 0; c < 3; ++c) indices.push_back(i * 3 + c);
+    }
+    return smr_mesh_create_from_arrays(vertices.data(), triangle_count * 3,
+                                       indices.data(), triangle_count);
+}
+
+SMR_TEST(bvh_skewed_mesh_sphere_overlap) {
+    const int n = 3000;
+    MeshHandle mesh = skewed_mesh(n);
+    CHECK(mesh != nullptr);
+
+    const float center[3] = {0.0f, 0.0f, 0.0f};
+    int count = -1;
+    CHECK(smr_mesh_sphere_overlap(mesh, center, 1e30f, nullptr, 0, &count) == SMR_SUCCESS);
+    CHECK(count == n);
+
+    std::vector<int> triangles(n, -1);
+    CHECK(smr_mesh_sphere_overlap(mesh, center, 1e30f, triangles.data(), n, &count) == SMR_SUCCESS);
+    std::vector<bool> seen(n, false);
+    for (int t : triangles) {
+        CHECK(t >= 0 && t < n && !seen[t]);
+        seen[t] = true;
+    }
+    smr_mesh_destroy(mesh);
+}
+
+SMR_TEST(bvh_skewed_mesh_ray_and_closest_point) {
+    MeshHandle mesh = skewed_mesh(3000);
+    CHECK(mesh != nullptr);
+
+    // Along +x the first plane (x = 1e-3) is hit
+    const float origin[3] = {-1.0f, 1e-5f, 1e-5f};
+    const float direction[3] = {1.0f, 0.0f, 0.0f};
+    MeshHit hit;
+    CHECK(smr_mesh_raycast(mesh, origin, direction, 1, 1e30f, &hit) == SMR_SUCCESS);
+    CHECK(hit.triangle == 0);
+    CHECK(std::fabs(hit.distance - 1.001f) < 1e-5f);
+
+    // Far beyond the last triangle the closest one is the last
+    const float far_point[3] = {1e12f, 0.0f, 0.0f};
+    CHECK(smr_mesh_closest_points(mesh, far_point, 1, 1e30f, &hit) == SMR_SUCCESS);
+    CHECK(hit.triangle == 2999);
+    smr_mesh_destroy(mesh);
+}
+
+// Points on a 0.1 m sphere around (5, 0, 0)
+static PointCloudHandle sphere_cloud(int count) {
+    std::vector<float> points;
+    for (int i = 0; i < count; ++i) {
+        // Fibonacci sphere
+        float z = 1.0f - 2.0f * (i + 0.5f) / count;
+        float r = std::sqrt(1.0f - z * z);
+        float phi = 2.39996323f * i;
+        points.push_back(5.0f + 0.1f * r * std::cos(phi));
+        points.push_back(0.1f * r * std::sin(phi));
+        points.push_back(0.1f * z);
+    }
+    PointCloudHandle cloud = smr_pointcloud_create();
+    smr_pointcloud_set_points(cloud, points.data(), count);
+    return cloud;
+}
+
+static bool inside_cloud_bounds(MeshHandle mesh) {
+    std::vector<float> vertices(smr_mesh_get_vertex_count(mesh) * 3);
+    smr_mesh_get_vertices(mesh, vertices.data());
+    for (size_t i = 0; i < vertices.size(); i += 3) {
+        if (std::fabs(vertices[i] - 5.0f) > 0.12f || std::fabs(vertices[i + 1]) > 0.12f ||
+            std::fabs(vertices[i + 2]) > 0.12f) {
+            return false;
+        }
+    }
+    return !vertices.empty();
+}
+
+SMR_TEST(poisson_reconstructs_the_cloud) {
+    PointCloudHandle cloud = sphere_cloud(20000);
+    const PoissonSettings settings = {6, 1.1f, false, 0.0f};
+
+    // Normals are required
+    CHECK(smr_mesh_create_poisson(cloud, &settings) == nullptr);
+
+    CHECK(smr_pointcloud_estimate_normals_knn(cloud, 16) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_orient_normals(cloud, 5.0f, 0.0f, 0.0f) == SMR_SUCCESS);
+    MeshHandle mesh = smr_mesh_create_poisson(cloud, &settings);
+    CHECK(mesh != nullptr);
+    CHECK(inside_cloud_bounds(mesh));
+    smr_mesh_destroy(mesh);
+
+    // The estimate covers the peak of a reconstruction. On one thread the
+    // scratch the first call kept is reused, so only the reconstruction counts.
+    smr_set_thread_count(1);
+    MemoryStats before, after;
+    smr_memory_get_stats(&before);
+    smr_memory_reset_peak();
+    mesh = smr_mesh_create_poisson(cloud, &settings);
+    smr_memory_get_stats(&after);
+    smr_set_thread_count(0);
+    CHECK(mesh != nullptr);
+    CHECK(smr_mesh_estimate_memory(cloud, &settings) >= after.peak_bytes - before.live_bytes);
+    smr_mesh_destroy(mesh);
+
+    JobHandle job = smr_job_mesh_create_poisson(cloud, &settings, nullptr, nullptr);
+    CHECK(smr_job_wait(job, -1) == SMR_JOB_COMPLETED);
+    mesh = smr_job_take_mesh(job);
+    CHECK(mesh != nullptr && inside_cloud_bounds(mesh));
+    smr_mesh_destroy(mesh);
+    smr_job_destroy(job);
+    smr_pointcloud_destroy(cloud);
+}
+
+SMR_TEST(mesh_estimate_covers_every_depth) {
+    PointCloudHandle cloud = sphere_cloud(20000);
+    CHECK(smr_pointcloud_estimate_normals_knn(cloud, 16) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_orient_normals(cloud, 5.0f, 0.0f, 0.0f) == SMR_SUCCESS);
+    const int deepest = 7;
+    PoissonSettings settings = {deepest, 1.1f, false, 0.0f};
+
+    // One pass gives what one call per depth would (plus the finest level's
+    // table, which it holds throughout), and its own peak stays within every
+    // figure
+    long long bytes[deepest];
+    MemoryStats before, after;
+    smr_memory_get_stats(&before);
+    smr_memory_reset_peak();
+    CHECK(smr_mesh_estimate_memory_depths(cloud, &settings, bytes) == SMR_SUCCESS);
+    smr_memory_get_stats(&after);
+    for (int depth = 1; depth <= deepest; ++depth) {
+        CHECK(bytes[depth - 1] >= after.peak_bytes - before.live_bytes);
+        PoissonSettings at_depth = {depth, 1.1f, false, 0.0f};
+        long long single = smr_mesh_estimate_memory(cloud, &at_depth);
+        CHECK(depth == deepest ? single == bytes[depth - 1] : single > 0 && single <= bytes[depth - 1]);
+    }
+
+    long long job_bytes[deepest] = {};
+    JobHandle job = smr_job_mesh_estimate_memory(cloud, &settings, job_bytes, nullptr, nullptr);
+    CHECK(smr_job_wait(job, -1) == SMR_JOB_COMPLETED);
+    CHECK(smr_job_get_result(job) == SMR_SUCCESS);
+    smr_job_destroy(job);
+    for (int depth = 1; depth <= deepest; ++depth) CHECK(job_bytes[depth - 1] == bytes[depth - 1]);
+
+    // Each figure covers the reconstruction at its depth; at the deepest, where
+    // the grid outweighs the table, it does not overshoot much (deepest first,
+    // so the scratch kept by the first call is reused)
+    smr_set_thread_count(1);
+    MeshHandle mesh = smr_mesh_create_poisson(cloud, &settings);
+    CHECK(mesh != nullptr);
+    smr_mesh_destroy(mesh);
+    for (int depth = deepest; depth >= 3; depth -= 2) {
+        PoissonSettings at_depth = {depth, 1.1f, false, 0.0f};
+        smr_memory_get_stats(&before);
+        smr_memory_reset_peak();
+        mesh = smr_mesh_create_poisson(cloud, &at_depth);
+        smr_memory_get_stats(&after);
+        CHECK(mesh != nullptr);
+        long long peak = after.peak_bytes - before.live_bytes;
+        CHECK(bytes[depth - 1] >= peak);
+        if (depth == deepest) CHECK(bytes[depth - 1] <= peak + peak / 10);
+        smr_mesh_destroy(mesh);
+    }
+    smr_set_thread_count(0);
+    smr_pointcloud_destroy(cloud);
+}
@@ -0,0 +1,345 @@
+/**
+ * @file test_path.cpp
+ * @brief Weld path resampling and weave tests
+ */
+
+#include "test_common.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Path through XY points (flat, normals +Z)
+static PathHandle planar_path(const std::vector<float>& xy) {
+    int count = static_cast<int>(xy.size() / 2);
+    std::vector<float> points, normals;
+    for (int i = 0; i < count; ++i) {
+        const float p[3] = {xy[i * 2], xy[i * 2 + 1], 0.0f};
+        const float n[3] = {0.0f, 0.0f, 1.0f};
+        points.insert(points.end(), p, p + 3);
+        normals.insert(normals.end(), n, n + 3);
+    }
+    PathParams params = {};
+    return smr_path_create_from_points(points.data(), normals.data(), count, &params);
+}
+
+static std::vector<WeldPoint> path_points(PathHandle path) {
+    std::vector<WeldPoint> points(smr_path_get_count(path));
+    smr_path_get_points(path, points.data());
+    return points;
+}
+
+// Consecutive samples at least half a minimum step (default 0.5 mm) apart,
+// last sample at the path end
+static bool well_spaced(const std::vector<WeldPoint>& points, float length) {
+    if (points.size() < 2) return false;
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (points[i].arc_length - points[i - 1].arc_length < 0.00025f) return false;
+    }
+    return std::fabs(points.back().arc_length - length) < 1e-6f;
+}
+
+SMR_TEST(adaptive_resample_straight_seam_has_no_sliver) {
+    std::vector<float> xy;
+    for (int i = 0; i <= 100; ++i) {
+        xy.push_back(i * 0.001f);
+        xy.push_back(0.0f);
+    }
+    PathHandle path = planar_path(xy);
+    CHECK(path != nullptr);
+    CHECK(smr_path_resample_adaptive(path, nullptr) == SMR_SUCCESS);
+
+    // 100 mm at the 20 mm default max step
+    std::vector<WeldPoint> points = path_points(path);
+    CHECK(points.size() == 6);
+    CHECK(well_spaced(points, smr_path_get_length(path)));
+    smr_path_destroy(path);
+}
+
+SMR_TEST(adaptive_resample_short_tail_after_turn) {
+    // 100 mm straight, then a 90 degree turn into a 0.7 mm tail
+    std::vector<float> xy;
+    for (int i = 0; i <= 100; ++i) {
+        xy.push_back(i * 0.001f);
+        xy.push_back(0.0f);
+    }
+    xy.push_back(0.1f);
+    xy.push_back(0.0007f);
+    PathHandle path = planar_path(xy);
+    CHECK(path != nullptr);
+    CHECK(smr_path_resample_adaptive(path, nullptr) == SMR_SUCCESS);
+    CHECK(well_spaced(path_points(path), smr_path_get_length(path)));
+    smr_path_destroy(path);
+}
+
+SMR_TEST(adaptive_resample_corner_shorter_than_min_steps) {
+    PathHandle path = planar_path({0.0f, 0.0f, 0.001f, 0.0f, 0.001f, 0.001f});
+    CHECK(path != nullptr);
+    CHECK(smr_path_resample_adaptive(path, nullptr) == SMR_SUCCESS);
+    CHECK(well_spaced(path_points(path), smr_path_get_length(path)));
+    smr_path_destroy(path);
+}
+
+SMR_TEST(adaptive_resample_keeps_chord_tolerance_on_a_bend) {
+    // 50 mm straight into a quarter turn of radius 10 mm
+    std::vector<float> xy;
+    for (int i = 0; i < 10; ++i) {
+        xy.push_back(i * 0.005f);
+        xy.push_back(0.0f);
+    }
+    for (int i = 0; i <= 16; ++i) {
+        float a = static_cast<float>(M_PI) * 0.5f * i / 16;
+        xy.push_back(0.05f + 0.01f * std::sin(a));
+        xy.push_back(0.01f - 0.01f * std::cos(a));
+    }
+    PathHandle path = planar_path(xy);
+    AdaptiveResampleSettings settings = {};
+    settings.chord_tolerance = 0.0001f;
+    CHECK(smr_path_resample_adaptive(path, &settings) == SMR_SUCCESS);
+    std::vector<WeldPoint> points = path_points(path);
+    CHECK(well_spaced(points, smr_path_get_length(path)));
+
+    // The spline midway between samples stays within tolerance of the chord
+    float straight_step = 0.0f, bend_step = 1.0f;
+    for (size_t i = 1; i < points.size(); ++i) {
+        const float* a = points[i - 1].position;
+        const float* b = points[i].position;
+        float mid_arc = 0.5f * (points[i - 1].arc_length + points[i].arc_length);
+        WeldPoint mid;
+        CHECK(smr_path_evaluate(path, &mid_arc, 1, &mid) == SMR_SUCCESS);
+        float chord[2] = {b[0] - a[0], b[1] - a[1]};
+        float len = std::hypot(chord[0], chord[1]);
+        float off = std::fabs(chord[0] * (mid.position[1] - a[1]) - chord[1] * (mid.position[0] - a[0])) / len;
+        CHECK(off < 1.05f * settings.chord_tolerance);
+
+        float step = points[i].arc_length - points[i - 1].arc_length;
+        if (b[0] < 0.045f) straight_step = std::max(straight_step, step);
+        if (a[0] > 0.05f) bend_step = std::min(bend_step, step);
+    }
+    CHECK(straight_step > 2.0f * bend_step);
+    CHECK(points.size() < 30);
+    smr_path_destroy(path);
+}
+
+SMR_TEST(weave_rejects_unbounded_sample_count) {
+    // 100 m seam at 1 mm/s and 1 kHz would need ~6.4e9 samples
+    PathHandle path = planar_path({0.0f, 0.0f, 100.0f, 0.0f});
+    CHECK(path != nullptr);
+    WeaveSettings weave = {};
+    weave.type = WEAVE_ZIGZAG;
+    weave.frequency = 1000.0f;
+    weave.travel_speed = 0.001f;
+    weave.samples_per_cycle = 64;
+    CHECK(smr_path_apply_weave_ex(path, &weave, nullptr, 0) == SMR_ERROR_INVALID_PARAMETER);
+    CHECK(smr_path_get_count(path) == 2);
+
+    // Defaults on a 100 mm seam stay well under the cap
+    PathHandle seam = planar_path({0.0f, 0.0f, 0.1f, 0.0f});
+    CHECK(seam != nullptr);
+    weave = WeaveSettings{};
+    weave.type = WEAVE_ZIGZAG;
+    CHECK(smr_path_apply_weave_ex(seam, &weave, nullptr, 0) == SMR_SUCCESS);
+    CHECK(smr_path_get_count(seam) > 2);
+    smr_path_destroy(seam);
+    smr_path_destroy(path);
+}
+
+SMR_TEST(projection_snaps_points_onto_a_sloped_surface) {
+    // Plane z = 0.2 x, wound so its normal points up
+    const float vertices[12] = {-0.1f, -0.5f, -0.02f, 1.1f, -0.5f, 0.22f,
+                                1.1f, 0.5f, 0.22f, -0.1f, 0.5f, -0.02f};
+    const int indices[6] = {0, 1, 2, 0, 2, 3};
+    MeshHandle mesh = smr_mesh_create_from_arrays(vertices, 4, indices, 2);
+
+    // 4 mm above the plane with vertical normals; the last point is 10 cm
+    // above, beyond the default 2 cm search distance
+    const int count = 21;
+    const float height = 0.004f;
+    std::vector<float> points, normals;
+    for (int i = 0; i < count; ++i) {
+        float x = 0.05f * i;
+        const float p[3] = {x, 0.1f, 0.2f * x + (i == count - 1 ? 0.1f : height)};
+        const float n[3] = {0.0f, 0.0f, 1.0f};
+        points.insert(points.end(), p, p + 3);
+        normals.insert(normals.end(), n, n + 3);
+    }
+    PathParams params = {};
+    PathHandle path = smr_path_create_from_points(points.data(), normals.data(), count, &params);
+    CHECK(mesh && path);
+
+    int projected = -1;
+    CHECK(smr_path_project_to_mesh(path, mesh, nullptr, &projected) == SMR_SUCCESS);
+    CHECK(projected == count - 1);
+
+    std::vector<WeldPoint> result = path_points(path);
+    const float slope_normal[3] = {-0.2f / std::sqrt(1.04f), 0.0f, 1.0f / std::sqrt(1.04f)};
+    for (int i = 0; i < count - 1; ++i) {
+        const WeldPoint& p = result[i];
+        CHECK(std::fabs(p.position[2] - 0.2f * p.position[0]) < 1e-5f);
+        float moved = std::sqrt(std::pow(p.position[0] - points[i * 3], 2.0f) +
+                                std::pow(p.position[1] - points[i * 3 + 1], 2.0f) +
+                                std::pow(p.position[2] - points[i * 3 + 2], 2.0f));
+        CHECK(std::fabs(moved - height / std::sqrt(1.04f)) < 1e-5f);
+        for (int k = 0; k < 3; ++k) CHECK(std::fabs(p.normal[k] - slope_normal[k]) < 1e-4f);
+        if (i > 0) CHECK(p.arc_length > result[i - 1].arc_length);
+    }
+    CHECK(result[count - 1].position[2] == points[(count - 1) * 3 + 2]);
+
+    smr_path_destroy(path);
+    smr_mesh_destroy(mesh);
+}
+
+// Deterministic noise in [-amplitude, amplitude]
+static float sample_noise(int i, float amplitude) {
+    return amplitude * (static_cast<float>((i * 7919) % 101) / 50.0f - 1.0f);
+}
+
+SMR_TEST(moving_average_matches_the_direct_window_sums) {
+    const int count = 500, window = 21;
+    std::vector<float> xy;
+    for (int i = 0; i < count; ++i) {
+        xy.push_back(0.001f * i);
+        xy.push_back(sample_noise(i, 0.0005f));
+    }
+    PathHandle path = planar_path(xy);
+    CHECK(smr_path_smooth(path, window) == SMR_SUCCESS);
+    std::vector<WeldPoint> result = path_points(path);
+
+    // Window shrinks symmetrically toward the ends
+    for (int i = 0; i < count; ++i) {
+        int h = std::min(window / 2, std::min(i, count - 1 - i));
+        double sum[2] = {0.0, 0.0};
+        for (int j = i - h; j <= i + h; ++j) {
+            sum[0] += xy[j * 2];
+            sum[1] += xy[j * 2 + 1];
+        }
+        CHECK(std::fabs(result[i].position[0] - sum[0] / (2 * h + 1)) < 1e-6f);
+        CHECK(std::fabs(result[i].position[1] - sum[1] / (2 * h + 1)) < 1e-6f);
+    }
+    smr_path_destroy(path);
+}
+
+SMR_TEST(smoothing_filters_keep_ends_and_corners) {
+    // L-shaped seam with a clean corner at sample `corner`, noise across each leg
+    const int corner = 250, count = 501;
+    std::vector<float> xy;
+    for (int i = 0; i < count; ++i) {
+        float along = 0.001f * std::min(i, corner);
+        float noise = (i == 0 || i == corner || i == count - 1) ? 0.0f : sample_noise(i, 0.0005f);
+        if (i <= corner) {
+            xy.push_back(along);
+            xy.push_back(noise);
+        } else {
+            xy.push_back(0.001f * corner + noise);
+            xy.push_back(0.001f * (i - corner));
+        }
+    }
+    auto deviation = [&](const std::vector<WeldPoint>& points) {
+        double sum = 0.0;
+        for (int i = 0; i < count; ++i) {
+            float d = (i <= corner) ? points[i].position[1] : points[i].position[0] - 0.001f * corner;
+            sum += d * d;
+        }
+        return std::sqrt(sum / count);
+    };
+
+    const SmoothingMethod methods[3] = {SMOOTH_MOVING_AVERAGE, SMOOTH_SAVITZKY_GOLAY, SMOOTH_BSPLINE};
+    for (SmoothingMethod method : methods) {
+        PathHandle path = planar_path(xy);
+        double before = deviation(path_points(path));
+        SmoothingSettings settings = {};
+        settings.method = method;
+        settings.window_size = 15;
+        CHECK(smr_path_smooth_ex(path, &settings) == SMR_SUCCESS);
+
+        std::vector<WeldPoint> result = path_points(path);
+        CHECK(static_cast<int>(result.size()) == count);
+        const int fixed[3] = {0, corner, count - 1};
+        for (int i : fixed) {
+            CHECK(result[i].position[0] == xy[i * 2]);
+            CHECK(result[i].position[1] == xy[i * 2 + 1]);
+        }
+        CHECK(deviation(result) < 0.5 * before);
+        smr_path_destroy(path);
+    }
+}
+
+SMR_TEST(spline_resampling_does_not_compound) {
+    // Coarse quarter circle, radius 0.1
+    std::vector<float> xy;
+    for (int i = 0; i <= 8; ++i) {
+        float a = static_cast<float>(M_PI) * 0.5f * i / 8;
+        xy.push_back(0.1f * std::cos(a));
+        xy.push_back(0.1f * std::sin(a));
+    }
+    PathHandle direct = planar_path(xy);
+    PathHandle repeated = planar_path(xy);
+    CHECK(smr_path_resample(direct, 0.002f) == SMR_SUCCESS);
+    CHECK(smr_path_resample(repeated, 0.01f) == SMR_SUCCESS);
+    CHECK(smr_path_resample(repeated, 0.0005f) == SMR_SUCCESS);
+    CHECK(smr_path_resample(repeated, 0.002f) == SMR_SUCCESS);
+
+    std::vector<WeldPoint> a = path_points(direct), b = path_points(repeated);
+    CHECK(a.size() == b.size() && a.size() > 70);
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+        for (int k = 0; k < 3; ++k) CHECK(std::fabs(a[i].position[k] - b[i].position[k]) < 1e-6f);
+        float r = std::hypot(a[i].position[0], a[i].position[1]);
+        CHECK(std::fabs(r - 0.1f) < 2e-4f);
+        CHECK(std::fabs(a[i].normal[2] - 1.0f) < 1e-5f);
+    }
+    CHECK(std::fabs(smr_path_get_length(direct) - 0.05f * static_cast<float>(M_PI)) < 1e-4f);
+
+    // Evaluation at the sample arc lengths reproduces the samples
+    std::vector<float> arc_lengths;
+    for (const WeldPoint& p : a) arc_lengths.push_back(p.arc_length);
+    arc_lengths.push_back(-1.0f);   // Clamped to the start
+    std::vector<WeldPoint> evaluated(arc_lengths.size());
+    CHECK(smr_path_evaluate(repeated, arc_lengths.data(), static_cast<int>(arc_lengths.size()),
+                            evaluated.data()) == SMR_SUCCESS);
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (int k = 0; k < 3; ++k) CHECK(std::fabs(evaluated[i].position[k] - a[i].position[k]) < 1e-5f);
+    }
+    CHECK(std::fabs(evaluated.back().position[0] - 0.1f) < 1e-6f);
+    CHECK(std::fabs(evaluated.back().position[1]) < 1e-6f);
+
+    smr_path_destroy(direct);
+    smr_path_destroy(repeated);
+}
+
+SMR_TEST(weave_samples_every_cycle_alike_from_a_coarse_path) {
+    // 10 cm seam given by its two ends: 20 cycles at 16 samples each
+    WeaveSettings settings = {};
+    settings.type = WEAVE_ZIGZAG;
+    settings.amplitude = 0.002f;
+    settings.frequency = 2.0f;
+    settings.travel_speed = 0.01f;
+    settings.samples_per_cycle = 16;
+    const float step = 0.01f / 2.0f / 16;
+    PathHandle zigzag = planar_path({0.0f, 0.0f, 0.1f, 0.0f});
+    CHECK(smr_path_apply_weave_ex(zigzag, &settings, nullptr, 0) == SMR_SUCCESS);
+    std::vector<WeldPoint> woven = path_points(zigzag);
+    CHECK(woven.size() == 321);
+
+    // Lateral offset along -y (tangent x normal): -1 at phase 0, +1 at phase 0.5
+    for (size_t i = 0; i < woven.size(); ++i) {
+        CHECK(std::fabs(woven[i].arc_length - step * i) < 1e-6f);
+        float phase = std::fmod(static_cast<float>(i), 16.0f) / 16.0f;
+        float wave = 1.0f - 4.0f * std::fabs(phase - 0.5f);
+        CHECK(std::fabs(woven[i].position[1] + settings.amplitude * wave) < 1e-6f);
+        CHECK(std::fabs(woven[i].position[0] - step * i) < 1e-6f);
+        CHECK(woven[i].position[2] == 0.0f);
+    }
+
+    // A user profile through the same corners reproduces the built-in wave
+    const float profile[8] = {-1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f};
+    settings.type = WEAVE_CUSTOM;
+    PathHandle custom = planar_path({0.0f, 0.0f, 0.1f, 0.0f});
+    CHECK(smr_path_apply_weave_ex(custom, &settings, profile, 4) == SMR_SUCCESS);
+    std::vector<WeldPoint> custom_woven = path_points(custom);
+    CHECK(custom_woven.size() == woven.size());
+    for (size_t i = 0; i < woven.size() && i < custom_woven.size(); ++i) {
+        for (int k = 0; k < 3; ++k) CHECK(std::fabs(custom_woven[i].position[k] - woven[i].position[k]) < 1e-6f);
+    }
+
+    smr_path_destroy(zigzag);
+    smr_path_destroy(custom);
+}
@@ -0,0 +1,174 @@
+/**
+ * @file test_path_set.cpp
+ * @brief Multi-seam path set and weld sequencing tests
+ */
+
+#include "test_common.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Wavy seam along x at height y, within reach of a UR5
+static void wavy_seam(int count, float y, std::vector<float>& points, std::vector<float>& normals) {
+    points.clear();
+    normals.clear();
+    for (int i = 0; i < count; ++i) {
+        float x = 0.35f + 0.2f * i / (count - 1);
+        const float p[3] = {x, y + 0.01f * std::sin(40.0f * x), 0.0f};
+        const float n[3] = {0.0f, 0.0f, 1.0f};
+        points.insert(points.end(), p, p + 3);
+        normals.insert(normals.end(), n, n + 3);
+    }
+}
+
+static bool same_points(const WeldPoint* a, const WeldPoint* b, int count) {
+    for (int i = 0; i < count; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            if (a[i].position[k] != b[i].position[k] || a[i].normal[k] != b[i].normal[k]) return false;
+        }
+        if (a[i].arc_length != b[i].arc_length) return false;
+    }
+    return true;
+}
+
+SMR_TEST(path_set_batch_operations_match_single_paths) {
+    const int counts[3] = {40, 7, 120};
+    const float ys[3] = {-0.15f, 0.0f, 0.15f};
+    PathSetHandle set = smr_path_set_create(3);
+    PathHandle paths[3];
+    PathParams params = {};
+    for (int s = 0; s < 3; ++s) {
+        std::vector<float> points, normals;
+        wavy_seam(counts[s], ys[s], points, normals);
+        int seam = -1;
+        CHECK(smr_path_set_add_seam(set, points.data(), normals.data(), counts[s], &seam) == SMR_SUCCESS);
+        CHECK(seam == s);
+        paths[s] = smr_path_create_from_points(points.data(), normals.data(), counts[s], &params);
+    }
+    CHECK(smr_path_set_get_seam_count(set) == 3);
+
+    SmoothingSettings smoothing = {};
+    smoothing.method = SMOOTH_SAVITZKY_GOLAY;
+    WeaveSettings weave = {};
+    weave.type = WEAVE_ZIGZAG;
+    CHECK(smr_path_set_resample(set, 0.004f) == SMR_SUCCESS);
+    CHECK(smr_path_set_smooth(set, &smoothing) == SMR_SUCCESS);
+    CHECK(smr_path_set_apply_weave(set, &weave, nullptr, 0) == SMR_SUCCESS);
+    for (int s = 0; s < 3; ++s) {
+        CHECK(smr_path_resample(paths[s], 0.004f) == SMR_SUCCESS);
+        CHECK(smr_path_smooth_ex(paths[s], &smoothing) == SMR_SUCCESS);
+        CHECK(smr_path_apply_weave_ex(paths[s], &weave, nullptr, 0) == SMR_SUCCESS);
+    }
+
+    // Offsets delimit each seam's copy of the single-path result
+    int total = smr_path_set_get_count(set);
+    std::vector<int> offsets(4);
+    CHECK(smr_path_set_get_offsets(set, offsets.data()) == SMR_SUCCESS);
+    CHECK(offsets[0] == 0 && offsets[3] == total);
+    std::vector<WeldPoint> all(total);
+    CHECK(smr_path_set_get_points(set, all.data()) == SMR_SUCCESS);
+    for (int s = 0; s < 3; ++s) {
+        int count = smr_path_get_count(paths[s]);
+        CHECK(offsets[s + 1] - offsets[s] == count);
+        std::vector<WeldPoint> single(count);
+        smr_path_get_points(paths[s], single.data());
+        CHECK(same_points(&all[offsets[s]], single.data(), count));
+        std::vector<WeldPoint> seam(count);
+        CHECK(smr_path_set_get_seam_points(set, s, seam.data()) == SMR_SUCCESS);
+        CHECK(same_points(seam.data(), single.data(), count));
+    }
+
+    // The SoA copy holds the same values
+    std::vector<float> positions(total * 3), arc_lengths(total);
+    CHECK(smr_path_set_get_arrays(set, positions.data(), nullptr, nullptr, arc_lengths.data()) == SMR_SUCCESS);
+    for (int i = 0; i < total; ++i) {
+        for (int k = 0; k < 3; ++k) CHECK(positions[i * 3 + k] == all[i].position[k]);
+        CHECK(arc_lengths[i] == all[i].arc_length);
+    }
+
+    // Batch IK matches per-path IK
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    std::vector<double> joints(total * 6);
+    std::vector<char> reachable(total);
+    CHECK(smr_path_set_to_joints(set, robot, 0.015f, nullptr, nullptr, joints.data(),
+                                 reinterpret_cast<bool*>(reachable.data()), nullptr) == SMR_SUCCESS);
+    for (int s = 0; s < 3; ++s) {
+        int count = smr_path_get_count(paths[s]);
+        std::vector<double> single(count * 6);
+        std::vector<char> single_reachable(count);
+        CHECK(smr_path_to_joints_ex(paths[s], robot, 0.015f, nullptr, nullptr, single.data(),
+                                    reinterpret_cast<bool*>(single_reachable.data()), nullptr) == SMR_SUCCESS);
+        for (int i = 0; i < count; ++i) {
+            CHECK(reachable[offsets[s] + i] == single_reachable[i]);
+            for (int j = 0; j < 6; ++j) CHECK(std::fabs(joints[(offsets[s] + i) * 6 + j] - single[i * 6 + j]) < 1e-6);
+        }
+    }
+
+    smr_robot_destroy(robot);
+    for (PathHandle path : paths) smr_path_destroy(path);
+    smr_path_set_destroy(set);
+}
+
+SMR_TEST(sequence_visits_every_seam_once_and_reorder_applies_it) {
+    // Six pieces of one line, stored shuffled and in alternating directions;
+    // the cheapest tour sweeps along the line
+    const int num_seams = 6, count = 9;
+    const int piece_of_seam[num_seams] = {3, 0, 5, 1, 4, 2};
+    PathSetHandle set = smr_path_set_create(1);
+    std::vector<std::vector<WeldPoint>> originals;
+    for (int s = 0; s < num_seams; ++s) {
+        float start = 0.30f + 0.05f * piece_of_seam[s];
+        std::vector<float> points, normals;
+        for (int i = 0; i < count; ++i) {
+            float t = static_cast<float>(s % 2 ? count - 1 - i : i) / (count - 1);
+            const float p[3] = {start + 0.04f * t, 0.1f, 0.0f};
+            const float n[3] = {0.0f, 0.0f, 1.0f};
+            points.insert(points.end(), p, p + 3);
+            normals.insert(normals.end(), n, n + 3);
+        }
+        CHECK(smr_path_set_add_seam(set, points.data(), normals.data(), count, nullptr) == SMR_SUCCESS);
+        originals.emplace_back(count);
+        smr_path_set_get_seam_points(set, s, originals.back().data());
+    }
+
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    int order[num_seams];
+    bool reversed[num_seams];
+    double cost = -1.0;
+    CHECK(smr_path_set_optimize_sequence(set, robot, 0.015f, nullptr, nullptr, order, reversed,
+                                         &cost) == SMR_SUCCESS);
+    CHECK(cost > 0.0);
+
+    std::vector<int> visits(num_seams, 0);
+    for (int k = 0; k < num_seams; ++k) {
+        CHECK(order[k] >= 0 && order[k] < num_seams);
+        if (order[k] >= 0 && order[k] < num_seams) ++visits[order[k]];
+    }
+    for (int v : visits) CHECK(v == 1);
+
+    // Reordered seams are the originals, reversed where flagged
+    CHECK(smr_path_set_reorder(set, order, reversed) == SMR_SUCCESS);
+    CHECK(smr_path_set_get_count(set) == num_seams * count);
+    std::vector<WeldPoint> prev_seam;
+    for (int k = 0; k < num_seams; ++k) {
+        std::vector<WeldPoint> seam(count);
+        CHECK(smr_path_set_get_seam_points(set, k, seam.data()) == SMR_SUCCESS);
+        const std::vector<WeldPoint>& original = originals[order[k]];
+        for (int i = 0; i < count; ++i) {
+            const WeldPoint& expected = original[reversed[k] ? count - 1 - i : i];
+            for (int c = 0; c < 3; ++c) {
+                CHECK(seam[i].position[c] == expected.position[c]);
+                CHECK(seam[i].tangent[c] == (reversed[k] ? -expected.tangent[c] : expected.tangent[c]));
+            }
+        }
+        CHECK(seam[0].arc_length == 0.0f);
+        CHECK(std::fabs(seam[count - 1].arc_length - 0.04f) < 1e-5f);
+
+        // Sweep: each seam starts at the gap after the previous one ends
+        if (k > 0) CHECK(std::fabs(seam[0].position[0] - prev_seam[count - 1].position[0]) < 0.0101f);
+        prev_seam = seam;
+    }
+
+    smr_robot_destroy(robot);
+    smr_path_set_destroy(set);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file test_pipeline.cpp
+ * @brief Scan-to-trajectory pipeline tests
+ */
+
+#include "test_common.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+static const char* SCAN_FILE = "smr_test_scan.ply";
+
+// ASCII PLY of a 10 cm sphere around the origin (the default view point),
+// with a few far-off stray points
+static int write_sphere_scan(const char* path) {
+    const int sphere_points = 20000;
+    std::vector<float> xyz;
+    for (int i = 0; i < sphere_points; ++i) {
+        float z = 1.0f - 2.0f * (i + 0.5f) / sphere_points;
+        float r = std::sqrt(1.0f - z * z);
+        float phi = 2.39996323f * i;
+        const float p[3] = {0.1f * r * std::cos(phi), 0.1f * r * std::sin(phi), 0.1f * z};
+        xyz.insert(xyz.end(), p, p + 3);
+    }
+    for (int k = 0; k < 5; ++k) {
+        const float p[3] = {0.3f, 0.05f * k - 0.1f, 0.02f * k};
+        xyz.insert(xyz.end(), p, p + 3);
+    }
+    int count = static_cast<int>(xyz.size() / 3);
+
+    std::ofstream file(path);
+    file << "ply\nformat ascii 1.0\nelement vertex " << count
+         << "\nproperty float x\nproperty float y\nproperty float z\nend_header\n";
+    for (int i = 0; i < count; ++i) {
+        file << xyz[i * 3] << ' ' << xyz[i * 3 + 1] << ' ' << xyz[i * 3 + 2] << '\n';
+    }
+    return count;
+}
+
+SMR_TEST(pipeline_runs_scan_to_trajectory) {
+    int file_points = write_sphere_scan(SCAN_FILE);
+
+    PipelineSettings settings = {};
+    settings.poisson.depth = 6;
+    settings.block_points = 4096;   // Many blocks: reading overlaps downsampling
+    PipelineHandle pipeline = smr_pipeline_create(&settings);
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    CHECK(pipeline && robot);
+
+    CHECK(smr_pipeline_run(pipeline, "smr_test_missing_scan.ply", robot) == SMR_ERROR_FILE_NOT_FOUND);
+    CHECK(smr_pipeline_run(pipeline, SCAN_FILE, robot) == SMR_SUCCESS);
+
+    double stage_ms[SMR_STAGE_COUNT];
+    CHECK(smr_pipeline_get_stage_times(pipeline, stage_ms) == SMR_SUCCESS);
+    for (double ms : stage_ms) CHECK(ms > 0.0);
+
+    // Same cloud as the one-call-per-stage flow
+    PointCloudHandle reference = smr_pointcloud_create();
+    CHECK(smr_pointcloud_load_ply(reference, SCAN_FILE) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_get_count(reference) == file_points);
+    CHECK(smr_pointcloud_downsample_voxel(reference, 0.002f) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_remove_outliers(reference, 20, 2.0f) == SMR_SUCCESS);
+    PointCloudHandle cloud = smr_pipeline_get_pointcloud(pipeline);
+    int count = smr_pointcloud_get_count(cloud);
+    CHECK(count == smr_pointcloud_get_count(reference));
+    CHECK(count > 0 && count < file_points);
+    CHECK(smr_pointcloud_has_normals(cloud));
+    smr_pointcloud_destroy(reference);
+
+    // Strays are gone; normals face the view point at the centre
+    std::vector<float> points(count * 3), normals(count * 3);
+    CHECK(smr_pointcloud_get_points(cloud, points.data()) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_get_normals(cloud, normals.data()) == SMR_SUCCESS);
+    for (int i = 0; i < count; ++i) {
+        const float* p = &points[i * 3];
+        const float* n = &normals[i * 3];
+        float radius = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        CHECK(std::fabs(radius - 0.1f) < 0.002f);
+        CHECK(p[0] * n[0] + p[1] * n[1] + p[2] * n[2] < 0.0f);
+    }
+
+    MeshHandle mesh = smr_pipeline_get_mesh(pipeline);
+    CHECK(mesh && smr_mesh_get_triangle_count(mesh) > 0);
+    PathHandle path = smr_pipeline_get_path(pipeline);
+    int path_count = smr_path_get_count(path);
+    CHECK(path_count > 0);
+    CHECK(smr_pipeline_get_joint_count(pipeline) == path_count);
+    std::vector<double> joints(path_count * 6);
+    CHECK(smr_pipeline_get_joints(pipeline, joints.data(), nullptr) == SMR_SUCCESS);
+    for (double q : joints) CHECK(std::isfinite(q));
+
+    // A second run reuses the pipeline's buffers and gives the same result
+    long long bytes = smr_pipeline_get_memory(pipeline);
+    CHECK(smr_pipeline_run(pipeline, SCAN_FILE, robot) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_get_count(smr_pipeline_get_pointcloud(pipeline)) == count);
+    CHECK(smr_pipeline_get_joint_count(pipeline) == path_count);
+    CHECK(smr_pipeline_get_memory(pipeline) <= bytes);
+
+    // Without a robot the run stops after the path
+    CHECK(smr_pipeline_run(pipeline, SCAN_FILE, nullptr) == SMR_SUCCESS);
+    CHECK(smr_pipeline_get_stage_times(pipeline, stage_ms) == SMR_SUCCESS);
+    CHECK(stage_ms[SMR_STAGE_PATH] > 0.0 && stage_ms[SMR_STAGE_TRAJECTORY] == 0.0);
+    CHECK(smr_pipeline_get_joint_count(pipeline) == 0);
+
+    std::remove(SCAN_FILE);
+    smr_robot_destroy(robot);
+    smr_pipeline_destroy(pipeline);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file test_pointcloud.cpp
+ * @brief Point cloud storage, filter and memory tests
+ */
+
+#include "test_common.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static const char* CLOUD_FILE = "smr_test_cloud.ply";
+
+// side^3 grid at 1 cm spacing
+static PointCloudHandle grid_cloud(int side) {
+    std::vector<float> points;
+    for (int z = 0; z < side; ++z)
+        for (int y = 0; y < side; ++y)
+            for (int x = 0; x < side; ++x) {
+                points.push_back(x * 0.01f);
+                points.push_back(y * 0.01f);
+                points.push_back(z * 0.01f);
+            }
+    PointCloudHandle cloud = smr_pointcloud_create();
+    smr_pointcloud_set_points(cloud, points.data(), side * side * side);
+    return cloud;
+}
+
+SMR_TEST(shrinking_filters_release_replaced_arrays) {
+    PointCloudHandle cloud = grid_cloud(20);
+    CHECK(smr_pointcloud_estimate_normals_knn(cloud, 8) == SMR_SUCCESS);
+    long long full = smr_pointcloud_get_memory(cloud);
+
+    // 5 cm voxels keep one point in 125: the 8000-point arrays it replaced
+    // are not kept alongside the 64-point ones
+    CHECK(smr_pointcloud_downsample_voxel(cloud, 0.05f) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_get_count(cloud) == 64);
+    long long downsampled = smr_pointcloud_get_memory(cloud);
+    CHECK(downsampled * 20 < full);
+
+    // Same-size filters keep one spare, counted until trimmed
+    int permutation[64];
+    CHECK(smr_pointcloud_sort_spatial(cloud, permutation) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_sort_spatial(cloud, permutation) == SMR_SUCCESS);
+    long long sorted = smr_pointcloud_get_memory(cloud);
+    CHECK(smr_pointcloud_trim_memory(cloud) == SMR_SUCCESS);
+    long long trimmed = smr_pointcloud_get_memory(cloud);
+    CHECK(trimmed < sorted && trimmed <= downsampled);
+    CHECK(sorted - trimmed <= trimmed / 2);
+    CHECK(smr_pointcloud_trim_memory(nullptr) == SMR_ERROR_INVALID_HANDLE);
+    smr_pointcloud_destroy(cloud);
+}
+
+// Scattered points with unit normals; 1001 is not a multiple of any SIMD width
+static void scattered_points(int count, std::vector<float>& points, std::vector<float>& normals) {
+    points.clear();
+    normals.clear();
+    for (int i = 0; i < count; ++i) {
+        float t = static_cast<float>((i * 7919) % count) / count;
+        const float p[3] = {std::sin(37.0f * t) * 0.3f, 1e-7f * i - 0.2f, 12.5f * t * t};
+        float len = std::sqrt(1.0f + t * t + 4.0f * t);
+        const float n[3] = {t / len, -2.0f * std::sqrt(t) / len, 1.0f / len};
+        points.insert(points.end(), p, p + 3);
+        normals.insert(normals.end(), n, n + 3);
+    }
+}
+
+static void write_ply(const char* path, const std::vector<float>& points, const std::vector<float>& normals) {
+    FILE* file = std::fopen(path, "w");
+    int count = static_cast<int>(points.size() / 3);
+    std::fprintf(file, "ply\nformat ascii 1.0\nelement vertex %d\n"
+                       "property float x\nproperty float y\nproperty float z\n"
+                       "property float nx\nproperty float ny\nproperty float nz\nend_header\n", count);
+    for (int i = 0; i < count; ++i) {
+        const float* p = &points[i * 3];
+        const float* n = &normals[i * 3];
+        std::fprintf(file, "%.9g %.9g %.9g %.9g %.9g %.9g\n", p[0], p[1], p[2], n[0], n[1], n[2]);
+    }
+    std::fclose(file);
+}
+
+SMR_TEST(point_storage_round_trips_interleaved_arrays) {
+    const int count = 1001;
+    std::vector<float> points, normals;
+    scattered_points(count, points, normals);
+
+    // Interleaved in, interleaved out, bit for bit
+    PointCloudHandle cloud = smr_pointcloud_create();
+    CHECK(smr_pointcloud_set_points(cloud, points.data(), count) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_get_count(cloud) == count);
+    CHECK(!smr_pointcloud_has_normals(cloud));
+    std::vector<float> out(count * 3);
+    CHECK(smr_pointcloud_get_points(cloud, out.data()) == SMR_SUCCESS);
+    CHECK(std::memcmp(out.data(), points.data(), out.size() * sizeof(float)) == 0);
+    smr_pointcloud_destroy(cloud);
+
+    // Normals read from a file travel the same way
+    write_ply(CLOUD_FILE, points, normals);
+    cloud = smr_pointcloud_create();
+    CHECK(smr_pointcloud_load_ply(cloud, CLOUD_FILE) == SMR_SUCCESS);
+    std::remove(CLOUD_FILE);
+    CHECK(smr_pointcloud_get_count(cloud) == count && smr_pointcloud_has_normals(cloud));
+    CHECK(smr_pointcloud_get_points(cloud, out.data()) == SMR_SUCCESS);
+    CHECK(std::memcmp(out.data(), points.data(), out.size() * sizeof(float)) == 0);
+    CHECK(smr_pointcloud_get_normals(cloud, out.data()) == SMR_SUCCESS);
+    CHECK(std::memcmp(out.data(), normals.data(), out.size() * sizeof(float)) == 0);
+    smr_pointcloud_destroy(cloud);
+}
+
+SMR_TEST(normals_point_across_a_plane) {
+    // Plane x = 0.05, sampled on a staggered 33 x 31 grid (no multiple of any SIMD width)
+    std::vector<float> points;
+    for (int k = 0; k < 31; ++k) {
+        for (int j = 0; j < 33; ++j) {
+            points.push_back(0.05f);
+            points.push_back(0.002f * j);
+            points.push_back(0.002f * k + 0.0003f * (j % 3));
+        }
+    }
+    int count = static_cast<int>(points.size() / 3);
+    PointCloudHandle cloud = smr_pointcloud_create();
+    smr_pointcloud_set_points(cloud, points.data(), count);
+    CHECK(smr_pointcloud_estimate_normals_knn(cloud, 11) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_has_normals(cloud));
+
+    std::vector<float> normals(count * 3);
+    CHECK(smr_pointcloud_get_normals(cloud, normals.data()) == SMR_SUCCESS);
+    for (int i = 0; i < count; ++i) {
+        CHECK(std::fabs(normals[i * 3]) == 1.0f);
+        CHECK(normals[i * 3 + 1] == 0.0f && normals[i * 3 + 2] == 0.0f);
+    }
+    smr_pointcloud_destroy(cloud);
+}
+
+SMR_TEST(spatial_sort_permutation_maps_back_to_the_input) {
+    const int count = 1001;
+    std::vector<float> points, normals;
+    scattered_points(count, points, normals);
+    write_ply(CLOUD_FILE, points, normals);
+    PointCloudHandle cloud = smr_pointcloud_create();
+    CHECK(smr_pointcloud_load_ply(cloud, CLOUD_FILE) == SMR_SUCCESS);
+    std::remove(CLOUD_FILE);
+
+    std::vector<int> permutation(count, -1);
+    CHECK(smr_pointcloud_sort_spatial(cloud, permutation.data()) == SMR_SUCCESS);
+    CHECK(smr_pointcloud_get_count(cloud) == count);
+
+    // Every input point appears once, with its own normal
+    std::vector<float> sorted(count * 3), sorted_normals(count * 3);
+    smr_pointcloud_get_points(cloud, sorted.data());
+    smr_pointcloud_get_normals(cloud, sorted_normals.data());
+    std::vector<int> seen(count, 0);
+    for (int i = 0; i < count; ++i) {
+        int original = permutation[i];
+        CHECK(original >= 0 && original < count);
+        ++seen[original];
+        CHECK(std::memcmp(&sorted[i * 3], &points[original * 3], 3 * sizeof(float)) == 0);
+        CHECK(std::memcmp(&sorted_normals[i * 3], &normals[original * 3], 3 * sizeof(float)) == 0);
+    }
+    for (int s : seen) CHECK(s == 1);
+
+    // Neighbors in memory are near in space
+    auto path_length = [](const std::vector<float>& p) {
+        double length = 0.0;
+        for (size_t i = 3; i < p.size(); i += 3) {
+            double dx = p[i] - p[i - 3], dy = p[i + 1] - p[i - 2], dz = p[i + 2] - p[i - 1];
+            length += std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+        return length;
+    };
+    CHECK(path_length(sorted) * 4 < path_length(points));
+
+    // Sorting sorted points changes nothing
+    CHECK(smr_pointcloud_sort_spatial(cloud, permutation.data()) == SMR_SUCCESS);
+    for (int i = 0; i < count; ++i) CHECK(permutation[i] == i);
+    CHECK(smr_pointcloud_sort_spatial(cloud, nullptr) == SMR_SUCCESS);
+    smr_pointcloud_destroy(cloud);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_robot.cpp
+ * @brief Robot model and reachability map file tests
+ */
+
+#include "test_common.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+static const char* MAP_FILE = "smr_test_reachability.bin";
+
+// Grid dims follow the magic, version and DH table in the file header
+static const size_t MAP_DIMS_OFFSET = 4 + sizeof(uint32_t) + 6 * sizeof(DHParams);
+
+static std::vector<char> read_file(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void write_file(const char* path, const std::vector<char>& bytes) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+static void set_dims(std::vector<char>& bytes, int32_t x, int32_t y, int32_t z) {
+    const int32_t dims[3] = {x, y, z};
+    std::memcpy(bytes.data() + MAP_DIMS_OFFSET, dims, sizeof(dims));
+}
+
+SMR_TEST(reachability_load_rejects_bad_dimensions) {
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    CHECK(robot != nullptr);
+    ReachabilitySettings settings = {};
+    settings.voxel_size = 0.1f;
+    settings.bounds_min[0] = 0.2f;
+    settings.bounds_max[0] = 0.4f;
+    settings.bounds_max[1] = 0.2f;
+    settings.bounds_max[2] = 0.2f;
+    settings.orientation_samples = 4;
+    CHECK(smr_robot_build_reachability(robot, &settings) == SMR_SUCCESS);
+    CHECK(smr_robot_save_reachability(robot, MAP_FILE) == SMR_SUCCESS);
+    const std::vector<char> saved = read_file(MAP_FILE);
+    CHECK(saved.size() > MAP_DIMS_OFFSET + 16);
+    CHECK(smr_robot_load_reachability(robot, MAP_FILE) == SMR_SUCCESS);
+
+    // Product overflows 64 bits without the per-axis cap
+    std::vector<char> bytes = saved;
+    set_dims(bytes, 0x7fffffff, 0x7fffffff, 0x7fffffff);
+    write_file(MAP_FILE, bytes);
+    CHECK(smr_robot_load_reachability(robot, MAP_FILE) == SMR_ERROR_FILE_FORMAT);
+
+    // Within the cap, but far more voxels than the file holds
+    bytes = saved;
+    set_dims(bytes, 65536, 65536, 65536);
+    write_file(MAP_FILE, bytes);
+    CHECK(smr_robot_load_reachability(robot, MAP_FILE) == SMR_ERROR_FILE_FORMAT);
+
+    // Truncated voxel data
+    bytes = saved;
+    bytes.pop_back();
+    write_file(MAP_FILE, bytes);
+    CHECK(smr_robot_load_reachability(robot, MAP_FILE) == SMR_ERROR_FILE_FORMAT);
+
+    std::remove(MAP_FILE);
+    smr_robot_destroy(robot);
+}
+
+SMR_TEST(reachability_build_rejects_oversized_grids) {
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    CHECK(robot != nullptr);
+
+    // 1 m at 1 nm voxels: the per-axis count overflows int
+    ReachabilitySettings settings = {};
+    settings.voxel_size = 1e-9f;
+    settings.bounds_max[0] = settings.bounds_max[1] = settings.bounds_max[2] = 1.0f;
+    CHECK(smr_robot_build_reachability(robot, &settings) == SMR_ERROR_INVALID_PARAMETER);
+
+    // Default voxels over astronomically large bounds
+    settings = ReachabilitySettings{};
+    settings.bounds_min[0] = -1e30f;
+    settings.bounds_max[0] = 1e30f;
+    CHECK(smr_robot_build_reachability(robot, &settings) == SMR_ERROR_INVALID_PARAMETER);
+
+    // Just over the per-axis cap
+    settings = ReachabilitySettings{};
+    settings.voxel_size = 1.0f;
+    settings.bounds_max[0] = 65537.0f;
+    CHECK(smr_robot_build_reachability(robot, &settings) == SMR_ERROR_INVALID_PARAMETER);
+
+    smr_robot_destroy(robot);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file test_simd.cpp
+ * @brief SIMD kernel dispatch tests
+ */
+
+#include "test_common.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static const char* SIMD_TEST = "simd_levels_give_identical_results";
+static const char* SIMD_OUT_VARIABLE = "SMR_TEST_SIMD_OUT";
+#if defined(_WIN32)
+static const char* QUIET = " > NUL";
+#else
+static const char* QUIET = " > /dev/null";
+#endif
+
+static void set_environment(const char* name, const char* value) {
+#if defined(_WIN32)
+    _putenv_s(name, value ? value : "");
+#else
+    if (value) setenv(name, value, 1);
+    else unsetenv(name);
+#endif
+}
+
+/// Outputs of every stage that runs on the dispatched kernels
+struct KernelResults {
+    char level[16];
+    std::vector<int> permutation;      // Spatial sort (voxel keys)
+    std::vector<float> normals;        // kNN normals (distances, covariance)
+    std::vector<float> filtered;       // Outlier removal, then downsampling (distances, voxel keys)
+    std::vector<float> vertices;       // Reconstruction (cube cases)
+};
+
+// Noisy 10 cm sphere; the odd count leaves a scalar tail in every kernel
+static std::vector<float> noisy_sphere(int count) {
+    std::vector<float> points;
+    for (int i = 0; i < count; ++i) {
+        float z = 1.0f - 2.0f * (i + 0.5f) / count;
+        float r = std::sqrt(1.0f - z * z);
+        float phi = 2.39996323f * i;
+        float radius = 0.1f + 0.0005f * (static_cast<float>((i * 7919) % 101) / 50.0f - 1.0f);
+        points.push_back(radius * r * std::cos(phi));
+        points.push_back(radius * r * std::sin(phi));
+        points.push_back(radius * z);
+    }
+    return points;
+}
+
+static void compute_results(KernelResults& out) {
+    std::memset(out.level, 0, sizeof(out.level));
+    std::strncpy(out.level, smr_get_simd_level(), sizeof(out.level) - 1);
+
+    const int count = 20003;
+    std::vector<float> points = noisy_sphere(count);
+    PointCloudHandle cloud = smr_pointcloud_create();
+    smr_pointcloud_set_points(cloud, points.data(), count);
+    out.permutation.resize(count);
+    smr_pointcloud_sort_spatial(cloud, out.permutation.data());
+    smr_pointcloud_estimate_normals_knn(cloud, 16);
+    out.normals.resize(count * 3);
+    smr_pointcloud_get_normals(cloud, out.normals.data());
+
+    smr_pointcloud_orient_normals(cloud, 0.0f, 0.0f, 0.0f);
+    const PoissonSettings settings = {6, 1.1f, false, 0.0f};
+    MeshHandle mesh = smr_mesh_create_poisson(cloud, &settings);
+    out.vertices.resize(mesh ? smr_mesh_get_vertex_count(mesh) * 3 : 0);
+    if (mesh) smr_mesh_get_vertices(mesh, out.vertices.data());
+    smr_mesh_destroy(mesh);
+    smr_pointcloud_destroy(cloud);
+
+    PointCloudHandle filtered = smr_pointcloud_create();
+    smr_pointcloud_set_points(filtered, points.data(), count);
+    smr_pointcloud_remove_outliers(filtered, 16, 1.0f);
+    smr_pointcloud_downsample_voxel(filtered, 0.004f);
+    out.filtered.resize(smr_pointcloud_get_count(filtered) * 3);
+    smr_pointcloud_get_points(filtered, out.filtered.data());
+    smr_pointcloud_destroy(filtered);
+}
+
+template <typename T>
+static void write_array(FILE* file, const std::vector<T>& values) {
+    unsigned long long n = values.size();
+    std::fwrite(&n, sizeof(n), 1, file);
+    if (n) std::fwrite(values.data(), sizeof(T), values.size(), file);
+}
+
+template <typename T>
+static bool read_array(FILE* file, std::vector<T>& values) {
+    unsigned long long n = 0;
+    if (std::fread(&n, sizeof(n), 1, file) != 1 || n > (1ull << 28)) return false;
+    values.resize(static_cast<size_t>(n));
+    return n == 0 || std::fread(values.data(), sizeof(T), values.size(), file) == values.size();
+}
+
+// Runs this test in a child process limited to `level` by SMR_SIMD (the
+// level is detected once per process)
+static bool run_at_level(const char* level, KernelResults& out) {
+    std::string path = std::string("smr_test_simd_") + level + ".bin";
+    set_environment("SMR_SIMD", level);
+    set_environment(SIMD_OUT_VARIABLE, path.c_str());
+    std::string command = std::string("\"") + test_executable() + "\" " + SIMD_TEST + QUIET;
+    int status = std::system(command.c_str());
+    set_environment("SMR_SIMD", nullptr);
+    set_environment(SIMD_OUT_VARIABLE, nullptr);
+
+    FILE* file = status == 0 ? std::fopen(path.c_str(), "rb") : nullptr;
+    if (!file) return false;
+    bool ok = std::fread(out.level, sizeof(out.level), 1, file) == 1 &&
+              read_array(file, out.permutation) && read_array(file, out.normals) &&
+              read_array(file, out.filtered) && read_array(file, out.vertices);
+    std::fclose(file);
+    std::remove(path.c_str());
+    return ok;
+}
+
+static bool close_arrays(const std::vector<float>& a, const std::vector<float>& b, float tolerance) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::fabs(a[i] - b[i]) > tolerance) return false;
+    }
+    return true;
+}
+
+SMR_TEST(simd_levels_give_identical_results) {
+    // Child: record this process's results for the parent
+    if (const char* out_path = std::getenv(SIMD_OUT_VARIABLE)) {
+        KernelResults results;
+        compute_results(results);
+        FILE* file = std::fopen(out_path, "wb");
+        CHECK(file != nullptr);
+        std::fwrite(results.level, sizeof(results.level), 1, file);
+        write_array(file, results.permutation);
+        write_array(file, results.normals);
+        write_array(file, results.filtered);
+        write_array(file, results.vertices);
+        std::fclose(file);
+        return;
+    }
+
+    KernelResults scalar;
+    CHECK(run_at_level("scalar", scalar));
+    CHECK(std::strcmp(scalar.level, "scalar") == 0);
+    CHECK(!scalar.normals.empty() && !scalar.filtered.empty() && !scalar.vertices.empty());
+
+    // Levels the CPU lacks fall back to the best one it has
+    const char* levels[2] = {"avx2", "avx512"};
+    for (const char* level : levels) {
+        KernelResults vector;
+        CHECK(run_at_level(level, vector));
+        CHECK(std::strcmp(vector.level, "scalar") == 0 || std::strcmp(vector.level, "neon") == 0 ||
+              std::strcmp(vector.level, "avx2") == 0 || std::strcmp(vector.level, level) == 0);
+
+        // Distances, voxel keys and cube cases round like the scalar code;
+        // covariance sums are only reordered
+        CHECK(vector.permutation == scalar.permutation);
+        CHECK(vector.filtered == scalar.filtered);
+        CHECK(close_arrays(vector.normals, scalar.normals, 1e-5f));
+        CHECK(close_arrays(vector.vertices, scalar.vertices, 1e-5f));
+    }
+}
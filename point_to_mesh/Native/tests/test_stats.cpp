@@ -0,0 +1,127 @@
+/**
+ * @file test_stats.cpp
+ * @brief Stage timer, counter and trace tests
+ */
+
+#include "test_common.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static const char* TRACE_FILE = "smr_test_trace.json";
+
+static StageStat find_stat(const char* name) {
+    std::vector<StageStat> stats(smr_stats_get(nullptr, 0));
+    smr_stats_get(stats.data(), static_cast<int>(stats.size()));
+    for (const StageStat& stat : stats) {
+        if (std::strcmp(stat.name, name) == 0) return stat;
+    }
+    StageStat missing = {name, -1, 0.0, 0.0};
+    return missing;
+}
+
+static bool all_zero() {
+    std::vector<StageStat> stats(smr_stats_get(nullptr, 0));
+    smr_stats_get(stats.data(), static_cast<int>(stats.size()));
+    for (const StageStat& stat : stats) {
+        if (stat.count != 0 || stat.total_ms != 0.0) return false;
+    }
+    return !stats.empty();
+}
+
+// Normal estimation, then IK along a seam that runs out of reach
+static void run_workload(RobotHandle robot) {
+    const int count = 5000;
+    std::vector<float> points;
+    for (int i = 0; i < count; ++i) {
+        points.push_back(0.001f * (i % 100));
+        points.push_back(0.001f * (i / 100));
+        points.push_back(0.0f);
+    }
+    PointCloudHandle cloud = smr_pointcloud_create();
+    smr_pointcloud_set_points(cloud, points.data(), count);
+    smr_pointcloud_estimate_normals_knn(cloud, 16);
+    smr_pointcloud_destroy(cloud);
+
+    const int seam_count = 20;
+    std::vector<float> seam, normals;
+    for (int i = 0; i < seam_count; ++i) {
+        const float p[3] = {0.4f + 0.06f * i, 0.0f, 0.0f};
+        const float n[3] = {0.0f, 0.0f, 1.0f};
+        seam.insert(seam.end(), p, p + 3);
+        normals.insert(normals.end(), n, n + 3);
+    }
+    PathParams params = {};
+    PathHandle path = smr_path_create_from_points(seam.data(), normals.data(), seam_count, &params);
+    std::vector<double> joints(seam_count * 6);
+    bool reachable[seam_count];
+    smr_path_to_joints_ex(path, robot, 0.015f, nullptr, nullptr, joints.data(), reachable, nullptr);
+    smr_path_destroy(path);
+}
+
+SMR_TEST(stats_record_only_while_enabled) {
+    if (smr_stats_set_mode(SMR_STATS_OFF) == SMR_ERROR_NOT_IMPLEMENTED) return;   // Compiled out
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    CHECK(robot != nullptr);
+
+    smr_stats_reset();
+    run_workload(robot);
+    CHECK(all_zero());
+
+    CHECK(smr_stats_set_mode(SMR_STATS_ON) == SMR_SUCCESS);
+    run_workload(robot);
+    CHECK(smr_stats_set_mode(SMR_STATS_OFF) == SMR_SUCCESS);
+
+    const char* timers[4] = {"pointcloud.normals.search", "pointcloud.normals.pca",
+                             "ik.trajectory", "ik.solve"};
+    for (const char* name : timers) {
+        StageStat stat = find_stat(name);
+        CHECK(stat.count > 0);
+        CHECK(stat.total_ms > 0.0 && stat.max_ms > 0.0 && stat.max_ms <= stat.total_ms);
+    }
+    StageStat solves = find_stat("ik.solve");
+    StageStat iterations = find_stat("ik.iterations");
+    StageStat failures = find_stat("ik.failures");
+    CHECK(iterations.count >= solves.count);
+    CHECK(failures.count > 0 && failures.count < solves.count);
+    CHECK(iterations.total_ms == 0.0);
+
+    // Off again: nothing more is added
+    run_workload(robot);
+    CHECK(find_stat("ik.solve").count == solves.count);
+
+    smr_stats_reset();
+    CHECK(all_zero());
+    smr_robot_destroy(robot);
+}
+
+SMR_TEST(stats_trace_writes_chrome_json) {
+    if (smr_stats_set_mode(SMR_STATS_TRACE) == SMR_ERROR_NOT_IMPLEMENTED) return;
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    run_workload(robot);
+    CHECK(smr_stats_set_mode(SMR_STATS_OFF) == SMR_SUCCESS);
+    CHECK(smr_stats_write_trace(TRACE_FILE) == SMR_SUCCESS);
+    smr_stats_reset();
+    smr_robot_destroy(robot);
+
+    std::ifstream file(TRACE_FILE);
+    std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(TRACE_FILE);
+    CHECK(json.compare(0, 15, "{\"traceEvents\":") == 0);
+    CHECK(json.find("\"name\":\"ik.trajectory\"") != std::string::npos);
+    CHECK(json.find("\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.find("\"dropped_events\":0") != std::string::npos);
+    CHECK(json.find_last_of('}') > json.find("displayTimeUnit"));
+
+    // Reset discards the events
+    CHECK(smr_stats_write_trace(TRACE_FILE) == SMR_SUCCESS);
+    file.open(TRACE_FILE);
+    json.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(TRACE_FILE);
+    CHECK(json.find("\"ph\":\"X\"") == std::string::npos);
+}
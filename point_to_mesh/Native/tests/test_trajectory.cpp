@@ -0,0 +1,268 @@
+/**
+ * @file test_trajectory.cpp
+ * @brief Path-to-joints (trajectory IK) tests
+ */
+
+#include "test_common.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Straight seam along x at y = 0, normals +Z, within reach of a UR5
+static PathHandle straight_seam(int count) {
+    std::vector<float> points, normals;
+    for (int i = 0; i < count; ++i) {
+        const float p[3] = {0.35f + 0.2f * i / (count - 1), 0.0f, 0.0f};
+        const float n[3] = {0.0f, 0.0f, 1.0f};
+        points.insert(points.end(), p, p + 3);
+        normals.insert(normals.end(), n, n + 3);
+    }
+    PathParams params = {};
+    return smr_path_create_from_points(points.data(), normals.data(), count, &params);
+}
+
+SMR_TEST(cancelled_trajectory_ik_marks_unsolved_points) {
+    const int count = 20000;
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    PathHandle path = straight_seam(count);
+    CHECK(robot && path);
+
+    TrajectoryIKSettings settings = {};
+    settings.chunk_size = 16;
+    settings.num_threads = 1;
+    std::vector<double> joints(count * 6);
+    std::vector<char> reachable(count);
+    std::vector<SMRErrorCode> status(count, static_cast<SMRErrorCode>(1));
+    JobHandle job = smr_job_path_to_joints(path, robot, 0.015f, &settings, nullptr, joints.data(),
+                                           reinterpret_cast<bool*>(reachable.data()), status.data(),
+                                           nullptr, nullptr);
+    CHECK(job != nullptr);
+
+    // Cancel once the first chunks are solved
+    while (smr_job_get_progress(job) <= 0.0f && smr_job_get_state(job) < SMR_JOB_COMPLETED) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    smr_job_cancel(job);
+    CHECK(smr_job_wait(job, -1) == SMR_JOB_CANCELLED);
+    smr_job_destroy(job);
+
+    // Every point has a verdict; those never solved are not reported as reachable
+    int solved = 0, cancelled = 0;
+    for (int i = 0; i < count; ++i) {
+        CHECK(status[i] == SMR_SUCCESS || status[i] < 0);
+        CHECK((reachable[i] != 0) == (status[i] == SMR_SUCCESS));
+        for (int j = 0; j < 6; ++j) CHECK(std::isfinite(joints[i * 6 + j]));
+        solved += status[i] == SMR_SUCCESS;
+        cancelled += status[i] == SMR_ERROR_CANCELLED;
+    }
+    CHECK(solved > 0 && cancelled > 0);
+
+    smr_path_destroy(path);
+    smr_robot_destroy(robot);
+}
+
+static double max_abs_difference(const std::vector<double>& a, const std::vector<double>& b) {
+    double d = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) d = std::max(d, std::fabs(a[i] - b[i]));
+    return d;
+}
+
+SMR_TEST(parallel_trajectory_ik_matches_serial_solve) {
+    const int count = 400;
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    PathHandle path = straight_seam(count);
+    CHECK(robot && path);
+
+    // One chunk is the plain warm-started serial solve
+    TrajectoryIKSettings serial = {};
+    serial.chunk_size = count;
+    serial.num_threads = 1;
+    std::vector<double> expected(count * 6);
+    std::vector<char> reachable(count);
+    CHECK(smr_path_to_joints_ex(path, robot, 0.015f, &serial, nullptr, expected.data(),
+                                reinterpret_cast<bool*>(reachable.data()), nullptr) == SMR_SUCCESS);
+    for (int i = 0; i < count; ++i) CHECK(reachable[i]);
+
+    // Small chunks on four workers, seeded by the continuation pass
+    smr_set_thread_count(4);
+    TrajectoryIKSettings parallel = {};
+    parallel.chunk_size = 16;
+    parallel.num_threads = 4;
+    std::vector<double> joints(count * 6);
+    std::vector<SMRErrorCode> status(count);
+    SMRErrorCode result = smr_path_to_joints_ex(path, robot, 0.015f, &parallel, nullptr, joints.data(),
+                                                reinterpret_cast<bool*>(reachable.data()), status.data());
+    smr_set_thread_count(0);
+    CHECK(result == SMR_SUCCESS);
+    for (int i = 0; i < count; ++i) CHECK(status[i] == SMR_SUCCESS && reachable[i]);
+
+    // Same branch everywhere, so no jump at any chunk boundary
+    CHECK(max_abs_difference(joints, expected) < 1e-3);
+    for (int i = 1; i < count; ++i) {
+        std::vector<double> a(&joints[(i - 1) * 6], &joints[i * 6]);
+        std::vector<double> b(&joints[i * 6], &joints[(i + 1) * 6]);
+        CHECK(max_abs_difference(a, b) < 0.05);
+    }
+
+    // Every configuration puts the flange where the serial one does
+    for (int i = 0; i < count; i += 37) {
+        double expected_pose[16], pose[16];
+        CHECK(smr_robot_forward_kinematics(robot, &expected[i * 6], expected_pose) == SMR_SUCCESS);
+        CHECK(smr_robot_forward_kinematics(robot, &joints[i * 6], pose) == SMR_SUCCESS);
+        for (int k = 0; k < 16; ++k) CHECK(std::fabs(pose[k] - expected_pose[k]) < 1e-4);
+    }
+
+    smr_path_destroy(path);
+    smr_robot_destroy(robot);
+}
+
+// Seam on an arc of radius 0.45 m around the base, from -60 to +60 degrees
+static PathHandle arc_seam(int count) {
+    std::vector<float> points, normals;
+    for (int i = 0; i < count; ++i) {
+        float angle = -1.047f + 2.094f * i / (count - 1);
+        const float p[3] = {0.45f * std::cos(angle), 0.45f * std::sin(angle), 0.0f};
+        const float n[3] = {0.0f, 0.0f, 1.0f};
+        points.insert(points.end(), p, p + 3);
+        normals.insert(normals.end(), n, n + 3);
+    }
+    PathParams params = {};
+    return smr_path_create_from_points(points.data(), normals.data(), count, &params);
+}
+
+SMR_TEST(global_ik_keeps_one_branch_along_the_seam) {
+    const int count = 300;
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    PathHandle path = arc_seam(count);
+    CHECK(robot && path);
+
+    // Rediscover branches often, so every layer offers several to switch to
+    GlobalIKSettings settings = {};
+    settings.discovery_interval = 16;
+    std::vector<double> joints(count * 6);
+    std::vector<char> reachable(count);
+    std::vector<SMRErrorCode> status(count);
+    CHECK(smr_path_to_joints_global(path, robot, 0.015f, &settings, joints.data(),
+                                    reinterpret_cast<bool*>(reachable.data()), status.data()) == SMR_SUCCESS);
+
+    // The base sweeps 120 degrees but no joint jumps between neighbors, and
+    // the elbow and wrist never change side
+    double largest_step = 0.0;
+    for (int i = 0; i < count; ++i) {
+        CHECK(reachable[i] && status[i] == SMR_SUCCESS);
+        if (i == 0) continue;
+        for (int j = 0; j < 6; ++j) {
+            largest_step = std::max(largest_step, std::fabs(joints[i * 6 + j] - joints[(i - 1) * 6 + j]));
+        }
+        CHECK((joints[i * 6 + 2] > 0) == (joints[2] > 0));
+        CHECK((std::sin(joints[i * 6 + 4]) > 0) == (std::sin(joints[4]) > 0));
+    }
+    CHECK(largest_step < 0.1);
+    CHECK(std::fabs(joints[(count - 1) * 6] - joints[0]) > 1.5);
+
+    smr_path_destroy(path);
+    smr_robot_destroy(robot);
+}
+
+SMR_TEST(tool_axis_tilt_reaches_points_beyond_the_nominal_pose) {
+    // Radial seam running out to 0.92 m, past where a vertical torch reaches
+    const int count = 60;
+    std::vector<float> points, normals;
+    for (int i = 0; i < count; ++i) {
+        const float p[3] = {0.84f + 0.08f * i / (count - 1), 0.0f, 0.0f};
+        const float n[3] = {0.0f, 0.0f, 1.0f};
+        points.insert(points.end(), p, p + 3);
+        normals.insert(normals.end(), n, n + 3);
+    }
+    PathParams params = {};
+    PathHandle path = smr_path_create_from_points(points.data(), normals.data(), count, &params);
+    RobotHandle robot = smr_robot_create(ROBOT_UR5);
+    CHECK(robot && path);
+
+    std::vector<double> joints(count * 6);
+    std::vector<char> reachable(count);
+    CHECK(smr_path_to_joints_ex(path, robot, 0.015f, nullptr, nullptr, joints.data(),
+                                reinterpret_cast<bool*>(reachable.data()), nullptr) == SMR_SUCCESS);
+    CHECK(reachable[0] && !reachable[count - 1]);
+
+    ToolAxisSettings settings = {};
+    settings.travel_tolerance = 0.5f;
+    settings.work_tolerance = 0.5f;
+    settings.angle_samples = 5;
+    std::vector<SMRErrorCode> status(count);
+    std::vector<float> angles(count * 3);
+    CHECK(smr_path_to_joints_tool_axis(path, robot, 0.015f, &settings, joints.data(),
+                                       reinterpret_cast<bool*>(reachable.data()), status.data(),
+                                       angles.data()) == SMR_SUCCESS);
+
+    // Every point is reached, tilted within the tolerances and ramped in
+    // rather than switched from one point to the next
+    for (int i = 0; i < count; ++i) {
+        CHECK(reachable[i] && status[i] == SMR_SUCCESS);
+        CHECK(std::fabs(angles[i * 3 + 1]) <= settings.travel_tolerance + 1e-5f);
+        CHECK(std::fabs(angles[i * 3 + 2]) <= settings.work_tolerance + 1e-5f);
+        if (i > 0) {
+            for (int k = 0; k < 3; ++k) CHECK(std::fabs(angles[i * 3 + k] - angles[(i - 1) * 3 + k]) < 0.1f);
+        }
+    }
+    CHECK(angles[(count - 1) * 3 + 1] != 0.0f || angles[(count - 1) * 3 + 2] != 0.0f);
+
+    smr_path_destroy(path);
+    smr_robot_destroy(robot);
+}
+
+SMR_TEST(time_parameterization_respects_joint_limits) {
+    // UR5 kinematics with slow joints, so the limits rather than the travel
+    // speed set the pace on the arc
+    const DHParams dh[6] = {{0.0, -M_PI / 2, 0.089159, 0.0}, {-0.425, 0.0, 0.0, 0.0},
+                            {-0.39225, 0.0, 0.0, 0.0}, {0.0, -M_PI / 2, 0.10915, 0.0},
+                            {0.0, M_PI / 2, 0.09465, 0.0}, {0.0, 0.0, 0.0823, 0.0}};
+    JointLimits limits[6];
+    for (int j = 0; j < 6; ++j) limits[j] = {-2 * M_PI, 2 * M_PI, 0.3 + 0.1 * j, 1.0 + 0.5 * j};
+    RobotHandle robot = smr_robot_create_custom(dh, limits);
+    const int count = 200;
+    PathHandle path = arc_seam(count);
+    CHECK(robot && path);
+
+    std::vector<double> joints(count * 6);
+    std::vector<char> reachable(count);
+    CHECK(smr_path_to_joints(path, robot, 0.015f, joints.data(),
+                             reinterpret_cast<bool*>(reachable.data())) == SMR_SUCCESS);
+
+    TimingSettings settings = {};
+    settings.travel_speed = 0.5f;
+    std::vector<double> times(count), velocities(count * 6), accelerations(count * 6);
+    std::vector<float> speed(count);
+    CHECK(smr_path_time_parameterize(path, robot, joints.data(), &settings, times.data(),
+                                     velocities.data(), accelerations.data(), speed.data()) == SMR_SUCCESS);
+
+    // Starts and ends at rest, never exceeds a limit, and some joint is at
+    // its velocity limit somewhere (the trajectory is as fast as allowed)
+    CHECK(times[0] == 0.0);
+    bool saturated = false;
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) CHECK(times[i] > times[i - 1]);
+        CHECK(speed[i] <= settings.travel_speed * 1.0001f);
+        for (int j = 0; j < 6; ++j) {
+            double v = std::fabs(velocities[i * 6 + j]);
+            CHECK(v <= limits[j].max_velocity * (1 + 1e-6));
+            CHECK(std::fabs(accelerations[i * 6 + j]) <= limits[j].max_accel * (1 + 1e-6));
+            saturated = saturated || v > 0.99 * limits[j].max_velocity;
+            if (i == 0 || i == count - 1) CHECK(v < 1e-9);
+        }
+    }
+    CHECK(saturated);
+
+    // Integrating the reported seam speed covers the seam's arc length
+    std::vector<WeldPoint> samples(count);
+    CHECK(smr_path_get_points(path, samples.data()) == SMR_SUCCESS);
+    for (int i = 1; i < count; ++i) {
+        double covered = 0.5 * (speed[i] + speed[i - 1]) * (times[i] - times[i - 1]);
+        CHECK(std::fabs(covered - (samples[i].arc_length - samples[i - 1].arc_length)) < 1e-5);
+    }
+
+    smr_path_destroy(path);
+    smr_robot_destroy(robot);
+}
@@ -2,6 +2,7 @@
 // WeldingPipeline.cs - High-level Welding Pipeline Controller
 // =============================================================================
 using System;
+using System.Collections;
 using System.Collections.Generic;
 using UnityEngine;
 
@@ -60,6 +61,8 @@ namespace SMRWelding
 
         // State
         private PipelineState _state = PipelineState.Idle;
+        private NativeJob _activeJob;
+        private bool _cancelRequested;
         private bool _disposed;
 
         // Events
@@ -90,6 +93,7 @@ namespace SMRWelding
             public int PoissonDepth { get; set; } = 8;
             public float DensityThreshold { get; set; } = 0.01f;
             public int SimplifyTarget { get; set; } = 0; // 0 = no simplification
+            public int MeshMemoryBudgetMB { get; set; } = 0; // 0 = no limit; lowers PoissonDepth to fit
 
             // Path generation
             public float PathStepSize { get; set; } = 0.005f;
@@ -101,6 +105,9 @@ namespace SMRWelding
 
             // Robot
             public RobotType RobotType { get; set; } = RobotType.UR5;
+
+            // Threads of the shared native pool (0 = leave unchanged; all cores by default)
+            public int NativeThreads { get; set; } = 0;
         }
 
         private Config _config;
@@ -108,6 +115,8 @@ namespace SMRWelding
         public WeldingPipeline(Config config = null)
         {
             _config = config ?? new Config();
+            if (_config.NativeThreads > 0)
+                NativeBindings.smr_set_thread_count(_config.NativeThreads);
         }
 
         ~WeldingPipeline()
@@ -127,6 +136,7 @@ namespace SMRWelding
             {
                 if (disposing)
                 {
+                    _activeJob?.Dispose();
                     _pointCloud?.Dispose();
                     _mesh?.Dispose();
                     _robot?.Dispose();
@@ -215,6 +225,172 @@ namespace SMRWelding
             }
         }
 
+        /// <summary>
+        /// Run the complete pipeline as a coroutine (StartCoroutine). Loading,
+        /// filtering, normal estimation and orientation, reconstruction,
+        /// density trimming, decimation and IK run as native jobs, so the main
+        /// thread only polls them once per frame. Two steps stay synchronous:
+        /// ToUnityMesh, because UnityEngine.Mesh may only be built on the main
+        /// thread (the native side is a copy of the vertex and index arrays),
+        /// and GeneratePath, whose native calls scale with the path samples,
+        /// not the scan. Failures end in PipelineState.Error instead of an
+        /// exception.
+        /// </summary>
+        public IEnumerator RunFromFileRoutine(string pointCloudPath)
+        {
+            _cancelRequested = false;
+
+            // Step 1: Load point cloud
+            if (!TryStep(() =>
+                {
+                    _pointCloud?.Dispose();
+                    _pointCloud = new PointCloudWrapper();
+                })) yield break;
+            yield return RunJob(() => NativeJob.LoadPointCloud(_pointCloud, pointCloudPath),
+                PipelineState.LoadingPointCloud, "Loading point cloud...", null);
+            if (!IsRunning) yield break;
+
+            // Step 2: Process point cloud
+            if (!TryStep(() =>
+                {
+                    if (_pointCloud.Count == 0)
+                        throw new InvalidOperationException("No point cloud loaded");
+                })) yield break;
+            if (_config.VoxelSize > 0)
+            {
+                yield return RunJob(() => NativeJob.DownsampleVoxel(_pointCloud, _config.VoxelSize),
+                    PipelineState.ProcessingPointCloud, "Downsampling...", null);
+                if (!IsRunning) yield break;
+            }
+            yield return RunJob(() => NativeJob.RemoveOutliers(_pointCloud, _config.OutlierNeighbors, _config.OutlierStdRatio),
+                PipelineState.ProcessingPointCloud, "Removing outliers...", null);
+            if (!IsRunning) yield break;
+            yield return RunJob(() => NativeJob.EstimateNormals(_pointCloud, _config.NormalKNN),
+                PipelineState.ProcessingPointCloud, "Estimating normals...", null);
+            if (!IsRunning) yield break;
+            yield return RunJob(() => NativeJob.OrientNormals(_pointCloud, Vector3.zero),
+                PipelineState.ProcessingPointCloud, "Orienting normals...", null);
+            if (!IsRunning) yield break;
+
+            // Step 3: Generate mesh
+            PoissonSettings settings = MeshSettings();
+            if (_config.MeshMemoryBudgetMB > 0)
+            {
+                long[] estimates = new long[settings.depth];
+                yield return RunJob(() => NativeJob.EstimateMeshMemory(_pointCloud, settings, estimates),
+                    PipelineState.GeneratingMesh, "Estimating mesh memory...", null);
+                if (!IsRunning) yield break;
+                if (!TryStep(() => settings.depth = FitDepth(estimates))) yield break;
+            }
+            _mesh?.Dispose();
+            _mesh = null;
+            yield return RunJob(() => NativeJob.CreateMesh(_pointCloud, settings),
+                PipelineState.GeneratingMesh, "Generating mesh...", job => _mesh = job.TakeMesh());
+            if (!IsRunning) yield break;
+            yield return RunJob(() => NativeJob.RemoveLowDensity(_mesh, _config.DensityThreshold),
+                PipelineState.GeneratingMesh, "Removing low-density vertices...", null);
+            if (!IsRunning) yield break;
+
+            int triangles = _mesh.TriangleCount;
+            if (_config.SimplifyTarget > 0 && triangles > _config.SimplifyTarget)
+            {
+                float ratio = (float)_config.SimplifyTarget / triangles;
+                yield return RunJob(() => NativeJob.Simplify(_mesh, ratio),
+                    PipelineState.GeneratingMesh, "Simplifying mesh...", null);
+                if (!IsRunning) yield break;
+            }
+            // Main thread only (UnityEngine.Mesh)
+            if (!TryStep(() => _unityMesh = _mesh.ToUnityMesh())) yield break;
+
+            // Step 4: Generate path (cost scales with the path, not the scan)
+            if (!TryStep(GeneratePath)) yield break;
+
+            // Step 5: Compute trajectory
+            if (!TryStep(() =>
+                {
+                    _robot?.Dispose();
+                    _robot = new RobotWrapper(_config.RobotType);
+                })) yield break;
+
+            int count = _path.Count;
+            var jointsFlat = new double[count * 6];
+            var reachable = new byte[count];
+            yield return RunJob(() => NativeJob.PathToJoints(_path, _robot, _config.StandoffDistance, jointsFlat, reachable),
+                PipelineState.ComputingTrajectory, "Computing robot trajectory...", job =>
+                {
+                    _jointTrajectory = new double[count][];
+                    _reachability = new bool[count];
+                    for (int i = 0; i < count; i++)
+                    {
+                        _jointTrajectory[i] = new double[6];
+                        Array.Copy(jointsFlat, i * 6, _jointTrajectory[i], 0, 6);
+                        _reachability[i] = reachable[i] != 0;
+                    }
+                });
+            if (!IsRunning) yield break;
+
+            SetState(PipelineState.Ready, 1, "Pipeline complete");
+        }
+
+        /// <summary>
+        /// Stop RunFromFileRoutine at the next native checkpoint
+        /// </summary>
+        public void Cancel()
+        {
+            _cancelRequested = true;
+            _activeJob?.Cancel();
+        }
+
+        private bool IsRunning => _state != PipelineState.Error && _state != PipelineState.Idle;
+
+        // Submit a job and report its progress every frame until it is done
+        private IEnumerator RunJob(Func<NativeJob> submit, PipelineState state, string message,
+                                   Action<NativeJob> onCompleted)
+        {
+            if (_cancelRequested)
+            {
+                SetState(PipelineState.Idle, 0, "Cancelled");
+                yield break;
+            }
+            if (!TryStep(() => _activeJob = submit())) yield break;
+
+            try
+            {
+                while (!_activeJob.IsDone)
+                {
+                    SetState(state, _activeJob.Progress, message);
+                    yield return null;
+                }
+
+                var jobState = _activeJob.State;
+                if (jobState == SMRJobState.Cancelled)
+                    SetState(PipelineState.Idle, 0, "Cancelled");
+                else if (jobState == SMRJobState.Failed)
+                    SetState(PipelineState.Error, 0, $"Error: {message} failed ({_activeJob.Result})");
+                else if (TryStep(() => onCompleted?.Invoke(_activeJob)))
+                    SetState(state, 1, message);
+            }
+            finally
+            {
+                _activeJob.Dispose();
+                _activeJob = null;
+            }
+        }
+
+        private bool TryStep(Action step)
+        {
+            try
+            {
+                step();
+                return true;
+            }
+            catch (Exception ex)
+            {
+                SetState(PipelineState.Error, 0, $"Error: {ex.Message}");
+                return false;
+            }
+        }
+
         private void LoadPointCloud(string path)
         {
             _pointCloud?.Dispose();
@@ -254,20 +430,48 @@ namespace SMRWelding
             _pointCloud.OrientNormals(Vector3.zero);
         }
 
-        private void GenerateMesh()
+        /// <summary>
+        /// Poisson settings for the loaded cloud at the configured depth
+        /// </summary>
+        private PoissonSettings MeshSettings()
         {
-            if (_pointCloud == null || !_pointCloud.HasNormals)
-                throw new InvalidOperationException("Point cloud must have normals");
-
-            _mesh?.Dispose();
-
-            var settings = new PoissonSettings
+            return new PoissonSettings
             {
                 depth = _config.PoissonDepth,
                 scale = 1.1f,
                 linear_fit = false,
                 density_threshold = _config.DensityThreshold
             };
+        }
+
+        /// <summary>
+        /// Deepest level whose native estimate (one per depth, see
+        /// MeshWrapper.EstimateMemoryByDepth) fits MeshMemoryBudgetMB
+        /// </summary>
+        private int FitDepth(long[] estimates)
+        {
+            long budget = (long)_config.MeshMemoryBudgetMB * 1024 * 1024;
+            int depth = estimates.Length;
+            while (depth >= 1 && estimates[depth - 1] > budget)
+                depth--;
+            if (depth < 1)
+                throw new InvalidOperationException(
+                    $"Mesh does not fit in {_config.MeshMemoryBudgetMB} MB at any depth");
+            if (depth != _config.PoissonDepth)
+                Debug.LogWarning($"Poisson depth lowered to {depth} to fit {_config.MeshMemoryBudgetMB} MB");
+            return depth;
+        }
+
+        private void GenerateMesh()
+        {
+            if (_pointCloud == null || !_pointCloud.HasNormals)
+                throw new InvalidOperationException("Point cloud must have normals");
+
+            _mesh?.Dispose();
+
+            var settings = MeshSettings();
+            if (_config.MeshMemoryBudgetMB > 0)
+                settings.depth = FitDepth(MeshWrapper.EstimateMemoryByDepth(_pointCloud, settings));
 
             _mesh = MeshWrapper.CreateFromPoisson(_pointCloud, settings);
             Debug.Log($"Generated mesh: {_mesh.VertexCount} vertices, {_mesh.TriangleCount} triangles");
@@ -12,6 +12,7 @@ namespace SMRWelding.Native
     public class MeshWrapper : IDisposable
     {
         private IntPtr _handle;
+        private bool _owned = true;     // false for objects owned by a native pipeline
         private bool _disposed;
 
         public IntPtr Handle => _handle;
@@ -22,6 +23,14 @@ namespace SMRWelding.Native
             _handle = handle;
         }
 
+        /// <summary>
+        /// View of an object owned by native code (e.g. a PipelineWrapper); Dispose does not destroy it
+        /// </summary>
+        internal static MeshWrapper Borrow(IntPtr handle)
+        {
+            return new MeshWrapper(handle) { _owned = false };
+        }
+
         ~MeshWrapper()
         {
             Dispose(false);
@@ -45,6 +54,50 @@ namespace SMRWelding.Native
             return new MeshWrapper(handle);
         }
 
+        /// <summary>
+        /// Upper estimate of the native bytes CreateFromPoisson will need at its
+        /// peak (reconstruction grid and mesh). The mesh filters run afterwards,
+        /// once the grid is freed.
+        /// </summary>
+        public static long EstimateMemory(PointCloudWrapper pointCloud, PoissonSettings? settings = null)
+        {
+            if (pointCloud == null || !pointCloud.IsValid)
+                throw new ArgumentException("Invalid point cloud");
+
+            var actualSettings = settings ?? PoissonSettings.Default;
+            long bytes = NativeBindings.smr_mesh_estimate_memory(pointCloud.Handle, ref actualSettings);
+            if (bytes < 0)
+                throw new SMRNativeException(SMRErrorCode.InvalidParameter,
+                    $"Failed to estimate memory: {NativeBindings.GetLastError()}");
+            return bytes;
+        }
+
+        /// <summary>
+        /// EstimateMemory at every depth from 1 to settings.depth (element depth - 1),
+        /// from one pass over the points. Blocks; use NativeJob.EstimateMeshMemory
+        /// from the main thread.
+        /// </summary>
+        public static long[] EstimateMemoryByDepth(PointCloudWrapper pointCloud, PoissonSettings settings)
+        {
+            if (pointCloud == null || !pointCloud.IsValid)
+                throw new ArgumentException("Invalid point cloud");
+
+            long[] bytes = new long[Math.Max(settings.depth, 0)];
+            var result = NativeBindings.smr_mesh_estimate_memory_depths(pointCloud.Handle, ref settings, bytes);
+            if (result != SMRErrorCode.Success)
+                throw new SMRNativeException(result,
+                    $"Failed to estimate memory: {NativeBindings.GetLastError()}");
+            return bytes;
+        }
+
+        /// <summary>
+        /// Wrap a mesh handle created elsewhere (e.g. by a NativeJob); takes ownership
+        /// </summary>
+        internal static MeshWrapper FromHandle(IntPtr handle)
+        {
+            return new MeshWrapper(handle);
+        }
+
         public void Dispose()
         {
             Dispose(true);
@@ -55,7 +108,8 @@ namespace SMRWelding.Native
         {
             if (!_disposed && _handle != IntPtr.Zero)
             {
-                NativeBindings.smr_mesh_destroy(_handle);
+                if (_owned)
+                    NativeBindings.smr_mesh_destroy(_handle);
                 _handle = IntPtr.Zero;
             }
             _disposed = true;
@@ -79,6 +133,29 @@ namespace SMRWelding.Native
             }
         }
 
+        /// <summary>
+        /// Native bytes held by this handle, including spare arrays kept for the filters
+        /// </summary>
+        public long MemoryBytes
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeBindings.smr_mesh_get_memory(_handle);
+            }
+        }
+
+        /// <summary>
+        /// Release the spare arrays kept for the filters (e.g. once filtering is done)
+        /// </summary>
+        public void TrimMemory()
+        {
+            ThrowIfDisposed();
+            var result = NativeBindings.smr_mesh_trim_memory(_handle);
+            if (result != SMRErrorCode.Success)
+                throw new SMRNativeException(result);
+        }
+
         /// <summary>
         /// Get vertices as Unity Vector3 array
         /// </summary>
@@ -23,12 +23,25 @@ namespace SMRWelding.Native
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern int smr_get_version();
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_get_simd_level();
+
         public static string GetLastError()
         {
             IntPtr ptr = smr_get_last_error();
             return ptr != IntPtr.Zero ? Marshal.PtrToStringAnsi(ptr) : string.Empty;
         }
 
+        /// <summary>
+        /// Vector instruction set the native kernels picked on this CPU
+        /// ("avx512", "avx2", "neon" or "scalar")
+        /// </summary>
+        public static string GetSimdLevel()
+        {
+            IntPtr ptr = smr_get_simd_level();
+            return ptr != IntPtr.Zero ? Marshal.PtrToStringAnsi(ptr) : string.Empty;
+        }
+
         // =====================================================================
         // Point Cloud Functions
         // =====================================================================
@@ -76,6 +89,9 @@ namespace SMRWelding.Native
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern SMRErrorCode smr_pointcloud_remove_outliers(IntPtr handle, int nb_neighbors, float std_ratio);
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_pointcloud_sort_spatial(IntPtr handle, int[] out_permutation);
+
         // =====================================================================
         // Mesh Functions
         // =====================================================================
@@ -83,6 +99,10 @@ namespace SMRWelding.Native
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr smr_mesh_create_poisson(IntPtr pc_handle, ref PoissonSettings settings);
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_mesh_create_from_arrays(
+            float[] vertices, int vertex_count, int[] indices, int triangle_count);
+
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern void smr_mesh_destroy(IntPtr handle);
 
@@ -113,6 +133,20 @@ namespace SMRWelding.Native
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
         public static extern SMRErrorCode smr_mesh_save_obj(IntPtr handle, string path);
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_mesh_raycast(
+            IntPtr handle, float[] origins, float[] directions, int count,
+            float max_distance, [Out] MeshHit[] out_hits);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_mesh_closest_points(
+            IntPtr handle, float[] points, int count, float max_distance, [Out] MeshHit[] out_hits);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_mesh_sphere_overlap(
+            IntPtr handle, float[] center, float radius,
+            int[] out_triangles, int max_triangles, out int out_count);
+
         // =====================================================================
         // Robot Functions
         // =====================================================================
@@ -151,6 +185,39 @@ namespace SMRWelding.Native
         [return: MarshalAs(UnmanagedType.I1)]
         public static extern bool smr_robot_check_joint_limits(IntPtr handle, double[] joint_angles);
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_robot_build_reachability(
+            IntPtr handle, ref ReachabilitySettings settings);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern SMRErrorCode smr_robot_save_reachability(IntPtr handle, string path);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern SMRErrorCode smr_robot_load_reachability(IntPtr handle, string path);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_robot_query_reachability(
+            IntPtr handle, float[] positions, int count,
+            float[] out_reach_ratio, float[] out_manipulability);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_robot_set_collision_capsules(
+            IntPtr handle, LinkCapsule[] capsules, int count);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_robot_check_collisions(
+            IntPtr robot_handle, IntPtr[] obstacles, int obstacle_count,
+            double[] joints, int count, ref CollisionSettings settings,
+            [MarshalAs(UnmanagedType.LPArray)] bool[] out_collision, out int out_first_collision);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_robot_plan_transit(
+            IntPtr robot_handle, IntPtr[] obstacles, int obstacle_count,
+            double[] start_joints, double[] goal_joints,
+            ref CollisionSettings collision_settings, ref TransitSettings settings,
+            CollisionCallback callback, IntPtr user_data,
+            double[] out_joints, int max_points, out int out_count);
+
         // =====================================================================
         // Path Functions
         // =====================================================================
@@ -176,15 +243,360 @@ namespace SMRWelding.Native
         public static extern SMRErrorCode smr_path_apply_weave(
             IntPtr handle, WeaveType weave_type, float amplitude, float frequency);
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_apply_weave_ex(
+            IntPtr handle, ref WeaveSettings settings, float[] profile, int profile_samples);
+
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern SMRErrorCode smr_path_resample(IntPtr handle, float step_size);
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_resample_adaptive(IntPtr handle, ref AdaptiveResampleSettings settings);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern float smr_path_get_length(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_evaluate(IntPtr handle, float[] arc_lengths, int count,
+            [Out, MarshalAs(UnmanagedType.LPArray)] WeldPoint[] out_points);
+
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern SMRErrorCode smr_path_smooth(IntPtr handle, int window_size);
 
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_smooth_ex(IntPtr handle, ref SmoothingSettings settings);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_project_to_mesh(
+            IntPtr path_handle, IntPtr mesh_handle, ref SurfaceProjectionSettings settings,
+            out int out_projected);
+
         [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
         public static extern SMRErrorCode smr_path_to_joints(
             IntPtr path_handle, IntPtr robot_handle, float standoff,
             double[] out_joints, [MarshalAs(UnmanagedType.LPArray)] bool[] out_reachable);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_to_joints_ex(
+            IntPtr path_handle, IntPtr robot_handle, float standoff,
+            ref TrajectoryIKSettings settings, double[] seed_joints,
+            double[] out_joints, [MarshalAs(UnmanagedType.LPArray)] bool[] out_reachable,
+            int[] out_status);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_to_joints_global(
+            IntPtr path_handle, IntPtr robot_handle, float standoff,
+            ref GlobalIKSettings settings,
+            double[] out_joints, [MarshalAs(UnmanagedType.LPArray)] bool[] out_reachable,
+            int[] out_status);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_to_joints_tool_axis(
+            IntPtr path_handle, IntPtr robot_handle, float standoff,
+            ref ToolAxisSettings settings,
+            double[] out_joints, [MarshalAs(UnmanagedType.LPArray)] bool[] out_reachable,
+            int[] out_status, float[] out_tool_angles);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_time_parameterize(
+            IntPtr path_handle, IntPtr robot_handle, double[] joints,
+            ref TimingSettings settings, double[] out_timestamps,
+            double[] out_joint_velocities, double[] out_joint_accelerations,
+            float[] out_path_speed);
+
+        // =====================================================================
+        // Path Set Functions
+        // =====================================================================
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_path_set_create(int num_threads);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void smr_path_set_destroy(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_add_seam(
+            IntPtr handle, float[] points, float[] normals, int count, out int out_seam);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_add_path(
+            IntPtr set_handle, IntPtr path_handle, out int out_seam);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int smr_path_set_get_seam_count(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int smr_path_set_get_count(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_get_offsets(IntPtr handle, int[] out_offsets);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_get_points(IntPtr handle,
+            [Out, MarshalAs(UnmanagedType.LPArray)] WeldPoint[] out_points);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_get_seam_points(IntPtr handle, int seam,
+            [Out, MarshalAs(UnmanagedType.LPArray)] WeldPoint[] out_points);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_get_arrays(IntPtr handle,
+            float[] out_positions, float[] out_normals, float[] out_tangents, float[] out_arc_lengths);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_optimize_sequence(
+            IntPtr set_handle, IntPtr robot_handle, float standoff,
+            ref SequenceSettings settings, double[] start_joints, int[] out_order,
+            [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.I1)] bool[] out_reversed,
+            out double out_cost);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_reorder(
+            IntPtr handle, int[] order,
+            [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.I1)] bool[] reversed);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_resample(IntPtr handle, float step_size);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_resample_adaptive(
+            IntPtr handle, ref AdaptiveResampleSettings settings);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_smooth(IntPtr handle, ref SmoothingSettings settings);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_apply_weave(
+            IntPtr handle, ref WeaveSettings settings, float[] profile, int profile_samples);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_path_set_to_joints(
+            IntPtr set_handle, IntPtr robot_handle, float standoff,
+            ref TrajectoryIKSettings settings, double[] seed_joints,
+            double[] out_joints, [MarshalAs(UnmanagedType.LPArray)] bool[] out_reachable,
+            int[] out_status);
+
+        // =====================================================================
+        // Pipeline Functions
+        // =====================================================================
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_pipeline_create(ref PipelineSettings settings);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void smr_pipeline_destroy(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern SMRErrorCode smr_pipeline_run(IntPtr handle, string path, IntPtr robot_handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_pipeline_get_pointcloud(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_pipeline_get_mesh(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_pipeline_get_path(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int smr_pipeline_get_joint_count(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_pipeline_get_joints(IntPtr handle, double[] out_joints,
+            [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.I1)] bool[] out_reachable);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_pipeline_get_stage_times(IntPtr handle, double[] out_ms);
+
+        // =====================================================================
+        // Thread Pool Functions
+        // =====================================================================
+        // All parallel native work shares one pool; size it so that native
+        // work and Unity's job system together fit the machine.
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_set_thread_count(int num_threads);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int smr_get_thread_count();
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_set_thread_affinity(int[] cpus, int count);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void smr_shutdown();
+
+        /// <summary>
+        /// Join the native worker and job threads when the application quits,
+        /// before the plugin unloads (the library does not join them itself)
+        /// </summary>
+        [UnityEngine.RuntimeInitializeOnLoadMethod]
+        private static void RegisterShutdown()
+        {
+            UnityEngine.Application.quitting += smr_shutdown;
+        }
+
+        // =====================================================================
+        // Instrumentation Functions
+        // =====================================================================
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_stats_set_mode(SMRStatsMode mode);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int smr_stats_get([Out] StageStat[] out_stats, int capacity);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void smr_stats_reset();
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern SMRErrorCode smr_stats_write_trace(string path);
+
+        /// <summary>
+        /// Snapshot of every native stage timer and counter
+        /// </summary>
+        public static StageStat[] GetStats()
+        {
+            int count = smr_stats_get(null, 0);
+            var stats = new StageStat[count];
+            smr_stats_get(stats, count);
+            return stats;
+        }
+
+        // =====================================================================
+        // Memory Functions
+        // =====================================================================
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_memory_get_stats(out MemoryStats stats);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void smr_memory_reset_peak();
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern long smr_mesh_estimate_memory(IntPtr pointCloud, ref PoissonSettings settings);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_mesh_estimate_memory_depths(IntPtr pointCloud, ref PoissonSettings settings,
+            [Out] long[] outBytes);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern long smr_pointcloud_get_memory(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_pointcloud_trim_memory(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern long smr_mesh_get_memory(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_mesh_trim_memory(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern long smr_path_get_memory(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern long smr_path_set_get_memory(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern long smr_robot_get_memory(IntPtr handle);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern long smr_pipeline_get_memory(IntPtr handle);
+
+        /// <summary>
+        /// Current and peak native memory of all tracked buffers
+        /// </summary>
+        public static MemoryStats GetMemoryStats()
+        {
+            smr_memory_get_stats(out MemoryStats stats);
+            return stats;
+        }
+
+        // =====================================================================
+        // Output buffers of the joint jobs are written after the call returns:
+        // pass pinned memory (see NativeJob) and keep it pinned until the job ends.
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_job_set_thread_count(int num_threads);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern IntPtr smr_job_pointcloud_load_ply(IntPtr handle, string path,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern IntPtr smr_job_pointcloud_load_pcd(IntPtr handle, string path,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_pointcloud_estimate_normals_knn(IntPtr handle, int k,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_pointcloud_downsample_voxel(IntPtr handle, float voxel_size,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_pointcloud_remove_outliers(IntPtr handle, int nb_neighbors,
+            float std_ratio, JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_pointcloud_orient_normals(IntPtr handle,
+            float camera_x, float camera_y, float camera_z, JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_mesh_create_poisson(IntPtr pc_handle, ref PoissonSettings settings,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_mesh_estimate_memory(IntPtr pc_handle, ref PoissonSettings settings,
+            IntPtr out_bytes, JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_mesh_remove_low_density(IntPtr handle, float quantile,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_mesh_simplify(IntPtr handle, float target_ratio,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_path_to_joints(
+            IntPtr path_handle, IntPtr robot_handle, float standoff,
+            IntPtr settings, double[] seed_joints,
+            IntPtr out_joints, IntPtr out_reachable, IntPtr out_status,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_path_set_to_joints(
+            IntPtr set_handle, IntPtr robot_handle, float standoff,
+            IntPtr settings, double[] seed_joints,
+            IntPtr out_joints, IntPtr out_reachable, IntPtr out_status,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
+        public static extern IntPtr smr_job_pipeline_run(IntPtr handle, string path, IntPtr robot_handle,
+            JobCallback callback, IntPtr user_data);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRJobState smr_job_get_state(IntPtr job);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern float smr_job_get_progress(IntPtr job);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_job_cancel(IntPtr job);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRJobState smr_job_wait(IntPtr job, int timeout_ms);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SMRErrorCode smr_job_get_result(IntPtr job);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr smr_job_take_mesh(IntPtr job);
+
+        [DllImport(DLL_NAME, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void smr_job_destroy(IntPtr job);
     }
 }
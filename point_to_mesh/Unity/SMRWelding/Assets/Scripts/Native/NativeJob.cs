@@ -0,0 +1,263 @@
+// =============================================================================
+// NativeJob.cs - Asynchronous Native Operations
+// =============================================================================
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using UnityEngine;
+
+namespace SMRWelding.Native
+{
+    /// <summary>
+    /// A long native operation running on the library's job threads.
+    /// Poll State/Progress (e.g. once per frame) instead of blocking the main
+    /// thread; Dispose cancels an unfinished job and waits for it to stop.
+    /// The objects a job works on must not be used until it is done.
+    /// A native completion callback may destroy its own job: smr_job_destroy
+    /// then returns at once and the job is freed after the callback.
+    /// </summary>
+    public sealed class NativeJob : IDisposable
+    {
+        private IntPtr _handle;
+        private readonly List<GCHandle> _pins = new List<GCHandle>();
+
+        public IntPtr Handle => _handle;
+        public SMRJobState State => NativeBindings.smr_job_get_state(_handle);
+        public float Progress => NativeBindings.smr_job_get_progress(_handle);
+        public bool IsDone => State >= SMRJobState.Completed;
+
+        /// <summary>
+        /// Result of the finished operation (Cancelled if it was cancelled)
+        /// </summary>
+        public SMRErrorCode Result => NativeBindings.smr_job_get_result(_handle);
+
+        private NativeJob()
+        {
+        }
+
+        ~NativeJob()
+        {
+            Release();
+        }
+
+        public void Dispose()
+        {
+            Release();
+            GC.SuppressFinalize(this);
+        }
+
+        private void Release()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                NativeBindings.smr_job_destroy(_handle);
+                _handle = IntPtr.Zero;
+            }
+            foreach (var pin in _pins)
+                pin.Free();
+            _pins.Clear();
+        }
+
+        /// <summary>
+        /// Ask the job to stop at its next checkpoint
+        /// </summary>
+        public void Cancel()
+        {
+            NativeBindings.smr_job_cancel(_handle);
+        }
+
+        /// <summary>
+        /// Block until the job is done or the timeout expires (-1 = no limit)
+        /// </summary>
+        public SMRJobState Wait(int timeoutMs = -1)
+        {
+            return NativeBindings.smr_job_wait(_handle, timeoutMs);
+        }
+
+        /// <summary>
+        /// Throw if the finished job did not succeed
+        /// </summary>
+        public void ThrowIfFailed()
+        {
+            var result = Result;
+            if (result != SMRErrorCode.Success)
+                throw new SMRNativeException(result);
+        }
+
+        // =====================================================================
+        // Submissions
+        // =====================================================================
+
+        /// <summary>
+        /// Load a PLY or PCD file into a point cloud
+        /// </summary>
+        public static NativeJob LoadPointCloud(PointCloudWrapper pointCloud, string path)
+        {
+            if (pointCloud == null || !pointCloud.IsValid)
+                throw new ArgumentException("Invalid point cloud");
+
+            string ext = System.IO.Path.GetExtension(path).ToLower();
+            if (ext == ".ply")
+                return Submit(NativeBindings.smr_job_pointcloud_load_ply(pointCloud.Handle, path, null, IntPtr.Zero));
+            if (ext == ".pcd")
+                return Submit(NativeBindings.smr_job_pointcloud_load_pcd(pointCloud.Handle, path, null, IntPtr.Zero));
+            throw new ArgumentException($"Unsupported format: {ext}");
+        }
+
+        /// <summary>
+        /// Estimate point cloud normals from k nearest neighbors
+        /// </summary>
+        public static NativeJob EstimateNormals(PointCloudWrapper pointCloud, int k)
+        {
+            if (pointCloud == null || !pointCloud.IsValid)
+                throw new ArgumentException("Invalid point cloud");
+            return Submit(NativeBindings.smr_job_pointcloud_estimate_normals_knn(pointCloud.Handle, k, null, IntPtr.Zero));
+        }
+
+        /// <summary>
+        /// Keep one point per voxel of the given size
+        /// </summary>
+        public static NativeJob DownsampleVoxel(PointCloudWrapper pointCloud, float voxelSize)
+        {
+            if (pointCloud == null || !pointCloud.IsValid)
+                throw new ArgumentException("Invalid point cloud");
+            return Submit(NativeBindings.smr_job_pointcloud_downsample_voxel(pointCloud.Handle, voxelSize, null, IntPtr.Zero));
+        }
+
+        /// <summary>
+        /// Remove statistical outliers
+        /// </summary>
+        public static NativeJob RemoveOutliers(PointCloudWrapper pointCloud, int neighbors, float stdRatio)
+        {
+            if (pointCloud == null || !pointCloud.IsValid)
+                throw new ArgumentException("Invalid point cloud");
+            return Submit(NativeBindings.smr_job_pointcloud_remove_outliers(pointCloud.Handle, neighbors, stdRatio, null, IntPtr.Zero));
+        }
+
+        /// <summary>
+        /// Orient normals toward a viewpoint
+        /// </summary>
+        public static NativeJob OrientNormals(PointCloudWrapper pointCloud, Vector3 viewpoint)
+        {
+            if (pointCloud == null || !pointCloud.IsValid)
+                throw new ArgumentException("Invalid point cloud");
+            return Submit(NativeBindings.smr_job_pointcloud_orient_normals(pointCloud.Handle,
+                viewpoint.x, viewpoint.y, viewpoint.z, null, IntPtr.Zero));
+        }
+
+        /// <summary>
+        /// Reconstruct a mesh; collect it with TakeMesh once completed
+        /// </summary>
+        public static NativeJob CreateMesh(PointCloudWrapper pointCloud, PoissonSettings settings)
+        {
+            if (pointCloud == null || !pointCloud.IsValid)
+                throw new ArgumentException("Invalid point cloud");
+            return Submit(NativeBindings.smr_job_mesh_create_poisson(pointCloud.Handle, ref settings, null, IntPtr.Zero));
+        }
+
+        /// <summary>
+        /// Estimate reconstruction memory at depths 1 to settings.depth. The buffer
+        /// (settings.depth longs) stays pinned until the job is disposed.
+        /// </summary>
+        public static NativeJob EstimateMeshMemory(PointCloudWrapper pointCloud, PoissonSettings settings,
+                                                   long[] outBytes)
+        {
+            if (pointCloud == null || !pointCloud.IsValid)
+                throw new ArgumentException("Invalid point cloud");
+            if (outBytes == null || outBytes.Length < settings.depth)
+                throw new ArgumentException("Need one entry per depth", nameof(outBytes));
+
+            var job = new NativeJob();
+            IntPtr bytes = job.Pin(outBytes);
+            job._handle = NativeBindings.smr_job_mesh_estimate_memory(pointCloud.Handle, ref settings, bytes,
+                null, IntPtr.Zero);
+            return job.CheckSubmitted();
+        }
+
+        /// <summary>
+        /// Remove vertices below a density quantile
+        /// </summary>
+        public static NativeJob RemoveLowDensity(MeshWrapper mesh, float quantile)
+        {
+            if (mesh == null || !mesh.IsValid)
+                throw new ArgumentException("Invalid mesh");
+            return Submit(NativeBindings.smr_job_mesh_remove_low_density(mesh.Handle, quantile, null, IntPtr.Zero));
+        }
+
+        /// <summary>
+        /// Decimate a mesh to a fraction of its triangles
+        /// </summary>
+        public static NativeJob Simplify(MeshWrapper mesh, float targetRatio)
+        {
+            if (mesh == null || !mesh.IsValid)
+                throw new ArgumentException("Invalid mesh");
+            return Submit(NativeBindings.smr_job_mesh_simplify(mesh.Handle, targetRatio, null, IntPtr.Zero));
+        }
+
+        /// <summary>
+        /// Convert a path to joints. The buffers (Count * 6 doubles, Count flags)
+        /// stay pinned until the job is disposed.
+        /// </summary>
+        public static NativeJob PathToJoints(PathWrapper path, RobotWrapper robot, float standoff,
+                                             double[] outJoints, byte[] outReachable)
+        {
+            if (path == null || !path.IsValid)
+                throw new ArgumentException("Invalid path");
+            if (robot == null || !robot.IsValid)
+                throw new ArgumentException("Invalid robot");
+
+            var job = new NativeJob();
+            IntPtr joints = job.Pin(outJoints);
+            IntPtr reachable = job.Pin(outReachable);
+            job._handle = NativeBindings.smr_job_path_to_joints(path.Handle, robot.Handle, standoff,
+                IntPtr.Zero, null, joints, reachable, IntPtr.Zero, null, IntPtr.Zero);
+            return job.CheckSubmitted();
+        }
+
+        /// <summary>
+        /// Run a native pipeline on a point cloud file (robot may be null to stop after the path)
+        /// </summary>
+        public static NativeJob RunPipeline(PipelineWrapper pipeline, string path, RobotWrapper robot)
+        {
+            if (pipeline == null || !pipeline.IsValid)
+                throw new ArgumentException("Invalid pipeline");
+            IntPtr robotHandle = robot != null ? robot.Handle : IntPtr.Zero;
+            return Submit(NativeBindings.smr_job_pipeline_run(pipeline.Handle, path, robotHandle, null, IntPtr.Zero));
+        }
+
+        /// <summary>
+        /// Take ownership of the mesh of a completed CreateMesh job
+        /// </summary>
+        public MeshWrapper TakeMesh()
+        {
+            IntPtr mesh = NativeBindings.smr_job_take_mesh(_handle);
+            if (mesh == IntPtr.Zero)
+                throw new InvalidOperationException("Job has no mesh to take");
+            return MeshWrapper.FromHandle(mesh);
+        }
+
+        private static NativeJob Submit(IntPtr handle)
+        {
+            var job = new NativeJob { _handle = handle };
+            return job.CheckSubmitted();
+        }
+
+        private NativeJob CheckSubmitted()
+        {
+            if (_handle == IntPtr.Zero)
+            {
+                Release();
+                GC.SuppressFinalize(this);
+                throw new SMRNativeException(SMRErrorCode.InvalidParameter, "Failed to submit native job");
+            }
+            return this;
+        }
+
+        private IntPtr Pin(Array buffer)
+        {
+            var pin = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+            _pins.Add(pin);
+            return pin.AddrOfPinnedObject();
+        }
+    }
+}
@@ -20,6 +20,7 @@ namespace SMRWelding.Native
         InvalidFormat = -6,
         NoSolution = -7,
         Timeout = -8,
+        Cancelled = -10,
         Unknown = -99
     }
 
@@ -44,7 +45,15 @@ namespace SMRWelding.Native
         Zigzag = 1,
         Circular = 2,
         Triangle = 3,
-        Figure8 = 4
+        Figure8 = 4,
+        Custom = 5
+    }
+
+    public enum SmoothingMethod
+    {
+        MovingAverage = 0,
+        SavitzkyGolay = 1,
+        BSpline = 2
     }
 
     /// <summary>
@@ -135,6 +144,285 @@ namespace SMRWelding.Native
         };
     }
 
+    /// <summary>
+    /// Trajectory IK settings for path-to-joints conversion (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TrajectoryIKSettings
+    {
+        public int chunk_size;
+        public int num_threads;
+        public int max_iterations;
+        public double tolerance;
+        public double max_joint_step;
+
+        public static TrajectoryIKSettings Default => new TrajectoryIKSettings();
+    }
+
+    /// <summary>
+    /// Global (configuration-consistent) IK settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct GlobalIKSettings
+    {
+        public int discovery_interval;
+        public int num_threads;
+        public double motion_weight;
+        public double limit_weight;
+        public double manipulability_weight;
+        public double max_joint_step;
+
+        public static GlobalIKSettings Default => new GlobalIKSettings();
+    }
+
+    /// <summary>
+    /// Tool-axis redundancy settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct ToolAxisSettings
+    {
+        public int spin_samples;
+        public float spin_range;
+        public float travel_tolerance;
+        public float work_tolerance;
+        public int angle_samples;
+        public double min_manipulability;
+        public int blend_window;
+        public int num_threads;
+
+        public static ToolAxisSettings Default => new ToolAxisSettings();
+    }
+
+    /// <summary>
+    /// Path time parameterization settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TimingSettings
+    {
+        public float travel_speed;
+        public double velocity_scale;
+        public double accel_scale;
+
+        public static TimingSettings Default => new TimingSettings();
+    }
+
+    /// <summary>
+    /// Workspace reachability map settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct ReachabilitySettings
+    {
+        public float voxel_size;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+        public float[] bounds_min;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+        public float[] bounds_max;
+        public int orientation_samples;
+        public int num_threads;
+
+        public static ReachabilitySettings Default => new ReachabilitySettings
+        {
+            bounds_min = new float[3],
+            bounds_max = new float[3]
+        };
+    }
+
+    /// <summary>
+    /// Collision capsule attached to a robot DH frame (0 = base, 6 = flange)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct LinkCapsule
+    {
+        public int frame;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+        public float[] p0;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+        public float[] p1;
+        public float radius;
+    }
+
+    /// <summary>
+    /// Collision checking settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct CollisionSettings
+    {
+        public float link_radius;
+        public float margin;
+        public float tip_clearance;
+        public double max_joint_step;
+        [MarshalAs(UnmanagedType.I1)]
+        public bool ignore_self_collision;
+        public int num_threads;
+
+        public static CollisionSettings Default => new CollisionSettings();
+    }
+
+    /// <summary>
+    /// Weave generation settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct WeaveSettings
+    {
+        public WeaveType type;
+        public float amplitude;
+        public float frequency;
+        public float travel_speed;
+        public int samples_per_cycle;
+
+        public static WeaveSettings Default => new WeaveSettings();
+    }
+
+    /// <summary>
+    /// Curvature-adaptive resampling settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct AdaptiveResampleSettings
+    {
+        public float chord_tolerance;
+        public float angle_tolerance;
+        public float min_step;
+        public float max_step;
+
+        public static AdaptiveResampleSettings Default => new AdaptiveResampleSettings();
+    }
+
+    /// <summary>
+    /// Joint-space transit planning settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TransitSettings
+    {
+        public double step_size;
+        public int max_iterations;
+        public float time_limit;
+        public int shortcut_iterations;
+        public uint seed;
+        public int num_threads;
+
+        public static TransitSettings Default => new TransitSettings();
+    }
+
+    /// <summary>
+    /// Extra collision test for the planners (true = in collision).
+    /// Called from native worker threads, possibly concurrently.
+    /// </summary>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    public delegate bool CollisionCallback(IntPtr joints, IntPtr user_data);
+
+    /// <summary>
+    /// State of an asynchronous native job
+    /// </summary>
+    public enum SMRJobState
+    {
+        Pending = 0,
+        Running = 1,
+        Completed = 2,
+        Failed = 3,
+        Cancelled = 4
+    }
+
+    /// <summary>
+    /// Job completion callback. Called once on a native job thread;
+    /// must not destroy or wait on the job.
+    /// </summary>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate void JobCallback(IntPtr job, SMRJobState state, IntPtr user_data);
+
+    /// <summary>
+    /// Native instrumentation mode
+    /// </summary>
+    public enum SMRStatsMode
+    {
+        Off = 0,
+        On = 1,       // Stage timers and counters
+        Trace = 2     // Also record Chrome trace events
+    }
+
+    /// <summary>
+    /// One native stage timer or counter (name points to a static native string)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct StageStat
+    {
+        public IntPtr name;
+        public long count;
+        public double total_ms;
+        public double max_ms;
+
+        public string Name => Marshal.PtrToStringAnsi(name);
+    }
+
+    /// <summary>
+    /// Process-wide native memory counters (tracked buffers only)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MemoryStats
+    {
+        public long live_bytes;
+        public long peak_bytes;
+        public long allocations;
+    }
+
+    /// <summary>
+    /// Weld sequence optimization settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SequenceSettings
+    {
+        public float time_limit;
+        public float min_heat_distance;
+        public float heat_penalty;
+        [MarshalAs(UnmanagedType.I1)]
+        public bool return_home;
+        [MarshalAs(UnmanagedType.I1)]
+        public bool fixed_direction;
+        public int num_threads;
+
+        public static SequenceSettings Default => new SequenceSettings();
+    }
+
+    /// <summary>
+    /// Path-to-surface projection settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SurfaceProjectionSettings
+    {
+        public float max_distance;
+        public int num_threads;
+
+        public static SurfaceProjectionSettings Default => new SurfaceProjectionSettings();
+    }
+
+    /// <summary>
+    /// Path smoothing settings (0 = native default)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SmoothingSettings
+    {
+        public SmoothingMethod method;
+        public int window_size;
+        public int polynomial_order;
+        public float corner_angle;
+
+        public static SmoothingSettings Default => new SmoothingSettings();
+    }
+
+    /// <summary>
+    /// Mesh ray-cast / closest-point result (triangle = -1 if nothing was found)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MeshHit
+    {
+        public int triangle;
+        public float distance;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+        public float[] point;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+        public float[] normal;
+    }
+
     /// <summary>
     /// Poisson surface reconstruction settings
     /// </summary>
@@ -156,6 +444,43 @@ namespace SMRWelding.Native
         };
     }
 
+    /// <summary>
+    /// Native scan-to-trajectory pipeline settings (0 = native default, negative = stage off where noted)
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PipelineSettings
+    {
+        public float voxel_size;           // negative = no downsampling
+        public int outlier_neighbors;      // negative = no outlier removal
+        public float outlier_std_ratio;
+        public int normal_knn;
+        public float view_point_x;         // Normals are oriented towards this point
+        public float view_point_y;
+        public float view_point_z;
+        public PoissonSettings poisson;    // density_threshold negative = keep all
+        public float simplify_ratio;       // 0 = no decimation
+        public PathParams path;
+        public int smooth_window;          // negative = no smoothing
+        public TrajectoryIKSettings ik;
+        public int block_points;
+
+        public static PipelineSettings Default => new PipelineSettings();
+    }
+
+    /// <summary>
+    /// Native pipeline stages (indices of the stage times)
+    /// </summary>
+    public enum PipelineStage
+    {
+        Load = 0,
+        Outliers = 1,
+        Normals = 2,
+        Mesh = 3,
+        Path = 4,
+        Trajectory = 5,
+        Count = 6
+    }
+
     /// <summary>
     /// 4x4 transformation matrix (row-major)
     /// </summary>
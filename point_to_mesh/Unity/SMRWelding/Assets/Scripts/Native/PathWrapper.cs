@@ -13,6 +13,7 @@ namespace SMRWelding.Native
     public class PathWrapper : IDisposable
     {
         private IntPtr _handle;
+        private bool _owned = true;     // false for objects owned by a native pipeline
         private bool _disposed;
 
         public IntPtr Handle => _handle;
@@ -23,6 +24,14 @@ namespace SMRWelding.Native
             _handle = handle;
         }
 
+        /// <summary>
+        /// View of an object owned by native code (e.g. a PipelineWrapper); Dispose does not destroy it
+        /// </summary>
+        internal static PathWrapper Borrow(IntPtr handle)
+        {
+            return new PathWrapper(handle) { _owned = false };
+        }
+
         ~PathWrapper()
         {
             Dispose(false);
@@ -90,7 +99,8 @@ namespace SMRWelding.Native
         {
             if (!_disposed && _handle != IntPtr.Zero)
             {
-                NativeBindings.smr_path_destroy(_handle);
+                if (_owned)
+                    NativeBindings.smr_path_destroy(_handle);
                 _handle = IntPtr.Zero;
             }
             _disposed = true;
@@ -108,6 +118,18 @@ namespace SMRWelding.Native
             }
         }
 
+        /// <summary>
+        /// Native bytes held by this handle
+        /// </summary>
+        public long MemoryBytes
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeBindings.smr_path_get_memory(_handle);
+            }
+        }
+
         /// <summary>
         /// Get all weld points
         /// </summary>
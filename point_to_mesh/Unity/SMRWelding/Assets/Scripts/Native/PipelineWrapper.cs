@@ -0,0 +1,150 @@
+// =============================================================================
+// PipelineWrapper.cs - Native Scan-to-Trajectory Pipeline
+// =============================================================================
+using System;
+
+namespace SMRWelding.Native
+{
+    /// <summary>
+    /// Runs load, filtering, reconstruction, path and trajectory stages in one
+    /// native call. Results stay owned by the pipeline and are replaced by the
+    /// next Run; buffers are reused between runs.
+    /// </summary>
+    public class PipelineWrapper : IDisposable
+    {
+        private IntPtr _handle;
+        private bool _disposed;
+
+        public IntPtr Handle => _handle;
+        public bool IsValid => _handle != IntPtr.Zero;
+
+        /// <summary>
+        /// Create a pipeline (null settings = native defaults)
+        /// </summary>
+        public PipelineWrapper(PipelineSettings? settings = null)
+        {
+            var actualSettings = settings ?? PipelineSettings.Default;
+            _handle = NativeBindings.smr_pipeline_create(ref actualSettings);
+            if (_handle == IntPtr.Zero)
+                throw new SMRNativeException(SMRErrorCode.InvalidParameter,
+                    $"Failed to create pipeline: {NativeBindings.GetLastError()}");
+        }
+
+        ~PipelineWrapper()
+        {
+            Dispose(false);
+        }
+
+        public void Dispose()
+        {
+            Dispose(true);
+            GC.SuppressFinalize(this);
+        }
+
+        protected virtual void Dispose(bool disposing)
+        {
+            if (!_disposed && _handle != IntPtr.Zero)
+            {
+                NativeBindings.smr_pipeline_destroy(_handle);
+                _handle = IntPtr.Zero;
+            }
+            _disposed = true;
+        }
+
+        /// <summary>
+        /// Process a PLY or PCD file (robot may be null to stop after the path).
+        /// Blocks; use NativeJob.RunPipeline to run it off the main thread.
+        /// </summary>
+        public void Run(string path, RobotWrapper robot = null)
+        {
+            ThrowIfDisposed();
+            IntPtr robotHandle = robot != null ? robot.Handle : IntPtr.Zero;
+            var result = NativeBindings.smr_pipeline_run(_handle, path, robotHandle);
+            if (result != SMRErrorCode.Success)
+                throw new SMRNativeException(result, $"Pipeline failed: {NativeBindings.GetLastError()}");
+        }
+
+        /// <summary>
+        /// Reconstructed mesh of the last run (owned by the pipeline; null if none)
+        /// </summary>
+        public MeshWrapper Mesh
+        {
+            get
+            {
+                ThrowIfDisposed();
+                IntPtr mesh = NativeBindings.smr_pipeline_get_mesh(_handle);
+                return mesh != IntPtr.Zero ? MeshWrapper.Borrow(mesh) : null;
+            }
+        }
+
+        /// <summary>
+        /// Weld path of the last run (owned by the pipeline; null if none)
+        /// </summary>
+        public PathWrapper Path
+        {
+            get
+            {
+                ThrowIfDisposed();
+                IntPtr path = NativeBindings.smr_pipeline_get_path(_handle);
+                return path != IntPtr.Zero ? PathWrapper.Borrow(path) : null;
+            }
+        }
+
+        /// <summary>
+        /// Native bytes held by this pipeline (cloud, mesh, path and joints of the last run)
+        /// </summary>
+        public long MemoryBytes
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeBindings.smr_pipeline_get_memory(_handle);
+            }
+        }
+
+        /// <summary>
+        /// Joint trajectory of the last run (empty if it ran without a robot)
+        /// </summary>
+        public (double[][] joints, bool[] reachable) GetJointTrajectory()
+        {
+            ThrowIfDisposed();
+            int count = NativeBindings.smr_pipeline_get_joint_count(_handle);
+            if (count <= 0) return (Array.Empty<double[]>(), Array.Empty<bool>());
+
+            double[] jointsFlat = new double[count * 6];
+            bool[] reachable = new bool[count];
+
+            var result = NativeBindings.smr_pipeline_get_joints(_handle, jointsFlat, reachable);
+            if (result != SMRErrorCode.Success)
+                throw new SMRNativeException(result);
+
+            double[][] joints = new double[count][];
+            for (int i = 0; i < count; i++)
+            {
+                joints[i] = new double[6];
+                Array.Copy(jointsFlat, i * 6, joints[i], 0, 6);
+            }
+
+            return (joints, reachable);
+        }
+
+        /// <summary>
+        /// Milliseconds spent in each stage of the last run, indexed by PipelineStage
+        /// </summary>
+        public double[] GetStageTimes()
+        {
+            ThrowIfDisposed();
+            double[] ms = new double[(int)PipelineStage.Count];
+            var result = NativeBindings.smr_pipeline_get_stage_times(_handle, ms);
+            if (result != SMRErrorCode.Success)
+                throw new SMRNativeException(result);
+            return ms;
+        }
+
+        private void ThrowIfDisposed()
+        {
+            if (_disposed || _handle == IntPtr.Zero)
+                throw new ObjectDisposedException(nameof(PipelineWrapper));
+        }
+    }
+}
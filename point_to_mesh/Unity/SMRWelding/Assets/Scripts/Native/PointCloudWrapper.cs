@@ -97,6 +97,29 @@ namespace SMRWelding.Native
             }
         }
 
+        /// <summary>
+        /// Native bytes held by this handle, including spare arrays kept for the filters
+        /// </summary>
+        public long MemoryBytes
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeBindings.smr_pointcloud_get_memory(_handle);
+            }
+        }
+
+        /// <summary>
+        /// Release the spare arrays kept for the filters (e.g. once filtering is done)
+        /// </summary>
+        public void TrimMemory()
+        {
+            ThrowIfDisposed();
+            var result = NativeBindings.smr_pointcloud_trim_memory(_handle);
+            if (result != SMRErrorCode.Success)
+                throw new SMRNativeException(result);
+        }
+
         /// <summary>
         /// Get points as Unity Vector3 array
         /// </summary>
@@ -209,6 +232,21 @@ namespace SMRWelding.Native
                 throw new SMRNativeException(result);
         }
 
+        /// <summary>
+        /// Reorder points along a Morton (Z-order) curve so that neighbors are
+        /// close in memory. Returns, for each new position, the point's
+        /// original index.
+        /// </summary>
+        public int[] SortSpatial()
+        {
+            ThrowIfDisposed();
+            int[] permutation = new int[Math.Max(Count, 0)];
+            var result = NativeBindings.smr_pointcloud_sort_spatial(_handle, permutation);
+            if (result != SMRErrorCode.Success)
+                throw new SMRNativeException(result);
+            return permutation;
+        }
+
         private void ThrowIfDisposed()
         {
             if (_disposed || _handle == IntPtr.Zero)
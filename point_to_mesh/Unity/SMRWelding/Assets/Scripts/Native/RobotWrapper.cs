@@ -194,6 +194,18 @@ namespace SMRWelding.Native
             return mat;
         }
 
+        /// <summary>
+        /// Native bytes held by this robot (reachability map and collision model)
+        /// </summary>
+        public long MemoryBytes
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeBindings.smr_robot_get_memory(_handle);
+            }
+        }
+
         private static double[] ConvertFromUnityMatrix(Matrix4x4 mat)
         {
             return new double[] {